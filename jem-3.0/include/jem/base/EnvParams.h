@@ -49,6 +49,7 @@ class EnvParams
   static const char*      CONCURRENCY;
   static const char*      ABORT_ON_EXCEPT;
   static const char*      LOG_BUFFER_SIZE;
+  static const char*      MEM_PROFILE;
 
 };
 
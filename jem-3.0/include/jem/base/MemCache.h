@@ -48,6 +48,11 @@ class MemCache
 
     ( size_t          size );
 
+  static void*      alloc
+
+    ( size_t          size,
+      const char*     tag );
+
   static void*      allocNoThrow
 
     ( size_t          size )        noexcept;
@@ -63,6 +68,13 @@ class MemCache
       size_t          oldSize,
       size_t          newSize );
 
+  static void*      realloc
+
+    ( void*           addr,
+      size_t          oldSize,
+      size_t          newSize,
+      const char*     tag );
+
   static void*      reallocNoThrow
 
     ( void*           addr,
@@ -73,9 +85,75 @@ class MemCache
 
     ( size_t          size );
 
+  static void       setProfiling
+
+    ( bool            flag );
+
+  static bool       isProfiling   ();
+
+  static const char*  setTag
+
+    ( const char*     tag )         noexcept;
+
+
+  class             TagScope;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   class MemCache::TagScope
+//-----------------------------------------------------------------------
+
+
+class MemCache::TagScope
+{
+ public:
+
+  explicit inline   TagScope
+
+    ( const char*     tag )         noexcept;
+
+  inline           ~TagScope      ();
+
+
+ private:
+
+                    TagScope      ( const TagScope& );
+  TagScope&         operator =    ( const TagScope& );
+
+
+ private:
+
+  const char*       prevTag_;
+
 };
 
 
+
+
+
+//#######################################################################
+//   Implementation
+//#######################################################################
+
+//=======================================================================
+//   class MemCache::TagScope
+//=======================================================================
+
+
+inline MemCache::TagScope::TagScope ( const char* tag ) noexcept
+{
+  prevTag_ = MemCache::setTag ( tag );
+}
+
+
+inline MemCache::TagScope::~TagScope ()
+{
+  MemCache::setTag ( prevTag_ );
+}
+
+
 JEM_END_PACKAGE_BASE
 
 #endif
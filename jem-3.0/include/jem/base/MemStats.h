@@ -0,0 +1,113 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+#ifndef JEM_BASE_MEMSTATS_H
+#define JEM_BASE_MEMSTATS_H
+
+#include <jem/base/Array.h>
+
+
+namespace jem
+{
+  namespace io
+  {
+    class TextOutput;
+  }
+}
+
+
+JEM_BEGIN_PACKAGE_BASE
+
+
+//-----------------------------------------------------------------------
+//   class MemStats
+//-----------------------------------------------------------------------
+
+
+class MemStats
+{
+ public:
+
+  static const int        CLASS_COUNT = 16;
+  static const int        MAX_TAGS    = 32;
+  static const char*      OTHER_TAG;
+
+  struct                  SizeClass
+  {
+    lint                    allocCount;
+    lint                    hitCount;
+    lint                    cachedCount;
+  };
+
+  struct                  Tag
+  {
+    const char*             name;
+    lint                    allocCount;
+    lint                    byteCount;
+  };
+
+
+                          MemStats    ();
+
+  void                    clear       ();
+
+  void                    merge
+
+    ( const MemStats&       rhs );
+
+  lint                    bytesInUse  () const;
+  double                  hitRate     () const;
+
+  void                    printTo
+
+    ( io::TextOutput&       out )        const;
+
+  static MemStats         getTotal    ();
+  static Array<MemStats>  getThreads  ();
+
+
+ public:
+
+  int                     threadID;
+  lint                    allocCount;
+  lint                    freeCount;
+  lint                    allocBytes;
+  lint                    freeBytes;
+  lint                    peakBytes;
+  lint                    largeCount;
+  lint                    largeBytes;
+  SizeClass               classes[CLASS_COUNT];
+  int                     tagCount;
+  Tag                     tags[MAX_TAGS];
+
+};
+
+
+JEM_END_PACKAGE_BASE
+
+#endif
@@ -0,0 +1,209 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+#ifndef JEM_BASE_THREADTEAM_H
+#define JEM_BASE_THREADTEAM_H
+
+#include <jem/base/Object.h>
+
+
+JEM_BEGIN_PACKAGE_BASE
+
+
+//-----------------------------------------------------------------------
+//   class ThreadTeam
+//-----------------------------------------------------------------------
+
+// A fixed group of threads that execute loops in parallel. The index
+// range of a loop is split into one contiguous chunk per thread, and
+// the calling thread executes the first chunk itself. A loop that is
+// started while the team is busy -- for instance from within another
+// loop -- is executed by the calling thread alone.
+//
+// Each thread can have a current team that is used by the threaded
+// numerical kernels.
+
+
+class ThreadTeam : public Object
+{
+ public:
+
+  typedef ThreadTeam        Self;
+  typedef Object            Super;
+
+
+  class                     Work
+  {
+   public:
+
+    virtual void              run
+
+      ( idx_t                   first,
+        idx_t                   last )      = 0;
+
+
+   protected:
+
+    virtual                  ~Work      ();
+
+  };
+
+
+  explicit                  ThreadTeam
+
+    ( int                     size );
+
+  inline int                size        () const noexcept;
+
+  void                      execute
+
+    ( Work&                   work,
+      idx_t                   count,
+      idx_t                   grain = 1 );
+
+  template <class Func>
+
+    inline void             forEach
+
+    ( idx_t                   count,
+      idx_t                   grain,
+      const Func&             func );
+
+  static Ref<Self>          getCurrent  ();
+
+  static void               setCurrent
+
+    ( const Ref<Self>&        team );
+
+
+ protected:
+
+  virtual                  ~ThreadTeam  ();
+
+
+ private:
+
+  class                     Shared_;
+  class                     Worker_;
+
+  template <class Func>
+    class                   FuncWork_;
+
+  static int                getKey_     ();
+  static void               initKey_    ();
+
+
+ private:
+
+  static int                localKey_;
+
+  Ref<Shared_>              shared_;
+  int                       size_;
+
+};
+
+
+//#######################################################################
+//   implementation
+//#######################################################################
+
+//=======================================================================
+//   class ThreadTeam::FuncWork_
+//=======================================================================
+
+
+template <class Func>
+
+  class ThreadTeam::FuncWork_ : public Work
+
+{
+ public:
+
+  explicit inline           FuncWork_
+
+    ( const Func&             func ) :
+
+      func_ ( func )
+
+  {}
+
+  virtual void              run
+
+    ( idx_t                   first,
+      idx_t                   last )     override
+
+  {
+    func_ ( first, last );
+  }
+
+
+ private:
+
+  const Func&               func_;
+
+};
+
+
+//=======================================================================
+//   class ThreadTeam
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   size
+//-----------------------------------------------------------------------
+
+
+inline int ThreadTeam::size () const noexcept
+{
+  return size_;
+}
+
+
+//-----------------------------------------------------------------------
+//   forEach
+//-----------------------------------------------------------------------
+
+
+template <class Func>
+
+  inline void ThreadTeam::forEach
+
+  ( idx_t        count,
+    idx_t        grain,
+    const Func&  func )
+
+{
+  FuncWork_<Func>  work ( func );
+
+  execute ( work, count, grain );
+}
+
+
+JEM_END_PACKAGE_BASE
+
+#endif
@@ -146,7 +146,7 @@ template <class T>
 
   offset = AllocatorUtils::align ( sizeof(Self) );
   msize  = offset + (size_t) size * sizeof(T);
-  mem    = (byte*) MemCache::alloc ( msize );
+  mem    = (byte*) MemCache::alloc ( msize, "jem::Array" );
   *ptr   = (T*)   (mem + offset);
   block  = (Self*) mem;
 
@@ -269,14 +269,15 @@ template <class T>
 
   if ( oldBlock == &null )
   {
-    newBlock = (Self*) MemCache::alloc ( msize );
+    newBlock = (Self*) MemCache::alloc ( msize, "jem::Array" );
     newBlock->refcount = 1;
   }
   else
   {
     newBlock = (Self*)
 
-      MemCache::realloc ( oldBlock, oldBlock->msize_, msize );
+      MemCache::realloc ( oldBlock, oldBlock->msize_, msize,
+                          "jem::Array" );
   }
 
   newBlock->msize_ = msize;
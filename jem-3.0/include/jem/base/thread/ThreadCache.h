@@ -38,6 +38,9 @@
 JEM_BEGIN_PACKAGE_BASE
 
 
+class MemStats;
+
+
 //-----------------------------------------------------------------------
 //   class ThreadCache
 //-----------------------------------------------------------------------
@@ -68,7 +71,8 @@ class ThreadCache : private AllocatorUtils
   inline void*          alloc
 
     ( size_t              size,
-      ThrowMode           tm = CAN_THROW );
+      ThrowMode           tm  = CAN_THROW,
+      const char*         tag = nullptr );
 
   inline void           dealloc
 
@@ -80,12 +84,35 @@ class ThreadCache : private AllocatorUtils
     ( void*               oldAddr,
       size_t              oldSize,
       size_t              newSize,
-      ThrowMode           tm = CAN_THROW );
+      ThrowMode           tm  = CAN_THROW,
+      const char*         tag = nullptr );
 
   void                  setSize
 
     ( size_t              size );
 
+  void                  setProfiling
+
+    ( bool                flag );
+
+  inline bool           isProfiling   () const noexcept;
+
+  const char*           setTag
+
+    ( const char*         tag )          noexcept;
+
+  static void           setDefaultProfiling
+
+    ( bool                flag );
+
+  static bool           getDefaultProfiling ();
+
+  static idx_t          getStats
+
+    ( MemStats&           total,
+      MemStats*           threads,
+      idx_t               maxThreads );
+
 
  private:
 
@@ -108,9 +135,23 @@ class ThreadCache : private AllocatorUtils
       size_t              size,
       ThrowMode           tm );
 
+  void                  profileAlloc_
+
+    ( size_t              size,
+      bool                hit,
+      const char*         tag )          noexcept;
+
+  void                  profileDealloc_
+
+    ( size_t              size,
+      bool                cached )       noexcept;
+
+  static MemStats&      getRetiredStats_ ();
+
 
  private:
 
+  class                 Profile_;
   struct                Item_;
   class                 ItemList_;
   friend class          ItemList_;
@@ -139,6 +180,7 @@ class ThreadCache : private AllocatorUtils
   ItemList_             freeLists_[FREE_LIST_COUNT];
   size_t                cacheSize_;
   byte                  errors_;
+  Profile_*             profile_;
 
 };
 
@@ -168,6 +210,17 @@ ThreadCache::ItemList_::ItemList_ ()
 //   class ThreadCache
 //=======================================================================
 
+//-----------------------------------------------------------------------
+//   isProfiling
+//-----------------------------------------------------------------------
+
+
+inline bool ThreadCache::isProfiling () const noexcept
+{
+  return (profile_ != nullptr);
+}
+
+
 //-----------------------------------------------------------------------
 //   alloc
 //-----------------------------------------------------------------------
@@ -175,8 +228,9 @@ ThreadCache::ItemList_::ItemList_ ()
 
 inline void* ThreadCache::alloc
 
-  ( size_t     size,
-    ThrowMode  tm )
+  ( size_t       size,
+    ThrowMode    tm,
+    const char*  tag )
 
 {
   if ( size == 0 )
@@ -195,10 +249,20 @@ inline void* ThreadCache::alloc
       list->first = item->next;
       list->length--;
 
+      if ( profile_ )
+      {
+        profileAlloc_ ( size, true,  tag );
+      }
+
       return (void*) item;
     }
     else
     {
+      if ( profile_ )
+      {
+        profileAlloc_ ( size, false, tag );
+      }
+
       return alloc_ ( align(size), tm );
     }
   }
@@ -207,6 +271,11 @@ inline void* ThreadCache::alloc
     size_t  n = align ( size + 1 );
     byte*   p;
 
+    if ( profile_ )
+    {
+      profileAlloc_ ( size, false, tag );
+    }
+
     if ( size < LARGE_ALLOC )
     {
       p = (byte*) alloc_ ( n, tm );
@@ -254,6 +323,11 @@ inline void ThreadCache::dealloc
     ItemList_*  list = freeLists_ + ((size - 1) / ALIGNMENT);
     Item_*      item = (Item_*) addr;
 
+    if ( profile_ )
+    {
+      profileDealloc_ ( size, (list->length < list->maxLength) );
+    }
+
     if ( list->length == list->maxLength )
     {
       std::free ( item );
@@ -270,6 +344,11 @@ inline void ThreadCache::dealloc
     size_t  n = align ( size + 1 );
     byte*   p = (byte*) addr;
 
+    if ( profile_ )
+    {
+      profileDealloc_ ( size, false );
+    }
+
     for ( size_t i = size; i < n; i++ )
     {
       errors_ = (byte) (errors_ | (p[size] - CANARY_VALUE));
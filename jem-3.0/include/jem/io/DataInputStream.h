@@ -37,6 +37,9 @@
 JEM_BEGIN_PACKAGE( io )
 
 
+class MappedInputStream;
+
+
 //-----------------------------------------------------------------------
 //   class DataInputStream
 //-----------------------------------------------------------------------
@@ -144,6 +147,7 @@ class DataInputStream : public FilterInputStream,
   const int               SEX_;
 
   Options                 options_;
+  MappedInputStream*      mapped_;
 
 };
 
@@ -55,7 +55,8 @@ class GzipFileWriter : public OutputStreamWriter,
   explicit                GzipFileWriter
 
     ( const String&         name,
-      OpenFlags             flags = 0 );
+      OpenFlags             flags   = 0,
+      int                   threads = 0 );
 
   explicit                GzipFileWriter
 
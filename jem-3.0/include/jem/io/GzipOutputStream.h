@@ -50,6 +50,8 @@ class GzipOutputStream : public OutputStream
 
   JEM_DECLARE_CLASS   ( GzipOutputStream, OutputStream );
 
+  static const idx_t    DEFAULT_BLOCK_SIZE;
+
 
   explicit              GzipOutputStream
 
@@ -70,6 +72,15 @@ class GzipOutputStream : public OutputStream
     ( const void*         buf,
       idx_t               n )                noexcept override;
 
+  void                  setThreads
+
+    ( int                 count,
+      idx_t               blockSize = -1 );
+
+  void                  setBlockIndex
+
+    ( Ref<OutputStream>   index );
+
 
  protected:
 
@@ -82,11 +93,25 @@ class GzipOutputStream : public OutputStream
 
     ( ThrowMode           tm = CAN_THROW );
 
+  void                  finishBlocks_
+
+    ( ThrowMode           tm );
+
+  void                  closeIndex_
+
+    ( ThrowMode           tm );
+
 
  private:
 
+  class                 Parallel_;
+  class                 Worker_;
+
   Ref<OutputStream>     output_;
+  Ref<OutputStream>     index_;
   Ref<Deflator>         deflator_;
+  Ref<Parallel_>        parallel_;
+  int                   level_;
 
 };
 
@@ -0,0 +1,127 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+#ifndef JEM_IO_MAPPEDINPUTSTREAM_H
+#define JEM_IO_MAPPEDINPUTSTREAM_H
+
+#include <jem/io/InputStream.h>
+
+
+JEM_BEGIN_PACKAGE( io )
+
+
+class MappedFile;
+
+
+//-----------------------------------------------------------------------
+//   class MappedInputStream
+//-----------------------------------------------------------------------
+
+
+class MappedInputStream : public InputStream
+{
+ public:
+
+  JEM_DECLARE_CLASS     ( MappedInputStream, InputStream );
+
+
+  explicit                MappedInputStream
+
+    ( const String&         name );
+
+  explicit                MappedInputStream
+
+    ( Ref<MappedFile>       file );
+
+                          MappedInputStream
+
+    ( const Self&           rhs );
+
+  virtual
+    Ref<InputStream>      dup               () override;
+  virtual void            close             () override;
+
+  virtual idx_t           poll
+
+    ( const Time&           timeout )          override;
+
+  virtual idx_t           read
+
+    ( void*                 buf,
+      idx_t                 n )                override;
+
+  virtual void            readAll
+
+    ( void*                 buf,
+      idx_t                 n )                override;
+
+  virtual idx_t           skip
+
+    ( idx_t                 n )                override;
+
+  const byte*             readSpan
+
+    ( idx_t                 n );
+
+  lint                    available         () const;
+  lint                    getPosition       () const;
+
+  void                    setPosition
+
+    ( lint                  pos );
+
+  Ref<MappedFile>         getMappedFile     () const;
+
+
+ protected:
+
+  virtual                ~MappedInputStream ();
+
+
+ private:
+
+  void                    closedError_      () const;
+
+  void                    eofError_
+
+    ( idx_t                 n )                const;
+
+
+ private:
+
+  Ref<MappedFile>         file_;
+  const byte*             addr_;
+  lint                    size_;
+  lint                    pos_;
+
+};
+
+
+JEM_END_PACKAGE( io )
+
+#endif
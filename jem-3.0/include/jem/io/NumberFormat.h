@@ -58,6 +58,7 @@ class NumberFormat
   static const int      SCIENTIFIC;
   static const int      UPPERCASE;
   static const int      SHOW_SIGN;
+  static const int      SHORTEST;
 
 
   inline                NumberFormat      ()       noexcept;
@@ -85,6 +86,10 @@ class NumberFormat
 
     ( bool                choice = true );
 
+  inline void           setShortest
+
+    ( bool                choice = true );
+
   void                  setIntegerBase
 
     ( int                 base  );
@@ -228,6 +233,17 @@ inline void NumberFormat::setShowSign ( bool choice )
 }
 
 
+//-----------------------------------------------------------------------
+//   setShortest
+//-----------------------------------------------------------------------
+
+
+inline void NumberFormat::setShortest ( bool choice )
+{
+  setFlag ( SHORTEST, choice );
+}
+
+
 //-----------------------------------------------------------------------
 //   getFlags
 //-----------------------------------------------------------------------
@@ -124,11 +124,46 @@ class Context : public Object
       const SendBuffer&       sbuf,
       Opcode                  op )                  = 0;
 
+  // Sends scounts[i] items from sbuf to process i and receives
+  // rcounts[i] items from process i into rbuf. The items for (and
+  // from) each process are stored contiguously in rank order. This
+  // is a collective operation.
+
+  virtual void              alltoallv
+
+    ( const RecvBuffer&       rbuf,
+      const idx_t*            rcounts,
+      const SendBuffer&       sbuf,
+      const idx_t*            scounts );
+
+  // Receives rcounts[i] items from process sources[i] and sends
+  // scounts[i] items to process dests[i], using at most one message
+  // per peer. Only the listed processes take part in the exchange.
+  // Empty messages are skipped, so the counts must be consistent
+  // between each pair of peers.
+
+  virtual void              neighborExchange
+
+    ( const RecvBuffer&       rbuf,
+      const int*              sources,
+      const idx_t*            rcounts,
+      int                     srcCount,
+      const SendBuffer&       sbuf,
+      const int*              dests,
+      const idx_t*            scounts,
+      int                     destCount,
+      int                     tag = DEFAULT_TAG );
+
 
  protected:
 
   virtual                  ~Context        ();
 
+
+ private:
+
+  Ref<Context>              collCtx_;
+
 };
 
 
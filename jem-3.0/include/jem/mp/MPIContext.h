@@ -36,6 +36,13 @@
 JEM_BEGIN_PACKAGE( mp )
 
 
+JEM_BEGIN_NAMESPACE( mpi )
+
+class Hierarchy;
+
+JEM_END_NAMESPACE( mpi )
+
+
 //-----------------------------------------------------------------------
 //   class MPIContext
 //-----------------------------------------------------------------------
@@ -48,6 +55,8 @@ class MPIContext : public Context
   typedef MPIContext        Self;
   typedef Context           Super;
 
+  static const idx_t        HIER_MAX_SIZE;
+
 
   explicit                  MPIContext
 
@@ -122,6 +131,26 @@ class MPIContext : public Context
       const SendBuffer&       sbuf,
       Opcode                  opcode )              override;
 
+  virtual void              alltoallv
+
+    ( const RecvBuffer&       rbuf,
+      const idx_t*            rcounts,
+      const SendBuffer&       sbuf,
+      const idx_t*            scounts )             override;
+
+  Ref<Self>                 split
+
+    ( int                     color,
+      int                     key );
+
+  Ref<Self>                 splitShared    ();
+
+  void                      setHierColl
+
+    ( bool                    choice,
+      idx_t                   maxSize = HIER_MAX_SIZE );
+
+  inline bool               getHierColl    () const noexcept;
   inline MPI_Comm           getComm        () const noexcept;
   static void               finalize       ();
   inline static bool        finalized      ()       noexcept;
@@ -132,6 +161,14 @@ class MPIContext : public Context
   virtual                  ~MPIContext     ();
 
 
+ private:
+
+  inline bool               useHier_
+
+    ( idx_t                   count,
+      Type                    type )          const noexcept;
+
+
  private:
 
   static MPI_Op             OP_TABLE_[OPCODE_COUNT];
@@ -143,6 +180,9 @@ class MPIContext : public Context
   int                       size_;
   int                       myRank_;
 
+  Ref<mpi::Hierarchy>       hier_;
+  idx_t                     hierMaxSize_;
+
 };
 
 
@@ -150,6 +190,17 @@ class MPIContext : public Context
 //   Implementation
 //#######################################################################
 
+//-----------------------------------------------------------------------
+//   getHierColl
+//-----------------------------------------------------------------------
+
+
+inline bool MPIContext::getHierColl () const noexcept
+{
+  return (hier_ != nullptr);
+}
+
+
 //-----------------------------------------------------------------------
 //   getComm
 //-----------------------------------------------------------------------
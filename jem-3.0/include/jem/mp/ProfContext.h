@@ -0,0 +1,199 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+#ifndef JEM_MP_PROFCONTEXT_H
+#define JEM_MP_PROFCONTEXT_H
+
+#include <jem/mp/Context.h>
+
+
+namespace jem
+{
+  namespace io
+  {
+    class PrintWriter;
+  }
+}
+
+
+JEM_BEGIN_PACKAGE( mp )
+
+
+//-----------------------------------------------------------------------
+//   class ProfContext
+//-----------------------------------------------------------------------
+
+// Wraps another context and records how much data is sent to and
+// received from each peer and with each tag, how long the process
+// is blocked in point-to-point operations and request lists, and how
+// much time is spent in collective operations. A context and all its
+// clones share the same statistics.
+
+
+class ProfContext : public Context
+{
+ public:
+
+  typedef ProfContext         Self;
+  typedef Context             Super;
+
+
+  explicit                    ProfContext
+
+    ( const Ref<Context>&       ctx );
+
+  virtual String              getErrorString
+
+    ( int                       err )           const override;
+
+  virtual int                 size           () const override;
+  virtual int                 myRank         () const override;
+  virtual bool                isShared       () const override;
+
+  virtual void                abort
+
+    ( int                       err )                 override;
+
+  virtual Ref<Context>        clone          ()       override;
+
+  virtual Ref<RequestList>    newRequestList ()       override;
+
+  virtual void                send
+
+    ( const SendBuffer&         buf,
+      int                       dest,
+      int                       tag )                 override;
+
+  virtual void                recv
+
+    ( const RecvBuffer&         buf,
+      int                       src,
+      int                       tag,
+      Status*                   stat )                override;
+
+  virtual Ref<Request>        initSend
+
+    ( const SendBuffer&         buf,
+      int                       dest,
+      int                       tag )                 override;
+
+  virtual Ref<Request>        initRecv
+
+    ( const RecvBuffer&         buf,
+      int                       src,
+      int                       tag )                 override;
+
+  virtual void                barrier        ()       override;
+
+  virtual void                broadcast
+
+    ( const SendBuffer&         buf )                 override;
+
+  virtual void                broadcast
+
+    ( const RecvBuffer&         buf,
+      int                       root )                override;
+
+  virtual void                reduce
+
+    ( const RecvBuffer&         in,
+      const SendBuffer&         out,
+      int                       root,
+      Opcode                    opcode )              override;
+
+  virtual void                allreduce
+
+    ( const RecvBuffer&         in,
+      const SendBuffer&         out,
+      Opcode                    opcode )              override;
+
+  virtual void                alltoallv
+
+    ( const RecvBuffer&         rbuf,
+      const idx_t*              rcounts,
+      const SendBuffer&         sbuf,
+      const idx_t*              scounts )             override;
+
+  inline Context*             getInner       () const noexcept;
+  void                        resetStats     ();
+
+  void                        printStats
+
+    ( io::PrintWriter&          out )           const;
+
+  // Collective operation; the merged report is printed by the
+  // process with rank zero only.
+
+  void                        printReport
+
+    ( io::PrintWriter&          out );
+
+
+ protected:
+
+  virtual                    ~ProfContext    ();
+
+
+ private:
+
+  class                       Stats_;
+  class                       Request_;
+  class                       RequestList_;
+  class                       Utils_;
+
+  friend class                Request_;
+  friend class                RequestList_;
+  friend class                Utils_;
+
+
+ private:
+
+  Ref<Context>                inner_;
+  Ref<Stats_>                 stats_;
+
+};
+
+
+//#######################################################################
+//   implementation
+//#######################################################################
+
+//-----------------------------------------------------------------------
+//   getInner
+//-----------------------------------------------------------------------
+
+
+inline Context* ProfContext::getInner () const noexcept
+{
+  return inner_.get ();
+}
+
+
+JEM_END_PACKAGE( mp )
+
+#endif
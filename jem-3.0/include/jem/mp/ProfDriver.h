@@ -0,0 +1,92 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+#ifndef JEM_MP_PROFDRIVER_H
+#define JEM_MP_PROFDRIVER_H
+
+#include <jem/mp/Driver.h>
+
+
+JEM_BEGIN_PACKAGE( mp )
+
+
+//-----------------------------------------------------------------------
+//   class ProfDriver
+//-----------------------------------------------------------------------
+
+// Runs a task with another driver and wraps the context passed to
+// the task in a ProfContext. When the task has finished, each process
+// writes its communication statistics to the file "<prefix>.<rank>"
+// and the root process writes a merged report to "<prefix>". The
+// prefix is taken from the environment variable JEM_MP_PROF_FILE and
+// defaults to "mp-prof".
+//
+// The standard driver factory creates a ProfDriver for driver names
+// of the form "prof:<name>", such as "prof:mpi".
+
+
+class ProfDriver : public Driver
+{
+ public:
+
+  typedef ProfDriver  Self;
+  typedef Driver      Super;
+
+
+  explicit            ProfDriver
+
+    ( const Ref<Driver>&  driver );
+
+  virtual void        start
+
+    ( TaskFactory&      factory,
+      int               argc,
+      char**            argv )      override;
+
+
+ protected:
+
+  virtual            ~ProfDriver ();
+
+
+ private:
+
+  class               Task_;
+  class               TaskFactory_;
+
+
+ private:
+
+  Ref<Driver>         driver_;
+
+};
+
+
+JEM_END_PACKAGE( mp )
+
+#endif
@@ -0,0 +1,173 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+#ifndef JEM_MP_SHMCONTEXT_H
+#define JEM_MP_SHMCONTEXT_H
+
+#include <jem/mp/Buffer.h>
+#include <jem/mp/Context.h>
+
+
+JEM_BEGIN_PACKAGE( mp )
+
+
+namespace shm
+{
+  class Engine;
+}
+
+
+//-----------------------------------------------------------------------
+//   class ShmContext
+//-----------------------------------------------------------------------
+
+
+class ShmContext : public Context
+{
+ public:
+
+  typedef ShmContext          Self;
+  typedef Context             Super;
+
+
+  explicit                    ShmContext
+
+    ( const Ref<shm::Engine>&   engine,
+      int                       context = 0 );
+
+  virtual String              getErrorString
+
+    ( int                       err )           const override;
+
+  virtual int                 size           () const override;
+  virtual int                 myRank         () const override;
+
+  virtual void                abort
+
+    ( int                       err )                 override;
+
+  virtual Ref<Context>        clone          ()       override;
+
+  virtual Ref<RequestList>    newRequestList ()       override;
+
+  virtual void                send
+
+    ( const SendBuffer&         buf,
+      int                       dest,
+      int                       tag )                 override;
+
+  virtual void                recv
+
+    ( const RecvBuffer&         buf,
+      int                       src,
+      int                       tag,
+      Status*                   stat )                override;
+
+  virtual Ref<Request>        initSend
+
+    ( const SendBuffer&         buf,
+      int                       dest,
+      int                       tag )                 override;
+
+  virtual Ref<Request>        initRecv
+
+    ( const RecvBuffer&         buf,
+      int                       src,
+      int                       tag )                 override;
+
+  virtual void                barrier        ()       override;
+
+  virtual void                broadcast
+
+    ( const SendBuffer&         buf )                 override;
+
+  virtual void                broadcast
+
+    ( const RecvBuffer&         buf,
+      int                       root )                override;
+
+  virtual void                reduce
+
+    ( const RecvBuffer&         in,
+      const SendBuffer&         out,
+      int                       root,
+      Opcode                    opcode )              override;
+
+  virtual void                allreduce
+
+    ( const RecvBuffer&         in,
+      const SendBuffer&         out,
+      Opcode                    opcode )              override;
+
+
+ protected:
+
+  virtual                    ~ShmContext     ();
+
+
+ private:
+
+  class                       Utils_;
+  friend class                Utils_;
+
+  int                         broadcast_
+
+    ( const Buffer&             buf,
+      int                       root,
+      int                       err );
+
+  int                         reduce_
+
+    ( const RecvBuffer&         in,
+      const SendBuffer&         out,
+      int                       root,
+      Opcode                    opcode );
+
+  int                         exchange_
+
+    ( const Buffer&             sbuf,
+      int                       dest,
+      const Buffer&             rbuf,
+      int                       src,
+      int                       tag,
+      Status*                   stat = 0 );
+
+  static void                 initOnce_      ();
+
+
+ private:
+
+  Ref<shm::Engine>            engine_;
+  int                         context_;
+
+};
+
+
+JEM_END_PACKAGE( mp )
+
+#endif
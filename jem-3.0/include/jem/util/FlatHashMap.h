@@ -0,0 +1,200 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#ifndef JEM_UTIL_FLATHASHMAP_H
+#define JEM_UTIL_FLATHASHMAP_H
+
+#include <jem/base/utilities.h>
+
+
+JEM_BEGIN_PACKAGE( util )
+
+
+//-----------------------------------------------------------------------
+//   class FlatHashMap
+//-----------------------------------------------------------------------
+
+// An open-addressing hash map that stores its entries in one flat
+// array, using robin-hood linear probing. The key type must be an
+// integer type -- or convertible to one -- and both the key and the
+// value type must be trivially copyable. Lookups touch one or two
+// consecutive cache lines, instead of chasing a chain of separately
+// allocated nodes like the HashMap class.
+
+template <class K, class V>
+
+  class FlatHashMap
+
+{
+ public:
+
+  typedef K               KeyType;
+  typedef V               ValueType;
+
+
+                          FlatHashMap         ()       noexcept;
+
+  explicit                FlatHashMap
+
+    ( idx_t                 n );
+
+                          FlatHashMap
+
+    ( const FlatHashMap&    rhs );
+
+                          FlatHashMap
+
+    ( FlatHashMap&&         rhs )                      noexcept;
+
+                         ~FlatHashMap         ();
+
+  FlatHashMap&            operator =
+
+    ( const FlatHashMap&    rhs );
+
+  inline FlatHashMap&     operator =
+
+    ( FlatHashMap&&         rhs )                      noexcept;
+
+  void                    swap
+
+    ( FlatHashMap&          rhs )                      noexcept;
+
+  V&                      operator            []
+
+    ( K                     key );
+
+  inline bool             contains
+
+    ( K                     key )                const;
+
+  inline V*               find
+
+    ( K                     key );
+
+  inline const V*         find
+
+    ( K                     key )                const;
+
+  inline void             prefetch
+
+    ( K                     key )                const noexcept;
+
+  bool                    insert
+
+    ( K                     key,
+      const V&              value );
+
+  bool                    erase
+
+    ( K                     key );
+
+  void                    clear               ();
+
+  void                    reserve
+
+    ( idx_t                 n );
+
+  void                    trimToSize          ();
+  inline idx_t            capacity            () const noexcept;
+  inline idx_t            size                () const noexcept;
+
+
+ private:
+
+  struct                  Slot_
+  {
+    K                       key;
+    V                       value;
+  };
+
+  static const int        MIN_BITS_;
+  static const int        MAX_DIST_;
+
+  inline idx_t            home_
+
+    ( K                     key )                const noexcept;
+
+  inline idx_t            locate_
+
+    ( K                     key )                const noexcept;
+
+  V*                      insert_
+
+    ( K                     key,
+      const V&              value,
+      bool&                 isNew );
+
+  void                    rehash_
+
+    ( int                   nbits );
+
+  void                    alloc_
+
+    ( int                   nbits );
+
+  void                    free_               ();
+
+
+ private:
+
+  Slot_*                  slots_;
+  byte*                   dists_;
+  idx_t                   size_;
+  idx_t                   mask_;
+  idx_t                   limit_;
+  int                     bits_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   related functions
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  inline void             swap
+
+  ( FlatHashMap<K,V>&       lhs,
+    FlatHashMap<K,V>&       rhs ) noexcept;
+
+
+
+
+//#######################################################################
+//   Implementation
+//#######################################################################
+
+JEM_END_PACKAGE( util )
+
+#include <jem/util/FlatHashMap.tcc>
+
+#endif
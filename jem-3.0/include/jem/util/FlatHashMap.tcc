@@ -0,0 +1,711 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#ifndef JEM_UTIL_FLATHASHMAP_TCC
+#define JEM_UTIL_FLATHASHMAP_TCC
+
+#include <cstring>
+#include <type_traits>
+#include <jem/base/assert.h>
+#include <jem/base/MemCache.h>
+
+
+JEM_BEGIN_PACKAGE( util )
+
+
+//=======================================================================
+//   class FlatHashMap
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  const int FlatHashMap<K,V>::MIN_BITS_ = 3;
+
+template <class K, class V>
+
+  const int FlatHashMap<K,V>::MAX_DIST_ = 128;
+
+
+//-----------------------------------------------------------------------
+//   constructors & destructor
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  FlatHashMap<K,V>::FlatHashMap () noexcept
+{
+  static_assert ( std::is_trivially_copyable<K>::value,
+                  "the key type must be trivially copyable" );
+  static_assert ( std::is_trivially_copyable<V>::value,
+                  "the value type must be trivially copyable" );
+
+  slots_ = nullptr;
+  dists_ = nullptr;
+  size_  = 0;
+  mask_  = 0;
+  limit_ = 0;
+  bits_  = 0;
+}
+
+
+template <class K, class V>
+
+  FlatHashMap<K,V>::FlatHashMap ( idx_t n ) :
+
+    FlatHashMap ()
+
+{
+  reserve ( n );
+}
+
+
+template <class K, class V>
+
+  FlatHashMap<K,V>::FlatHashMap ( const FlatHashMap& rhs ) :
+
+    FlatHashMap ()
+
+{
+  if ( rhs.size_ > 0 )
+  {
+    const idx_t  cap = rhs.mask_ + 1;
+
+    alloc_ ( rhs.bits_ );
+
+    std::memcpy ( slots_, rhs.slots_,
+                  (size_t) cap * sizeof(*slots_) );
+    std::memcpy ( dists_, rhs.dists_, (size_t) cap );
+
+    size_ = rhs.size_;
+  }
+}
+
+
+template <class K, class V>
+
+  FlatHashMap<K,V>::FlatHashMap ( FlatHashMap&& rhs ) noexcept :
+
+    FlatHashMap ()
+
+{
+  swap ( rhs );
+}
+
+
+template <class K, class V>
+
+  FlatHashMap<K,V>::~FlatHashMap ()
+{
+  free_ ();
+}
+
+
+//-----------------------------------------------------------------------
+//   assignment operators
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  FlatHashMap<K,V>& FlatHashMap<K,V>::operator =
+
+  ( const FlatHashMap& rhs )
+
+{
+  if ( this != &rhs )
+  {
+    FlatHashMap  tmp ( rhs );
+
+    swap ( tmp );
+  }
+
+  return *this;
+}
+
+
+template <class K, class V>
+
+  inline FlatHashMap<K,V>& FlatHashMap<K,V>::operator =
+
+  ( FlatHashMap&& rhs ) noexcept
+
+{
+  swap ( rhs );
+
+  return *this;
+}
+
+
+//-----------------------------------------------------------------------
+//   swap
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  void FlatHashMap<K,V>::swap ( FlatHashMap& rhs ) noexcept
+
+{
+  jem::swap ( slots_, rhs.slots_ );
+  jem::swap ( dists_, rhs.dists_ );
+  jem::swap ( size_,  rhs.size_  );
+  jem::swap ( mask_,  rhs.mask_  );
+  jem::swap ( limit_, rhs.limit_ );
+  jem::swap ( bits_,  rhs.bits_  );
+}
+
+
+//-----------------------------------------------------------------------
+//   operator []
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  V& FlatHashMap<K,V>::operator [] ( K key )
+
+{
+  bool  isNew;
+
+  return *insert_ ( key, V(), isNew );
+}
+
+
+//-----------------------------------------------------------------------
+//   contains
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  inline bool FlatHashMap<K,V>::contains ( K key ) const
+
+{
+  return (locate_( key ) >= 0);
+}
+
+
+//-----------------------------------------------------------------------
+//   find
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  inline V* FlatHashMap<K,V>::find ( K key )
+
+{
+  idx_t  i = locate_ ( key );
+
+  return (i >= 0) ? &slots_[i].value : nullptr;
+}
+
+
+template <class K, class V>
+
+  inline const V* FlatHashMap<K,V>::find ( K key ) const
+
+{
+  idx_t  i = locate_ ( key );
+
+  return (i >= 0) ? &slots_[i].value : nullptr;
+}
+
+
+//-----------------------------------------------------------------------
+//   prefetch
+//-----------------------------------------------------------------------
+
+// Issues a prefetch for the slot in which a search for the given key
+// starts. Callers that look up many keys can prefetch a batch of keys
+// first so that the cache misses overlap.
+
+template <class K, class V>
+
+  inline void FlatHashMap<K,V>::prefetch ( K key ) const noexcept
+
+{
+#if defined(__GNUC__)
+
+  if ( size_ > 0 )
+  {
+    idx_t  i = home_ ( key );
+
+    __builtin_prefetch ( dists_ + i );
+    __builtin_prefetch ( slots_ + i );
+  }
+
+#endif
+}
+
+
+//-----------------------------------------------------------------------
+//   insert
+//-----------------------------------------------------------------------
+
+// Returns true if the key is new and false if the value associated
+// with an existing key has been replaced.
+
+template <class K, class V>
+
+  bool FlatHashMap<K,V>::insert
+
+  ( K         key,
+    const V&  value )
+
+{
+  bool  isNew;
+  V*    slot = insert_ ( key, value, isNew );
+
+  if ( ! isNew )
+  {
+    *slot = value;
+  }
+
+  return isNew;
+}
+
+
+//-----------------------------------------------------------------------
+//   erase
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  bool FlatHashMap<K,V>::erase ( K key )
+
+{
+  idx_t  i = locate_ ( key );
+
+  if ( i < 0 )
+  {
+    return false;
+  }
+
+  // Shift the following entries one slot back until an empty slot
+  // or an entry in its home slot is found.
+
+  idx_t  j = (i + 1) & mask_;
+
+  while ( dists_[j] > 1 )
+  {
+    slots_[i] = slots_[j];
+    dists_[i] = (byte) (dists_[j] - 1);
+    i         = j;
+    j         = (j + 1) & mask_;
+  }
+
+  dists_[i] = 0;
+  size_--;
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------
+//   clear
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  void FlatHashMap<K,V>::clear ()
+
+{
+  if ( size_ > 0 )
+  {
+    std::memset ( dists_, 0, (size_t) (mask_ + 1) );
+
+    size_ = 0;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   reserve
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  void FlatHashMap<K,V>::reserve ( idx_t n )
+
+{
+  int  nbits = MIN_BITS_;
+
+  while ( (1_idx << nbits) - (1_idx << (nbits - 3)) < n )
+  {
+    nbits++;
+  }
+
+  if ( nbits > bits_ )
+  {
+    rehash_ ( nbits );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   trimToSize
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  void FlatHashMap<K,V>::trimToSize ()
+
+{
+  if ( size_ == 0 )
+  {
+    free_ ();
+  }
+  else
+  {
+    int  nbits = MIN_BITS_;
+
+    while ( (1_idx << nbits) - (1_idx << (nbits - 3)) < size_ )
+    {
+      nbits++;
+    }
+
+    if ( nbits < bits_ )
+    {
+      rehash_ ( nbits );
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   capacity
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  inline idx_t FlatHashMap<K,V>::capacity () const noexcept
+
+{
+  return limit_;
+}
+
+
+//-----------------------------------------------------------------------
+//   size
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  inline idx_t FlatHashMap<K,V>::size () const noexcept
+
+{
+  return size_;
+}
+
+
+//-----------------------------------------------------------------------
+//   home_
+//-----------------------------------------------------------------------
+
+// Integer keys are hashed with a multiplicative (Fibonacci) hash; the
+// upper bits of the product select the home slot. This spreads
+// consecutive keys evenly over the table.
+
+template <class K, class V>
+
+  inline idx_t FlatHashMap<K,V>::home_ ( K key ) const noexcept
+
+{
+  const ulint  h = (ulint) key * JEM_ULINT_C( 0x9E3779B97F4A7C15 );
+
+  return (idx_t) (h >> (64 - bits_));
+}
+
+
+//-----------------------------------------------------------------------
+//   locate_
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  inline idx_t FlatHashMap<K,V>::locate_ ( K key ) const noexcept
+
+{
+  if ( size_ == 0 )
+  {
+    return -1;
+  }
+
+  idx_t  i = home_ ( key );
+  int    d = 1;
+
+  // The search stops as soon as an entry is found that is closer to
+  // its home slot than the key would be; robin-hood insertion
+  // guarantees that the key can not be stored beyond that entry.
+
+  while ( true )
+  {
+    int  k = dists_[i];
+
+    if ( k < d )
+    {
+      return -1;
+    }
+
+    if ( k == d && slots_[i].key == key )
+    {
+      return i;
+    }
+
+    i = (i + 1) & mask_;
+    d++;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   insert_
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  V* FlatHashMap<K,V>::insert_
+
+  ( K         key,
+    const V&  value,
+    bool&     isNew )
+
+{
+  if ( size_ >= limit_ )
+  {
+    rehash_ ( bits_ > 0 ? bits_ + 1 : MIN_BITS_ );
+  }
+
+  Slot_  entry = { key, value };
+  V*     slot  = nullptr;
+  idx_t  i     = home_ ( key );
+  int    d     = 1;
+
+  while ( true )
+  {
+    int  k = dists_[i];
+
+    if ( k == 0 )
+    {
+      slots_[i] = entry;
+      dists_[i] = (byte) d;
+      isNew     = true;
+
+      size_++;
+
+      return slot ? slot : &slots_[i].value;
+    }
+
+    if ( ! slot && k == d && slots_[i].key == key )
+    {
+      isNew = false;
+
+      return &slots_[i].value;
+    }
+
+    if ( k < d )
+    {
+      // Take the slot from the entry that is closer to its home
+      // slot and carry that entry further.
+
+      jem::swap ( entry, slots_[i] );
+
+      dists_[i] = (byte) d;
+      d         = k;
+
+      if ( ! slot )
+      {
+        slot = &slots_[i].value;
+      }
+    }
+
+    i = (i + 1) & mask_;
+    d++;
+
+    if ( d > MAX_DIST_ )
+    {
+      // Too many collisions; grow the table and insert the entry
+      // that is currently being carried.
+
+      bool  dummy;
+
+      rehash_ ( bits_ + 1 );
+      insert_ ( entry.key, entry.value, dummy );
+
+      isNew = true;
+
+      return &slots_[locate_( key )].value;
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   rehash_
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  void FlatHashMap<K,V>::rehash_ ( int nbits )
+
+{
+  Slot_*       slots = slots_;
+  byte*        dists = dists_;
+  const idx_t  cap   = (slots ? mask_ + 1 : 0);
+  bool         dummy;
+
+
+  alloc_ ( nbits );
+
+  size_ = 0;
+
+  for ( idx_t i = 0; i < cap; i++ )
+  {
+    if ( dists[i] )
+    {
+      insert_ ( slots[i].key, slots[i].value, dummy );
+    }
+  }
+
+  if ( slots )
+  {
+    MemCache::dealloc ( slots, (size_t) cap * sizeof(*slots) );
+    MemCache::dealloc ( dists, (size_t) cap );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   alloc_
+//-----------------------------------------------------------------------
+
+// Allocates a new, empty table. The current arrays are not released;
+// they are left unchanged if the allocation fails.
+
+template <class K, class V>
+
+  void FlatHashMap<K,V>::alloc_ ( int nbits )
+
+{
+  const idx_t  cap   = 1_idx << nbits;
+
+  byte*        dists =
+
+    (byte*) MemCache::alloc ( (size_t) cap, "jem::util::FlatHashMap" );
+
+  Slot_*       slots;
+
+  try
+  {
+    slots = (Slot_*) MemCache::alloc ( (size_t) cap * sizeof(*slots),
+                                       "jem::util::FlatHashMap" );
+  }
+  catch ( ... )
+  {
+    MemCache::dealloc ( dists, (size_t) cap );
+    throw;
+  }
+
+  std::memset ( dists, 0, (size_t) cap );
+
+  slots_ = slots;
+  dists_ = dists;
+  mask_  = cap - 1;
+  limit_ = cap - (cap >> 3);
+  bits_  = nbits;
+}
+
+
+//-----------------------------------------------------------------------
+//   free_
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  void FlatHashMap<K,V>::free_ ()
+
+{
+  if ( slots_ )
+  {
+    const idx_t  cap = mask_ + 1;
+
+    MemCache::dealloc ( slots_, (size_t) cap * sizeof(*slots_) );
+    MemCache::dealloc ( dists_, (size_t) cap );
+  }
+
+  slots_ = nullptr;
+  dists_ = nullptr;
+  size_  = 0;
+  mask_  = 0;
+  limit_ = 0;
+  bits_  = 0;
+}
+
+
+//=======================================================================
+//   related functions
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   swap
+//-----------------------------------------------------------------------
+
+
+template <class K, class V>
+
+  inline void             swap
+
+  ( FlatHashMap<K,V>&       lhs,
+    FlatHashMap<K,V>&       rhs ) noexcept
+
+{
+  lhs.swap ( rhs );
+}
+
+
+JEM_END_PACKAGE( util )
+
+#endif
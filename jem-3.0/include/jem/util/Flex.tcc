@@ -78,7 +78,8 @@ template <class T>
 {
   JEM_ASSERT2 ( n >= 0, "invalid Flex size" );
 
-  data_     = (T*) MemCache::alloc ( (size_t) n * sizeof(T) );
+  data_     = (T*) MemCache::alloc ( (size_t) n * sizeof(T),
+                                     "jem::util::Flex" );
   size_     = n;
   capacity_ = size_;
   expand_   = EXPANSION_FACTOR;
@@ -803,7 +804,8 @@ template <class T>
 
 {
   size_ = capacity_ = distance ( first, last );
-  data_ = (T*) MemCache::alloc ( (size_t) size_ * sizeof(*data_) );
+  data_ = (T*) MemCache::alloc ( (size_t) size_ * sizeof(*data_),
+                                 "jem::util::Flex" );
 
   try
   {
@@ -952,7 +954,8 @@ template <class T>
 
     ( data_,
       (size_t) capacity_ * sizeof(*data_),
-      (size_t) cap       * sizeof(*data_) );
+      (size_t) cap       * sizeof(*data_),
+      "jem::util::Flex" );
 
   capacity_ = cap;
 }
@@ -973,7 +976,8 @@ template <class T>
 {
   T*  buffer = (T*)
 
-    MemCache::alloc ( (size_t) cap * sizeof(*buffer) );
+    MemCache::alloc ( (size_t) cap * sizeof(*buffer),
+                      "jem::util::Flex" );
 
   try
   {
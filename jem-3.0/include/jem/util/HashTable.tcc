@@ -679,7 +679,8 @@ template <class T>
   capacity_  = cap;
   n          = hashSize ( tableBits_ );
   table_     = (void**) MemCache::alloc ( (size_t) (n + 1) *
-                                          sizeof(*table_) );
+                                          sizeof(*table_),
+                                          "jem::util::HashTable" );
 
   for ( i = 0; i < n; i++ )
   {
@@ -747,7 +748,8 @@ template <class T>
   newTable =
 
     (void**) MemCache::alloc ( (size_t) (newSize + 1) *
-                               sizeof(*table_) );
+                               sizeof(*table_),
+                               "jem::util::HashTable" );
 
   newTable[newSize] = newTable;
 
@@ -1742,7 +1742,8 @@ template <class T, int N, class A>
   n      = 1_ulint << tableBits_;
   table_ = (void**)
 
-    MemCache::alloc ( sizeof(*table_) * (size_t) (n + 1) );
+    MemCache::alloc ( sizeof(*table_) * (size_t) (n + 1),
+                      "jem::util::SparseArray" );
 
   for ( ulint i = 0; i < n; i++ )
   {
@@ -1946,7 +1947,8 @@ template <class T, int N, class A>
   newMask  = newSize - 1_ulint;
   newTable = (void**)
 
-    MemCache::alloc ( sizeof(void*) * (size_t) (newSize + 1) );
+    MemCache::alloc ( sizeof(void*) * (size_t) (newSize + 1),
+                      "jem::util::SparseArray" );
 
   for ( i = 0; i < newSize; i++ )
   {
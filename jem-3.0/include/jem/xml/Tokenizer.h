@@ -149,6 +149,10 @@ class Tokenizer : public Object
 
     ( TextOutput&           out );
 
+  idx_t                   readRawText
+
+    ( StringBuffer&         buf );
+
 
  protected:
 
@@ -44,6 +44,7 @@ const char*  EnvParams::CACHE_SIZE      = "JEM_CACHE_SIZE";
 const char*  EnvParams::CONCURRENCY     = "JEM_CONCURRENCY";
 const char*  EnvParams::ABORT_ON_EXCEPT = "JEM_ABORT_ON_EXCEPTION";
 const char*  EnvParams::LOG_BUFFER_SIZE = "JEM_LOG_BUFFER_SIZE";
+const char*  EnvParams::MEM_PROFILE     = "JEM_MEM_PROFILE";
 
 
 //=======================================================================
@@ -37,6 +37,7 @@
 #include <jem/base/Float.h>
 #include <jem/base/ParseException.h>
 #include <jem/base/TypeTraits.h>
+#include <jem/io/FloatConv.h>
 #include <jem/io/ObjectInput.h>
 #include <jem/io/ObjectOutput.h>
 
@@ -266,6 +267,15 @@ bool Float::parse
     buf[j++] = s[i++];
   }
 
+  if ( io::FloatConv::parse( tmp, buf, j ) )
+  {
+    value = tmp;
+    return true;
+  }
+
+  // Let strtod handle the special cases, such as hexadecimal numbers
+  // and infinity.
+
   buf[j] = '\0';
 
   tmp = strtod ( buf, & end );
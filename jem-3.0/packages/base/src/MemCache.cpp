@@ -53,6 +53,23 @@ void* MemCache::alloc ( size_t size )
 }
 
 
+// The tag is only used for profiling; it names the kind of object
+// that the memory is allocated for. A tag set with setTag() takes
+// precedence.
+
+
+void* MemCache::alloc
+
+  ( size_t       size,
+    const char*  tag )
+
+{
+  ThreadLib::init ();
+
+  return ThreadLib::getCache()->alloc ( size, CAN_THROW, tag );
+}
+
+
 //-----------------------------------------------------------------------
 //   allocNoThrow
 //-----------------------------------------------------------------------
@@ -102,6 +119,22 @@ void* MemCache::realloc
 }
 
 
+void* MemCache::realloc
+
+  ( void*        addr,
+    size_t       oldSize,
+    size_t       newSize,
+    const char*  tag )
+
+{
+  JEM_ASSERT_NOTHROW ( ThreadLib::initialized() );
+
+  return ThreadLib::getCache ()
+
+    -> realloc ( addr, oldSize, newSize, CAN_THROW, tag );
+}
+
+
 //-----------------------------------------------------------------------
 //   reallocNoThrow
 //-----------------------------------------------------------------------
@@ -134,4 +167,50 @@ void MemCache::setSize ( size_t size )
 }
 
 
+//-----------------------------------------------------------------------
+//   setProfiling
+//-----------------------------------------------------------------------
+
+
+void MemCache::setProfiling ( bool flag )
+{
+  ThreadLib::init ();
+
+  // This only affects the current thread and the threads that are
+  // created afterwards.
+
+  ThreadCache::setDefaultProfiling  ( flag );
+  ThreadLib::getCache()->setProfiling ( flag );
+}
+
+
+//-----------------------------------------------------------------------
+//   isProfiling
+//-----------------------------------------------------------------------
+
+
+bool MemCache::isProfiling ()
+{
+  ThreadLib::init ();
+
+  return ThreadLib::getCache()->isProfiling ();
+}
+
+
+//-----------------------------------------------------------------------
+//   setTag
+//-----------------------------------------------------------------------
+
+
+const char* MemCache::setTag ( const char* tag ) noexcept
+{
+  if ( ! ThreadLib::initialized() )
+  {
+    return nullptr;
+  }
+
+  return ThreadLib::getCache()->setTag ( tag );
+}
+
+
 JEM_END_PACKAGE_BASE
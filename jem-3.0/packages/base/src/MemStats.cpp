@@ -0,0 +1,308 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <cstring>
+#include <jem/base/MemStats.h>
+#include <jem/base/thread/ThreadCache.h>
+#include <jem/io/TextOutput.h>
+
+
+JEM_BEGIN_PACKAGE_BASE
+
+
+//=======================================================================
+//   class MemStats
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+const char*  MemStats::OTHER_TAG = "(other)";
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+MemStats::MemStats ()
+{
+  clear ();
+}
+
+
+//-----------------------------------------------------------------------
+//   clear
+//-----------------------------------------------------------------------
+
+
+void MemStats::clear ()
+{
+  threadID   = -1;
+  allocCount = 0;
+  freeCount  = 0;
+  allocBytes = 0;
+  freeBytes  = 0;
+  peakBytes  = 0;
+  largeCount = 0;
+  largeBytes = 0;
+  tagCount   = 0;
+
+  for ( int i = 0; i < CLASS_COUNT; i++ )
+  {
+    classes[i].allocCount  = 0;
+    classes[i].hitCount    = 0;
+    classes[i].cachedCount = 0;
+  }
+
+  for ( int i = 0; i < MAX_TAGS; i++ )
+  {
+    tags[i].name       = nullptr;
+    tags[i].allocCount = 0;
+    tags[i].byteCount  = 0;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   merge
+//-----------------------------------------------------------------------
+
+// One tag slot is reserved for the tag "(other)" that collects the
+// allocations of all tags that do not fit in the table, so that no
+// counters are attributed to the wrong tag.
+
+void MemStats::merge ( const MemStats& rhs )
+{
+  allocCount += rhs.allocCount;
+  freeCount  += rhs.freeCount;
+  allocBytes += rhs.allocBytes;
+  freeBytes  += rhs.freeBytes;
+  peakBytes  += rhs.peakBytes;
+  largeCount += rhs.largeCount;
+  largeBytes += rhs.largeBytes;
+
+  for ( int i = 0; i < CLASS_COUNT; i++ )
+  {
+    classes[i].allocCount  += rhs.classes[i].allocCount;
+    classes[i].hitCount    += rhs.classes[i].hitCount;
+    classes[i].cachedCount += rhs.classes[i].cachedCount;
+  }
+
+  for ( int j = 0; j < rhs.tagCount; j++ )
+  {
+    const Tag&  t = rhs.tags[j];
+    int         i = 0;
+
+    for ( ; i < tagCount; i++ )
+    {
+      if ( std::strcmp( tags[i].name, t.name ) == 0 )
+      {
+        break;
+      }
+    }
+
+    if ( i == tagCount )
+    {
+      if ( tagCount < MAX_TAGS - 1 &&
+           std::strcmp( t.name, OTHER_TAG ) != 0 )
+      {
+        tags[tagCount++].name = t.name;
+      }
+      else
+      {
+        for ( i = 0; i < tagCount; i++ )
+        {
+          if ( std::strcmp( tags[i].name, OTHER_TAG ) == 0 )
+          {
+            break;
+          }
+        }
+
+        if ( i == tagCount )
+        {
+          tags[tagCount++].name = OTHER_TAG;
+        }
+      }
+    }
+
+    tags[i].allocCount += t.allocCount;
+    tags[i].byteCount  += t.byteCount;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   bytesInUse
+//-----------------------------------------------------------------------
+
+// Memory may be released by another thread than the one that has
+// allocated it, so the figure for a single thread can be negative.
+// In that case zero is returned. The figure for all threads is exact.
+
+
+lint MemStats::bytesInUse () const
+{
+  return max ( allocBytes - freeBytes, (lint) 0 );
+}
+
+
+//-----------------------------------------------------------------------
+//   hitRate
+//-----------------------------------------------------------------------
+
+
+double MemStats::hitRate () const
+{
+  lint  allocs = 0;
+  lint  hits   = 0;
+
+  for ( int i = 0; i < CLASS_COUNT; i++ )
+  {
+    allocs += classes[i].allocCount;
+    hits   += classes[i].hitCount;
+  }
+
+  if ( allocs == 0 )
+  {
+    return 0.0;
+  }
+  else
+  {
+    return ((double) hits / (double) allocs);
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   printTo
+//-----------------------------------------------------------------------
+
+
+void MemStats::printTo ( io::TextOutput& out ) const
+{
+  using io::endl;
+
+  const lint  align = (lint) AllocatorUtils::ALIGNMENT;
+
+
+  if ( threadID < 0 )
+  {
+    print ( out, "Memory statistics (all threads):", endl );
+  }
+  else
+  {
+    print ( out, "Memory statistics (thread ", threadID, "):", endl );
+  }
+
+  print ( out, "  allocations       : ", allocCount, endl );
+  print ( out, "  deallocations     : ", freeCount,  endl );
+  print ( out, "  allocated bytes   : ", allocBytes, endl );
+  print ( out, "  bytes in use      : ", bytesInUse(), endl );
+  print ( out, "  peak bytes in use : ", peakBytes,  endl );
+  print ( out, "  large allocations : ", largeCount,
+               " (", largeBytes, " bytes)", endl );
+  print ( out, "  free list hits    : ",
+               100.0 * hitRate(), " %", endl );
+
+  for ( int i = 0; i < CLASS_COUNT; i++ )
+  {
+    const SizeClass&  c = classes[i];
+
+    if ( c.allocCount == 0 )
+    {
+      continue;
+    }
+
+    print ( out, "    size <= ", (i + 1) * align, " : ",
+                 c.allocCount, " allocs, ",
+                 c.hitCount,   " hits, ",
+                 c.cachedCount, " cached frees", endl );
+  }
+
+  if ( tagCount > 0 )
+  {
+    print ( out, "  large allocations by tag:", endl );
+  }
+
+  for ( int i = 0; i < tagCount; i++ )
+  {
+    print ( out, "    ", tags[i].name, " : ", tags[i].allocCount,
+                 " allocs, ", tags[i].byteCount, " bytes", endl );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   getTotal
+//-----------------------------------------------------------------------
+
+
+MemStats MemStats::getTotal ()
+{
+  MemStats  total;
+
+  ThreadCache::getStats ( total, nullptr, 0 );
+
+  return total;
+}
+
+
+//-----------------------------------------------------------------------
+//   getThreads
+//-----------------------------------------------------------------------
+
+
+Array<MemStats> MemStats::getThreads ()
+{
+  Array<MemStats>  list;
+  MemStats         total;
+  idx_t            n;
+
+
+  // Threads may start or terminate while collecting the statistics,
+  // so repeat until the array is large enough.
+
+  n = ThreadCache::getStats ( total, nullptr, 0 );
+
+  do
+  {
+    list.resize ( n + 4 );
+
+    n = ThreadCache::getStats ( total, list.addr(), list.size() );
+  }
+  while ( n > list.size() );
+
+  return list[slice(BEGIN,n)];
+}
+
+
+JEM_END_PACKAGE_BASE
@@ -0,0 +1,489 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <jem/base/assert.h>
+#include <jem/base/Once.h>
+#include <jem/base/Array.h>
+#include <jem/base/Thread.h>
+#include <jem/base/Monitor.h>
+#include <jem/base/Collectable.h>
+#include <jem/base/RuntimeException.h>
+#include <jem/base/String.h>
+#include <jem/base/ThreadTeam.h>
+
+
+JEM_BEGIN_PACKAGE_BASE
+
+
+//=======================================================================
+//   class ThreadTeam::Shared_
+//=======================================================================
+
+
+class ThreadTeam::Shared_ : public Collectable
+{
+ public:
+
+  inline void               runChunk
+
+    ( Work&                   work,
+      idx_t                   count,
+      int                     ichunk,
+      int                     nchunks );
+
+  bool                      finish
+
+    ( String&                 where,
+      String&                 what );
+
+
+ public:
+
+  Monitor                   monitor;
+  Array< Ref<Thread> >      workers;
+
+  Work*                     work;
+  idx_t                     count;
+  int                       active;
+  int                       pending;
+  lint                      epoch;
+  bool                      busy;
+  bool                      failed;
+  bool                      quit;
+
+  String                    errWhere;
+  String                    errWhat;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   runChunk
+//-----------------------------------------------------------------------
+
+
+inline void ThreadTeam::Shared_::runChunk
+
+  ( Work&  work,
+    idx_t  count,
+    int    ichunk,
+    int    nchunks )
+
+{
+  idx_t  first = (idx_t) ((lint) count *  ichunk      / nchunks);
+  idx_t  last  = (idx_t) ((lint) count * (ichunk + 1) / nchunks);
+
+  if ( first < last )
+  {
+    work.run ( first, last );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   finish
+//-----------------------------------------------------------------------
+
+// Waits until the other threads have executed their chunks. This
+// must be done even if the first chunk failed, because the work
+// object lives on the stack of the caller. Returns false if one of
+// the other threads failed, and stores the context and message of
+// its exception in where and what.
+
+bool ThreadTeam::Shared_::finish
+
+  ( String&  where,
+    String&  what )
+
+{
+  bool  ok;
+
+  monitor.lock ();
+
+  while ( pending > 0 )
+  {
+    monitor.waitNoCancel ();
+  }
+
+  ok   = ! failed;
+  busy = false;
+  work = nullptr;
+
+  if ( failed )
+  {
+    where = errWhere;
+    what  = errWhat;
+  }
+
+  monitor.unlock ();
+
+  return ok;
+}
+
+
+//=======================================================================
+//   class ThreadTeam::Worker_
+//=======================================================================
+
+
+class ThreadTeam::Worker_ : public Thread
+{
+ public:
+
+                            Worker_
+
+    ( Shared_*                shared,
+      int                     rank );
+
+  virtual void              run     () override;
+
+
+ protected:
+
+  virtual                  ~Worker_ ();
+
+
+ private:
+
+  Shared_*                  shared_;
+  int                       rank_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+ThreadTeam::Worker_::Worker_
+
+  ( Shared_*  shared,
+    int       rank ) :
+
+    shared_ ( shared ),
+    rank_   ( rank )
+
+{}
+
+
+ThreadTeam::Worker_::~Worker_ ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+void ThreadTeam::Worker_::run ()
+{
+  Shared_&  s     = *shared_;
+  lint      epoch = 0;
+
+  allowCancel ( false );
+
+  s.monitor.lock ();
+
+  while ( true )
+  {
+    while ( s.epoch == epoch && ! s.quit )
+    {
+      s.monitor.waitNoCancel ();
+    }
+
+    if ( s.quit )
+    {
+      break;
+    }
+
+    epoch = s.epoch;
+
+    if ( rank_ >= s.active )
+    {
+      continue;
+    }
+
+    Work*   work  = s.work;
+    idx_t   count = s.count;
+    int     n     = s.active;
+    bool    ok    = true;
+
+    String  where;
+    String  what;
+
+    s.monitor.unlock ();
+
+    try
+    {
+      s.runChunk ( *work, count, rank_, n );
+    }
+    catch ( const Throwable& ex )
+    {
+      ok    = false;
+      where = ex.where ();
+      what  = ex.what  ();
+    }
+    catch ( ... )
+    {
+      ok    = false;
+      where = JEM_FUNC;
+      what  = "unknown exception";
+    }
+
+    s.monitor.lock ();
+
+    // Only the first exception is reported.
+
+    if ( ! ok && ! s.failed )
+    {
+      s.failed   = true;
+      s.errWhere = where;
+      s.errWhat  = what;
+    }
+
+    if ( --s.pending == 0 )
+    {
+      s.monitor.notifyAll ();
+    }
+  }
+
+  s.monitor.unlock ();
+}
+
+
+//=======================================================================
+//   class ThreadTeam::Work
+//=======================================================================
+
+
+ThreadTeam::Work::~Work ()
+{}
+
+
+//=======================================================================
+//   class ThreadTeam
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+int  ThreadTeam::localKey_ = -1;
+
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+ThreadTeam::ThreadTeam ( int size ) :
+
+  size_ ( size )
+
+{
+  JEM_PRECHECK2 ( size > 0, "invalid team size" );
+
+  Shared_*  s;
+
+  shared_   = newInstance<Shared_> ();
+  s         = shared_.get ();
+
+  s->work    = nullptr;
+  s->count   = 0;
+  s->active  = 0;
+  s->pending = 0;
+  s->epoch   = 0;
+  s->busy    = false;
+  s->failed  = false;
+  s->quit    = false;
+
+  s->workers.resize ( size - 1 );
+
+  for ( int i = 1; i < size; i++ )
+  {
+    Ref<Thread>  t = newInstance<Worker_> ( s, i );
+
+    t->start ();
+
+    s->workers[i - 1] = t;
+  }
+}
+
+
+ThreadTeam::~ThreadTeam ()
+{
+  Shared_&     s = *shared_;
+  const idx_t  n = s.workers.size ();
+
+  s.monitor.lock      ();
+  s.quit = true;
+  s.monitor.notifyAll ();
+  s.monitor.unlock    ();
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    s.workers[i]->join ();
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   execute
+//-----------------------------------------------------------------------
+
+
+void ThreadTeam::execute
+
+  ( Work&  work,
+    idx_t  count,
+    idx_t  grain )
+
+{
+  Shared_&  s = *shared_;
+
+  String    where;
+  String    what;
+  idx_t     n;
+
+
+  if ( count <= 0 )
+  {
+    return;
+  }
+
+  if ( grain < 1 )
+  {
+    grain = 1;
+  }
+
+  n = count / grain;
+
+  if ( n > (idx_t) size_ )
+  {
+    n = (idx_t) size_;
+  }
+
+  if ( n <= 1 )
+  {
+    work.run ( 0, count );
+    return;
+  }
+
+  s.monitor.lock ();
+
+  if ( s.busy )
+  {
+    s.monitor.unlock ();
+    work.run         ( 0, count );
+    return;
+  }
+
+  s.busy    = true;
+  s.failed  = false;
+  s.work    = &work;
+  s.count   = count;
+  s.active  = (int) n;
+  s.pending = (int) n - 1;
+  s.epoch++;
+
+  s.monitor.notifyAll ();
+  s.monitor.unlock    ();
+
+  // An exception thrown by the calling thread is passed on unchanged.
+  // An exception thrown by one of the other threads is passed on as
+  // a RuntimeException with the same context and message.
+
+  try
+  {
+    s.runChunk ( work, count, 0, (int) n );
+  }
+  catch ( ... )
+  {
+    s.finish ( where, what );
+    throw;
+  }
+
+  if ( ! s.finish( where, what ) )
+  {
+    throw RuntimeException ( where, what );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   getCurrent
+//-----------------------------------------------------------------------
+
+
+Ref<ThreadTeam> ThreadTeam::getCurrent ()
+{
+  return staticCast<Self> ( Thread::getLocal( getKey_() ) );
+}
+
+
+//-----------------------------------------------------------------------
+//   setCurrent
+//-----------------------------------------------------------------------
+
+
+void ThreadTeam::setCurrent ( const Ref<Self>& team )
+{
+  Thread::setLocal ( getKey_(), team );
+}
+
+
+//-----------------------------------------------------------------------
+//   getKey_
+//-----------------------------------------------------------------------
+
+
+int ThreadTeam::getKey_ ()
+{
+  static Once  once = JEM_ONCE_INITIALIZER;
+
+  runOnce ( once, & initKey_ );
+
+  return localKey_;
+}
+
+
+//-----------------------------------------------------------------------
+//   initKey_
+//-----------------------------------------------------------------------
+
+
+void ThreadTeam::initKey_ ()
+{
+  localKey_ = Thread::newLocalKey ();
+}
+
+
+JEM_END_PACKAGE_BASE
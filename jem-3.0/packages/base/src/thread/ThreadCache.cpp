@@ -27,7 +27,10 @@
  */
 
 
+#include <atomic>
 #include <cstring>
+#include <jem/base/SpinLock.h>
+#include <jem/base/MemStats.h>
 #include <jem/base/MemoryError.h>
 #include <jem/base/OutOfMemoryException.h>
 #include <jem/base/thread/ThreadCache.h>
@@ -36,6 +39,304 @@
 JEM_BEGIN_PACKAGE_BASE
 
 
+//=======================================================================
+//   class ThreadCache::Profile_
+//=======================================================================
+
+// The counters of a profile are only modified by the thread owning
+// the cache, but they may be read at any time by another thread that
+// collects the allocation statistics. This is why they are atomic
+// variables that are accessed with relaxed memory ordering.
+
+
+class ThreadCache::Profile_
+{
+ public:
+
+  typedef std::atomic<lint>   Counter;
+
+  struct                      TagEntry
+  {
+    std::atomic<const char*>    name;
+    Counter                     allocCount;
+    Counter                     byteCount;
+  };
+
+  static const int            OTHER_TAG = MemStats::MAX_TAGS - 1;
+  static const char*          UNTAGGED;
+  static const char*          OTHER;
+
+
+  explicit                    Profile_  ();
+
+  static inline void          add
+
+    ( Counter&                  c,
+      lint                      n )        noexcept;
+
+  TagEntry&                   findTag
+
+    ( const char*               name )     noexcept;
+
+  void                        getStats
+
+    ( MemStats&                 stats )    const;
+
+  void                        link      ();
+  void                        unlink    ();
+
+
+ public:
+
+  static SpinLock             lock;
+  static Profile_*            list;
+  static std::atomic<lint>    totalInUse;
+  static std::atomic<lint>    totalPeak;
+  static std::atomic_int      nextID;
+  static bool                 enabled;
+
+  Profile_*                   prev;
+  Profile_*                   next;
+  int                         id;
+  const char*                 tag;
+  lint                        inUse;
+
+  Counter                     allocCount;
+  Counter                     freeCount;
+  Counter                     allocBytes;
+  Counter                     freeBytes;
+  Counter                     peakBytes;
+  Counter                     largeCount;
+  Counter                     largeBytes;
+  Counter                     classAllocs[FREE_LIST_COUNT];
+  Counter                     classHits  [FREE_LIST_COUNT];
+  Counter                     classCached[FREE_LIST_COUNT];
+  TagEntry                    tags[MemStats::MAX_TAGS];
+
+};
+
+
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+const char*        ThreadCache::Profile_::UNTAGGED   = "(untagged)";
+const char*        ThreadCache::Profile_::OTHER      = "(other)";
+
+SpinLock           ThreadCache::Profile_::lock;
+ThreadCache::
+  Profile_*        ThreadCache::Profile_::list       = nullptr;
+std::atomic<lint>  ThreadCache::Profile_::totalInUse ( 0 );
+std::atomic<lint>  ThreadCache::Profile_::totalPeak  ( 0 );
+std::atomic_int    ThreadCache::Profile_::nextID     ( 0 );
+bool               ThreadCache::Profile_::enabled    = false;
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+ThreadCache::Profile_::Profile_ () :
+
+  allocCount ( 0 ),
+  freeCount  ( 0 ),
+  allocBytes ( 0 ),
+  freeBytes  ( 0 ),
+  peakBytes  ( 0 ),
+  largeCount ( 0 ),
+  largeBytes ( 0 )
+
+{
+  static_assert ( (int) FREE_LIST_COUNT == MemStats::CLASS_COUNT,
+                  "size class count mismatch" );
+
+  prev  = next = nullptr;
+  id    = nextID.fetch_add ( 1, std::memory_order_relaxed );
+  tag   = nullptr;
+  inUse = 0;
+
+  for ( size_t i = 0; i < FREE_LIST_COUNT; i++ )
+  {
+    classAllocs[i].store ( 0, std::memory_order_relaxed );
+    classHits  [i].store ( 0, std::memory_order_relaxed );
+    classCached[i].store ( 0, std::memory_order_relaxed );
+  }
+
+  for ( int i = 0; i < MemStats::MAX_TAGS; i++ )
+  {
+    tags[i].name      .store ( nullptr, std::memory_order_relaxed );
+    tags[i].allocCount.store ( 0,       std::memory_order_relaxed );
+    tags[i].byteCount .store ( 0,       std::memory_order_relaxed );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   add
+//-----------------------------------------------------------------------
+
+
+inline void ThreadCache::Profile_::add
+
+  ( Counter&  c,
+    lint      n ) noexcept
+
+{
+  // Only the owning thread modifies a counter, so there is no need
+  // for an expensive read-modify-write operation.
+
+  c.store ( c.load( std::memory_order_relaxed ) + n,
+            std::memory_order_relaxed );
+}
+
+
+//-----------------------------------------------------------------------
+//   findTag
+//-----------------------------------------------------------------------
+
+// The same tag may be stored at different addresses (in different
+// shared libraries, for instance), so tags are compared by name.
+
+
+ThreadCache::Profile_::TagEntry&
+
+  ThreadCache::Profile_::findTag ( const char* name ) noexcept
+
+{
+  if ( ! name )
+  {
+    name = UNTAGGED;
+  }
+
+  size_t  h = 0;
+  int     i;
+
+  for ( const char* s = name; *s; s++ )
+  {
+    h = 31 * h + (size_t) *s;
+  }
+
+  i = (int) (h % (size_t) OTHER_TAG);
+
+  for ( int j = 0; j < OTHER_TAG; j++ )
+  {
+    const char*  key = tags[i].name.load ( std::memory_order_relaxed );
+
+    if ( key == name || (key && std::strcmp( key, name ) == 0) )
+    {
+      return tags[i];
+    }
+
+    if ( ! key )
+    {
+      tags[i].name.store ( name, std::memory_order_release );
+
+      return tags[i];
+    }
+
+    if ( ++i == OTHER_TAG )
+    {
+      i = 0;
+    }
+  }
+
+  tags[OTHER_TAG].name.store ( OTHER, std::memory_order_release );
+
+  return tags[OTHER_TAG];
+}
+
+
+//-----------------------------------------------------------------------
+//   getStats
+//-----------------------------------------------------------------------
+
+
+void ThreadCache::Profile_::getStats ( MemStats& stats ) const
+{
+  const std::memory_order  relaxed = std::memory_order_relaxed;
+
+
+  stats.clear ();
+
+  stats.threadID   = id;
+  stats.allocCount = allocCount.load ( relaxed );
+  stats.freeCount  = freeCount .load ( relaxed );
+  stats.allocBytes = allocBytes.load ( relaxed );
+  stats.freeBytes  = freeBytes .load ( relaxed );
+  stats.peakBytes  = peakBytes .load ( relaxed );
+  stats.largeCount = largeCount.load ( relaxed );
+  stats.largeBytes = largeBytes.load ( relaxed );
+
+  for ( size_t i = 0; i < FREE_LIST_COUNT; i++ )
+  {
+    stats.classes[i].allocCount  = classAllocs[i].load ( relaxed );
+    stats.classes[i].hitCount    = classHits  [i].load ( relaxed );
+    stats.classes[i].cachedCount = classCached[i].load ( relaxed );
+  }
+
+  for ( int i = 0; i < MemStats::MAX_TAGS; i++ )
+  {
+    const char*  name =
+
+      tags[i].name.load ( std::memory_order_acquire );
+
+    if ( name )
+    {
+      MemStats::Tag&  t = stats.tags[stats.tagCount++];
+
+      t.name       = name;
+      t.allocCount = tags[i].allocCount.load ( relaxed );
+      t.byteCount  = tags[i].byteCount .load ( relaxed );
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   link & unlink
+//-----------------------------------------------------------------------
+
+
+void ThreadCache::Profile_::link ()
+{
+  lock.lock ();
+
+  next = list;
+  prev = nullptr;
+
+  if ( list )
+  {
+    list->prev = this;
+  }
+
+  list = this;
+
+  lock.unlock ();
+}
+
+
+void ThreadCache::Profile_::unlink ()
+{
+  if ( prev )
+  {
+    prev->next = next;
+  }
+  else
+  {
+    list = next;
+  }
+
+  if ( next )
+  {
+    next->prev = prev;
+  }
+
+  prev = next = nullptr;
+}
+
+
 //=======================================================================
 //   class ThreadCache::ItemList_
 //=======================================================================
@@ -65,14 +366,22 @@ ThreadCache::ItemList_::~ItemList_ ()
 
 ThreadCache::ThreadCache ( size_t size )
 {
-  errors_ = 0x0;
+  errors_  = 0x0;
+  profile_ = nullptr;
 
   setSize ( size );
+
+  if ( Profile_::enabled )
+  {
+    setProfiling ( true );
+  }
 }
 
 
 ThreadCache::~ThreadCache ()
-{}
+{
+  setProfiling ( false );
+}
 
 
 //-----------------------------------------------------------------------
@@ -93,10 +402,11 @@ AutoPointer<ThreadCache> ThreadCache::clone ()
 
 void* ThreadCache::realloc
 
-  ( void*      oldAddr,
-    size_t     oldSize,
-    size_t     newSize,
-    ThrowMode  tm )
+  ( void*        oldAddr,
+    size_t       oldSize,
+    size_t       newSize,
+    ThrowMode    tm,
+    const char*  tag )
 
 {
   void*  newAddr;
@@ -104,7 +414,7 @@ void* ThreadCache::realloc
 
   if ( oldSize < LARGE_ALLOC || newSize < LARGE_ALLOC )
   {
-    newAddr = alloc ( newSize, tm );
+    newAddr = alloc ( newSize, tm, tag );
 
     if ( oldSize < newSize )
     {
@@ -122,6 +432,12 @@ void* ThreadCache::realloc
     size_t  n = align ( oldSize + 1 );
     byte*   p = (byte*) oldAddr;
 
+    if ( profile_ )
+    {
+      profileDealloc_ ( oldSize, false );
+      profileAlloc_   ( newSize, false, tag );
+    }
+
     for ( size_t i = oldSize; i < n; i++ )
     {
       errors_ = (byte) (errors_ | (p[i] - CANARY_VALUE));
@@ -212,6 +528,124 @@ void ThreadCache::setSize ( size_t size )
 }
 
 
+//-----------------------------------------------------------------------
+//   setProfiling
+//-----------------------------------------------------------------------
+
+
+void ThreadCache::setProfiling ( bool flag )
+{
+  if ( flag && ! profile_ )
+  {
+    profile_ = new Profile_ ();
+
+    profile_->link ();
+  }
+  else if ( ! flag && profile_ )
+  {
+    MemStats  stats;
+
+    profile_->getStats ( stats );
+
+    Profile_::lock.lock ();
+
+    profile_->unlink ();
+    getRetiredStats_().merge ( stats );
+
+    Profile_::lock.unlock ();
+
+    delete profile_;
+
+    profile_ = nullptr;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   setTag
+//-----------------------------------------------------------------------
+
+
+const char* ThreadCache::setTag ( const char* tag ) noexcept
+{
+  const char*  prev = nullptr;
+
+  if ( profile_ )
+  {
+    prev          = profile_->tag;
+    profile_->tag = tag;
+  }
+
+  return prev;
+}
+
+
+//-----------------------------------------------------------------------
+//   setDefaultProfiling
+//-----------------------------------------------------------------------
+
+
+void ThreadCache::setDefaultProfiling ( bool flag )
+{
+  Profile_::enabled = flag;
+}
+
+
+//-----------------------------------------------------------------------
+//   getDefaultProfiling
+//-----------------------------------------------------------------------
+
+
+bool ThreadCache::getDefaultProfiling ()
+{
+  return Profile_::enabled;
+}
+
+
+//-----------------------------------------------------------------------
+//   getStats
+//-----------------------------------------------------------------------
+
+
+idx_t ThreadCache::getStats
+
+  ( MemStats&  total,
+    MemStats*  threads,
+    idx_t      maxThreads )
+
+{
+  MemStats  stats;
+  idx_t     count = 0;
+
+
+  Profile_::lock.lock ();
+
+  total = getRetiredStats_ ();
+
+  for ( Profile_* p = Profile_::list; p; p = p->next )
+  {
+    p->getStats ( stats );
+    total.merge ( stats );
+
+    if ( count < maxThreads )
+    {
+      threads[count] = stats;
+    }
+
+    count++;
+  }
+
+  Profile_::lock.unlock ();
+
+  total.threadID  = -1;
+  total.peakBytes =
+
+    Profile_::totalPeak.load ( std::memory_order_relaxed );
+
+  return count;
+}
+
+
 //-----------------------------------------------------------------------
 //   alloc_
 //-----------------------------------------------------------------------
@@ -284,4 +718,114 @@ void ThreadCache::allocError_
 }
 
 
+//-----------------------------------------------------------------------
+//   profileAlloc_
+//-----------------------------------------------------------------------
+
+// A large allocation is attributed to the tag of the current scope
+// if there is one, and otherwise to the tag given by the caller.
+
+
+void ThreadCache::profileAlloc_
+
+  ( size_t       size,
+    bool         hit,
+    const char*  tag ) noexcept
+
+{
+  Profile_&   p = *profile_;
+  const lint  n = (lint) size;
+
+  lint        total;
+  lint        peak;
+
+
+  Profile_::add ( p.allocCount, 1 );
+  Profile_::add ( p.allocBytes, n );
+
+  if      ( size <= MAX_ITEM_SIZE )
+  {
+    size_t  i = (size - 1) / ALIGNMENT;
+
+    Profile_::add ( p.classAllocs[i], 1 );
+
+    if ( hit )
+    {
+      Profile_::add ( p.classHits[i], 1 );
+    }
+  }
+  else if ( size >= LARGE_ALLOC )
+  {
+    Profile_::TagEntry&  t = p.findTag ( p.tag ? p.tag : tag );
+
+    Profile_::add ( p.largeCount,   1 );
+    Profile_::add ( p.largeBytes,   n );
+    Profile_::add ( t.allocCount,   1 );
+    Profile_::add ( t.byteCount,    n );
+  }
+
+  p.inUse += n;
+
+  if ( p.inUse > p.peakBytes.load( std::memory_order_relaxed ) )
+  {
+    p.peakBytes.store ( p.inUse, std::memory_order_relaxed );
+  }
+
+  total = n + Profile_::totalInUse.fetch_add (
+    n, std::memory_order_relaxed
+  );
+
+  peak  = Profile_::totalPeak.load ( std::memory_order_relaxed );
+
+  while ( total > peak &&
+          ! Profile_::totalPeak.compare_exchange_weak (
+            peak, total, std::memory_order_relaxed ) )
+  {}
+}
+
+
+//-----------------------------------------------------------------------
+//   profileDealloc_
+//-----------------------------------------------------------------------
+
+
+void ThreadCache::profileDealloc_
+
+  ( size_t  size,
+    bool    cached ) noexcept
+
+{
+  Profile_&   p = *profile_;
+  const lint  n = (lint) size;
+
+
+  Profile_::add ( p.freeCount, 1 );
+  Profile_::add ( p.freeBytes, n );
+
+  if ( cached )
+  {
+    Profile_::add ( p.classCached[(size - 1) / ALIGNMENT], 1 );
+  }
+
+  p.inUse -= n;
+
+  Profile_::totalInUse.fetch_sub ( n, std::memory_order_relaxed );
+}
+
+
+//-----------------------------------------------------------------------
+//   getRetiredStats_
+//-----------------------------------------------------------------------
+
+
+MemStats& ThreadCache::getRetiredStats_ ()
+{
+  // Accumulates the statistics of threads that have terminated.
+
+  static MemStats  stats;
+
+  return stats;
+}
+
+
 JEM_END_PACKAGE_BASE
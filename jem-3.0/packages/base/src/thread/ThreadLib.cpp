@@ -308,14 +308,17 @@ void ThreadLib::reapZombies ()
 void ThreadLib::init_ ()
 {
   lint  cacheSize;
+  lint  profile;
 
   try
   {
     initialized_ = 1;
     cacheSize    = Cache::DEFAULT_SIZE;
+    profile      = 0;
 
     igetenv ( SPIN_COUNT, EnvParams::SPIN_COUNT );
     igetenv ( cacheSize,  EnvParams::CACHE_SIZE );
+    igetenv ( profile,    EnvParams::MEM_PROFILE );
 
     if ( SPIN_COUNT < 0 )
     {
@@ -326,6 +329,8 @@ void ThreadLib::init_ ()
       cacheSize = 0;
     }
 
+    Cache::setDefaultProfiling ( profile != 0 );
+
     Lock_::mutex = new Mutex ();
 
     Native::init     ();
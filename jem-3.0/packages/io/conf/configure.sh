@@ -241,6 +241,9 @@ if [ -n "$USE_ZLIB" ] && TestZlib ; then
   cp -f native/ZlibDeflator.h    "$PKG_INC_DIR/Deflator.h"   || Die
   cp -f native/ZlibInflator.cpp   Inflator.cpp               || Die
   cp -f native/ZlibDeflator.cpp   Deflator.cpp               || Die
+  cp -f native/ZlibBlockDeflator.h \
+                                 "$PKG_INC_DIR/BlockDeflator.h" || Die
+  cp -f native/ZlibBlockDeflator.cpp BlockDeflator.cpp          || Die
 
   PopDir || Die
 
@@ -256,6 +259,9 @@ else
   cp -f native/DummyDeflator.h   "$PKG_INC_DIR/Deflator.h"   || Die
   cp -f native/DummyInflator.cpp  Inflator.cpp               || Die
   cp -f native/DummyDeflator.cpp  Deflator.cpp               || Die
+  cp -f native/DummyBlockDeflator.h \
+                                 "$PKG_INC_DIR/BlockDeflator.h" || Die
+  cp -f native/DummyBlockDeflator.cpp BlockDeflator.cpp         || Die
 
   PopDir || Die
 
@@ -16,5 +16,8 @@ cp -f native/PosixFileStream.cpp  NativeFileStream.cpp || Die
 cp -f native/PosixDirListing.h \
       "$PKG_INC_DIR/native/DirListing.h"               || Die
 cp -f native/PosixDirListing.cpp  NativeDirListing.cpp || Die
+cp -f native/PosixMappedFile.h \
+      "$PKG_INC_DIR/native/MappedFile.h"               || Die
+cp -f native/PosixMappedFile.cpp  NativeMappedFile.cpp || Die
 
 PopDir || Die
@@ -16,5 +16,8 @@ cp -f native/WinFileStream.cpp  NativeFileStream.cpp || Die
 cp -f native/WinDirListing.h \
       "$PKG_INC_DIR/native/DirListing.h"             || Die
 cp -f native/WinDirListing.cpp  NativeDirListing.cpp || Die
+cp -f native/WinMappedFile.h \
+      "$PKG_INC_DIR/native/MappedFile.h"             || Die
+cp -f native/WinMappedFile.cpp  NativeMappedFile.cpp || Die
 
 PopDir || Die
@@ -0,0 +1,655 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <cstring>
+#include <jem/base/assert.h>
+#include <jem/base/Thread.h>
+#include <jem/base/Monitor.h>
+#include <jem/base/MemCache.h>
+#include <jem/base/Collectable.h>
+#include <jem/base/IllegalArgumentException.h>
+#include <jem/io/params.h>
+#include <jem/io/IOException.h>
+#include <jem/io/AsyncOutputStream.h>
+
+
+JEM_BEGIN_PACKAGE( io )
+
+
+//=======================================================================
+//   class AsyncOutputStream::Data_
+//=======================================================================
+
+// The buffers are used in a round-robin fashion. The producer fills
+// the buffer with index (filled % bufcount); the writer thread
+// writes the buffer with index (written % bufcount). A buffer is
+// owned by the producer as long as (filled - written) is smaller
+// than the number of buffers.
+
+
+class AsyncOutputStream::Data_ : public Collectable
+{
+ public:
+
+  struct                  Buffer
+  {
+    byte*                   data;
+    idx_t                   size;
+    bool                    flush;
+  };
+
+
+                          Data_
+
+    ( const Ref<OutputStream>&  out,
+      idx_t                     bufsize,
+      int                       bufcount );
+
+  inline Buffer&          nextFree    ();
+  inline Buffer&          nextFull    ();
+
+
+ public:
+
+  Monitor                 monitor;
+  Ref<OutputStream>       output;
+  const idx_t             bufsize;
+  const int               bufcount;
+  Buffer*                 buffers;
+  lint                    filled;
+  lint                    written;
+  bool                    quit;
+  bool                    failed;
+  String                  error;
+
+
+ protected:
+
+  virtual                ~Data_       ();
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+AsyncOutputStream::Data_::Data_
+
+  ( const Ref<OutputStream>&  out,
+    idx_t                     bsize,
+    int                       bcount ) :
+
+    output   ( out    ),
+    bufsize  ( bsize  ),
+    bufcount ( bcount )
+
+{
+  buffers = new Buffer[bufcount];
+
+  for ( int i = 0; i < bufcount; i++ )
+  {
+    buffers[i].data  = nullptr;
+    buffers[i].size  = 0;
+    buffers[i].flush = false;
+  }
+
+  try
+  {
+    for ( int i = 0; i < bufcount; i++ )
+    {
+      buffers[i].data = (byte*) MemCache::alloc ( (size_t) bufsize );
+    }
+  }
+  catch ( ... )
+  {
+    for ( int i = 0; i < bufcount; i++ )
+    {
+      if ( buffers[i].data )
+      {
+        MemCache::dealloc ( buffers[i].data, (size_t) bufsize );
+      }
+    }
+
+    delete [] buffers;
+
+    throw;
+  }
+
+  filled  = 0;
+  written = 0;
+  quit    = false;
+  failed  = false;
+}
+
+
+AsyncOutputStream::Data_::~Data_ ()
+{
+  for ( int i = 0; i < bufcount; i++ )
+  {
+    MemCache::dealloc ( buffers[i].data, (size_t) bufsize );
+  }
+
+  delete [] buffers;
+
+  buffers = nullptr;
+}
+
+
+//-----------------------------------------------------------------------
+//   nextFree
+//-----------------------------------------------------------------------
+
+
+inline AsyncOutputStream::Data_::Buffer&
+
+  AsyncOutputStream::Data_::nextFree ()
+
+{
+  return buffers[filled % bufcount];
+}
+
+
+//-----------------------------------------------------------------------
+//   nextFull
+//-----------------------------------------------------------------------
+
+
+inline AsyncOutputStream::Data_::Buffer&
+
+  AsyncOutputStream::Data_::nextFull ()
+
+{
+  return buffers[written % bufcount];
+}
+
+
+//=======================================================================
+//   class AsyncOutputStream::Writer_
+//=======================================================================
+
+
+class AsyncOutputStream::Writer_ : public Thread
+{
+ public:
+
+  explicit                Writer_
+
+    ( const Ref<Data_>&     data );
+
+  virtual void            run     () override;
+
+
+ protected:
+
+  virtual                ~Writer_ ();
+
+
+ private:
+
+  Ref<Data_>              data_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+AsyncOutputStream::Writer_::Writer_ ( const Ref<Data_>& data ) :
+
+  data_ ( data )
+
+{}
+
+
+AsyncOutputStream::Writer_::~Writer_ ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+void AsyncOutputStream::Writer_::run ()
+{
+  Data_&         d = *data_;
+  Lock<Monitor>  lock ( d.monitor );
+
+  allowCancel ( false );
+
+  while ( true )
+  {
+    while ( d.written == d.filled && ! d.quit )
+    {
+      d.monitor.waitNoCancel ();
+    }
+
+    if ( d.written == d.filled )
+    {
+      break;
+    }
+
+    Data_::Buffer&  buf = d.nextFull ();
+
+    // Data are discarded after an error; the error is reported to
+    // the producer when it calls one of the stream functions.
+
+    if ( ! d.failed )
+    {
+      String  error;
+      bool    failed = false;
+
+      d.monitor.unlock ();
+
+      try
+      {
+        if ( buf.size > 0 )
+        {
+          d.output->write ( buf.data, buf.size );
+        }
+
+        if ( buf.flush )
+        {
+          d.output->flush ();
+        }
+      }
+      catch ( const Throwable& ex )
+      {
+        failed = true;
+        error  = ex.what ();
+      }
+      catch ( ... )
+      {
+        failed = true;
+        error  = "unknown error";
+      }
+
+      d.monitor.lock ();
+
+      if ( failed )
+      {
+        d.failed = true;
+        d.error  = error;
+      }
+    }
+
+    buf.size  = 0;
+    buf.flush = false;
+
+    d.written++;
+    d.monitor.notifyAll ();
+  }
+}
+
+
+//=======================================================================
+//   class AsyncOutputStream
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+const int  AsyncOutputStream::DEFAULT_BUFCOUNT = 2;
+
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+AsyncOutputStream::AsyncOutputStream
+
+  ( Ref<OutputStream>  out,
+    idx_t              bufsize,
+    int                bufcount ) :
+
+    Super ( out )
+
+{
+  if ( bufsize <= 0_idx )
+  {
+    bufsize = DEFAULT_BUFSIZE;
+  }
+
+  if ( bufcount <= 0 )
+  {
+    bufcount = DEFAULT_BUFCOUNT;
+  }
+
+  if ( bufcount < 2 )
+  {
+    throw IllegalArgumentException (
+      JEM_FUNC,
+      "an asynchronous stream requires at least two buffers"
+    );
+  }
+
+  data_   = newInstance<Data_> ( out, bufsize, bufcount );
+  buffer_ = data_->nextFree().data;
+  last_   = 0_idx;
+  closed_ = false;
+
+#ifdef JEM_USE_THREADS
+
+  writer_ = newInstance<Writer_> ( data_ );
+
+  writer_->start ();
+
+#endif
+}
+
+
+AsyncOutputStream::~AsyncOutputStream ()
+{
+  try
+  {
+    if ( ! closed_ )
+    {
+      handOff_ ( false );
+    }
+  }
+  catch ( ... )
+  {}
+
+  stop_ ();
+}
+
+
+//-----------------------------------------------------------------------
+//   close
+//-----------------------------------------------------------------------
+
+
+void AsyncOutputStream::close ()
+{
+  if ( closed_ )
+  {
+    return;
+  }
+
+  closed_ = true;
+
+  try
+  {
+    handOff_ ( false );
+    drain_   ();
+  }
+  catch ( ... )
+  {
+    stop_ ();
+    throw;
+  }
+
+  stop_          ();
+  checkError_    ();
+  output_->close ();
+}
+
+
+//-----------------------------------------------------------------------
+//   flush
+//-----------------------------------------------------------------------
+
+
+void AsyncOutputStream::flush ()
+{
+  // Note that this function does not wait until the data have been
+  // written; call sync() for that.
+
+  checkOpen_ ();
+  handOff_   ( true );
+}
+
+
+//-----------------------------------------------------------------------
+//   write
+//-----------------------------------------------------------------------
+
+
+void AsyncOutputStream::write ( const void* buf, idx_t n )
+{
+  JEM_PRECHECK ( n >= 0 );
+
+  const byte*  src     = (const byte*) buf;
+  const idx_t  bufsize = data_->bufsize;
+
+
+  checkOpen_ ();
+
+  while ( n > 0 )
+  {
+    idx_t  k = min ( n, bufsize - last_ );
+
+    std::memcpy ( buffer_ + last_, src, (size_t) k );
+
+    last_ += k;
+    src   += k;
+    n     -= k;
+
+    if ( last_ == bufsize )
+    {
+      handOff_ ( false );
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   writeNoThrow
+//-----------------------------------------------------------------------
+
+
+void AsyncOutputStream::writeNoThrow
+
+  ( const void*  buf,
+    idx_t        n ) noexcept
+
+{
+  Data_&  d = *data_;
+
+  if ( closed_ )
+  {
+    return;
+  }
+
+  // Wait until the writer thread is idle and then write the data
+  // directly, so that the output order is preserved.
+
+  d.monitor.lock ();
+
+  while ( d.written != d.filled )
+  {
+    d.monitor.waitNoCancel ();
+  }
+
+  if ( last_ > 0_idx )
+  {
+    output_->writeNoThrow ( buffer_, last_ );
+    last_ = 0_idx;
+  }
+
+  if ( n > 0_idx )
+  {
+    output_->writeNoThrow ( buf, n );
+  }
+
+  d.monitor.unlock ();
+}
+
+
+//-----------------------------------------------------------------------
+//   sync
+//-----------------------------------------------------------------------
+
+
+void AsyncOutputStream::sync ()
+{
+  checkOpen_  ();
+  handOff_    ( true );
+  drain_      ();
+  checkError_ ();
+}
+
+
+//-----------------------------------------------------------------------
+//   handOff_
+//-----------------------------------------------------------------------
+
+
+void AsyncOutputStream::handOff_ ( bool flush )
+{
+  Data_&  d = *data_;
+
+  checkError_ ();
+
+  if ( last_ == 0_idx && ! flush )
+  {
+    return;
+  }
+
+  if ( ! writer_ )
+  {
+    // No thread support; write the data synchronously.
+
+    idx_t  n = last_;
+
+    last_ = 0_idx;
+
+    output_->write ( buffer_, n );
+
+    if ( flush )
+    {
+      output_->flush ();
+    }
+
+    return;
+  }
+
+  Lock<Monitor>    lock ( d.monitor );
+  Data_::Buffer&   buf = d.nextFree ();
+
+  buf.size  = last_;
+  buf.flush = flush;
+  last_     = 0_idx;
+
+  d.filled++;
+  d.monitor.notifyAll ();
+
+  // Wait until the next buffer has been written to the output stream.
+
+  while ( d.filled - d.written >= d.bufcount )
+  {
+    d.monitor.wait ();
+  }
+
+  buffer_ = d.nextFree().data;
+}
+
+
+//-----------------------------------------------------------------------
+//   drain_
+//-----------------------------------------------------------------------
+
+
+void AsyncOutputStream::drain_ ()
+{
+  Data_&         d = *data_;
+  Lock<Monitor>  lock ( d.monitor );
+
+  while ( d.written != d.filled )
+  {
+    d.monitor.wait ();
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   stop_
+//-----------------------------------------------------------------------
+
+
+void AsyncOutputStream::stop_ ()
+{
+  if ( writer_ )
+  {
+    Data_&  d = *data_;
+
+    d.monitor.lock      ();
+    d.quit = true;
+    d.monitor.notifyAll ();
+    d.monitor.unlock    ();
+
+    writer_->join ();
+
+    writer_ = nullptr;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   checkOpen_
+//-----------------------------------------------------------------------
+
+
+void AsyncOutputStream::checkOpen_ () const
+{
+  if ( closed_ )
+  {
+    throw IOException ( JEM_FUNC, "stream closed" );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   checkError_
+//-----------------------------------------------------------------------
+
+
+void AsyncOutputStream::checkError_ () const
+{
+  Data_&         d = *data_;
+  Lock<Monitor>  lock ( d.monitor );
+
+  if ( d.failed )
+  {
+    throw IOException (
+      JEM_FUNC,
+      "asynchronous write failed: " + d.error
+    );
+  }
+}
+
+
+JEM_END_PACKAGE( io )
@@ -0,0 +1,201 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <cstring>
+#include <jem/base/assert.h>
+#include <jem/io/ZipException.h>
+#include "native/ZlibBlockDeflator.h"
+
+
+JEM_BEGIN_PACKAGE( io )
+
+
+//=======================================================================
+//   class BlockDeflator
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+BlockDeflator::BlockDeflator ( int level )
+{
+  int  result;
+
+
+  if ( level < 0 )
+  {
+    level = Z_DEFAULT_COMPRESSION;
+  }
+
+  std::memset ( &zstream_, 0x0, sizeof(z_stream) );
+
+  zstream_.zalloc = Z_NULL;
+  zstream_.zfree  = Z_NULL;
+  zstream_.opaque = 0;
+
+  // Each block is compressed into a raw deflate stream without a
+  // zlib header.
+
+  result = deflateInit2 ( &zstream_, level, Z_DEFLATED,
+                          -15,       8,     Z_DEFAULT_STRATEGY );
+
+  if ( result != Z_OK )
+  {
+    throw ZipException (
+      JEM_FUNC,
+      String::format ( "zip error: %s", zstream_.msg )
+    );
+  }
+}
+
+
+BlockDeflator::~BlockDeflator ()
+{
+  deflateEnd ( &zstream_ );
+}
+
+
+//-----------------------------------------------------------------------
+//   maxOutputSize
+//-----------------------------------------------------------------------
+
+
+idx_t BlockDeflator::maxOutputSize ( idx_t n )
+{
+  JEM_PRECHECK ( n >= 0 );
+
+  // Reserve some extra space for the empty stored block that is
+  // appended by a sync flush.
+
+  return (idx_t) deflateBound ( &zstream_, (uLong) n ) + 16_idx;
+}
+
+
+//-----------------------------------------------------------------------
+//   deflate
+//-----------------------------------------------------------------------
+
+
+idx_t BlockDeflator::deflate
+
+  ( byte*        out,
+    idx_t        outsize,
+    const void*  in,
+    idx_t        n,
+    bool         last )
+
+{
+  JEM_PRECHECK ( n >= 0 && outsize >= 0 );
+
+  const int  mode = last ? Z_FINISH : Z_SYNC_FLUSH;
+
+  int        result;
+
+
+  if ( deflateReset( &zstream_ ) != Z_OK )
+  {
+    zipError_ ();
+  }
+
+  zstream_.next_in   = (Bytef*) in;
+  zstream_.avail_in  = (uInt)   n;
+  zstream_.next_out  = (Bytef*) out;
+  zstream_.avail_out = (uInt)   outsize;
+
+  result = ::deflate ( &zstream_, mode );
+
+  if ( (last && result != Z_STREAM_END) ||
+       (! last && result != Z_OK)      ||
+       zstream_.avail_in  != 0          ||
+       zstream_.avail_out == 0 )
+  {
+    zipError_ ();
+  }
+
+  return (outsize - (idx_t) zstream_.avail_out);
+}
+
+
+//-----------------------------------------------------------------------
+//   checksum
+//-----------------------------------------------------------------------
+
+
+ulint BlockDeflator::checksum
+
+  ( ulint        crc,
+    const void*  buf,
+    idx_t        n )
+
+{
+  return (ulint) ::crc32 ( (uLong) crc, (const Bytef*) buf, (uInt) n );
+}
+
+
+//-----------------------------------------------------------------------
+//   combine
+//-----------------------------------------------------------------------
+
+
+ulint BlockDeflator::combine
+
+  ( ulint  crc1,
+    ulint  crc2,
+    lint   n2 )
+
+{
+  return (ulint) ::crc32_combine ( (uLong) crc1, (uLong) crc2,
+                                   (z_off_t) n2 );
+}
+
+
+//-----------------------------------------------------------------------
+//   zipError_
+//-----------------------------------------------------------------------
+
+
+void BlockDeflator::zipError_ ()
+{
+  const char*  msg = zstream_.msg;
+
+  if ( ! msg )
+  {
+    msg = "insufficient output space";
+  }
+
+  throw ZipException (
+    JEM_FUNC,
+    String::format ( "zip error: %s", msg )
+  );
+}
+
+
+JEM_END_PACKAGE( io )
@@ -27,8 +27,10 @@
  */
 
 
+#include <jem/base/limits.h>
 #include <jem/base/ClassTemplate.h>
 #include <jem/io/StreamCodec.h>
+#include <jem/io/MappedInputStream.h>
 #include <jem/io/SerializationException.h>
 #include <jem/io/DataInputStream.h>
 
@@ -39,6 +41,49 @@ JEM_DEFINE_CLASS( jem::io::DataInputStream );
 JEM_BEGIN_PACKAGE( io )
 
 
+//=======================================================================
+//   private functions
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   decodeArray
+//-----------------------------------------------------------------------
+
+// Decodes an array directly from a memory-mapped input stream if
+// possible; this avoids the intermediate buffer in the StreamCodec.
+
+
+template <class T>
+
+  static inline void  decodeArray
+
+  ( InputStream&        in,
+    MappedInputStream*  mapped,
+    T*                  buf,
+    idx_t               n,
+    int                 sex )
+
+{
+  const int  XDR_SIZE = xdr::TypeTraits<T>::XDR_SIZE;
+
+  if ( ! mapped )
+  {
+    StreamCodec::decode ( in, buf, n, sex );
+    return;
+  }
+
+  while ( n > 0 )
+  {
+    idx_t  k = min ( n, maxOf<idx_t>() / XDR_SIZE );
+
+    xdr::decode ( buf, k, mapped->readSpan( k * XDR_SIZE ), sex );
+
+    buf += k;
+    n   -= k;
+  }
+}
+
+
 //=======================================================================
 //   class DataInputStream
 //=======================================================================
@@ -54,6 +99,7 @@ DataInputStream::DataInputStream () :
 
 {
   options_ = DEFAULT_OPTIONS;
+  mapped_  = nullptr;
 }
 
 
@@ -64,6 +110,7 @@ DataInputStream::DataInputStream ( Ref<InputStream> in ) :
 
 {
   options_ = DEFAULT_OPTIONS;
+  mapped_  = dynamicCast<MappedInputStream*> ( input_ );
 }
 
 
@@ -245,7 +292,7 @@ double DataInputStream::decodeDouble ()
 
 void DataInputStream::decode ( bool* buf, idx_t n )
 {
-  StreamCodec::decode ( *input_, buf, n, SEX_ );
+  decodeArray ( *input_, mapped_, buf, n, SEX_ );
 }
 
 
@@ -267,7 +314,7 @@ void DataInputStream::decode ( byte* buf, idx_t n )
 
 void DataInputStream::decode ( char* buf, idx_t n )
 {
-  StreamCodec::decode ( *input_, buf, n, SEX_ );
+  decodeArray ( *input_, mapped_, buf, n, SEX_ );
 }
 
 
@@ -278,7 +325,7 @@ void DataInputStream::decode ( char* buf, idx_t n )
 
 void DataInputStream::decode ( short* buf, idx_t n )
 {
-  StreamCodec::decode ( *input_, buf, n, SEX_ );
+  decodeArray ( *input_, mapped_, buf, n, SEX_ );
 }
 
 
@@ -289,7 +336,7 @@ void DataInputStream::decode ( short* buf, idx_t n )
 
 void DataInputStream::decode ( int* buf, idx_t n )
 {
-  StreamCodec::decode ( *input_, buf, n, SEX_ );
+  decodeArray ( *input_, mapped_, buf, n, SEX_ );
 }
 
 
@@ -300,7 +347,7 @@ void DataInputStream::decode ( int* buf, idx_t n )
 
 void DataInputStream::decode ( long* buf, idx_t n )
 {
-  StreamCodec::decode ( *input_, buf, n, SEX_ );
+  decodeArray ( *input_, mapped_, buf, n, SEX_ );
 }
 
 
@@ -311,7 +358,7 @@ void DataInputStream::decode ( long* buf, idx_t n )
 
 void DataInputStream::decode ( lint* buf, idx_t n )
 {
-  StreamCodec::decode ( *input_, buf, n, SEX_ );
+  decodeArray ( *input_, mapped_, buf, n, SEX_ );
 }
 
 
@@ -322,7 +369,27 @@ void DataInputStream::decode ( lint* buf, idx_t n )
 
 void DataInputStream::decode ( idx_t* buf, idx_t n )
 {
-  StreamCodec::decode ( *input_, buf, n, SEX_, options_ );
+  const int  XDR_SIZE = xdr::TypeTraits<JEM_IDX_T>::XDR_SIZE;
+
+  bool       native   = true;
+
+  if      ( options_ & IDX_SIZE_4BYTES )
+  {
+    native = (XDR_SIZE == 4);
+  }
+  else if ( options_ & IDX_SIZE_8BYTES )
+  {
+    native = (XDR_SIZE == 8);
+  }
+
+  if ( native )
+  {
+    decodeArray ( *input_, mapped_, (JEM_IDX_T*) buf, n, SEX_ );
+  }
+  else
+  {
+    StreamCodec::decode ( *input_, buf, n, SEX_, options_ );
+  }
 }
 
 
@@ -333,7 +400,7 @@ void DataInputStream::decode ( idx_t* buf, idx_t n )
 
 void DataInputStream::decode ( float* buf, idx_t n )
 {
-  StreamCodec::decode ( *input_, buf, n, SEX_ );
+  decodeArray ( *input_, mapped_, buf, n, SEX_ );
 }
 
 
@@ -344,7 +411,7 @@ void DataInputStream::decode ( float* buf, idx_t n )
 
 void DataInputStream::decode ( double* buf, idx_t n )
 {
-  StreamCodec::decode ( *input_, buf, n, SEX_ );
+  decodeArray ( *input_, mapped_, buf, n, SEX_ );
 }
 
 
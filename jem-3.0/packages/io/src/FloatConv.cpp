@@ -0,0 +1,2716 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <cstring>
+#include <jem/base/assert.h>
+#include <jem/io/FloatConv.h>
+
+
+JEM_BEGIN_PACKAGE( io )
+
+
+//=======================================================================
+//   private data
+//=======================================================================
+
+// The conversion from binary to decimal is based on the Ryu algorithm
+// by Ulf Adams (PLDI 2018). The conversion from decimal to binary is
+// based on the algorithm by Daniel Lemire and Michael Eisel (Software:
+// Practice and Experience, 2021), with a fall back to exact big
+// integer arithmetic in the rare cases that the result can not be
+// determined with 128-bit arithmetic.
+//
+// POW5_SPLIT_[i] contains the 125 most significant bits of 5^i, and
+// POW5_INV_SPLIT_[i] contains the 125 most significant bits of 5^-i,
+// rounded up. The first element of each pair contains the least
+// significant 64 bits.
+
+static const ulint  POW5_SPLIT_[326][2] =
+{
+  { 0x0000000000000000_ulint, 0x1000000000000000_ulint },
+  { 0x0000000000000000_ulint, 0x1400000000000000_ulint },
+  { 0x0000000000000000_ulint, 0x1900000000000000_ulint },
+  { 0x0000000000000000_ulint, 0x1f40000000000000_ulint },
+  { 0x0000000000000000_ulint, 0x1388000000000000_ulint },
+  { 0x0000000000000000_ulint, 0x186a000000000000_ulint },
+  { 0x0000000000000000_ulint, 0x1e84800000000000_ulint },
+  { 0x0000000000000000_ulint, 0x1312d00000000000_ulint },
+  { 0x0000000000000000_ulint, 0x17d7840000000000_ulint },
+  { 0x0000000000000000_ulint, 0x1dcd650000000000_ulint },
+  { 0x0000000000000000_ulint, 0x12a05f2000000000_ulint },
+  { 0x0000000000000000_ulint, 0x174876e800000000_ulint },
+  { 0x0000000000000000_ulint, 0x1d1a94a200000000_ulint },
+  { 0x0000000000000000_ulint, 0x12309ce540000000_ulint },
+  { 0x0000000000000000_ulint, 0x16bcc41e90000000_ulint },
+  { 0x0000000000000000_ulint, 0x1c6bf52634000000_ulint },
+  { 0x0000000000000000_ulint, 0x11c37937e0800000_ulint },
+  { 0x0000000000000000_ulint, 0x16345785d8a00000_ulint },
+  { 0x0000000000000000_ulint, 0x1bc16d674ec80000_ulint },
+  { 0x0000000000000000_ulint, 0x1158e460913d0000_ulint },
+  { 0x0000000000000000_ulint, 0x15af1d78b58c4000_ulint },
+  { 0x0000000000000000_ulint, 0x1b1ae4d6e2ef5000_ulint },
+  { 0x0000000000000000_ulint, 0x10f0cf064dd59200_ulint },
+  { 0x0000000000000000_ulint, 0x152d02c7e14af680_ulint },
+  { 0x0000000000000000_ulint, 0x1a784379d99db420_ulint },
+  { 0x0000000000000000_ulint, 0x108b2a2c28029094_ulint },
+  { 0x0000000000000000_ulint, 0x14adf4b7320334b9_ulint },
+  { 0x4000000000000000_ulint, 0x19d971e4fe8401e7_ulint },
+  { 0x8800000000000000_ulint, 0x1027e72f1f128130_ulint },
+  { 0xaa00000000000000_ulint, 0x1431e0fae6d7217c_ulint },
+  { 0xd480000000000000_ulint, 0x193e5939a08ce9db_ulint },
+  { 0xc9a0000000000000_ulint, 0x1f8def8808b02452_ulint },
+  { 0xbe04000000000000_ulint, 0x13b8b5b5056e16b3_ulint },
+  { 0xad85000000000000_ulint, 0x18a6e32246c99c60_ulint },
+  { 0xd8e6400000000000_ulint, 0x1ed09bead87c0378_ulint },
+  { 0x878fe80000000000_ulint, 0x13426172c74d822b_ulint },
+  { 0x6973e20000000000_ulint, 0x1812f9cf7920e2b6_ulint },
+  { 0x03d0da8000000000_ulint, 0x1e17b84357691b64_ulint },
+  { 0x8262889000000000_ulint, 0x12ced32a16a1b11e_ulint },
+  { 0x22fb2ab400000000_ulint, 0x178287f49c4a1d66_ulint },
+  { 0xabb9f56100000000_ulint, 0x1d6329f1c35ca4bf_ulint },
+  { 0xcb54395ca0000000_ulint, 0x125dfa371a19e6f7_ulint },
+  { 0xbe2947b3c8000000_ulint, 0x16f578c4e0a060b5_ulint },
+  { 0x2db399a0ba000000_ulint, 0x1cb2d6f618c878e3_ulint },
+  { 0xfc90400474400000_ulint, 0x11efc659cf7d4b8d_ulint },
+  { 0x7bb4500591500000_ulint, 0x166bb7f0435c9e71_ulint },
+  { 0xdaa16406f5a40000_ulint, 0x1c06a5ec5433c60d_ulint },
+  { 0xa8a4de8459868000_ulint, 0x118427b3b4a05bc8_ulint },
+  { 0xd2ce16256fe82000_ulint, 0x15e531a0a1c872ba_ulint },
+  { 0x87819baecbe22800_ulint, 0x1b5e7e08ca3a8f69_ulint },
+  { 0xf4b1014d3f6d5900_ulint, 0x111b0ec57e6499a1_ulint },
+  { 0x71dd41a08f48af40_ulint, 0x1561d276ddfdc00a_ulint },
+  { 0x0e549208b31adb10_ulint, 0x1aba4714957d300d_ulint },
+  { 0x28f4db456ff0c8ea_ulint, 0x10b46c6cdd6e3e08_ulint },
+  { 0x33321216cbecfb24_ulint, 0x14e1878814c9cd8a_ulint },
+  { 0xbffe969c7ee839ed_ulint, 0x1a19e96a19fc40ec_ulint },
+  { 0xf7ff1e21cf512434_ulint, 0x105031e2503da893_ulint },
+  { 0xf5fee5aa43256d41_ulint, 0x14643e5ae44d12b8_ulint },
+  { 0x337e9f14d3eec892_ulint, 0x197d4df19d605767_ulint },
+  { 0x005e46da08ea7ab6_ulint, 0x1fdca16e04b86d41_ulint },
+  { 0xa03aec4845928cb2_ulint, 0x13e9e4e4c2f34448_ulint },
+  { 0xc849a75a56f72fde_ulint, 0x18e45e1df3b0155a_ulint },
+  { 0x7a5c1130ecb4fbd6_ulint, 0x1f1d75a5709c1ab1_ulint },
+  { 0xec798abe93f11d65_ulint, 0x13726987666190ae_ulint },
+  { 0xa797ed6e38ed64bf_ulint, 0x184f03e93ff9f4da_ulint },
+  { 0x517de8c9c728bdef_ulint, 0x1e62c4e38ff87211_ulint },
+  { 0xd2eeb17e1c7976b5_ulint, 0x12fdbb0e39fb474a_ulint },
+  { 0x87aa5ddda397d462_ulint, 0x17bd29d1c87a191d_ulint },
+  { 0xe994f5550c7dc97b_ulint, 0x1dac74463a989f64_ulint },
+  { 0x11fd195527ce9ded_ulint, 0x128bc8abe49f639f_ulint },
+  { 0xd67c5faa71c24568_ulint, 0x172ebad6ddc73c86_ulint },
+  { 0x8c1b77950e32d6c2_ulint, 0x1cfa698c95390ba8_ulint },
+  { 0x57912abd28dfc639_ulint, 0x121c81f7dd43a749_ulint },
+  { 0xad75756c7317b7c8_ulint, 0x16a3a275d494911b_ulint },
+  { 0x98d2d2c78fdda5ba_ulint, 0x1c4c8b1349b9b562_ulint },
+  { 0x9f83c3bcb9ea8794_ulint, 0x11afd6ec0e14115d_ulint },
+  { 0x0764b4abe8652979_ulint, 0x161bcca7119915b5_ulint },
+  { 0x493de1d6e27e73d7_ulint, 0x1ba2bfd0d5ff5b22_ulint },
+  { 0x6dc6ad264d8f0866_ulint, 0x1145b7e285bf98f5_ulint },
+  { 0xc938586fe0f2ca80_ulint, 0x159725db272f7f32_ulint },
+  { 0x7b866e8bd92f7d20_ulint, 0x1afcef51f0fb5eff_ulint },
+  { 0xad34051767bdae34_ulint, 0x10de1593369d1b5f_ulint },
+  { 0x9881065d41ad19c1_ulint, 0x15159af804446237_ulint },
+  { 0x7ea147f492186032_ulint, 0x1a5b01b605557ac5_ulint },
+  { 0x6f24ccf8db4f3c1f_ulint, 0x1078e111c3556cbb_ulint },
+  { 0x4aee003712230b27_ulint, 0x14971956342ac7ea_ulint },
+  { 0xdda98044d6abcdf0_ulint, 0x19bcdfabc13579e4_ulint },
+  { 0x0a89f02b062b60b6_ulint, 0x10160bcb58c16c2f_ulint },
+  { 0xcd2c6c35c7b638e4_ulint, 0x141b8ebe2ef1c73a_ulint },
+  { 0x8077874339a3c71d_ulint, 0x1922726dbaae3909_ulint },
+  { 0xe0956914080cb8e4_ulint, 0x1f6b0f092959c74b_ulint },
+  { 0x6c5d61ac8507f38e_ulint, 0x13a2e965b9d81c8f_ulint },
+  { 0x4774ba17a649f072_ulint, 0x188ba3bf284e23b3_ulint },
+  { 0x1951e89d8fdc6c8f_ulint, 0x1eae8caef261aca0_ulint },
+  { 0x0fd3316279e9c3d9_ulint, 0x132d17ed577d0be4_ulint },
+  { 0x13c7fdbb186434cf_ulint, 0x17f85de8ad5c4edd_ulint },
+  { 0x58b9fd29de7d4203_ulint, 0x1df67562d8b36294_ulint },
+  { 0xb7743e3a2b0e4942_ulint, 0x12ba095dc7701d9c_ulint },
+  { 0xe5514dc8b5d1db92_ulint, 0x17688bb5394c2503_ulint },
+  { 0xdea5a13ae3465277_ulint, 0x1d42aea2879f2e44_ulint },
+  { 0x0b2784c4ce0bf38a_ulint, 0x1249ad2594c37ceb_ulint },
+  { 0xcdf165f6018ef06d_ulint, 0x16dc186ef9f45c25_ulint },
+  { 0x416dbf7381f2ac88_ulint, 0x1c931e8ab871732f_ulint },
+  { 0x88e497a83137abd5_ulint, 0x11dbf316b346e7fd_ulint },
+  { 0xeb1dbd923d8596ca_ulint, 0x1652efdc6018a1fc_ulint },
+  { 0x25e52cf6cce6fc7d_ulint, 0x1be7abd3781eca7c_ulint },
+  { 0x97af3c1a40105dce_ulint, 0x1170cb642b133e8d_ulint },
+  { 0xfd9b0b20d0147542_ulint, 0x15ccfe3d35d80e30_ulint },
+  { 0x3d01cde904199292_ulint, 0x1b403dcc834e11bd_ulint },
+  { 0x462120b1a28ffb9b_ulint, 0x1108269fd210cb16_ulint },
+  { 0xd7a968de0b33fa82_ulint, 0x154a3047c694fddb_ulint },
+  { 0xcd93c3158e00f923_ulint, 0x1a9cbc59b83a3d52_ulint },
+  { 0xc07c59ed78c09bb6_ulint, 0x10a1f5b813246653_ulint },
+  { 0xb09b7068d6f0c2a3_ulint, 0x14ca732617ed7fe8_ulint },
+  { 0xdcc24c830cacf34c_ulint, 0x19fd0fef9de8dfe2_ulint },
+  { 0xc9f96fd1e7ec180f_ulint, 0x103e29f5c2b18bed_ulint },
+  { 0x3c77cbc661e71e13_ulint, 0x144db473335deee9_ulint },
+  { 0x8b95beb7fa60e598_ulint, 0x1961219000356aa3_ulint },
+  { 0x6e7b2e65f8f91efe_ulint, 0x1fb969f40042c54c_ulint },
+  { 0xc50cfcffbb9bb35f_ulint, 0x13d3e2388029bb4f_ulint },
+  { 0xb6503c3faa82a037_ulint, 0x18c8dac6a0342a23_ulint },
+  { 0xa3e44b4f95234844_ulint, 0x1efb1178484134ac_ulint },
+  { 0xe66eaf11bd360d2b_ulint, 0x135ceaeb2d28c0eb_ulint },
+  { 0xe00a5ad62c839075_ulint, 0x183425a5f872f126_ulint },
+  { 0x980cf18bb7a47493_ulint, 0x1e412f0f768fad70_ulint },
+  { 0x5f0816f752c6c8dc_ulint, 0x12e8bd69aa19cc66_ulint },
+  { 0xf6ca1cb527787b13_ulint, 0x17a2ecc414a03f7f_ulint },
+  { 0xf47ca3e2715699d7_ulint, 0x1d8ba7f519c84f5f_ulint },
+  { 0xf8cde66d86d62026_ulint, 0x127748f9301d319b_ulint },
+  { 0xf7016008e88ba830_ulint, 0x17151b377c247e02_ulint },
+  { 0xb4c1b80b22ae923c_ulint, 0x1cda62055b2d9d83_ulint },
+  { 0x50f91306f5ad1b65_ulint, 0x12087d4358fc8272_ulint },
+  { 0xe53757c8b318623f_ulint, 0x168a9c942f3ba30e_ulint },
+  { 0x9e852dbadfde7acf_ulint, 0x1c2d43b93b0a8bd2_ulint },
+  { 0xa3133c94cbeb0cc1_ulint, 0x119c4a53c4e69763_ulint },
+  { 0x8bd80bb9fee5cff1_ulint, 0x16035ce8b6203d3c_ulint },
+  { 0xaece0ea87e9f43ee_ulint, 0x1b843422e3a84c8b_ulint },
+  { 0x4d40c9294f238a75_ulint, 0x1132a095ce492fd7_ulint },
+  { 0x2090fb73a2ec6d12_ulint, 0x157f48bb41db7bcd_ulint },
+  { 0x68b53a508ba78856_ulint, 0x1adf1aea12525ac0_ulint },
+  { 0x417144725748b536_ulint, 0x10cb70d24b7378b8_ulint },
+  { 0x51cd958eed1ae283_ulint, 0x14fe4d06de5056e6_ulint },
+  { 0xe640faf2a8619b24_ulint, 0x1a3de04895e46c9f_ulint },
+  { 0xefe89cd7a93d00f7_ulint, 0x1066ac2d5daec3e3_ulint },
+  { 0xebe2c40d938c4134_ulint, 0x14805738b51a74dc_ulint },
+  { 0x26db7510f86f5181_ulint, 0x19a06d06e2611214_ulint },
+  { 0x9849292a9b4592f1_ulint, 0x100444244d7cab4c_ulint },
+  { 0xbe5b73754216f7ad_ulint, 0x1405552d60dbd61f_ulint },
+  { 0xadf25052929cb598_ulint, 0x1906aa78b912cba7_ulint },
+  { 0x996ee4673743e2ff_ulint, 0x1f485516e7577e91_ulint },
+  { 0xffe54ec0828a6ddf_ulint, 0x138d352e5096af1a_ulint },
+  { 0xbfdea270a32d0957_ulint, 0x18708279e4bc5ae1_ulint },
+  { 0x2fd64b0ccbf84bad_ulint, 0x1e8ca3185deb719a_ulint },
+  { 0x5de5eee7ff7b2f4c_ulint, 0x1317e5ef3ab32700_ulint },
+  { 0x755f6aa1ff59fb1f_ulint, 0x17dddf6b095ff0c0_ulint },
+  { 0x92b7454a7f3079e7_ulint, 0x1dd55745cbb7ecf0_ulint },
+  { 0x5bb28b4e8f7e4c30_ulint, 0x12a5568b9f52f416_ulint },
+  { 0xf29f2e22335ddf3c_ulint, 0x174eac2e8727b11b_ulint },
+  { 0xef46f9aac035570b_ulint, 0x1d22573a28f19d62_ulint },
+  { 0xd58c5c0ab8215667_ulint, 0x123576845997025d_ulint },
+  { 0x4aef730d6629ac01_ulint, 0x16c2d4256ffcc2f5_ulint },
+  { 0x9dab4fd0bfb41701_ulint, 0x1c73892ecbfbf3b2_ulint },
+  { 0xa28b11e277d08e60_ulint, 0x11c835bd3f7d784f_ulint },
+  { 0x8b2dd65b15c4b1f9_ulint, 0x163a432c8f5cd663_ulint },
+  { 0x6df94bf1db35de77_ulint, 0x1bc8d3f7b3340bfc_ulint },
+  { 0xc4bbcf772901ab0a_ulint, 0x115d847ad000877d_ulint },
+  { 0x35eac354f34215cd_ulint, 0x15b4e5998400a95d_ulint },
+  { 0x8365742a30129b40_ulint, 0x1b221effe500d3b4_ulint },
+  { 0xd21f689a5e0ba108_ulint, 0x10f5535fef208450_ulint },
+  { 0x06a742c0f58e894a_ulint, 0x1532a837eae8a565_ulint },
+  { 0x4851137132f22b9d_ulint, 0x1a7f5245e5a2cebe_ulint },
+  { 0xed32ac26bfd75b42_ulint, 0x108f936baf85c136_ulint },
+  { 0xa87f57306fcd3212_ulint, 0x14b378469b673184_ulint },
+  { 0xd29f2cfc8bc07e97_ulint, 0x19e056584240fde5_ulint },
+  { 0xa3a37c1dd7584f1e_ulint, 0x102c35f729689eaf_ulint },
+  { 0x8c8c5b254d2e62e6_ulint, 0x14374374f3c2c65b_ulint },
+  { 0x6faf71eea079fb9f_ulint, 0x1945145230b377f2_ulint },
+  { 0x0b9b4e6a48987a87_ulint, 0x1f965966bce055ef_ulint },
+  { 0x674111026d5f4c94_ulint, 0x13bdf7e0360c35b5_ulint },
+  { 0xc111554308b71fba_ulint, 0x18ad75d8438f4322_ulint },
+  { 0x7155aa93cae4e7a8_ulint, 0x1ed8d34e547313eb_ulint },
+  { 0x26d58a9c5ecf10c9_ulint, 0x13478410f4c7ec73_ulint },
+  { 0xf08aed437682d4fb_ulint, 0x1819651531f9e78f_ulint },
+  { 0xecada89454238a3a_ulint, 0x1e1fbe5a7e786173_ulint },
+  { 0x73ec895cb4963664_ulint, 0x12d3d6f88f0b3ce8_ulint },
+  { 0x90e7abb3e1bbc3fd_ulint, 0x1788ccb6b2ce0c22_ulint },
+  { 0x352196a0da2ab4fd_ulint, 0x1d6affe45f818f2b_ulint },
+  { 0x0134fe24885ab11e_ulint, 0x1262dfeebbb0f97b_ulint },
+  { 0xc1823dadaa715d65_ulint, 0x16fb97ea6a9d37d9_ulint },
+  { 0x31e2cd19150db4bf_ulint, 0x1cba7de5054485d0_ulint },
+  { 0x1f2dc02fad2890f7_ulint, 0x11f48eaf234ad3a2_ulint },
+  { 0xa6f9303b9872b535_ulint, 0x1671b25aec1d888a_ulint },
+  { 0x50b77c4a7e8f6282_ulint, 0x1c0e1ef1a724eaad_ulint },
+  { 0x5272adae8f199d91_ulint, 0x1188d357087712ac_ulint },
+  { 0x670f591a32e004f6_ulint, 0x15eb082cca94d757_ulint },
+  { 0x40d32f60bf980633_ulint, 0x1b65ca37fd3a0d2d_ulint },
+  { 0x4883fd9c77bf03e0_ulint, 0x111f9e62fe44483c_ulint },
+  { 0x5aa4fd0395aec4d8_ulint, 0x156785fbbdd55a4b_ulint },
+  { 0x314e3c447b1a760e_ulint, 0x1ac1677aad4ab0de_ulint },
+  { 0xded0e5aaccf089c9_ulint, 0x10b8e0acac4eae8a_ulint },
+  { 0x96851f15802cac3b_ulint, 0x14e718d7d7625a2d_ulint },
+  { 0xfc2666dae037d74a_ulint, 0x1a20df0dcd3af0b8_ulint },
+  { 0x9d980048cc22e68e_ulint, 0x10548b68a044d673_ulint },
+  { 0x84fe005aff2ba032_ulint, 0x1469ae42c8560c10_ulint },
+  { 0xa63d8071bef6883e_ulint, 0x198419d37a6b8f14_ulint },
+  { 0xcfcce08e2eb42a4e_ulint, 0x1fe52048590672d9_ulint },
+  { 0x21e00c58dd309a70_ulint, 0x13ef342d37a407c8_ulint },
+  { 0x2a580f6f147cc10d_ulint, 0x18eb0138858d09ba_ulint },
+  { 0xb4ee134ad99bf150_ulint, 0x1f25c186a6f04c28_ulint },
+  { 0x7114cc0ec80176d2_ulint, 0x137798f428562f99_ulint },
+  { 0xcd59ff127a01d486_ulint, 0x18557f31326bbb7f_ulint },
+  { 0xc0b07ed7188249a8_ulint, 0x1e6adefd7f06aa5f_ulint },
+  { 0xd86e4f466f516e09_ulint, 0x1302cb5e6f642a7b_ulint },
+  { 0xce89e3180b25c98b_ulint, 0x17c37e360b3d351a_ulint },
+  { 0x822c5bde0def3bee_ulint, 0x1db45dc38e0c8261_ulint },
+  { 0xf15bb96ac8b58575_ulint, 0x1290ba9a38c7d17c_ulint },
+  { 0x2db2a7c57ae2e6d2_ulint, 0x1734e940c6f9c5dc_ulint },
+  { 0x391f51b6d99ba086_ulint, 0x1d022390f8b83753_ulint },
+  { 0x03b3931248014454_ulint, 0x1221563a9b732294_ulint },
+  { 0x04a077d6da019569_ulint, 0x16a9abc9424feb39_ulint },
+  { 0x45c895cc9081fac3_ulint, 0x1c5416bb92e3e607_ulint },
+  { 0x8b9d5d9fda513cba_ulint, 0x11b48e353bce6fc4_ulint },
+  { 0xae84b507d0e58be8_ulint, 0x1621b1c28ac20bb5_ulint },
+  { 0x1a25e249c51eeee3_ulint, 0x1baa1e332d728ea3_ulint },
+  { 0xf057ad6e1b33554d_ulint, 0x114a52dffc679925_ulint },
+  { 0x6c6d98c9a2002aa1_ulint, 0x159ce797fb817f6f_ulint },
+  { 0x4788fefc0a803549_ulint, 0x1b04217dfa61df4b_ulint },
+  { 0x0cb59f5d8690214e_ulint, 0x10e294eebc7d2b8f_ulint },
+  { 0xcfe30734e83429a1_ulint, 0x151b3a2a6b9c7672_ulint },
+  { 0x83dbc9022241340a_ulint, 0x1a6208b50683940f_ulint },
+  { 0xb2695da15568c086_ulint, 0x107d457124123c89_ulint },
+  { 0x1f03b509aac2f0a7_ulint, 0x149c96cd6d16cbac_ulint },
+  { 0x26c4a24c1573acd1_ulint, 0x19c3bc80c85c7e97_ulint },
+  { 0x783ae56f8d684c03_ulint, 0x101a55d07d39cf1e_ulint },
+  { 0x16499ecb70c25f03_ulint, 0x1420eb449c8842e6_ulint },
+  { 0x9bdc067e4cf2f6c4_ulint, 0x19292615c3aa539f_ulint },
+  { 0x82d3081de02fb476_ulint, 0x1f736f9b3494e887_ulint },
+  { 0xb1c3e512ac1dd0c9_ulint, 0x13a825c100dd1154_ulint },
+  { 0xde34de57572544fc_ulint, 0x18922f31411455a9_ulint },
+  { 0x55c215ed2cee963b_ulint, 0x1eb6bafd91596b14_ulint },
+  { 0xb5994db43c151de5_ulint, 0x133234de7ad7e2ec_ulint },
+  { 0xe2ffa1214b1a655e_ulint, 0x17fec216198ddba7_ulint },
+  { 0xdbbf89699de0feb6_ulint, 0x1dfe729b9ff15291_ulint },
+  { 0x2957b5e202ac9f31_ulint, 0x12bf07a143f6d39b_ulint },
+  { 0xf3ada35a8357c6fe_ulint, 0x176ec98994f48881_ulint },
+  { 0x70990c31242db8bd_ulint, 0x1d4a7bebfa31aaa2_ulint },
+  { 0x865fa79eb69c9376_ulint, 0x124e8d737c5f0aa5_ulint },
+  { 0xe7f791866443b854_ulint, 0x16e230d05b76cd4e_ulint },
+  { 0xa1f575e7fd54a669_ulint, 0x1c9abd04725480a2_ulint },
+  { 0xa53969b0fe54e801_ulint, 0x11e0b622c774d065_ulint },
+  { 0x0e87c41d3dea2202_ulint, 0x1658e3ab7952047f_ulint },
+  { 0xd229b5248d64aa82_ulint, 0x1bef1c9657a6859e_ulint },
+  { 0x435a1136d85eea91_ulint, 0x117571ddf6c81383_ulint },
+  { 0x143095848e76a536_ulint, 0x15d2ce55747a1864_ulint },
+  { 0x193cbae5b2144e83_ulint, 0x1b4781ead1989e7d_ulint },
+  { 0x2fc5f4cf8f4cb112_ulint, 0x110cb132c2ff630e_ulint },
+  { 0xbbb77203731fdd56_ulint, 0x154fdd7f73bf3bd1_ulint },
+  { 0x2aa54e844fe7d4ac_ulint, 0x1aa3d4df50af0ac6_ulint },
+  { 0xdaa75112b1f0e4eb_ulint, 0x10a6650b926d66bb_ulint },
+  { 0xd15125575e6d1e26_ulint, 0x14cffe4e7708c06a_ulint },
+  { 0x85a56ead360865b0_ulint, 0x1a03fde214caf085_ulint },
+  { 0x7387652c41c53f8e_ulint, 0x10427ead4cfed653_ulint },
+  { 0x50693e7752368f71_ulint, 0x14531e58a03e8be8_ulint },
+  { 0x64838e1526c4334e_ulint, 0x1967e5eec84e2ee2_ulint },
+  { 0xfda4719a70754022_ulint, 0x1fc1df6a7a61ba9a_ulint },
+  { 0xde86c70086494815_ulint, 0x13d92ba28c7d14a0_ulint },
+  { 0x162878c0a7db9a1a_ulint, 0x18cf768b2f9c59c9_ulint },
+  { 0x5bb296f0d1d280a1_ulint, 0x1f03542dfb83703b_ulint },
+  { 0x194f9e5683239064_ulint, 0x1362149cbd322625_ulint },
+  { 0x5fa385ec23ec747e_ulint, 0x183a99c3ec7eafae_ulint },
+  { 0xf78c67672ce7919d_ulint, 0x1e494034e79e5b99_ulint },
+  { 0x3ab7c0a07c10bb02_ulint, 0x12edc82110c2f940_ulint },
+  { 0x4965b0c89b14e9c3_ulint, 0x17a93a2954f3b790_ulint },
+  { 0x5bbf1cfac1da2433_ulint, 0x1d9388b3aa30a574_ulint },
+  { 0xb957721cb92856a0_ulint, 0x127c35704a5e6768_ulint },
+  { 0xe7ad4ea3e7726c48_ulint, 0x171b42cc5cf60142_ulint },
+  { 0xa198a24ce14f075a_ulint, 0x1ce2137f74338193_ulint },
+  { 0x44ff65700cd16498_ulint, 0x120d4c2fa8a030fc_ulint },
+  { 0x563f3ecc1005bdbe_ulint, 0x16909f3b92c83d3b_ulint },
+  { 0x2bcf0e7f14072d2e_ulint, 0x1c34c70a777a4c8a_ulint },
+  { 0x5b61690f6c847c3d_ulint, 0x11a0fc668aac6fd6_ulint },
+  { 0xf239c35347a59b4c_ulint, 0x16093b802d578bcb_ulint },
+  { 0xeec83428198f021f_ulint, 0x1b8b8a6038ad6ebe_ulint },
+  { 0x553d20990ff96153_ulint, 0x1137367c236c6537_ulint },
+  { 0x2a8c68bf53f7b9a8_ulint, 0x1585041b2c477e85_ulint },
+  { 0x752f82ef28f5a812_ulint, 0x1ae64521f7595e26_ulint },
+  { 0x093db1d57999890b_ulint, 0x10cfeb353a97dad8_ulint },
+  { 0x0b8d1e4ad7ffeb4e_ulint, 0x1503e602893dd18e_ulint },
+  { 0x8e7065dd8dffe622_ulint, 0x1a44df832b8d45f1_ulint },
+  { 0xf9063faa78bfefd5_ulint, 0x106b0bb1fb384bb6_ulint },
+  { 0xb747cf9516efebca_ulint, 0x1485ce9e7a065ea4_ulint },
+  { 0xe519c37a5cabe6bd_ulint, 0x19a742461887f64d_ulint },
+  { 0xaf301a2c79eb7036_ulint, 0x1008896bcf54f9f0_ulint },
+  { 0xdafc20b798664c43_ulint, 0x140aabc6c32a386c_ulint },
+  { 0x11bb28e57e7fdf54_ulint, 0x190d56b873f4c688_ulint },
+  { 0x1629f31ede1fd72a_ulint, 0x1f50ac6690f1f82a_ulint },
+  { 0x4dda37f34ad3e67a_ulint, 0x13926bc01a973b1a_ulint },
+  { 0xe150c5f01d88e019_ulint, 0x187706b0213d09e0_ulint },
+  { 0x19a4f76c24eb181f_ulint, 0x1e94c85c298c4c59_ulint },
+  { 0xb0071aa39712ef13_ulint, 0x131cfd3999f7afb7_ulint },
+  { 0x9c08e14c7cd7aad8_ulint, 0x17e43c8800759ba5_ulint },
+  { 0x030b199f9c0d958e_ulint, 0x1ddd4baa0093028f_ulint },
+  { 0x61e6f003c1887d79_ulint, 0x12aa4f4a405be199_ulint },
+  { 0xba60ac04b1ea9cd7_ulint, 0x1754e31cd072d9ff_ulint },
+  { 0xa8f8d705de65440d_ulint, 0x1d2a1be4048f907f_ulint },
+  { 0xc99b8663aaff4a88_ulint, 0x123a516e82d9ba4f_ulint },
+  { 0xbc0267fc95bf1d2a_ulint, 0x16c8e5ca239028e3_ulint },
+  { 0xab0301fbbb2ee474_ulint, 0x1c7b1f3cac74331c_ulint },
+  { 0xeae1e13d54fd4ec9_ulint, 0x11ccf385ebc89ff1_ulint },
+  { 0x659a598caa3ca27b_ulint, 0x1640306766bac7ee_ulint },
+  { 0xff00efefd4cbcb1a_ulint, 0x1bd03c81406979e9_ulint },
+  { 0x3f6095f5e4ff5ef0_ulint, 0x116225d0c841ec32_ulint },
+  { 0xcf38bb735e3f36ac_ulint, 0x15baaf44fa52673e_ulint },
+  { 0x8306ea5035cf0457_ulint, 0x1b295b1638e7010e_ulint },
+  { 0x11e4527221a162b6_ulint, 0x10f9d8ede39060a9_ulint },
+  { 0x565d670eaa09bb64_ulint, 0x15384f295c7478d3_ulint },
+  { 0x2bf4c0d2548c2a3d_ulint, 0x1a8662f3b3919708_ulint },
+  { 0x1b78f88374d79a66_ulint, 0x1093fdd8503afe65_ulint },
+  { 0x625736a4520d8100_ulint, 0x14b8fd4e6449bdfe_ulint },
+  { 0xfaed044d6690e140_ulint, 0x19e73ca1fd5c2d7d_ulint },
+  { 0xbcd422b0601a8cc8_ulint, 0x103085e53e599c6e_ulint },
+  { 0x6c092b5c78212ffa_ulint, 0x143ca75e8df0038a_ulint },
+  { 0x070b763396297bf8_ulint, 0x194bd136316c046d_ulint },
+  { 0x48ce53c07bb3daf6_ulint, 0x1f9ec583bdc70588_ulint },
+  { 0x2d80f4584d5068da_ulint, 0x13c33b72569c6375_ulint },
+  { 0x78e1316e60a48310_ulint, 0x18b40a4eec437c52_ulint }
+};
+
+
+static const ulint  POW5_INV_SPLIT_[342][2] =
+{
+  { 0x0000000000000001_ulint, 0x2000000000000000_ulint },
+  { 0x999999999999999a_ulint, 0x1999999999999999_ulint },
+  { 0x47ae147ae147ae15_ulint, 0x147ae147ae147ae1_ulint },
+  { 0x6c8b4395810624de_ulint, 0x10624dd2f1a9fbe7_ulint },
+  { 0x7a786c226809d496_ulint, 0x1a36e2eb1c432ca5_ulint },
+  { 0x61f9f01b866e43ab_ulint, 0x14f8b588e368f084_ulint },
+  { 0xb4c7f34938583622_ulint, 0x10c6f7a0b5ed8d36_ulint },
+  { 0x87a6520ec08d236a_ulint, 0x1ad7f29abcaf4857_ulint },
+  { 0x9fb841a566d74f88_ulint, 0x15798ee2308c39df_ulint },
+  { 0xe62d01511f12a607_ulint, 0x112e0be826d694b2_ulint },
+  { 0xd6ae6881cb5109a4_ulint, 0x1b7cdfd9d7bdbab7_ulint },
+  { 0xdef1ed34a2a73aea_ulint, 0x15fd7fe17964955f_ulint },
+  { 0x7f27f0f6e885c8bb_ulint, 0x119799812dea1119_ulint },
+  { 0x650cb4be40d60df8_ulint, 0x1c25c268497681c2_ulint },
+  { 0xea70909833de7193_ulint, 0x16849b86a12b9b01_ulint },
+  { 0x21f3a6e0297ec143_ulint, 0x1203af9ee756159b_ulint },
+  { 0x6985d7cd0f313537_ulint, 0x1cd2b297d889bc2b_ulint },
+  { 0x2137dfd73f5a90f9_ulint, 0x170ef54646d49689_ulint },
+  { 0xe75fe645cc4873fa_ulint, 0x12725dd1d243aba0_ulint },
+  { 0xa5663d3c7a0d865d_ulint, 0x1d83c94fb6d2ac34_ulint },
+  { 0x511e976394d79eb1_ulint, 0x179ca10c9242235d_ulint },
+  { 0xda7edf82dd794bc1_ulint, 0x12e3b40a0e9b4f7d_ulint },
+  { 0x2a6498d1625bac68_ulint, 0x1e392010175ee596_ulint },
+  { 0xeeb6e0a781e2f053_ulint, 0x182db34012b25144_ulint },
+  { 0x58924d52ce4f26a9_ulint, 0x1357c299a88ea76a_ulint },
+  { 0x27507bb7b07ea441_ulint, 0x1ef2d0f5da7dd8aa_ulint },
+  { 0x52a6c95fc0655034_ulint, 0x18c240c4aecb13bb_ulint },
+  { 0x0eebd44c99eaa690_ulint, 0x13ce9a36f23c0fc9_ulint },
+  { 0xb17953adc3110a80_ulint, 0x1fb0f6be50601941_ulint },
+  { 0xc12ddc8b02740867_ulint, 0x195a5efea6b34767_ulint },
+  { 0x3424b06f3529a052_ulint, 0x14484bfeebc29f86_ulint },
+  { 0x901d59f290ee19db_ulint, 0x1039d66589687f9e_ulint },
+  { 0x4cfbc31db4b0295f_ulint, 0x19f623d5a8a73297_ulint },
+  { 0x3d9635b15d59bab2_ulint, 0x14c4e977ba1f5bac_ulint },
+  { 0x97ab5e277de16228_ulint, 0x109d8792fb4c4956_ulint },
+  { 0xf2abc9d8c9689d0d_ulint, 0x1a95a5b7f87a0ef0_ulint },
+  { 0x5bbca17a3aba173e_ulint, 0x154484932d2e725a_ulint },
+  { 0xafca1ac82efb45cb_ulint, 0x11039d428a8b8eae_ulint },
+  { 0xb2dcf7a6b1920945_ulint, 0x1b38fb9daa78e44a_ulint },
+  { 0xf57d92ebc141a104_ulint, 0x15c72fb1552d836e_ulint },
+  { 0xc46475896767b403_ulint, 0x116c262777579c58_ulint },
+  { 0x6d6d88dbd8a5ecd2_ulint, 0x1be03d0bf225c6f4_ulint },
+  { 0x8abe071646eb23db_ulint, 0x164cfda3281e38c3_ulint },
+  { 0x6efe6c11d255b649_ulint, 0x11d7314f534b609c_ulint },
+  { 0xb197134fb6ef8a0e_ulint, 0x1c8b821885456760_ulint },
+  { 0x27ac0f72f8bfa1a5_ulint, 0x16d601ad376ab91a_ulint },
+  { 0xb95672c260994e1e_ulint, 0x1244ce242c5560e1_ulint },
+  { 0xf5571e03cdc21695_ulint, 0x1d3ae36d13bbce35_ulint },
+  { 0x2aac18030b01abab_ulint, 0x17624f8a762fd82b_ulint },
+  { 0xbbbce0026f348956_ulint, 0x12b50c6ec4f31355_ulint },
+  { 0x92c7ccd0b1eda889_ulint, 0x1dee7a4ad4b81eef_ulint },
+  { 0xdbd30a408e57ba07_ulint, 0x17f1fb6f10934bf2_ulint },
+  { 0x7ca8d50071dfc806_ulint, 0x1327fc58da0f6ff5_ulint },
+  { 0xfaa7bb33e9660cd6_ulint, 0x1ea6608e29b24cbb_ulint },
+  { 0x9552fc298784d711_ulint, 0x18851a0b548ea3c9_ulint },
+  { 0xaaa8c9bad2d0ac0e_ulint, 0x139dae6f76d88307_ulint },
+  { 0xdddadc5e1e1aace3_ulint, 0x1f62b0b257c0d1a5_ulint },
+  { 0x7e48b04b4b488a4f_ulint, 0x191bc08eac9a4151_ulint },
+  { 0xcb6d59d5d5d3a1d9_ulint, 0x141633a556e1cdda_ulint },
+  { 0x3c577b1177dc817b_ulint, 0x1011c2eaabe7d7e2_ulint },
+  { 0xc6f25e825960cf2a_ulint, 0x19b604aaaca62636_ulint },
+  { 0x6bf518684780a5bb_ulint, 0x14919d5556eb51c5_ulint },
+  { 0x232a79ed06008496_ulint, 0x10747ddddf22a7d1_ulint },
+  { 0xd1dd8fe1a3340756_ulint, 0x1a53fc9631d10c81_ulint },
+  { 0xa7e4731ae8f66c45_ulint, 0x150ffd44f4a73d34_ulint },
+  { 0x531d28e253f8569e_ulint, 0x10d9976a5d52975d_ulint },
+  { 0xeb61db03b98d5762_ulint, 0x1af5bf109550f22e_ulint },
+  { 0xbc4e48cfc7a445e8_ulint, 0x159165a6ddda5b58_ulint },
+  { 0x6371d3d96c836b20_ulint, 0x11411e1f17e1e2ad_ulint },
+  { 0x9f1c8628ad9f11cd_ulint, 0x1b9b6364f3030448_ulint },
+  { 0xe5b06b53be18db0b_ulint, 0x1615e91d8f359d06_ulint },
+  { 0xeaf3890fcb4715a2_ulint, 0x11ab20e472914a6b_ulint },
+  { 0x44b8db4c7871bc37_ulint, 0x1c45016d841baa46_ulint },
+  { 0x03c715d6c6c1635f_ulint, 0x169d9abe03495505_ulint },
+  { 0x3638de456bcde919_ulint, 0x1217aefe69077737_ulint },
+  { 0x56c163a2461641c1_ulint, 0x1cf2b1970e725858_ulint },
+  { 0xdf011c81d1ab67ce_ulint, 0x17288e1271f51379_ulint },
+  { 0x7f3416ce4155eca5_ulint, 0x1286d80ec190dc61_ulint },
+  { 0x6520247d3556476e_ulint, 0x1da48ce468e7c702_ulint },
+  { 0xea801d30f7783925_ulint, 0x17b6d71d20b96c01_ulint },
+  { 0xbb99b0f3f92cfa84_ulint, 0x12f8ac174d612334_ulint },
+  { 0x5f5c4e532847f739_ulint, 0x1e5aacf215683854_ulint },
+  { 0x7f7d0b75b9d32c2e_ulint, 0x18488a5b44536043_ulint },
+  { 0x9930d5f7c7dc2358_ulint, 0x136d3b7c36a919cf_ulint },
+  { 0x8eb4898c72f9d226_ulint, 0x1f152bf9f10e8fb2_ulint },
+  { 0x722a07a38f2e41b8_ulint, 0x18ddbcc7f40ba628_ulint },
+  { 0xc1bb394fa5be9afa_ulint, 0x13e497065cd61e86_ulint },
+  { 0x9c5ec2190930f7f6_ulint, 0x1fd424d6faf030d7_ulint },
+  { 0x49e56814075a5ff8_ulint, 0x197683df2f268d79_ulint },
+  { 0x6e51201005e1e660_ulint, 0x145ecfe5bf520ac7_ulint },
+  { 0xf1da800cd181851a_ulint, 0x104bd984990e6f05_ulint },
+  { 0x4fc400148268d4f5_ulint, 0x1a12f5a0f4e3e4d6_ulint },
+  { 0xd96999aa01ed772b_ulint, 0x14dbf7b3f71cb711_ulint },
+  { 0xadee1488018ac5bc_ulint, 0x10aff95cc5b09274_ulint },
+  { 0x497ceda668de092c_ulint, 0x1ab328946f80ea54_ulint },
+  { 0x3aca57b853e4d424_ulint, 0x155c2076bf9a5510_ulint },
+  { 0x623b7960431d7683_ulint, 0x1116805effaeaa73_ulint },
+  { 0x9d2bf566d1c8bd9e_ulint, 0x1b5733cb32b110b8_ulint },
+  { 0x7dbcc452416d647f_ulint, 0x15df5ca28ef40d60_ulint },
+  { 0xcafd69db678ab6cc_ulint, 0x117f7d4ed8c33de6_ulint },
+  { 0xab2f0fc572778adf_ulint, 0x1bff2ee48e052fd7_ulint },
+  { 0x88f273045b92d580_ulint, 0x1665bf1d3e6a8cac_ulint },
+  { 0xd3f528d049424466_ulint, 0x11eaff4a98553d56_ulint },
+  { 0xb988414d4203a0a3_ulint, 0x1cab3210f3bb9557_ulint },
+  { 0x6139cdd76802e6e9_ulint, 0x16ef5b40c2fc7779_ulint },
+  { 0xe761717920025254_ulint, 0x125915cd68c9f92d_ulint },
+  { 0xa568b58e999d5086_ulint, 0x1d5b561574765b7c_ulint },
+  { 0x5120913ee14aa6d2_ulint, 0x177c44ddf6c515fd_ulint },
+  { 0xa74d40ff1aa21f0e_ulint, 0x12c9d0b1923744ca_ulint },
+  { 0x0baece64f769cb4a_ulint, 0x1e0fb44f50586e11_ulint },
+  { 0x3c8bd850c5ee3c3b_ulint, 0x180c903f7379f1a7_ulint },
+  { 0xca0979da37f1c9c9_ulint, 0x133d4032c2c7f485_ulint },
+  { 0xa9a8c2f6bfe942db_ulint, 0x1ec866b79e0cba6f_ulint },
+  { 0x2153cf2bccba9be3_ulint, 0x18a0522c7e709526_ulint },
+  { 0x1aa9728970954982_ulint, 0x13b374f06526ddb8_ulint },
+  { 0xf775840f1a88759d_ulint, 0x1f8587e7083e2f8c_ulint },
+  { 0x5f9136727ba05e17_ulint, 0x19379fec0698260a_ulint },
+  { 0x1940f85b9619e4df_ulint, 0x142c7ff0054684d5_ulint },
+  { 0xe100c6afab47ea4c_ulint, 0x1023998cd1053710_ulint },
+  { 0xce67a44c453fdd47_ulint, 0x19d28f47b4d524e7_ulint },
+  { 0xd852e9d69dccb106_ulint, 0x14a8729fc3ddb71f_ulint },
+  { 0x79dbee454b0a2738_ulint, 0x1086c219697e2c19_ulint },
+  { 0x295fe3a211a9d859_ulint, 0x1a71368f0f30468f_ulint },
+  { 0xbab31c81a7bb137a_ulint, 0x15275ed8d8f36ba5_ulint },
+  { 0x6228e39aec95a92f_ulint, 0x10ec4be0ad8f8951_ulint },
+  { 0x9d0e38f7e0ef7517_ulint, 0x1b13ac9aaf4c0ee8_ulint },
+  { 0xb0d82d931a592a79_ulint, 0x15a956e225d67253_ulint },
+  { 0x8d79be0f4847552e_ulint, 0x11544581b7dec1dc_ulint },
+  { 0x158f967eda0bbb7c_ulint, 0x1bba08cf8c979c94_ulint },
+  { 0x77a611ff14d62f97_ulint, 0x162e6d72d6dfb076_ulint },
+  { 0xf951a7ff43de8c79_ulint, 0x11bebdf578b2f391_ulint },
+  { 0xc21c3ffed2fdad8e_ulint, 0x1c6463225ab7ec1c_ulint },
+  { 0x01b0333242648ad8_ulint, 0x16b6b5b5155ff017_ulint },
+  { 0x0159c28e9b83a246_ulint, 0x122bc490dde659ac_ulint },
+  { 0xcef604175f3903a3_ulint, 0x1d12d41afca3c2ac_ulint },
+  { 0x725e69ac4c2d9c83_ulint, 0x17424348ca1c9bbd_ulint },
+  { 0xf5185489d68ae39c_ulint, 0x129b69070816e2fd_ulint },
+  { 0xee8d540fbdab05c6_ulint, 0x1dc574d80cf16b2f_ulint },
+  { 0xbed77672fe226b05_ulint, 0x17d12a4670c1228c_ulint },
+  { 0xff12c528cb4ebc04_ulint, 0x130dbb6b8d674ed6_ulint },
+  { 0xcb513b74787df9a0_ulint, 0x1e7c5f127bd87e24_ulint },
+  { 0x090dc929f9fe614d_ulint, 0x18637f41fcad31b7_ulint },
+  { 0xa0d7d42194cb810a_ulint, 0x1382cc34ca2427c5_ulint },
+  { 0x67bfb9cf5478ce77_ulint, 0x1f37ad21436d0c6f_ulint },
+  { 0x1fcc94a5dd2d71f9_ulint, 0x18f9574dcf8a7059_ulint },
+  { 0x7fd6dd517dbdf4c7_ulint, 0x13faac3e3fa1f37a_ulint },
+  { 0xffbe2ee8c92fee0b_ulint, 0x1ff779fd329cb8c3_ulint },
+  { 0x6631bf20a0f324d6_ulint, 0x1992c7fdc216fa36_ulint },
+  { 0xb827cc1a1a5c1d78_ulint, 0x14756ccb01abfb5e_ulint },
+  { 0x935309ae7b7ce460_ulint, 0x105df0a267bcc918_ulint },
+  { 0x1eeb42b0c594a099_ulint, 0x1a2fe76a3f9474f4_ulint },
+  { 0xe58902270476e6e1_ulint, 0x14f31f8832dd2a5c_ulint },
+  { 0xb7a0ce859d2bebe7_ulint, 0x10c27fa028b0eeb0_ulint },
+  { 0x59014a6f61dfdfd8_ulint, 0x1ad0cc33744e4ab4_ulint },
+  { 0xe0cdd525e7e64cad_ulint, 0x1573d68f903ea229_ulint },
+  { 0x4d7177518651d6f1_ulint, 0x11297872d9cbb4ee_ulint },
+  { 0x7be8bee8d6e957e8_ulint, 0x1b758d848fac54b0_ulint },
+  { 0xfcba3253df211320_ulint, 0x15f7a46a0c89dd59_ulint },
+  { 0x63c8284318e74280_ulint, 0x1192e9ee706e4aae_ulint },
+  { 0x060d0d3827d86a66_ulint, 0x1c1e43171a4a1117_ulint },
+  { 0x6b3da42cecad21eb_ulint, 0x167e9c127b6e7412_ulint },
+  { 0x88fe1cf0bd574e56_ulint, 0x11fee341fc585cdb_ulint },
+  { 0x419694b462254a23_ulint, 0x1ccb0536608d615f_ulint },
+  { 0x67abaa29e81dd4e9_ulint, 0x1708d0f84d3de77f_ulint },
+  { 0xb95621bb2017dd87_ulint, 0x126d73f9d764b932_ulint },
+  { 0xc223692b668c95a5_ulint, 0x1d7becc2f23ac1ea_ulint },
+  { 0xce82ba891ed6de1d_ulint, 0x179657025b6234bb_ulint },
+  { 0xa53562074bdf1818_ulint, 0x12deac01e2b4f6fc_ulint },
+  { 0x3b889cd87964f359_ulint, 0x1e3113363787f194_ulint },
+  { 0xfc6d4a46c783f5e1_ulint, 0x18274291c6065adc_ulint },
+  { 0x30576e9f06032b1a_ulint, 0x13529ba7d19eaf17_ulint },
+  { 0x1a257dcb3cd1de90_ulint, 0x1eea92a61c311825_ulint },
+  { 0x481dfe3c30a7e540_ulint, 0x18bba884e35a79b7_ulint },
+  { 0xd34b31c9c0865100_ulint, 0x13c9539d82aec7c5_ulint },
+  { 0x5211e942cda3b4cd_ulint, 0x1fa885c8d117a609_ulint },
+  { 0x74db21023e1c90a4_ulint, 0x19539e3a40dfb807_ulint },
+  { 0xf715b401cb4a0d50_ulint, 0x1442e4fb67196005_ulint },
+  { 0xf8de299b09080aa7_ulint, 0x103583fc527ab337_ulint },
+  { 0x8e304291a80cddd7_ulint, 0x19ef3993b72ab859_ulint },
+  { 0x3e8d020e200a4b13_ulint, 0x14bf6142f8eef9e1_ulint },
+  { 0x653d9b3e80083c0f_ulint, 0x10991a9bfa58c7e7_ulint },
+  { 0x6ec8f864000d2ce4_ulint, 0x1a8e90f9908e0ca5_ulint },
+  { 0x8bd3f9e999a423ea_ulint, 0x153eda614071a3b7_ulint },
+  { 0x3ca994bae1501cbb_ulint, 0x10ff151a99f482f9_ulint },
+  { 0xc775bac49bb3612b_ulint, 0x1b31bb5dc320d18e_ulint },
+  { 0xd2c4956a16291a89_ulint, 0x15c162b168e70e0b_ulint },
+  { 0xdbd0778811ba7ba1_ulint, 0x11678227871f3e6f_ulint },
+  { 0x2c80bf401c5d929b_ulint, 0x1bd8d03f3e9863e6_ulint },
+  { 0xbd33cc3349e47549_ulint, 0x16470cff6546b651_ulint },
+  { 0xca8fd68f6e505dd4_ulint, 0x11d270cc51055ea7_ulint },
+  { 0x4419574be3b3c953_ulint, 0x1c83e7ad4e6efdd9_ulint },
+  { 0x0347790982f63aa9_ulint, 0x16cfec8aa52597e1_ulint },
+  { 0xcf6c60d468c4fbba_ulint, 0x123ff06eea847980_ulint },
+  { 0xe57a34870e07f92a_ulint, 0x1d331a4b10d3f59a_ulint },
+  { 0x512e906c0b399422_ulint, 0x175c1508da432ae2_ulint },
+  { 0xda8ba6bcd5c7a9b5_ulint, 0x12b010d3e1cf5581_ulint },
+  { 0x90df712e22d90f87_ulint, 0x1de6815302e5559c_ulint },
+  { 0xda4c5a8b4f140c6c_ulint, 0x17eb9aa8cf1dde16_ulint },
+  { 0xaea37ba2a5a9a38a_ulint, 0x1322e220a5b17e78_ulint },
+  { 0x7dd25f6aa2a905a9_ulint, 0x1e9e369aa2b59727_ulint },
+  { 0x97db7f888220d154_ulint, 0x187e92154ef7ac1f_ulint },
+  { 0x797c6606ce80a777_ulint, 0x139874ddd8c6234c_ulint },
+  { 0x8f2d700ae4010bf1_ulint, 0x1f5a549627a36bad_ulint },
+  { 0x0c2459a25000d65a_ulint, 0x191510781fb5efbe_ulint },
+  { 0x701d1481d99a4515_ulint, 0x1410d9f9b2f7f2fe_ulint },
+  { 0xc017439b147b6a77_ulint, 0x100d7b2e28c65bfe_ulint },
+  { 0xccf205c4ed9243f2_ulint, 0x19af2b7d0e0a2cca_ulint },
+  { 0x0a5b37d0be0e9cc2_ulint, 0x148c22ca71a1bd6f_ulint },
+  { 0x0848f973cb3ee3ce_ulint, 0x10701bd527b4978c_ulint },
+  { 0xda0e5bec78649fb0_ulint, 0x1a4cf9550c5425ac_ulint },
+  { 0x7b3eaff060507fc0_ulint, 0x150a6110d6a9b7bd_ulint },
+  { 0x95cbbff380406633_ulint, 0x10d51a73deee2c97_ulint },
+  { 0xefac665266cd7052_ulint, 0x1aee90b964b04758_ulint },
+  { 0x2623850eb8a459db_ulint, 0x158ba6fab6f36c47_ulint },
+  { 0x1e82d0d893b6ae49_ulint, 0x113c85955f29236c_ulint },
+  { 0xfd9e1af41f8ab075_ulint, 0x1b9408eefea838ac_ulint },
+  { 0x97b1af29b2d559f7_ulint, 0x16100725988693bd_ulint },
+  { 0xac8e25baf5777b2c_ulint, 0x11a66c1e139edc97_ulint },
+  { 0x7a7d092b2258c513_ulint, 0x1c3d79c9b8fe2dbf_ulint },
+  { 0x61fda0ef4ead6a76_ulint, 0x169794a160cb57cc_ulint },
+  { 0xe7fe1a590bbdeec5_ulint, 0x1212dd4de7091309_ulint },
+  { 0xa6635d5b45fcb13a_ulint, 0x1ceafbafd80e84dc_ulint },
+  { 0x851c4aaf6b308dc8_ulint, 0x172262f3133ed0b0_ulint },
+  { 0xd0e36ef2bc26d7d4_ulint, 0x1281e8c275cbda26_ulint },
+  { 0xb49f17eac6a48c86_ulint, 0x1d9ca79d894629d7_ulint },
+  { 0x2a18dfef0550706b_ulint, 0x17b08617a104ee46_ulint },
+  { 0x54e0b3259dd9f389_ulint, 0x12f39e794d9d8b6b_ulint },
+  { 0x87cdeb6f62f65274_ulint, 0x1e5297287c2f4578_ulint },
+  { 0xd30b22bf825ea85d_ulint, 0x18421286c9bf6ac6_ulint },
+  { 0x0f3c1bcc684bb9e4_ulint, 0x13680ed23aff889f_ulint },
+  { 0x18602c7a4079296d_ulint, 0x1f0ce4839198da98_ulint },
+  { 0x46b356c833942124_ulint, 0x18d71d360e13e213_ulint },
+  { 0x388f78a029434db6_ulint, 0x13df4a91a4dcb4dc_ulint },
+  { 0x5a7f2766a86baf8a_ulint, 0x1fcbaa82a1612160_ulint },
+  { 0x153285ebb9efbfa2_ulint, 0x196fbb9bb44db44d_ulint },
+  { 0xaa8ed189618c994e_ulint, 0x145962e2f6a4903d_ulint },
+  { 0xeed8a7a11ad6e10c_ulint, 0x1047824f2bb6d9ca_ulint },
+  { 0x7e27729b5e249b45_ulint, 0x1a0c03b1df8af611_ulint },
+  { 0xfe85f549181d4904_ulint, 0x14d6695b193bf80d_ulint },
+  { 0xcb9e5dd4134aa0d0_ulint, 0x10ab877c142ff9a4_ulint },
+  { 0xdf63c9535211014d_ulint, 0x1aac0bf9b9e65c3a_ulint },
+  { 0x191ca10f74da6771_ulint, 0x15566ffafb1eb02f_ulint },
+  { 0xadb080d92a4852c1_ulint, 0x1111f32f2f4bc025_ulint },
+  { 0x15e7348eaa0d5134_ulint, 0x1b4feb7eb212cd09_ulint },
+  { 0xab1f5d3eee710dc4_ulint, 0x15d98932280f0a6d_ulint },
+  { 0xbc1917658b8da49d_ulint, 0x117ad428200c0857_ulint },
+  { 0x2cf4f23c127c3a94_ulint, 0x1bf7b9d9cce00d59_ulint },
+  { 0xf0c3f4fcdb969543_ulint, 0x165fc7e170b33de0_ulint },
+  { 0x5a365d9716121103_ulint, 0x11e6398126f5cb1a_ulint },
+  { 0x9056fc24f01ce804_ulint, 0x1ca38f350b22de90_ulint },
+  { 0xd9df301d8ce3ecd0_ulint, 0x16e93f5da2824ba6_ulint },
+  { 0xe17f59b13d8323da_ulint, 0x125432b14ecea2eb_ulint },
+  { 0x68cbc2b52f38395c_ulint, 0x1d53844ee47dd179_ulint },
+  { 0x53d6355dbf602de3_ulint, 0x177603725064a794_ulint },
+  { 0xa9782ab165e68b1c_ulint, 0x12c4cf8ea6b6ec76_ulint },
+  { 0x0f26aab56fd744fa_ulint, 0x1e07b27dd78b13f1_ulint },
+  { 0x3f52222abfdf6a62_ulint, 0x18062864ac6f4327_ulint },
+  { 0x65db4e88997f884e_ulint, 0x1338205089f29c1f_ulint },
+  { 0x6fc54a7428cc0d4a_ulint, 0x1ec033b40fea9365_ulint },
+  { 0x596aa1f68709a43b_ulint, 0x1899c2f673220f84_ulint },
+  { 0xadeee7f86c07b696_ulint, 0x13ae3591f5b4d936_ulint },
+  { 0x497e3ff3e00c5756_ulint, 0x1f7d228322baf524_ulint },
+  { 0xd464fff64cd6ac45_ulint, 0x1930e868e89590e9_ulint },
+  { 0x4383fff83d7889d1_ulint, 0x14272053ed4473ee_ulint },
+  { 0xcf9cccc69793a174_ulint, 0x101f4d0ff1038ff1_ulint },
+  { 0x7f6147a425b90252_ulint, 0x19cbae7fe805b31c_ulint },
+  { 0xcc4dd2e9b7c7350f_ulint, 0x14a2f1ffecd15c16_ulint },
+  { 0x3d0b0f215fd290d9_ulint, 0x10825b3323dab012_ulint },
+  { 0x61ab4b689950e7c1_ulint, 0x1a6a2b85062ab350_ulint },
+  { 0x4e22a2ba1440b967_ulint, 0x1521bc6a6b555c40_ulint },
+  { 0x0b4ee894dd009453_ulint, 0x10e7c9eebc4449cd_ulint },
+  { 0x1217da87c800ed51_ulint, 0x1b0c764ac6d3a948_ulint },
+  { 0xdb46486ca000bdda_ulint, 0x15a391d56bdc876c_ulint },
+  { 0x490506bd4ccd64af_ulint, 0x114fa7ddefe39f8a_ulint },
+  { 0xa8080ac87ae23ab1_ulint, 0x1bb2a62fe638ff43_ulint },
+  { 0x5339a239fbe82ef4_ulint, 0x162884f31e93ff69_ulint },
+  { 0x75c7b4fb2fecf25d_ulint, 0x11ba03f5b20fff87_ulint },
+  { 0x22d92191e647ea2e_ulint, 0x1c5cd322b67fff3f_ulint },
+  { 0xb57a8141850654f2_ulint, 0x16b0a8e891ffff65_ulint },
+  { 0xc4620101373843f5_ulint, 0x1226ed86db3332b7_ulint },
+  { 0x3a366801f1f39fee_ulint, 0x1d0b15a491eb8459_ulint },
+  { 0xfb5eb99b27f6198b_ulint, 0x173c115074bc69e0_ulint },
+  { 0x2f7efae2865e7ad6_ulint, 0x129674405d6387e7_ulint },
+  { 0xe597f7d0d6fd9156_ulint, 0x1dbd86cd6238d971_ulint },
+  { 0x8479930d78cadaab_ulint, 0x17cad23de82d7ac1_ulint },
+  { 0xd06142712d6f1556_ulint, 0x1308a831868ac89a_ulint },
+  { 0x4d686a4eaf182222_ulint, 0x1e74404f3daada91_ulint },
+  { 0xa453883ef279b4e8_ulint, 0x185d003f6488aeda_ulint },
+  { 0xe9dc6cff28615d87_ulint, 0x137d99cc506d58ae_ulint },
+  { 0xa960ae650d6895a4_ulint, 0x1f2f5c7a1a488de4_ulint },
+  { 0xbab3beb73ded4483_ulint, 0x18f2b061aea07183_ulint },
+  { 0x2ef6322c318a9d36_ulint, 0x13f559e7bee6c136_ulint },
+  { 0xe4bd1d13827761f0_ulint, 0x1feef63f97d79b89_ulint },
+  { 0x83ca7da9352c4e5a_ulint, 0x198bf832dfdfafa1_ulint },
+  { 0x9ca1fe20f756a515_ulint, 0x146ff9c24cb2f2e7_ulint },
+  { 0x4a1b31b3f9121daa_ulint, 0x1059949b708f28b9_ulint },
+  { 0x435eb5ecc1b695dd_ulint, 0x1a28edc580e50df5_ulint },
+  { 0x35e55e57015ede4a_ulint, 0x14ed8b04671da4c4_ulint },
+  { 0xc4b77eac0118b1d5_ulint, 0x10be08d0527e1d69_ulint },
+  { 0xa12597799b5ab622_ulint, 0x1ac9a7b3b7302f0f_ulint },
+  { 0x4db7ac6149155e81_ulint, 0x156e1fc2f8f358d9_ulint },
+  { 0xd7c6238107444b9b_ulint, 0x1124e63593f5e0ad_ulint },
+  { 0x593d059b3ed3ac2b_ulint, 0x1b6e3d2286563449_ulint },
+  { 0xe0fd9e15cbdc89bc_ulint, 0x15f1ca820511c36d_ulint },
+  { 0xb3fe18116fe3a163_ulint, 0x118e3b9b37416924_ulint },
+  { 0x866359b57fd29bd1_ulint, 0x1c16c5c525357507_ulint },
+  { 0xd1e91491330ee30e_ulint, 0x16789e3750f790d2_ulint },
+  { 0x74ba76da8f3f1c0b_ulint, 0x11fa182c40c60d75_ulint },
+  { 0xedf72490e531c678_ulint, 0x1cc359e067a348bb_ulint },
+  { 0x8b2c1d40b75b052d_ulint, 0x1702ae4d1fb5d3c9_ulint },
+  { 0x6f567dcd5f7c0424_ulint, 0x12688b70e62b0fd4_ulint },
+  { 0x7ef0c94898c66d06_ulint, 0x1d74124e3d11b2ed_ulint },
+  { 0x98c0a106e09ebd9f_ulint, 0x17900ea4fda7c257_ulint },
+  { 0x470080d24d4bcae6_ulint, 0x12d9a550caec9b79_ulint },
+  { 0xd800ce1d487944a2_ulint, 0x1e29088144adc58e_ulint },
+  { 0x1333d8176d2dd082_ulint, 0x1820d39a9d57d13f_ulint },
+  { 0xa8f646792424a6ce_ulint, 0x134d76154aaca765_ulint },
+  { 0x74bd3d8ea03aa47d_ulint, 0x1ee25688777aa56f_ulint },
+  { 0x5d64313ee6955064_ulint, 0x18b51206c5fbb78c_ulint },
+  { 0x4ab68dcbebaaa6b7_ulint, 0x13c40e6bd1962c70_ulint },
+  { 0x1124161312aaa457_ulint, 0x1fa01712e8f0471a_ulint },
+  { 0xda8344dc0eeee9df_ulint, 0x194cdf4253f36c14_ulint },
+  { 0xe2029d7cd8bf2180_ulint, 0x143d7f6843292343_ulint },
+  { 0x4e687dfd7a328133_ulint, 0x103132b9cf541c36_ulint },
+  { 0x4a40c9959050ceb8_ulint, 0x19e851294bb9c6bd_ulint },
+  { 0x0833d477a6a70bc6_ulint, 0x14b9da876fc7d231_ulint },
+  { 0xa02976c61eec096b_ulint, 0x1094aed2bfd30e8d_ulint },
+  { 0x004257a364acdbdf_ulint, 0x1a877e1dffb81749_ulint },
+  { 0xcd01dfb5ea23e319_ulint, 0x153931b1996012a0_ulint },
+  { 0x70ce4c91881cb5ae_ulint, 0x10fa8e27ade6754d_ulint },
+  { 0x1ae3adb5a69455e2_ulint, 0x1b2a7d0c4970bbaf_ulint },
+  { 0x7be957c4854377e8_ulint, 0x15bb973d078d62f2_ulint },
+  { 0xc987796a0435f987_ulint, 0x1162df64060ab58e_ulint },
+  { 0x75a58f1006bcc271_ulint, 0x1bd1656cd67788e4_ulint },
+  { 0xf7b7a5a66bca3527_ulint, 0x16411df0ab92d3e9_ulint },
+  { 0x5fc61e1ebca1c41f_ulint, 0x11cdb18d560f0fee_ulint },
+  { 0xffa363646102d365_ulint, 0x1c7c4f4889b1b316_ulint },
+  { 0x32e91c504d9bdc51_ulint, 0x16c9d906d48e28df_ulint },
+  { 0x8f20e37371497d0e_ulint, 0x123b140576d820b2_ulint },
+  { 0x7e9b0585820f2e7c_ulint, 0x1d2b533bf159cdea_ulint },
+  { 0xcbaf379e01a5beca_ulint, 0x1755dc2ff447d7ee_ulint },
+  { 0x0958f94b348498a1_ulint, 0x12ab168cc36cacbf_ulint }
+};
+
+
+static const double  EXACT_POW10_[23] =
+{
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+  1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const ulint   POW10_[20] =
+{
+  1_ulint,
+  10_ulint,
+  100_ulint,
+  1000_ulint,
+  10000_ulint,
+  100000_ulint,
+  1000000_ulint,
+  10000000_ulint,
+  100000000_ulint,
+  1000000000_ulint,
+  10000000000_ulint,
+  100000000000_ulint,
+  1000000000000_ulint,
+  10000000000000_ulint,
+  100000000000000_ulint,
+  1000000000000000_ulint,
+  10000000000000000_ulint,
+  100000000000000000_ulint,
+  1000000000000000000_ulint,
+  10000000000000000000_ulint
+};
+
+static const int     POW5_BITCOUNT_     = 125;
+static const int     POW5_SPLIT_SIZE_   = 326;
+static const int     POW5_INV_SIZE_     = 342;
+static const int     MANTISSA_BITS_     = 52;
+static const int     EXPONENT_BIAS_     = 1023;
+static const ulint   MANTISSA_MASK_     = (1_ulint << 52) - 1_ulint;
+static const ulint   EXPONENT_MASK_     = 0x7ff_ulint;
+
+// The maximum number of significant digits that is taken into account
+// when parsing a number. A binary floating point number is uniquely
+// determined by the first 767 significant digits.
+
+static const int     MAX_PARSE_DIGITS_  = 800;
+
+
+//=======================================================================
+//   class FloatConv::Utils_
+//=======================================================================
+
+
+class FloatConv::Utils_
+{
+ public:
+
+  // A 192-bit unsigned integer; w[0] is the least significant word.
+
+  struct                  Wide
+  {
+    ulint                   w[3];
+  };
+
+  // The (approximate) product P * 2^bexp of an integer and a power of
+  // ten. The exact product lies in the range [P, P + m) if errdir is
+  // positive, and in the range (P - m, P) if errdir is negative.
+
+  struct                  Scaled
+  {
+    Wide                    prod;
+    int                     bexp;
+    int                     errdir;
+    ulint                   m;
+  };
+
+
+  static inline ulint     mul128
+
+    ( ulint                 a,
+      ulint                 b,
+      ulint&                hi );
+
+  static inline ulint     shiftRight128
+
+    ( ulint                 lo,
+      ulint                 hi,
+      int                   n );
+
+  static inline ulint     mulShift
+
+    ( ulint                 m,
+      const ulint*          mul,
+      int                   j );
+
+  static inline int       pow5bits
+
+    ( int                   e );
+
+  static inline int       log10Pow2
+
+    ( int                   e );
+
+  static inline int       log10Pow5
+
+    ( int                   e );
+
+  static inline int       pow5Factor
+
+    ( ulint                 v );
+
+  static inline bool      isMultipleOfPow5
+
+    ( ulint                 v,
+      int                   p );
+
+  static inline bool      isMultipleOfPow2
+
+    ( ulint                 v,
+      int                   p );
+
+  static inline int       bitLength
+
+    ( ulint                 v );
+
+  static inline int       digitCount
+
+    ( ulint                 v );
+
+  static inline void      writeDigits
+
+    ( char*                 buf,
+      ulint                 v,
+      int                   n );
+
+  static bool             scale
+
+    ( Scaled&               s,
+      ulint                 m,
+      int                   q );
+
+  static bool             round
+
+    ( ulint&                result,
+      const Scaled&         s,
+      int                   r );
+
+  static inline ulint     toBits
+
+    ( double                x );
+
+  static inline double    fromBits
+
+    ( ulint                 bits );
+
+  static inline void      decompose
+
+    ( ulint&                m,
+      int&                  e,
+      ulint                 bits );
+
+  static bool             makeBits
+
+    ( ulint&                bits,
+      ulint                 w,
+      int                   q );
+
+  static ulint            exactScale
+
+    ( ulint                 m,
+      int                   e,
+      int                   q,
+      ulint                 guess );
+
+  static ulint            exactParse
+
+    ( const char*           str,
+      idx_t                 len,
+      ulint                 guess );
+
+
+ private:
+
+  static int              compareDecimal_
+
+    ( const BigNum_&        dnum,
+      int                   q,
+      bool                  sticky,
+      ulint                 h,
+      int                   g );
+
+  static inline void      add_
+
+    ( Wide&                 a,
+      ulint                 b );
+
+  static inline void      sub_
+
+    ( Wide&                 a,
+      ulint                 b );
+
+  static inline int       topBit_
+
+    ( const Wide&           a );
+
+  static inline ulint     shiftRight_
+
+    ( const Wide&           a,
+      int                   n );
+
+  static inline bool      testBit_
+
+    ( const Wide&           a,
+      int                   n );
+
+  static inline bool      lowBits_
+
+    ( const Wide&           a,
+      int                   n );
+
+};
+
+
+//-----------------------------------------------------------------------
+//   mul128
+//-----------------------------------------------------------------------
+
+
+inline ulint FloatConv::Utils_::mul128
+
+  ( ulint   a,
+    ulint   b,
+    ulint&  hi )
+
+{
+#if defined(__SIZEOF_INT128__)
+
+  unsigned __int128  p = (unsigned __int128) a * b;
+
+  hi = (ulint) (p >> 64);
+
+  return (ulint) p;
+
+#else
+
+  const ulint  MASK = 0xffffffff_ulint;
+
+  ulint        a0   = a & MASK;
+  ulint        a1   = a >> 32;
+  ulint        b0   = b & MASK;
+  ulint        b1   = b >> 32;
+  ulint        p00  = a0 * b0;
+  ulint        p01  = a0 * b1;
+  ulint        p10  = a1 * b0;
+  ulint        p11  = a1 * b1;
+  ulint        mid  = (p00 >> 32) + (p01 & MASK) + (p10 & MASK);
+
+  hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+
+  return ((mid << 32) | (p00 & MASK));
+
+#endif
+}
+
+
+//-----------------------------------------------------------------------
+//   shiftRight128
+//-----------------------------------------------------------------------
+
+
+inline ulint FloatConv::Utils_::shiftRight128
+
+  ( ulint  lo,
+    ulint  hi,
+    int    n )
+
+{
+  if      ( n == 0 )
+  {
+    return lo;
+  }
+  else if ( n < 64 )
+  {
+    return ((hi << (64 - n)) | (lo >> n));
+  }
+  else
+  {
+    return (hi >> (n - 64));
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   mulShift
+//-----------------------------------------------------------------------
+
+// Returns (m * mul) >> j, with mul a 128-bit integer and j >= 64.
+
+
+inline ulint FloatConv::Utils_::mulShift
+
+  ( ulint         m,
+    const ulint*  mul,
+    int           j )
+
+{
+  ulint  hi0, hi1;
+  ulint  lo1, sum;
+
+  mul128 ( m, mul[0], hi0 );
+
+  lo1  = mul128 ( m, mul[1], hi1 );
+  sum  = hi0 + lo1;
+  hi1 += (sum < hi0) ? 1_ulint : 0_ulint;
+
+  return shiftRight128 ( sum, hi1, j - 64 );
+}
+
+
+//-----------------------------------------------------------------------
+//   pow5bits, log10Pow2, log10Pow5
+//-----------------------------------------------------------------------
+
+// These functions are exact for 0 <= e <= 3528, 0 <= e <= 1650 and
+// 0 <= e <= 2620, respectively.
+
+
+inline int FloatConv::Utils_::pow5bits ( int e )
+{
+  return (int) ((((unsigned) e) * 1217359U) >> 19) + 1;
+}
+
+
+inline int FloatConv::Utils_::log10Pow2 ( int e )
+{
+  return (int) ((((unsigned) e) * 78913U) >> 18);
+}
+
+
+inline int FloatConv::Utils_::log10Pow5 ( int e )
+{
+  return (int) ((((unsigned) e) * 732923U) >> 20);
+}
+
+
+//-----------------------------------------------------------------------
+//   pow5Factor
+//-----------------------------------------------------------------------
+
+
+inline int FloatConv::Utils_::pow5Factor ( ulint v )
+{
+  int  n = 0;
+
+  while ( v > 0 && v % 5 == 0 )
+  {
+    v /= 5;
+    n++;
+  }
+
+  return n;
+}
+
+
+//-----------------------------------------------------------------------
+//   isMultipleOfPow5
+//-----------------------------------------------------------------------
+
+
+inline bool FloatConv::Utils_::isMultipleOfPow5
+
+  ( ulint  v,
+    int    p )
+
+{
+  return (pow5Factor( v ) >= p);
+}
+
+
+//-----------------------------------------------------------------------
+//   isMultipleOfPow2
+//-----------------------------------------------------------------------
+
+
+inline bool FloatConv::Utils_::isMultipleOfPow2
+
+  ( ulint  v,
+    int    p )
+
+{
+  return ((v & ((1_ulint << p) - 1_ulint)) == 0);
+}
+
+
+//-----------------------------------------------------------------------
+//   bitLength
+//-----------------------------------------------------------------------
+
+
+inline int FloatConv::Utils_::bitLength ( ulint v )
+{
+  int  n = 0;
+
+  while ( v >= 256_ulint )
+  {
+    v >>= 8;
+    n  += 8;
+  }
+
+  while ( v )
+  {
+    v >>= 1;
+    n++;
+  }
+
+  return n;
+}
+
+
+//-----------------------------------------------------------------------
+//   digitCount
+//-----------------------------------------------------------------------
+
+
+inline int FloatConv::Utils_::digitCount ( ulint v )
+{
+  int  n = 1;
+
+  while ( n < 20 && v >= POW10_[n] )
+  {
+    n++;
+  }
+
+  return n;
+}
+
+
+//-----------------------------------------------------------------------
+//   writeDigits
+//-----------------------------------------------------------------------
+
+
+inline void FloatConv::Utils_::writeDigits
+
+  ( char*  buf,
+    ulint  v,
+    int    n )
+
+{
+  for ( int i = n - 1; i >= 0; i-- )
+  {
+    buf[i] = (char) ('0' + (int) (v % 10));
+    v     /= 10;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   scale
+//-----------------------------------------------------------------------
+
+// Computes an approximation of m * 10^q. Returns false if q is out of
+// range.
+
+
+bool FloatConv::Utils_::scale
+
+  ( Scaled&  s,
+    ulint    m,
+    int      q )
+
+{
+  const ulint*  t;
+  ulint         lo0, hi0;
+  ulint         lo1, hi1;
+
+
+  if ( q >= 0 )
+  {
+    if ( q >= POW5_SPLIT_SIZE_ )
+    {
+      return false;
+    }
+
+    t        = POW5_SPLIT_[q];
+    s.bexp   = q + pow5bits( q ) - POW5_BITCOUNT_;
+    s.errdir = (pow5bits( q ) <= POW5_BITCOUNT_) ? 0 : 1;
+  }
+  else
+  {
+    if ( -q >= POW5_INV_SIZE_ )
+    {
+      return false;
+    }
+
+    t        = POW5_INV_SPLIT_[-q];
+    s.bexp   = q - (pow5bits( -q ) - 1 + POW5_BITCOUNT_);
+    s.errdir = -1;
+  }
+
+  lo0 = mul128 ( m, t[0], hi0 );
+  lo1 = mul128 ( m, t[1], hi1 );
+
+  s.m         = m;
+  s.prod.w[0] = lo0;
+  s.prod.w[1] = hi0 + lo1;
+  s.prod.w[2] = hi1 + ((s.prod.w[1] < hi0) ? 1_ulint : 0_ulint);
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------
+//   round
+//-----------------------------------------------------------------------
+
+// Rounds the scaled number s to a multiple of 2^r, using the round
+// half to even rule. Returns false if the result can not be
+// determined because of the truncation error in s.
+
+
+bool FloatConv::Utils_::round
+
+  ( ulint&         result,
+    const Scaled&  s,
+    int            r )
+
+{
+  JEM_ASSERT ( r > 0 && r < 192 );
+
+  if ( s.errdir == 0 )
+  {
+    result = shiftRight_ ( s.prod, r );
+
+    if ( testBit_( s.prod, r - 1 ) )
+    {
+      if ( lowBits_( s.prod, r - 1 ) || (result & 1_ulint) )
+      {
+        result++;
+      }
+    }
+
+    return true;
+  }
+
+  // The exact value is not equal to a tie, so it suffices to round
+  // the lower and upper bounds and check whether they are equal.
+
+  Wide   lb = s.prod;
+  Wide   ub = s.prod;
+  ulint  r0, r1;
+
+  if ( s.errdir > 0 )
+  {
+    add_ ( ub, s.m - 1_ulint );
+  }
+  else
+  {
+    sub_ ( lb, s.m );
+    sub_ ( ub, 1_ulint );
+  }
+
+  r0 = shiftRight_ ( lb, r );
+  r1 = shiftRight_ ( ub, r );
+
+  if ( testBit_( lb, r - 1 ) )
+  {
+    r0++;
+  }
+
+  if ( testBit_( ub, r - 1 ) )
+  {
+    r1++;
+  }
+
+  result = r0;
+
+  return (r0 == r1);
+}
+
+
+//-----------------------------------------------------------------------
+//   toBits & fromBits
+//-----------------------------------------------------------------------
+
+
+inline ulint FloatConv::Utils_::toBits ( double x )
+{
+  ulint  bits;
+
+  std::memcpy ( &bits, &x, sizeof(bits) );
+
+  return bits;
+}
+
+
+inline double FloatConv::Utils_::fromBits ( ulint bits )
+{
+  double  x;
+
+  std::memcpy ( &x, &bits, sizeof(x) );
+
+  return x;
+}
+
+
+//-----------------------------------------------------------------------
+//   decompose
+//-----------------------------------------------------------------------
+
+// Splits a positive, finite number into an integer m and an exponent
+// e so that the number equals m * 2^e.
+
+
+inline void FloatConv::Utils_::decompose
+
+  ( ulint&  m,
+    int&    e,
+    ulint   bits )
+
+{
+  const int  bexp = (int) ((bits >> MANTISSA_BITS_) & EXPONENT_MASK_);
+
+  m = bits & MANTISSA_MASK_;
+
+  if ( bexp == 0 )
+  {
+    e = 1 - EXPONENT_BIAS_ - MANTISSA_BITS_;
+  }
+  else
+  {
+    m |= (1_ulint << MANTISSA_BITS_);
+    e  = bexp - EXPONENT_BIAS_ - MANTISSA_BITS_;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   makeBits
+//-----------------------------------------------------------------------
+
+// Computes the bit pattern of the floating point number nearest to
+// w * 10^q, with w > 0. Returns false if the result is uncertain; in
+// that case bits is set to a number that is at most one unit in the
+// last place off.
+
+
+bool FloatConv::Utils_::makeBits
+
+  ( ulint&  bits,
+    ulint   w,
+    int     q )
+
+{
+  Scaled  s;
+  ulint   m;
+  int     ex, kb, r;
+  bool    ok;
+
+
+  if ( ! scale( s, w, q ) )
+  {
+    bits = 0;
+    return false;
+  }
+
+  ex = topBit_ ( s.prod ) + s.bexp;
+
+  if ( ex >= 1 - EXPONENT_BIAS_ )
+  {
+    kb = MANTISSA_BITS_ + 1;
+  }
+  else
+  {
+    kb = ex + EXPONENT_BIAS_ + MANTISSA_BITS_;
+  }
+
+  if ( kb <= 0 )
+  {
+    bits = 0;
+    return (kb < 0 && ex < -1 - EXPONENT_BIAS_ - MANTISSA_BITS_);
+  }
+
+  r  = topBit_ ( s.prod ) - kb + 1;
+  ok = round ( m, s, r );
+
+  if ( kb <= MANTISSA_BITS_ )
+  {
+    // Subnormal number; note that a carry results in the smallest
+    // normal number.
+
+    bits = m;
+  }
+  else
+  {
+    int  e = r + s.bexp;
+
+    if ( m >> (MANTISSA_BITS_ + 1) )
+    {
+      m >>= 1;
+      e++;
+    }
+
+    e += MANTISSA_BITS_ + EXPONENT_BIAS_;
+
+    if ( e >= (int) EXPONENT_MASK_ )
+    {
+      bits = EXPONENT_MASK_ << MANTISSA_BITS_;
+    }
+    else
+    {
+      bits = ((ulint) e << MANTISSA_BITS_) | (m & MANTISSA_MASK_);
+    }
+  }
+
+  return ok;
+}
+
+
+//-----------------------------------------------------------------------
+//   add_ & sub_
+//-----------------------------------------------------------------------
+
+
+inline void FloatConv::Utils_::add_
+
+  ( Wide&  a,
+    ulint  b )
+
+{
+  a.w[0] += b;
+
+  if ( a.w[0] < b )
+  {
+    if ( ++a.w[1] == 0 )
+    {
+      a.w[2]++;
+    }
+  }
+}
+
+
+inline void FloatConv::Utils_::sub_
+
+  ( Wide&  a,
+    ulint  b )
+
+{
+  if ( a.w[0] < b )
+  {
+    if ( a.w[1]-- == 0 )
+    {
+      a.w[2]--;
+    }
+  }
+
+  a.w[0] -= b;
+}
+
+
+//-----------------------------------------------------------------------
+//   topBit_
+//-----------------------------------------------------------------------
+
+
+inline int FloatConv::Utils_::topBit_ ( const Wide& a )
+{
+  if      ( a.w[2] )
+  {
+    return (127 + bitLength( a.w[2] ));
+  }
+  else if ( a.w[1] )
+  {
+    return ( 63 + bitLength( a.w[1] ));
+  }
+  else
+  {
+    return (bitLength( a.w[0] ) - 1);
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   shiftRight_
+//-----------------------------------------------------------------------
+
+
+inline ulint FloatConv::Utils_::shiftRight_
+
+  ( const Wide&  a,
+    int          n )
+
+{
+  if ( n >= 192 )
+  {
+    return 0_ulint;
+  }
+
+  const int  k = n / 64;
+  const int  b = n % 64;
+
+  ulint      lo = a.w[k];
+  ulint      hi = (k < 2) ? a.w[k + 1] : 0_ulint;
+
+  return shiftRight128 ( lo, hi, b );
+}
+
+
+//-----------------------------------------------------------------------
+//   testBit_
+//-----------------------------------------------------------------------
+
+
+inline bool FloatConv::Utils_::testBit_
+
+  ( const Wide&  a,
+    int          n )
+
+{
+  return (((a.w[n / 64] >> (n % 64)) & 1_ulint) != 0);
+}
+
+
+//-----------------------------------------------------------------------
+//   lowBits_
+//-----------------------------------------------------------------------
+
+// Returns true if any of the n least significant bits is set.
+
+
+inline bool FloatConv::Utils_::lowBits_
+
+  ( const Wide&  a,
+    int          n )
+
+{
+  for ( int i = 0; i < 3 && n > 0; i++, n -= 64 )
+  {
+    ulint  mask = (n >= 64) ? ~0_ulint : ((1_ulint << n) - 1_ulint);
+
+    if ( a.w[i] & mask )
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+//=======================================================================
+//   class FloatConv::BigNum_
+//=======================================================================
+
+// A simple, fixed-size big integer that is used to resolve the cases
+// that can not be handled with 128-bit arithmetic.
+
+
+class FloatConv::BigNum_
+{
+ public:
+
+  static const int        CAPACITY = 160;
+
+
+  inline                  BigNum_     ();
+
+  void                    set
+
+    ( ulint                 v );
+
+  void                    mulSmall
+
+    ( unsigned int          k );
+
+  void                    addSmall
+
+    ( unsigned int          k );
+
+  void                    mulPow5
+
+    ( int                   n );
+
+  void                    mulPow2
+
+    ( int                   n );
+
+  ulint                   getBits
+
+    ( int                   pos )        const;
+
+  bool                    testBit
+
+    ( int                   pos )        const;
+
+  bool                    lowBits
+
+    ( int                   n )          const;
+
+  static int              compare
+
+    ( const BigNum_&        lhs,
+      const BigNum_&        rhs );
+
+
+ private:
+
+  unsigned int            limbs_[CAPACITY];
+  int                     size_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline FloatConv::BigNum_::BigNum_ () :
+
+  size_ ( 0 )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   set
+//-----------------------------------------------------------------------
+
+
+void FloatConv::BigNum_::set ( ulint v )
+{
+  size_ = 0;
+
+  while ( v )
+  {
+    limbs_[size_++] = (unsigned int) (v & 0xffffffff_ulint);
+    v             >>= 32;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   mulSmall
+//-----------------------------------------------------------------------
+
+
+void FloatConv::BigNum_::mulSmall ( unsigned int k )
+{
+  ulint  carry = 0;
+
+  for ( int i = 0; i < size_; i++ )
+  {
+    ulint  t = (ulint) limbs_[i] * k + carry;
+
+    limbs_[i] = (unsigned int) (t & 0xffffffff_ulint);
+    carry     = t >> 32;
+  }
+
+  if ( carry )
+  {
+    JEM_ASSERT ( size_ < CAPACITY );
+
+    limbs_[size_++] = (unsigned int) carry;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   addSmall
+//-----------------------------------------------------------------------
+
+
+void FloatConv::BigNum_::addSmall ( unsigned int k )
+{
+  ulint  carry = k;
+
+  for ( int i = 0; i < size_ && carry; i++ )
+  {
+    ulint  t = (ulint) limbs_[i] + carry;
+
+    limbs_[i] = (unsigned int) (t & 0xffffffff_ulint);
+    carry     = t >> 32;
+  }
+
+  if ( carry )
+  {
+    JEM_ASSERT ( size_ < CAPACITY );
+
+    limbs_[size_++] = (unsigned int) carry;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   mulPow5
+//-----------------------------------------------------------------------
+
+
+void FloatConv::BigNum_::mulPow5 ( int n )
+{
+  // Note that 5^13 is the largest power of five that fits in 32 bits.
+
+  while ( n >= 13 )
+  {
+    mulSmall ( 1220703125U );
+
+    n -= 13;
+  }
+
+  if ( n > 0 )
+  {
+    unsigned int  k = 1;
+
+    for ( ; n > 0; n-- )
+    {
+      k *= 5;
+    }
+
+    mulSmall ( k );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   mulPow2
+//-----------------------------------------------------------------------
+
+
+void FloatConv::BigNum_::mulPow2 ( int n )
+{
+  if ( size_ == 0 || n <= 0 )
+  {
+    return;
+  }
+
+  const int  k = n / 32;
+  const int  b = n % 32;
+
+  JEM_ASSERT ( size_ + k + 1 <= CAPACITY );
+
+  if ( b == 0 )
+  {
+    for ( int i = size_ - 1; i >= 0; i-- )
+    {
+      limbs_[i + k] = limbs_[i];
+    }
+  }
+  else
+  {
+    limbs_[size_ + k] = 0;
+
+    for ( int i = size_ - 1; i >= 0; i-- )
+    {
+      limbs_[i + k + 1] |= limbs_[i] >> (32 - b);
+      limbs_[i + k]      = limbs_[i] << b;
+    }
+
+    size_++;
+  }
+
+  for ( int i = 0; i < k; i++ )
+  {
+    limbs_[i] = 0;
+  }
+
+  size_ += k;
+
+  while ( size_ > 0 && limbs_[size_ - 1] == 0 )
+  {
+    size_--;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   getBits
+//-----------------------------------------------------------------------
+
+// Returns the 64 bits starting at bit position pos.
+
+
+ulint FloatConv::BigNum_::getBits ( int pos ) const
+{
+  ulint  v = 0;
+
+  for ( int i = 0; i < 64; i++ )
+  {
+    if ( testBit( pos + i ) )
+    {
+      v |= (1_ulint << i);
+    }
+  }
+
+  return v;
+}
+
+
+//-----------------------------------------------------------------------
+//   testBit
+//-----------------------------------------------------------------------
+
+
+bool FloatConv::BigNum_::testBit ( int pos ) const
+{
+  const int  k = pos / 32;
+
+  if ( k >= size_ )
+  {
+    return false;
+  }
+
+  return (((limbs_[k] >> (pos % 32)) & 1U) != 0);
+}
+
+
+//-----------------------------------------------------------------------
+//   lowBits
+//-----------------------------------------------------------------------
+
+
+bool FloatConv::BigNum_::lowBits ( int n ) const
+{
+  for ( int i = 0; i < size_ && n > 0; i++, n -= 32 )
+  {
+    unsigned int  mask = (n >= 32) ? ~0U : ((1U << n) - 1U);
+
+    if ( limbs_[i] & mask )
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+//-----------------------------------------------------------------------
+//   compare
+//-----------------------------------------------------------------------
+
+
+int FloatConv::BigNum_::compare
+
+  ( const BigNum_&  lhs,
+    const BigNum_&  rhs )
+
+{
+  if ( lhs.size_ != rhs.size_ )
+  {
+    return (lhs.size_ < rhs.size_) ? -1 : 1;
+  }
+
+  for ( int i = lhs.size_ - 1; i >= 0; i-- )
+  {
+    if ( lhs.limbs_[i] != rhs.limbs_[i] )
+    {
+      return (lhs.limbs_[i] < rhs.limbs_[i]) ? -1 : 1;
+    }
+  }
+
+  return 0;
+}
+
+
+//=======================================================================
+//   class FloatConv::Utils_ (continued)
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   exactScale
+//-----------------------------------------------------------------------
+
+// Returns m * 2^e * 10^q rounded to the nearest integer. If q is
+// negative, then guess must be the result rounded down or up.
+
+
+ulint FloatConv::Utils_::exactScale
+
+  ( ulint  m,
+    int    e,
+    int    q,
+    ulint  guess )
+
+{
+  BigNum_  lhs;
+  BigNum_  rhs;
+  ulint    f;
+  int      k, c;
+
+
+  if ( q >= 0 )
+  {
+    lhs.set     ( m );
+    lhs.mulPow5 ( q );
+
+    k = e + q;
+
+    if ( k >= 0 )
+    {
+      lhs.mulPow2 ( k );
+
+      return lhs.getBits ( 0 );
+    }
+
+    f = lhs.getBits ( -k );
+
+    if ( lhs.testBit( -k - 1 ) )
+    {
+      if ( lhs.lowBits( -k - 1 ) || (f & 1_ulint) )
+      {
+        f++;
+      }
+    }
+
+    return f;
+  }
+
+  // Compare 2 * m * 2^e * 10^q with 2 * guess + 1.
+
+  lhs.set     ( m );
+  rhs.set     ( 2_ulint * guess + 1_ulint );
+  rhs.mulPow5 ( -q );
+
+  k = e + q + 1;
+
+  if ( k >= 0 )
+  {
+    lhs.mulPow2 (  k );
+  }
+  else
+  {
+    rhs.mulPow2 ( -k );
+  }
+
+  c = BigNum_::compare ( lhs, rhs );
+
+  if      ( c > 0 )
+  {
+    return (guess + 1_ulint);
+  }
+  else if ( c < 0 )
+  {
+    return guess;
+  }
+  else
+  {
+    return (guess + (guess & 1_ulint));
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   exactParse
+//-----------------------------------------------------------------------
+
+// Returns the bit pattern of the floating point number that is nearest
+// to the decimal number in the given string, which must be a valid,
+// unsigned number. The guess must be close to the exact result.
+
+
+ulint FloatConv::Utils_::exactParse
+
+  ( const char*  str,
+    idx_t        len,
+    ulint        guess )
+
+{
+  const ulint  INF_BITS = EXPONENT_MASK_ << MANTISSA_BITS_;
+
+  BigNum_      dnum;
+  ulint        bits;
+  ulint        mb, h;
+  bool         sticky;
+  bool         frac;
+  int          ndigits;
+  int          q, eb, g, c;
+  idx_t        i;
+
+
+  // Collect the significant digits.
+
+  sticky  = false;
+  frac    = false;
+  ndigits = 0;
+  q       = 0;
+
+  dnum.set ( 0 );
+
+  for ( i = 0; i < len; i++ )
+  {
+    char  ch = str[i];
+
+    if ( ch == '.' )
+    {
+      frac = true;
+      continue;
+    }
+
+    if ( ch < '0' || ch > '9' )
+    {
+      break;
+    }
+
+    if ( ndigits == 0 && ch == '0' )
+    {
+      if ( frac )
+      {
+        q--;
+      }
+
+      continue;
+    }
+
+    if ( ndigits < MAX_PARSE_DIGITS_ )
+    {
+      dnum.mulSmall ( 10U );
+      dnum.addSmall ( (unsigned int) (ch - '0') );
+
+      ndigits++;
+
+      if ( frac )
+      {
+        q--;
+      }
+    }
+    else
+    {
+      if ( ch != '0' )
+      {
+        sticky = true;
+      }
+
+      if ( ! frac )
+      {
+        q++;
+      }
+    }
+  }
+
+  if ( i < len )
+  {
+    int   sign = 1;
+    long  x    = 0;
+
+    i++;
+
+    if ( str[i] == '+' || str[i] == '-' )
+    {
+      sign = (str[i] == '-') ? -1 : 1;
+      i++;
+    }
+
+    for ( ; i < len; i++ )
+    {
+      if ( x < 100000 )
+      {
+        x = 10 * x + (str[i] - '0');
+      }
+    }
+
+    q += (int) (sign * x);
+  }
+
+  // Move the guess up or down until it is nearest to the decimal
+  // number. Note that the bit patterns of positive numbers are
+  // ordered in the same way as the numbers.
+
+  bits = guess;
+
+  while ( true )
+  {
+    if ( bits < INF_BITS )
+    {
+      decompose ( mb, eb, bits );
+
+      c = compareDecimal_ ( dnum, q, sticky, 2_ulint * mb + 1_ulint,
+                            eb - 1 );
+
+      if ( c > 0 || (c == 0 && (mb & 1_ulint)) )
+      {
+        bits++;
+        continue;
+      }
+    }
+
+    if ( bits == 0 )
+    {
+      break;
+    }
+
+    if ( bits >= INF_BITS )
+    {
+      bits = INF_BITS;
+      h    = (1_ulint << (MANTISSA_BITS_ + 2)) - 1_ulint;
+      g    = (int) EXPONENT_MASK_ - EXPONENT_BIAS_ - MANTISSA_BITS_ - 2;
+    }
+    else
+    {
+      if ( (bits & MANTISSA_MASK_) == 0 && (bits >> MANTISSA_BITS_) > 1 )
+      {
+        h = 4_ulint * mb - 1_ulint;
+        g = eb - 2;
+      }
+      else
+      {
+        h = 2_ulint * mb - 1_ulint;
+        g = eb - 1;
+      }
+    }
+
+    c = compareDecimal_ ( dnum, q, sticky, h, g );
+
+    if ( c < 0 || (c == 0 && (bits & 1_ulint)) )
+    {
+      bits--;
+      continue;
+    }
+
+    break;
+  }
+
+  return bits;
+}
+
+
+//-----------------------------------------------------------------------
+//   compareDecimal_
+//-----------------------------------------------------------------------
+
+// Compares the decimal number (dnum + sticky) * 10^q with h * 2^g.
+
+
+int FloatConv::Utils_::compareDecimal_
+
+  ( const BigNum_&  dnum,
+    int             q,
+    bool            sticky,
+    ulint           h,
+    int             g )
+
+{
+  BigNum_  lhs ( dnum );
+  BigNum_  rhs;
+  int      c, k;
+
+
+  rhs.set ( h );
+
+  if ( q >= 0 )
+  {
+    lhs.mulPow5 (  q );
+  }
+  else
+  {
+    rhs.mulPow5 ( -q );
+  }
+
+  k = q - g;
+
+  if ( k >= 0 )
+  {
+    lhs.mulPow2 (  k );
+  }
+  else
+  {
+    rhs.mulPow2 ( -k );
+  }
+
+  c = BigNum_::compare ( lhs, rhs );
+
+  if ( c == 0 && sticky )
+  {
+    c = 1;
+  }
+
+  return c;
+}
+
+
+//=======================================================================
+//   class FloatConv
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   toShortest
+//-----------------------------------------------------------------------
+
+// Stores the shortest sequence of decimal digits that uniquely
+// identifies the given number; that is, the number is equal to
+// d[0].d[1]d[2]... * 10^exp10. The number must be finite and it may
+// not be negative. Returns the number of digits.
+
+
+int FloatConv::toShortest
+
+  ( char*   digits,
+    int&    exp10,
+    double  value )
+
+{
+  const ulint  bits    = Utils_::toBits ( value );
+  const ulint  ieeeMan = bits & MANTISSA_MASK_;
+  const int    ieeeExp = (int) ((bits >> MANTISSA_BITS_) & EXPONENT_MASK_);
+
+  ulint        m2, mv;
+  ulint        vr, vp, vm;
+  ulint        output;
+  int          e2, e10;
+  int          removed;
+  int          n, mmShift;
+  bool         acceptBounds;
+  bool         vmIsTrailingZeros;
+  bool         vrIsTrailingZeros;
+
+
+  JEM_PRECHECK ( ieeeExp != (int) EXPONENT_MASK_ );
+
+  if ( ieeeMan == 0 && ieeeExp == 0 )
+  {
+    digits[0] = '0';
+    exp10     = 0;
+
+    return 1;
+  }
+
+  if ( ieeeExp == 0 )
+  {
+    e2 = 1 - EXPONENT_BIAS_ - MANTISSA_BITS_ - 2;
+    m2 = ieeeMan;
+  }
+  else
+  {
+    e2 = ieeeExp - EXPONENT_BIAS_ - MANTISSA_BITS_ - 2;
+    m2 = (1_ulint << MANTISSA_BITS_) | ieeeMan;
+  }
+
+  // Determine the interval of valid decimal representations.
+
+  acceptBounds      = ((m2 & 1_ulint) == 0);
+  mv                = 4_ulint * m2;
+  mmShift           = (ieeeMan != 0 || ieeeExp <= 1) ? 1 : 0;
+  vmIsTrailingZeros = false;
+  vrIsTrailingZeros = false;
+
+  // Convert the interval bounds to a decimal power base.
+
+  if ( e2 >= 0 )
+  {
+    const int  q = Utils_::log10Pow2( e2 ) - ((e2 > 3) ? 1 : 0);
+    const int  k = POW5_BITCOUNT_ + Utils_::pow5bits( q ) - 1;
+    const int  i = -e2 + q + k;
+
+    e10 = q;
+    vr  = Utils_::mulShift ( mv,           POW5_INV_SPLIT_[q], i );
+    vp  = Utils_::mulShift ( mv + 2_ulint, POW5_INV_SPLIT_[q], i );
+    vm  = Utils_::mulShift ( mv - 1_ulint - (ulint) mmShift,
+                             POW5_INV_SPLIT_[q], i );
+
+    if ( q <= 21 )
+    {
+      if      ( mv % 5 == 0 )
+      {
+        vrIsTrailingZeros = Utils_::isMultipleOfPow5 ( mv, q );
+      }
+      else if ( acceptBounds )
+      {
+        vmIsTrailingZeros = Utils_::isMultipleOfPow5 (
+          mv - 1_ulint - (ulint) mmShift, q
+        );
+      }
+      else if ( Utils_::isMultipleOfPow5( mv + 2_ulint, q ) )
+      {
+        vp--;
+      }
+    }
+  }
+  else
+  {
+    const int  q = Utils_::log10Pow5( -e2 ) - ((-e2 > 1) ? 1 : 0);
+    const int  i = -e2 - q;
+    const int  k = Utils_::pow5bits( i ) - POW5_BITCOUNT_;
+    const int  j = q - k;
+
+    e10 = q + e2;
+    vr  = Utils_::mulShift ( mv,           POW5_SPLIT_[i], j );
+    vp  = Utils_::mulShift ( mv + 2_ulint, POW5_SPLIT_[i], j );
+    vm  = Utils_::mulShift ( mv - 1_ulint - (ulint) mmShift,
+                             POW5_SPLIT_[i], j );
+
+    if      ( q <= 1 )
+    {
+      // The number mv has at least q trailing zero bits.
+
+      vrIsTrailingZeros = true;
+
+      if ( acceptBounds )
+      {
+        vmIsTrailingZeros = (mmShift == 1);
+      }
+      else
+      {
+        vp--;
+      }
+    }
+    else if ( q < 63 )
+    {
+      vrIsTrailingZeros = Utils_::isMultipleOfPow2 ( mv, q );
+    }
+  }
+
+  // Find the shortest decimal representation in the interval.
+
+  removed = 0;
+
+  if ( vmIsTrailingZeros || vrIsTrailingZeros )
+  {
+    int  lastRemovedDigit = 0;
+
+    while ( vp / 10 > vm / 10 )
+    {
+      vmIsTrailingZeros &= (vm % 10 == 0);
+      vrIsTrailingZeros &= (lastRemovedDigit == 0);
+      lastRemovedDigit   = (int) (vr % 10);
+      vr                /= 10;
+      vp                /= 10;
+      vm                /= 10;
+      removed++;
+    }
+
+    if ( vmIsTrailingZeros )
+    {
+      while ( vm % 10 == 0 )
+      {
+        vrIsTrailingZeros &= (lastRemovedDigit == 0);
+        lastRemovedDigit   = (int) (vr % 10);
+        vr                /= 10;
+        vp                /= 10;
+        vm                /= 10;
+        removed++;
+      }
+    }
+
+    if ( vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0 )
+    {
+      // Round to even.
+
+      lastRemovedDigit = 4;
+    }
+
+    output = vr;
+
+    if ( (vr == vm && (! acceptBounds || ! vmIsTrailingZeros)) ||
+         lastRemovedDigit >= 5 )
+    {
+      output++;
+    }
+  }
+  else
+  {
+    bool  roundUp = false;
+
+    while ( vp / 100 > vm / 100 )
+    {
+      roundUp  = (vr % 100 >= 50);
+      vr      /= 100;
+      vp      /= 100;
+      vm      /= 100;
+      removed += 2;
+    }
+
+    while ( vp / 10 > vm / 10 )
+    {
+      roundUp  = (vr % 10 >= 5);
+      vr      /= 10;
+      vp      /= 10;
+      vm      /= 10;
+      removed++;
+    }
+
+    output = vr;
+
+    if ( vr == vm || roundUp )
+    {
+      output++;
+    }
+  }
+
+  n     = Utils_::digitCount ( output );
+  exp10 = e10 + removed + n - 1;
+
+  Utils_::writeDigits ( digits, output, n );
+
+  // Strip trailing zeros.
+
+  while ( n > 1 && digits[n - 1] == '0' )
+  {
+    n--;
+  }
+
+  return n;
+}
+
+
+//-----------------------------------------------------------------------
+//   toPrecision
+//-----------------------------------------------------------------------
+
+// Stores the first ndigits decimal digits of the given number,
+// correctly rounded. The number must be finite and it may not be
+// negative, and ndigits must be between 1 and MAX_DIGITS.
+
+
+int FloatConv::toPrecision
+
+  ( char*   digits,
+    int&    exp10,
+    double  value,
+    int     ndigits )
+
+{
+  JEM_PRECHECK ( ndigits > 0 && ndigits <= MAX_DIGITS );
+
+  const ulint  bits = Utils_::toBits ( value );
+
+  Utils_::Scaled  s;
+  ulint           m, v;
+  int             e, k, q;
+
+
+  JEM_PRECHECK ( (bits >> MANTISSA_BITS_) < EXPONENT_MASK_ );
+
+  if ( bits == 0 )
+  {
+    std::memset ( digits, '0', (size_t) ndigits );
+
+    exp10 = 0;
+
+    return ndigits;
+  }
+
+  Utils_::decompose ( m, e, bits );
+
+  // Estimate the decimal exponent; it may be one too small.
+
+  k = e + Utils_::bitLength( m ) - 1;
+
+  if ( k >= 0 )
+  {
+    k =  Utils_::log10Pow2 (  k );
+  }
+  else
+  {
+    k = -Utils_::log10Pow2 ( -k ) - 1;
+  }
+
+  while ( true )
+  {
+    q = ndigits - 1 - k;
+
+    if ( ! Utils_::scale( s, m, q ) )
+    {
+      v = Utils_::exactScale ( m, e, q, 0 );
+    }
+    else
+    {
+      int  r = -(s.bexp + e);
+
+      if ( ! Utils_::round( v, s, r ) )
+      {
+        v = Utils_::exactScale ( m, e, q, v );
+      }
+    }
+
+    if ( v < POW10_[ndigits] )
+    {
+      break;
+    }
+
+    if ( v == POW10_[ndigits] )
+    {
+      v = POW10_[ndigits - 1];
+      k++;
+      break;
+    }
+
+    k++;
+  }
+
+  exp10 = k;
+
+  Utils_::writeDigits ( digits, v, ndigits );
+
+  return ndigits;
+}
+
+
+//-----------------------------------------------------------------------
+//   parse
+//-----------------------------------------------------------------------
+
+
+bool FloatConv::parse
+
+  ( double&      value,
+    const char*  str,
+    idx_t        len )
+
+{
+  const ulint  MAX_W = 1000000000000000000_ulint;
+
+  const char*  num;
+  bool         neg;
+  bool         frac;
+  bool         trunc;
+  ulint        w, bits;
+  long         x;
+  int          ndigits;
+  int          nsig;
+  int          q, esign;
+  idx_t        i, numlen;
+
+
+  i   = 0;
+  neg = false;
+
+  if ( i < len && (str[i] == '+' || str[i] == '-') )
+  {
+    neg = (str[i] == '-');
+    i++;
+  }
+
+  num     = str + i;
+  frac    = false;
+  trunc   = false;
+  w       = 0;
+  ndigits = 0;
+  nsig    = 0;
+  q       = 0;
+
+  for ( ; i < len; i++ )
+  {
+    const char  c = str[i];
+
+    if ( c >= '0' && c <= '9' )
+    {
+      ndigits++;
+
+      if ( nsig == 0 && c == '0' )
+      {
+        q -= frac ? 1 : 0;
+      }
+      else if ( w < MAX_W )
+      {
+        w  = 10 * w + (ulint) (c - '0');
+        q -= frac ? 1 : 0;
+        nsig++;
+      }
+      else
+      {
+        trunc = trunc || (c != '0');
+        q    += frac ? 0 : 1;
+        nsig++;
+      }
+    }
+    else if ( c == '.' && ! frac )
+    {
+      frac = true;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  if ( ndigits == 0 )
+  {
+    return false;
+  }
+
+  if ( i < len && (str[i] == 'e' || str[i] == 'E') )
+  {
+    i++;
+
+    esign = 1;
+    x     = 0;
+
+    if ( i < len && (str[i] == '+' || str[i] == '-') )
+    {
+      esign = (str[i] == '-') ? -1 : 1;
+      i++;
+    }
+
+    if ( i == len )
+    {
+      return false;
+    }
+
+    for ( ; i < len; i++ )
+    {
+      const char  c = str[i];
+
+      if ( c < '0' || c > '9' )
+      {
+        return false;
+      }
+
+      if ( x < 100000 )
+      {
+        x = 10 * x + (c - '0');
+      }
+    }
+
+    q += (int) (esign * x);
+  }
+
+  if ( i < len )
+  {
+    return false;
+  }
+
+  numlen = len - (idx_t) (num - str);
+
+  // Handle the simple cases first.
+
+  if ( w == 0 )
+  {
+    value = neg ? -0.0 : 0.0;
+    return true;
+  }
+
+  if ( ! trunc && w <= (1_ulint << 53) && q >= -22 && q <= 22 )
+  {
+    value = (double) w;
+
+    if ( q < 0 )
+    {
+      value /= EXACT_POW10_[-q];
+    }
+    else
+    {
+      value *= EXACT_POW10_[ q];
+    }
+
+    value = neg ? -value : value;
+
+    return true;
+  }
+
+  // Note that the value lies between 10^(q + n - 1) and 10^(q + n),
+  // with n the number of significant digits in w.
+
+  nsig = Utils_::digitCount ( w );
+
+  if      ( q + nsig < -324 )
+  {
+    bits = 0;
+  }
+  else if ( q + nsig > 310 )
+  {
+    bits = EXPONENT_MASK_ << MANTISSA_BITS_;
+  }
+  else
+  {
+    bool  ok = Utils_::makeBits ( bits, w, q );
+
+    if ( ok && trunc )
+    {
+      ulint  bits2;
+
+      ok = Utils_::makeBits ( bits2, w + 1_ulint, q ) && bits == bits2;
+    }
+
+    if ( ! ok )
+    {
+      bits = Utils_::exactParse ( num, numlen, bits );
+    }
+  }
+
+  value = Utils_::fromBits ( bits );
+  value = neg ? -value : value;
+
+  return true;
+}
+
+
+JEM_END_PACKAGE( io )
@@ -39,6 +39,29 @@ JEM_DEFINE_CLASS( jem::io::GzipFileWriter );
 JEM_BEGIN_PACKAGE( io )
 
 
+//=======================================================================
+//   private non-member functions
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   newGzipStream
+//-----------------------------------------------------------------------
+
+
+static Ref<OutputStream>  newGzipStream
+
+  ( const Ref<OutputStream>&  out,
+    int                       threads )
+
+{
+  Ref<GzipOutputStream>  gz = newInstance<GzipOutputStream> ( out );
+
+  gz->setThreads ( threads );
+
+  return gz;
+}
+
+
 //=======================================================================
 //   class GzipFileWriter
 //=======================================================================
@@ -51,12 +74,14 @@ JEM_BEGIN_PACKAGE( io )
 GzipFileWriter::GzipFileWriter
 
   ( const String&  name,
-    OpenFlags      flags ) :
+    OpenFlags      flags,
+    int            threads ) :
 
     Super (
-      newInstance<GzipOutputStream> (
+      newGzipStream (
         newInstance<FileOutputStream> (
-          name, flags & ~FileFlags::APPEND )
+          name, flags & ~FileFlags::APPEND ),
+        threads
       )
     )
 
@@ -27,11 +27,20 @@
  */
 
 
+#include <cstring>
 #include <jem/base/Time.h>
+#include <jem/base/Array.h>
+#include <jem/base/Thread.h>
+#include <jem/base/Monitor.h>
+#include <jem/base/MemCache.h>
 #include <jem/base/ClassTemplate.h>
+#include <jem/base/IllegalOperationException.h>
+#include <jem/util/ArrayBuffer.h>
 #include <jem/io/params.h>
 #include <jem/io/IOException.h>
+#include <jem/io/ZipException.h>
 #include <jem/io/GzipOutputStream.h>
+#include <jem/io/BlockDeflator.h>
 #include <jem/io/Deflator.h>
 
 
@@ -41,6 +50,15 @@ JEM_DEFINE_CLASS( jem::io::GzipOutputStream );
 JEM_BEGIN_PACKAGE( io )
 
 
+//=======================================================================
+//   private data
+//=======================================================================
+
+// The size of the gzip header that is written by the constructor.
+
+static const lint  HEADER_SIZE_ = 10;
+
+
 //=======================================================================
 //   private non-member functions
 //=======================================================================
@@ -65,10 +83,701 @@ inline void       writeLong
 }
 
 
+//-----------------------------------------------------------------------
+//   encodeLong
+//-----------------------------------------------------------------------
+
+
+inline byte*      encodeLong
+
+  ( byte*           buf,
+    ulint           num,
+    int             size )
+
+{
+  for ( int i = 0; i < size; i++ )
+  {
+    buf[i] = (byte) (num & 255_ulint);
+    num    = num >> 8;
+  }
+
+  return (buf + size);
+}
+
+
+//-----------------------------------------------------------------------
+//   writeIndex
+//-----------------------------------------------------------------------
+
+// The block index is a sequence of 64-bit, little-endian integers.
+// The first integer is the number of blocks; it is followed by the
+// compressed and uncompressed offsets of each block. The compressed
+// offsets are relative to the start of the gzip stream.
+
+
+static void       writeIndex
+
+  ( OutputStream&   out,
+    const lint*     offsets,
+    idx_t           n,
+    ThrowMode       tm )
+
+{
+  byte   buf[128];
+  byte*  pos;
+
+
+  pos = encodeLong ( buf, (ulint) (n / 2), 8 );
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    pos = encodeLong ( pos, (ulint) offsets[i], 8 );
+
+    if ( (pos - buf) == 128 || i == (n - 1) )
+    {
+      if ( tm == CAN_THROW )
+      {
+        out.write        ( buf, (idx_t) (pos - buf) );
+      }
+      else
+      {
+        out.writeNoThrow ( buf, (idx_t) (pos - buf) );
+      }
+
+      pos = buf;
+    }
+  }
+
+  if ( n == 0 )
+  {
+    if ( tm == CAN_THROW )
+    {
+      out.write        ( buf, 8 );
+    }
+    else
+    {
+      out.writeNoThrow ( buf, 8 );
+    }
+  }
+}
+
+
+//=======================================================================
+//   class GzipOutputStream::Parallel_
+//=======================================================================
+
+// In parallel mode the input is split into blocks that are compressed
+// independently by a set of worker threads. Each block is a raw
+// deflate stream that is terminated by a sync flush, except for the
+// last block which is terminated normally. The concatenation of the
+// blocks is therefore a single, standard deflate stream that can be
+// read by any gzip decoder. Because a block does not refer to data
+// in a preceding block, decompression can also be started at the
+// beginning of any block.
+//
+// The blocks are stored in a ring buffer. The producer fills the
+// block with index (filled % count); the workers compress the block
+// with index (taken % count); and the producer writes the compressed
+// blocks in order, starting with index (written % count).
+
+
+class GzipOutputStream::Parallel_ : public Collectable
+{
+ public:
+
+  struct                  Block
+  {
+    byte*                   input;
+    byte*                   output;
+    idx_t                   isize;
+    idx_t                   osize;
+    ulint                   crc;
+    bool                    last;
+    bool                    done;
+    String                  error;
+  };
+
+
+                          Parallel_
+
+    ( int                   level,
+      int                   nthreads,
+      idx_t                 blockSize,
+      lint                  offset );
+
+  void                    start       ();
+  void                    stop        ();
+
+  void                    write
+
+    ( const void*           buf,
+      idx_t                 n,
+      OutputStream&         out );
+
+  void                    handOff
+
+    ( bool                  last,
+      OutputStream&         out,
+      ThrowMode             tm = CAN_THROW );
+
+  void                    drain
+
+    ( OutputStream&         out,
+      ThrowMode             tm = CAN_THROW );
+
+  static void             compress
+
+    ( Block&                block,
+      BlockDeflator&        def );
+
+
+ public:
+
+  Monitor                 monitor;
+  const int               level;
+  const idx_t             blockSize;
+  const int               blockCount;
+  Block*                  blocks;
+  lint                    filled;
+  lint                    taken;
+  bool                    quit;
+
+  idx_t                   fill;
+  lint                    written;
+  lint                    coffset;
+  lint                    uoffset;
+  ulint                   crc;
+  String                  error;
+
+  Ref<BlockDeflator>      deflator;
+  Array< Ref<Thread> >    workers;
+
+  util::ArrayBuffer<lint> index;
+
+
+ protected:
+
+  virtual                ~Parallel_   ();
+
+
+ private:
+
+  bool                    writeNext_
+
+    ( OutputStream&         out,
+      ThrowMode             tm,
+      bool                  wait );
+
+  void                    checkError_
+
+    ( ThrowMode             tm );
+
+  void                    freeBlocks_ ();
+
+
+ private:
+
+  idx_t                   outSize_;
+
+};
+
+
+//=======================================================================
+//   class GzipOutputStream::Worker_
+//=======================================================================
+
+
+class GzipOutputStream::Worker_ : public Thread
+{
+ public:
+
+                          Worker_
+
+    ( const Ref<Parallel_>&     par,
+      const Ref<BlockDeflator>& def );
+
+  virtual void            run     () override;
+
+
+ protected:
+
+  virtual                ~Worker_ ();
+
+
+ private:
+
+  Ref<Parallel_>          par_;
+  Ref<BlockDeflator>      deflator_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+GzipOutputStream::Worker_::Worker_
+
+  ( const Ref<Parallel_>&      par,
+    const Ref<BlockDeflator>&  def ) :
+
+    par_      ( par ),
+    deflator_ ( def )
+
+{}
+
+
+GzipOutputStream::Worker_::~Worker_ ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::Worker_::run ()
+{
+  Parallel_&     p = *par_;
+  Lock<Monitor>  lock ( p.monitor );
+
+  allowCancel ( false );
+
+  while ( true )
+  {
+    while ( p.taken == p.filled && ! p.quit )
+    {
+      p.monitor.waitNoCancel ();
+    }
+
+    if ( p.taken == p.filled )
+    {
+      break;
+    }
+
+    Parallel_::Block&  b = p.blocks[p.taken % p.blockCount];
+
+    p.taken++;
+
+    p.monitor.unlock ();
+    Parallel_::compress ( b, *deflator_ );
+    p.monitor.lock   ();
+
+    b.done = true;
+
+    p.monitor.notifyAll ();
+  }
+}
+
+
+//=======================================================================
+//   class GzipOutputStream::Parallel_ (implementation)
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+GzipOutputStream::Parallel_::Parallel_
+
+  ( int    lvl,
+    int    nthreads,
+    idx_t  bsize,
+    lint   offset ) :
+
+    level      ( lvl   ),
+    blockSize  ( bsize ),
+    blockCount ( 2 * max ( 1, nthreads ) )
+
+{
+  deflator = newInstance<BlockDeflator> ( level );
+  outSize_ = deflator->maxOutputSize ( blockSize );
+  blocks   = new Block[blockCount];
+
+  for ( int i = 0; i < blockCount; i++ )
+  {
+    Block&  b = blocks[i];
+
+    b.input  = nullptr;
+    b.output = nullptr;
+    b.isize  = 0;
+    b.osize  = 0;
+    b.crc    = 0;
+    b.last   = false;
+    b.done   = false;
+  }
+
+  try
+  {
+    for ( int i = 0; i < blockCount; i++ )
+    {
+      Block&  b = blocks[i];
+
+      b.input  = (byte*) MemCache::alloc ( (size_t) blockSize );
+      b.output = (byte*) MemCache::alloc ( (size_t) outSize_  );
+    }
+
+#ifdef JEM_USE_THREADS
+
+    workers.resize ( nthreads );
+
+    for ( int i = 0; i < nthreads; i++ )
+    {
+      workers[i] = nullptr;
+    }
+
+#endif
+
+  }
+  catch ( ... )
+  {
+    freeBlocks_ ();
+    throw;
+  }
+
+  filled  = 0;
+  taken   = 0;
+  quit    = false;
+  fill    = 0;
+  written = 0;
+  coffset = offset;
+  uoffset = 0;
+  crc     = BlockDeflator::checksum ( 0, nullptr, 0 );
+}
+
+
+GzipOutputStream::Parallel_::~Parallel_ ()
+{
+  freeBlocks_ ();
+}
+
+
+//-----------------------------------------------------------------------
+//   start
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::Parallel_::start ()
+{
+  const idx_t  n = workers.size ();
+
+  // Each worker needs its own deflator; the one owned by this object
+  // is only used when there are no worker threads.
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    workers[i] = newInstance<Worker_> (
+      this,
+      newInstance<BlockDeflator> ( level )
+    );
+  }
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    workers[i]->start ();
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   stop
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::Parallel_::stop ()
+{
+  const idx_t  n = workers.size ();
+
+  monitor.lock      ();
+  quit = true;
+  monitor.notifyAll ();
+  monitor.unlock    ();
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    if ( workers[i] )
+    {
+      workers[i]->join ();
+    }
+  }
+
+  // This breaks the cycle between this object and the workers.
+
+  workers.resize ( 0 );
+}
+
+
+//-----------------------------------------------------------------------
+//   write
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::Parallel_::write
+
+  ( const void*    buf,
+    idx_t          n,
+    OutputStream&  out )
+
+{
+  const byte*  src = (const byte*) buf;
+
+  checkError_ ( CAN_THROW );
+
+  while ( n > 0 )
+  {
+    Block&  b = blocks[filled % blockCount];
+    idx_t   k = min ( n, blockSize - fill );
+
+    std::memcpy ( b.input + fill, src, (size_t) k );
+
+    fill += k;
+    src  += k;
+    n    -= k;
+
+    if ( fill == blockSize )
+    {
+      handOff ( false, out );
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   handOff
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::Parallel_::handOff
+
+  ( bool           last,
+    OutputStream&  out,
+    ThrowMode      tm )
+
+{
+  Block&  b = blocks[filled % blockCount];
+
+  if ( fill == 0 && ! last )
+  {
+    return;
+  }
+
+  b.isize = fill;
+  b.last  = last;
+  b.done  = false;
+  fill    = 0;
+
+  if ( workers.size() == 0 )
+  {
+    compress ( b, *deflator );
+
+    b.done = true;
+    filled++;
+  }
+  else
+  {
+    Lock<Monitor>  lock ( monitor );
+
+    filled++;
+    monitor.notifyAll ();
+  }
+
+  // Write the blocks that have been compressed and make sure that
+  // the next block is available.
+
+  while ( writeNext_( out, tm, false ) ) ;
+
+  while ( filled - written >= blockCount )
+  {
+    writeNext_ ( out, tm, true );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   drain
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::Parallel_::drain
+
+  ( OutputStream&  out,
+    ThrowMode      tm )
+
+{
+  while ( written < filled )
+  {
+    writeNext_ ( out, tm, true );
+  }
+
+  checkError_ ( tm );
+}
+
+
+//-----------------------------------------------------------------------
+//   compress
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::Parallel_::compress
+
+  ( Block&          b,
+    BlockDeflator&  def )
+
+{
+  try
+  {
+    b.crc   = BlockDeflator::checksum ( 0, nullptr, 0 );
+    b.crc   = BlockDeflator::checksum ( b.crc, b.input, b.isize );
+    b.osize = def.deflate ( b.output, def.maxOutputSize( b.isize ),
+                            b.input,  b.isize, b.last );
+  }
+  catch ( const Throwable& ex )
+  {
+    b.osize = 0;
+    b.error = ex.what ();
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   writeNext_
+//-----------------------------------------------------------------------
+
+
+bool GzipOutputStream::Parallel_::writeNext_
+
+  ( OutputStream&  out,
+    ThrowMode      tm,
+    bool           wait )
+
+{
+  if ( written == filled )
+  {
+    return false;
+  }
+
+  Block&  b = blocks[written % blockCount];
+
+  {
+    Lock<Monitor>  lock ( monitor );
+
+    if ( ! b.done && ! wait )
+    {
+      return false;
+    }
+
+    while ( ! b.done )
+    {
+      if ( tm == CAN_THROW )
+      {
+        monitor.wait         ();
+      }
+      else
+      {
+        monitor.waitNoCancel ();
+      }
+    }
+  }
+
+  written++;
+
+  if ( b.error.size() )
+  {
+    if ( ! error.size() )
+    {
+      error = b.error;
+    }
+
+    b.error = String ();
+  }
+
+  // Data are discarded after an error, but the remaining blocks are
+  // still processed so that the ring buffer stays consistent.
+
+  if ( error.size() )
+  {
+    checkError_ ( tm );
+    return true;
+  }
+
+  index.pushBack ( coffset );
+  index.pushBack ( uoffset );
+
+  coffset += b.osize;
+  uoffset += b.isize;
+  crc      = BlockDeflator::combine ( crc, b.crc, b.isize );
+
+  if ( tm == CAN_THROW )
+  {
+    out.write        ( b.output, b.osize );
+  }
+  else
+  {
+    out.writeNoThrow ( b.output, b.osize );
+  }
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------
+//   checkError_
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::Parallel_::checkError_ ( ThrowMode tm )
+{
+  if ( error.size() && tm == CAN_THROW )
+  {
+    throw ZipException ( JEM_FUNC, error );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   freeBlocks_
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::Parallel_::freeBlocks_ ()
+{
+  if ( blocks )
+  {
+    for ( int i = 0; i < blockCount; i++ )
+    {
+      Block&  b = blocks[i];
+
+      if ( b.input )
+      {
+        MemCache::dealloc ( b.input,  (size_t) blockSize );
+      }
+
+      if ( b.output )
+      {
+        MemCache::dealloc ( b.output, (size_t) outSize_  );
+      }
+    }
+
+    delete [] blocks;
+
+    blocks = nullptr;
+  }
+}
+
+
 //=======================================================================
 //   class GzipOutputStream
 //=======================================================================
 
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+const idx_t  GzipOutputStream::DEFAULT_BLOCK_SIZE = 128 * 1024;
+
 //-----------------------------------------------------------------------
 //   constructor & destructor
 //-----------------------------------------------------------------------
@@ -80,7 +789,8 @@ GzipOutputStream::GzipOutputStream
     int                level,
     idx_t              bufsize ) :
 
-    output_ ( out )
+    output_ ( out ),
+    level_  ( level )
 
 {
   JEM_PRECHECK ( out );
@@ -136,7 +846,7 @@ GzipOutputStream::GzipOutputStream
 
 GzipOutputStream::~GzipOutputStream ()
 {
-  if ( deflator_ )
+  if ( deflator_ || parallel_ )
   {
     finish_ ( NO_THROW );
   }
@@ -150,7 +860,7 @@ GzipOutputStream::~GzipOutputStream ()
 
 void GzipOutputStream::close ()
 {
-  if ( deflator_ )
+  if ( deflator_ || parallel_ )
   {
     finish_        ();
     output_->close ();
@@ -165,7 +875,13 @@ void GzipOutputStream::close ()
 
 void GzipOutputStream::flush ()
 {
-  if ( deflator_ )
+  if ( parallel_ )
+  {
+    parallel_->handOff ( false, *output_ );
+    parallel_->drain   ( *output_ );
+    output_  ->flush   ();
+  }
+  else if ( deflator_ )
   {
     deflator_->sync  ();
     output_  ->flush ();
@@ -180,6 +896,12 @@ void GzipOutputStream::flush ()
 
 void GzipOutputStream::write ( const void* buf, idx_t n )
 {
+  if ( parallel_ )
+  {
+    parallel_->write ( buf, n, *output_ );
+    return;
+  }
+
   if ( ! deflator_ )
   {
     throw IOException ( JEM_FUNC, "output stream not open" );
@@ -200,13 +922,78 @@ void GzipOutputStream::writeNoThrow
     idx_t        n ) noexcept
 
 {
-  if ( deflator_ )
+  if ( parallel_ )
+  {
+    try
+    {
+      parallel_->write ( buf, n, *output_ );
+    }
+    catch ( ... )
+    {}
+  }
+  else if ( deflator_ )
   {
     deflator_->deflate ( buf, n, NO_THROW );
   }
 }
 
 
+//-----------------------------------------------------------------------
+//   setThreads
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::setThreads
+
+  ( int    count,
+    idx_t  blockSize )
+
+{
+  if ( count <= 0 || parallel_ )
+  {
+    return;
+  }
+
+  if ( ! deflator_ || deflator_->getBytesIn() > 0 )
+  {
+    throw IllegalOperationException (
+      JEM_FUNC,
+      "the number of compression threads can only be set before "
+      "writing to a gzip output stream"
+    );
+  }
+
+  if ( blockSize <= 0 )
+  {
+    blockSize = DEFAULT_BLOCK_SIZE;
+  }
+
+  blockSize = max ( blockSize, 1024_idx );
+  blockSize = min ( blockSize, 64_idx * 1024 * 1024 );
+
+  // Write the gzip header and continue in parallel mode.
+
+  lint  offset = deflator_->flush ();
+
+  parallel_ = newInstance<Parallel_> ( level_,    count,
+                                       blockSize, offset );
+  deflator_ = nullptr;
+
+  parallel_->start ();
+}
+
+
+//-----------------------------------------------------------------------
+//   setBlockIndex
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::setBlockIndex ( Ref<OutputStream> index )
+{
+  index_ = index;
+}
+
+
 //-----------------------------------------------------------------------
 //   finish_
 //-----------------------------------------------------------------------
@@ -214,6 +1001,12 @@ void GzipOutputStream::writeNoThrow
 
 void GzipOutputStream::finish_ ( ThrowMode tm )
 {
+  if ( parallel_ )
+  {
+    finishBlocks_ ( tm );
+    return;
+  }
+
   deflator_->finish ( tm );
 
   writeLong ( *deflator_, deflator_->getChecksum() );
@@ -222,6 +1015,90 @@ void GzipOutputStream::finish_ ( ThrowMode tm )
   deflator_->flush  ( tm );
 
   deflator_ = nullptr;
+
+  // Without compression threads the data are stored as a single
+  // block that starts right after the header.
+
+  if ( index_ )
+  {
+    const lint  offsets[2] = { HEADER_SIZE_, 0 };
+
+    writeIndex  ( *index_, offsets, 2, tm );
+    closeIndex_ ( tm );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   finishBlocks_
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::finishBlocks_ ( ThrowMode tm )
+{
+  Ref<Parallel_>  p = parallel_;
+
+  byte            buf[8];
+
+  parallel_ = nullptr;
+
+  try
+  {
+    p->handOff ( true, *output_, tm );
+    p->drain   ( *output_, tm );
+  }
+  catch ( ... )
+  {
+    p->stop ();
+
+    if ( tm == CAN_THROW )
+    {
+      throw;
+    }
+
+    return;
+  }
+
+  p->stop ();
+
+  if ( p->error.size() )
+  {
+    return;
+  }
+
+  encodeLong ( buf,     p->crc,            4 );
+  encodeLong ( buf + 4, (ulint) p->uoffset, 4 );
+
+  if ( tm == CAN_THROW )
+  {
+    output_->write        ( buf, 8 );
+  }
+  else
+  {
+    output_->writeNoThrow ( buf, 8 );
+  }
+
+  if ( index_ )
+  {
+    writeIndex ( *index_, p->index.addr(), p->index.size(), tm );
+    closeIndex_ ( tm );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   closeIndex_
+//-----------------------------------------------------------------------
+
+
+void GzipOutputStream::closeIndex_ ( ThrowMode tm )
+{
+  if ( tm == CAN_THROW )
+  {
+    index_->close ();
+  }
+
+  index_ = nullptr;
 }
 
 
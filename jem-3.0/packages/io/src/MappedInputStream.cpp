@@ -0,0 +1,310 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <cstring>
+#include <jem/base/limits.h>
+#include <jem/base/ClassTemplate.h>
+#include <jem/base/IllegalArgumentException.h>
+#include <jem/io/IOException.h>
+#include <jem/io/EOFException.h>
+#include <jem/io/MappedFile.h>
+#include <jem/io/MappedInputStream.h>
+
+
+JEM_DEFINE_CLASS( jem::io::MappedInputStream );
+
+
+JEM_BEGIN_PACKAGE( io )
+
+
+//=======================================================================
+//   class MappedInputStream
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructors & destructor
+//-----------------------------------------------------------------------
+
+
+MappedInputStream::MappedInputStream ( const String& name ) :
+
+  file_ ( newInstance<MappedFile>( name ) )
+
+{
+  addr_ = file_->addr ();
+  size_ = file_->size ();
+  pos_  = 0;
+}
+
+
+MappedInputStream::MappedInputStream ( Ref<MappedFile> file ) :
+
+  file_ ( file )
+
+{
+  JEM_PRECHECK ( file );
+
+  addr_ = file_->addr ();
+  size_ = file_->size ();
+  pos_  = 0;
+}
+
+
+MappedInputStream::MappedInputStream ( const Self& rhs ) :
+
+  file_ ( rhs.file_ ),
+  addr_ ( rhs.addr_ ),
+  size_ ( rhs.size_ ),
+  pos_  ( rhs.pos_  )
+
+{}
+
+
+MappedInputStream::~MappedInputStream ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   dup
+//-----------------------------------------------------------------------
+
+
+Ref<InputStream> MappedInputStream::dup ()
+{
+  return newInstance<Self> ( *this );
+}
+
+
+//-----------------------------------------------------------------------
+//   close
+//-----------------------------------------------------------------------
+
+
+void MappedInputStream::close ()
+{
+  // The file is unmapped when the last stream referring to it has
+  // been closed or deleted.
+
+  file_ = nullptr;
+  addr_ = nullptr;
+  size_ = pos_ = 0;
+}
+
+
+//-----------------------------------------------------------------------
+//   poll
+//-----------------------------------------------------------------------
+
+
+idx_t MappedInputStream::poll ( const Time& timeout )
+{
+  return (idx_t) min ( available(), (lint) maxOf<idx_t>() );
+}
+
+
+//-----------------------------------------------------------------------
+//   read
+//-----------------------------------------------------------------------
+
+
+idx_t MappedInputStream::read ( void* buf, idx_t n )
+{
+  if ( ! file_ || ! file_->isOpen() )
+  {
+    closedError_ ();
+  }
+
+  n = (idx_t) min ( (lint) n, size_ - pos_ );
+
+  if ( n > 0 )
+  {
+    std::memcpy ( buf, addr_ + pos_, (size_t) n );
+
+    pos_ += n;
+  }
+
+  return n;
+}
+
+
+//-----------------------------------------------------------------------
+//   readAll
+//-----------------------------------------------------------------------
+
+
+void MappedInputStream::readAll ( void* buf, idx_t n )
+{
+  std::memcpy ( buf, readSpan( n ), (size_t) n );
+}
+
+
+//-----------------------------------------------------------------------
+//   skip
+//-----------------------------------------------------------------------
+
+
+idx_t MappedInputStream::skip ( idx_t n )
+{
+  if ( ! file_ || ! file_->isOpen() )
+  {
+    closedError_ ();
+  }
+
+  if ( n <= 0 )
+  {
+    return 0_idx;
+  }
+
+  n     = (idx_t) min ( (lint) n, size_ - pos_ );
+  pos_ += n;
+
+  return n;
+}
+
+
+//-----------------------------------------------------------------------
+//   readSpan
+//-----------------------------------------------------------------------
+
+
+const byte* MappedInputStream::readSpan ( idx_t n )
+{
+  if ( ! file_ || ! file_->isOpen() )
+  {
+    closedError_ ();
+  }
+
+  if ( n < 0 || (lint) n > size_ - pos_ )
+  {
+    eofError_ ( n );
+  }
+
+  const byte*  span = addr_ + pos_;
+
+  pos_ += n;
+
+  return span;
+}
+
+
+//-----------------------------------------------------------------------
+//   available
+//-----------------------------------------------------------------------
+
+
+lint MappedInputStream::available () const
+{
+  if ( file_ && file_->isOpen() )
+  {
+    return (size_ - pos_);
+  }
+  else
+  {
+    return 0_lint;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   getPosition
+//-----------------------------------------------------------------------
+
+
+lint MappedInputStream::getPosition () const
+{
+  return pos_;
+}
+
+
+//-----------------------------------------------------------------------
+//   setPosition
+//-----------------------------------------------------------------------
+
+
+void MappedInputStream::setPosition ( lint pos )
+{
+  if ( pos < 0 || pos > size_ )
+  {
+    throw IllegalArgumentException (
+      JEM_FUNC,
+      String::format (
+        "invalid file position: %d; valid range is [0,%d]",
+        pos,
+        size_
+      )
+    );
+  }
+
+  pos_ = pos;
+}
+
+
+//-----------------------------------------------------------------------
+//   getMappedFile
+//-----------------------------------------------------------------------
+
+
+Ref<MappedFile> MappedInputStream::getMappedFile () const
+{
+  return file_;
+}
+
+
+//-----------------------------------------------------------------------
+//   closedError_
+//-----------------------------------------------------------------------
+
+
+void MappedInputStream::closedError_ () const
+{
+  throw IOException (
+    JEM_FUNC,
+    "attempt to read from a closed memory-mapped file"
+  );
+}
+
+
+//-----------------------------------------------------------------------
+//   eofError_
+//-----------------------------------------------------------------------
+
+
+void MappedInputStream::eofError_ ( idx_t n ) const
+{
+  throw EOFException (
+    JEM_FUNC,
+    String::format (
+      "unexpected end of input; expected %d more bytes",
+      (lint) n - (size_ - pos_)
+    )
+  );
+}
+
+
+JEM_END_PACKAGE( io )
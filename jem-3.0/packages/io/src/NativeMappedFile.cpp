@@ -0,0 +1,170 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <jem/base/CString.h>
+#include <jem/base/LogBuffer.h>
+#include <jem/base/native/System.h>
+#include <jem/io/IOException.h>
+#include <jem/io/FileOpenException.h>
+#include "native/PosixMappedFile.h"
+
+extern "C"
+{
+  #include <sys/types.h>
+  #include <sys/stat.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+  #include <fcntl.h>
+}
+
+
+JEM_BEGIN_PACKAGE( io )
+
+
+//=======================================================================
+//   class PosixMappedFile
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   map
+//-----------------------------------------------------------------------
+
+
+void* PosixMappedFile::map
+
+  ( lint&          size,
+    const String&  name )
+
+{
+  struct stat  st;
+  void*        addr;
+  int          fd;
+
+
+  if ( name.size() == 0 )
+  {
+    throw FileOpenException (
+      JEM_FUNC,
+      "error opening file: empty file name"
+    );
+  }
+
+  fd = ::open ( makeCString( name ), O_RDONLY );
+
+  if ( fd == -1 )
+  {
+    String  details = NativeSystem::strerror ();
+
+    throw FileOpenException (
+      JEM_FUNC,
+      String::format (
+        "error opening file `%s\' (%s)", name, details
+      )
+    );
+  }
+
+  if ( ::fstat( fd, &st ) != 0 )
+  {
+    String  details = NativeSystem::strerror ();
+
+    ::close ( fd );
+
+    throw IOException (
+      JEM_FUNC,
+      String::format (
+        "error getting the size of file `%s\' (%s)", name, details
+      )
+    );
+  }
+
+  size = (lint) st.st_size;
+  addr = nullptr;
+
+  // An empty file can not be mapped; it simply has no data.
+
+  if ( size > 0 )
+  {
+    addr = ::mmap ( nullptr, (size_t) size, PROT_READ,
+                    MAP_PRIVATE, fd, 0 );
+
+    if ( addr == MAP_FAILED )
+    {
+      String  details = NativeSystem::strerror ();
+
+      ::close ( fd );
+
+      throw IOException (
+        JEM_FUNC,
+        String::format (
+          "error mapping file `%s\' into memory (%s)", name, details
+        )
+      );
+    }
+
+#ifdef MADV_SEQUENTIAL
+
+    ::madvise ( addr, (size_t) size, MADV_SEQUENTIAL );
+
+#endif
+  }
+
+  // The mapping remains valid after the file has been closed.
+
+  ::close ( fd );
+
+  LogBuffer::pushBack (
+    JEM_FUNC,
+    String::format (
+      "mapped file `%s\' (%d bytes)", name, size
+    )
+  );
+
+  return addr;
+}
+
+
+//-----------------------------------------------------------------------
+//   unmap
+//-----------------------------------------------------------------------
+
+
+void PosixMappedFile::unmap
+
+  ( void*  addr,
+    lint   size ) noexcept
+
+{
+  if ( addr && size > 0 )
+  {
+    ::munmap ( addr, (size_t) size );
+  }
+}
+
+
+JEM_END_PACKAGE( io )
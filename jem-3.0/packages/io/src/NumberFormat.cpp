@@ -27,10 +27,12 @@
  */
 
 
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <jem/io/DataInput.h>
 #include <jem/io/DataOutput.h>
+#include <jem/io/FloatConv.h>
 #include <jem/io/NumberFormat.h>
 
 
@@ -62,9 +64,169 @@ class NumberFormat::Utils_
     }
   }
 
+  static int  putFixed
+
+    ( char*        str,
+      int          i,
+      const char*  digits,
+      int          n,
+      int          exp10,
+      int          frac );
+
+  static int  putExp
+
+    ( char*        str,
+      int          i,
+      const char*  digits,
+      int          n,
+      int          exp10,
+      int          frac,
+      bool         upper );
+
+  static int  justify
+
+    ( char*        buf,
+      const char*  str,
+      int          n,
+      int          width );
+
 };
 
 
+//-----------------------------------------------------------------------
+//   putFixed
+//-----------------------------------------------------------------------
+
+// Prints the number d[0].d[1]d[2]... * 10^exp10 in fixed notation with
+// frac digits after the decimal point. Missing digits are zero.
+
+
+int NumberFormat::Utils_::putFixed
+
+  ( char*        str,
+    int          i,
+    const char*  digits,
+    int          n,
+    int          exp10,
+    int          frac )
+
+{
+  int  j;
+
+  if ( exp10 < 0 )
+  {
+    str[i++] = '0';
+  }
+
+  for ( j = 0; j <= exp10; j++ )
+  {
+    str[i++] = (j < n) ? digits[j] : '0';
+  }
+
+  str[i++] = '.';
+
+  for ( j = exp10 + 1; j <= exp10 + frac; j++ )
+  {
+    str[i++] = (j >= 0 && j < n) ? digits[j] : '0';
+  }
+
+  return i;
+}
+
+
+//-----------------------------------------------------------------------
+//   putExp
+//-----------------------------------------------------------------------
+
+
+int NumberFormat::Utils_::putExp
+
+  ( char*        str,
+    int          i,
+    const char*  digits,
+    int          n,
+    int          exp10,
+    int          frac,
+    bool         upper )
+
+{
+  str[i++] = digits[0];
+  str[i++] = '.';
+
+  for ( int j = 1; j <= frac; j++ )
+  {
+    str[i++] = (j < n) ? digits[j] : '0';
+  }
+
+  str[i++] = upper ? 'E' : 'e';
+
+  if ( exp10 < 0 )
+  {
+    str[i++] = '-';
+    exp10    = -exp10;
+  }
+  else
+  {
+    str[i++] = '+';
+  }
+
+  if ( exp10 >= 100 )
+  {
+    str[i++] = (char) ('0' + exp10 / 100);
+    exp10   %= 100;
+  }
+
+  str[i++] = (char) ('0' + exp10 / 10);
+  str[i++] = (char) ('0' + exp10 % 10);
+
+  return i;
+}
+
+
+//-----------------------------------------------------------------------
+//   justify
+//-----------------------------------------------------------------------
+
+
+int NumberFormat::Utils_::justify
+
+  ( char*        buf,
+    const char*  str,
+    int          n,
+    int          width )
+
+{
+  int  i, k;
+
+  if ( n < width )
+  {
+    k = width - n;
+
+    for ( i = 0; i < k; i++ )
+    {
+      buf[i] = ' ';
+    }
+
+    std::memcpy ( buf + k, str, (size_t) n );
+
+    n += k;
+  }
+  else
+  {
+    std::memcpy ( buf, str, (size_t) n );
+
+    k = -width;
+
+    while ( n < k )
+    {
+      buf[n++] = ' ';
+    }
+  }
+
+  return n;
+}
+
+
 //=======================================================================
 //   class NumberFormat
 //=======================================================================
@@ -77,6 +239,7 @@ class NumberFormat::Utils_
 const int    NumberFormat::SCIENTIFIC    = 1 << 0;
 const int    NumberFormat::UPPERCASE     = 1 << 1;
 const int    NumberFormat::SHOW_SIGN     = 1 << 2;
+const int    NumberFormat::SHORTEST      = 1 << 3;
 
 const char*  NumberFormat::LOWER_DIGITS_ = "0123456789abcdefx";
 const char*  NumberFormat::UPPER_DIGITS_ = "0123456789ABCDEFX";
@@ -354,9 +517,95 @@ String NumberFormat::print ( lint num ) const
 //-----------------------------------------------------------------------
 
 
+// The digits are generated by the FloatConv class; the output is
+// the same as that of sprintf, but it is obtained much faster. The
+// SHORTEST flag selects the shortest representation that can be read
+// back without loss of precision.
+
+
 int NumberFormat::print ( char* buf, double num ) const
 {
-  return std::sprintf ( buf, format_, floatWidth_, fracDigits_, num );
+  const bool  upper = (flags_ & UPPERCASE);
+
+  char        digits[FloatConv::MAX_DIGITS];
+  char        str[MIN_BUFSIZE];
+  int         prec, exp10;
+  int         i, n;
+
+
+  if ( flags_ & SCIENTIFIC )
+  {
+    prec = fracDigits_ + 1;
+  }
+  else
+  {
+    prec = (fracDigits_ > 0) ? fracDigits_ : 1;
+  }
+
+  if ( ! std::isfinite( num ) ||
+       (prec > FloatConv::MAX_DIGITS && ! (flags_ & SHORTEST)) )
+  {
+    return std::sprintf ( buf, format_, floatWidth_, fracDigits_, num );
+  }
+
+  i = 0;
+
+  if ( std::signbit( num ) )
+  {
+    str[i++] = '-';
+    num      = -num;
+  }
+  else if ( flags_ & SHOW_SIGN )
+  {
+    str[i++] = '+';
+  }
+
+  if ( flags_ & SHORTEST )
+  {
+    n = FloatConv::toShortest ( digits, exp10, num );
+
+    if ( (flags_ & SCIENTIFIC) || exp10 < -4 || exp10 >= 16 )
+    {
+      i = Utils_::putExp   ( str, i, digits, n, exp10,
+                             (n > 1) ? n - 1 : 1, upper );
+    }
+    else
+    {
+      i = Utils_::putFixed ( str, i, digits, n, exp10,
+                             (n - 1 - exp10 > 0) ? n - 1 - exp10 : 1 );
+    }
+  }
+  else
+  {
+    n = FloatConv::toPrecision ( digits, exp10, num, prec );
+
+    if      ( flags_ & SCIENTIFIC )
+    {
+      i = Utils_::putExp   ( str, i, digits, n, exp10,
+                             prec - 1, upper );
+    }
+    else if ( exp10 < -4 || exp10 >= prec )
+    {
+      int  frac = prec - 1;
+
+      // Mimic the C library: if rounding has carried the number into
+      // the exponential notation, the fraction digits are dropped.
+
+      if ( exp10 == prec && num < std::pow( 10.0, exp10 ) )
+      {
+        frac = 0;
+      }
+
+      i = Utils_::putExp   ( str, i, digits, n, exp10, frac, upper );
+    }
+    else
+    {
+      i = Utils_::putFixed ( str, i, digits, n, exp10,
+                             prec - 1 - exp10 );
+    }
+  }
+
+  return Utils_::justify ( buf, str, i, floatWidth_ );
 }
 
 
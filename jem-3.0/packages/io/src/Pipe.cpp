@@ -44,6 +44,14 @@ JEM_BEGIN_PACKAGE( io )
 //   class Pipe
 //=======================================================================
 
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+const byte  Pipe::CANARY_VALUE_ = 123;
+
+
 //-----------------------------------------------------------------------
 //   constructor & destructor
 //-----------------------------------------------------------------------
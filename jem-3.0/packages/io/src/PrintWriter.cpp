@@ -28,7 +28,6 @@
 
 
 #include <cctype>
-#include <cstdio>
 #include <jem/base/assert.h>
 #include <jem/base/MemCache.h>
 #include <jem/base/ClassTemplate.h>
@@ -646,9 +645,7 @@ void PrintWriter::printFloat ( double value )
     d.flush ();
   }
 
-  n = std::sprintf ( d.buffer + d.last,
-                     nf.format_, nf.floatWidth_, nf.fracDigits_, value );
-
+  n       = nf.print ( d.buffer + d.last, value );
   d.last += n;
 }
 
@@ -138,21 +138,32 @@ idx_t ReadBuffer::readUntil
     int      delim )
 
 {
-  idx_t  i = 0;
+  const char*  src;
+  const char*  end;
+  idx_t        i, k;
+
+
+  i = 0;
 
   do
   {
-    while ( first_ != last_ )
+    k   = min ( last_ - first_, n - i );
+    src = buffer_ + first_;
+    end = (const char*) std::memchr ( src, delim, (size_t) k );
+
+    if ( end )
     {
-      if ( i >= n || buffer_[first_] == delim )
-      {
-        return i;
-      }
-      else
-      {
-        buf[i] = buffer_[first_];
-        i++; first_++;
-      }
+      k = (idx_t) (end - src);
+    }
+
+    std::memcpy ( buf + i, src, (size_t) k );
+
+    i      += k;
+    first_ += k;
+
+    if ( end || i >= n )
+    {
+      return i;
     }
 
     fillBuffer_ ( in );
@@ -35,6 +35,7 @@
 #include <jem/base/ClassTemplate.h>
 #include <jem/base/ParseException.h>
 #include <jem/base/IllegalOperationException.h>
+#include <jem/io/FloatConv.h>
 #include <jem/io/Reader.h>
 
 
@@ -557,7 +558,6 @@ float Reader::parseFloat ()
 double Reader::parseDouble ()
 {
   char    buf[BUFSIZE_ + 1];
-  char*   end;
 
   double  x;
   int     c;
@@ -625,11 +625,8 @@ double Reader::parseDouble ()
   }
 
   pushBack( c );
-  buf[i++] = '\0';
 
-  x = strtod ( buf, &end );
-
-  if ( *buf == '\0' || *end != '\0' )
+  if ( ! FloatConv::parse( x, buf, i ) )
   {
     throw ParseException (
       JEM_FUNC,
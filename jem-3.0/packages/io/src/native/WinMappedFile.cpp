@@ -0,0 +1,171 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <jem/base/CString.h>
+#include <jem/base/LogBuffer.h>
+#include <jem/base/native/System.h>
+#include <jem/io/IOException.h>
+#include <jem/io/FileOpenException.h>
+#include "native/WinMappedFile.h"
+
+extern "C"
+{
+  #include <windows.h>
+}
+
+#include <jem/base/native/winclean.h>
+
+
+JEM_BEGIN_PACKAGE( io )
+
+
+//=======================================================================
+//   class WinMappedFile
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   map
+//-----------------------------------------------------------------------
+
+
+void* WinMappedFile::map
+
+  ( lint&          size,
+    const String&  name )
+
+{
+  LARGE_INTEGER  fsize;
+  HANDLE         hfile;
+  HANDLE         hmap;
+  void*          addr;
+
+
+  if ( name.size() == 0 )
+  {
+    throw FileOpenException (
+      JEM_FUNC,
+      "error opening file: empty file name"
+    );
+  }
+
+  hfile = CreateFileA ( makeCString( name ), GENERIC_READ,
+                        FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL, nullptr );
+
+  if ( hfile == INVALID_HANDLE_VALUE )
+  {
+    String  details = NativeSystem::strerror ();
+
+    throw FileOpenException (
+      JEM_FUNC,
+      String::format (
+        "error opening file `%s\' (%s)", name, details
+      )
+    );
+  }
+
+  if ( ! GetFileSizeEx( hfile, &fsize ) )
+  {
+    String  details = NativeSystem::strerror ();
+
+    CloseHandle ( hfile );
+
+    throw IOException (
+      JEM_FUNC,
+      String::format (
+        "error getting the size of file `%s\' (%s)", name, details
+      )
+    );
+  }
+
+  size = (lint) fsize.QuadPart;
+  addr = nullptr;
+
+  if ( size > 0 )
+  {
+    hmap = CreateFileMappingA ( hfile, nullptr, PAGE_READONLY,
+                                0, 0, nullptr );
+    addr = nullptr;
+
+    if ( hmap )
+    {
+      addr = MapViewOfFile ( hmap, FILE_MAP_READ, 0, 0, 0 );
+
+      // The view keeps a reference to the mapping object.
+
+      CloseHandle ( hmap );
+    }
+
+    if ( ! addr )
+    {
+      String  details = NativeSystem::strerror ();
+
+      CloseHandle ( hfile );
+
+      throw IOException (
+        JEM_FUNC,
+        String::format (
+          "error mapping file `%s\' into memory (%s)", name, details
+        )
+      );
+    }
+  }
+
+  CloseHandle ( hfile );
+
+  LogBuffer::pushBack (
+    JEM_FUNC,
+    String::format (
+      "mapped file `%s\' (%d bytes)", name, size
+    )
+  );
+
+  return addr;
+}
+
+
+//-----------------------------------------------------------------------
+//   unmap
+//-----------------------------------------------------------------------
+
+
+void WinMappedFile::unmap
+
+  ( void*  addr,
+    lint   size ) noexcept
+
+{
+  if ( addr && size > 0 )
+  {
+    UnmapViewOfFile ( addr );
+  }
+}
+
+
+JEM_END_PACKAGE( io )
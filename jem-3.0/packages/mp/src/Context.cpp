@@ -27,7 +27,12 @@
  */
 
 
+#include <cstring>
 #include <jem/base/ClassTemplate.h>
+#include <jem/base/PrecheckException.h>
+#include <jem/mp/Buffer.h>
+#include <jem/mp/RequestList.h>
+#include <jem/mp/MPException.h>
 #include <jem/mp/Context.h>
 
 
@@ -76,4 +81,186 @@ bool Context::isShared () const
 }
 
 
+//-----------------------------------------------------------------------
+//   alltoallv
+//-----------------------------------------------------------------------
+
+// The default implementation posts a receive for each non-empty
+// incoming part and then sends each non-empty outgoing part. The part
+// destined for this process is copied directly. The messages are
+// exchanged through a clone of this context so that they can not be
+// matched by point-to-point messages sent by the user. The clone is
+// created in the first call and is re-used in subsequent calls.
+
+
+void Context::alltoallv
+
+  ( const RecvBuffer&  rbuf,
+    const idx_t*       rcounts,
+    const SendBuffer&  sbuf,
+    const idx_t*       scounts )
+
+{
+  const int         procCount = size   ();
+  const int         rank      = myRank ();
+  const idx_t       typeSize  = (idx_t) sizeOf ( sbuf.type() );
+
+  Ref<RequestList>  reqs;
+
+  byte*             rdata     = (byte*) rbuf.addr ();
+  const byte*       sdata     = (const byte*) sbuf.addr ();
+  idx_t             roffset   = 0;
+  idx_t             soffset   = 0;
+  idx_t             n;
+
+
+  if ( rbuf.type() != sbuf.type() )
+  {
+    throw MPException (
+      JEM_FUNC,
+      "send and receive buffers have different types"
+    );
+  }
+
+  JEM_PRECHECK2 ( rcounts[rank] == scounts[rank],
+                  "send and receive counts do not match" );
+
+  if ( ! collCtx_ )
+  {
+    collCtx_ = clone ();
+  }
+
+  reqs = collCtx_->newRequestList ();
+
+  for ( int i = 0; i < procCount; i++ )
+  {
+    n = rcounts[i];
+
+    if ( n > 0 && i != rank )
+    {
+      reqs->addRequest ( RecvBuffer( rdata + typeSize * roffset,
+                                     typeSize * n ),
+                         i );
+    }
+
+    roffset += n;
+  }
+
+  JEM_PRECHECK2 ( roffset <= rbuf.size(), "receive buffer too small" );
+
+  reqs->startAll ();
+
+  roffset = 0;
+
+  for ( int i = 0; i < procCount; i++ )
+  {
+    n = scounts[i];
+
+    JEM_PRECHECK2 ( soffset + n <= sbuf.size(),
+                    "send buffer too small" );
+
+    if ( i == rank )
+    {
+      if ( n > 0 )
+      {
+        std::memcpy ( rdata + typeSize * roffset,
+                      sdata + typeSize * soffset,
+                      (size_t) (typeSize * n) );
+      }
+    }
+    else if ( n > 0 )
+    {
+      collCtx_->send ( SendBuffer( sdata + typeSize * soffset,
+                                   typeSize * n ), i );
+    }
+
+    roffset += rcounts[i];
+    soffset += n;
+  }
+
+  reqs->waitAll ();
+}
+
+
+//-----------------------------------------------------------------------
+//   neighborExchange
+//-----------------------------------------------------------------------
+
+
+void Context::neighborExchange
+
+  ( const RecvBuffer&  rbuf,
+    const int*         sources,
+    const idx_t*       rcounts,
+    int                srcCount,
+    const SendBuffer&  sbuf,
+    const int*         dests,
+    const idx_t*       scounts,
+    int                destCount,
+    int                tag )
+
+{
+  const idx_t       typeSize = (idx_t) sizeOf ( sbuf.type() );
+
+  Ref<RequestList>  reqs     = newRequestList ();
+
+  byte*             rdata    = (byte*) rbuf.addr ();
+  const byte*       sdata    = (const byte*) sbuf.addr ();
+  idx_t             offset;
+  idx_t             n;
+
+
+  if ( rbuf.type() != sbuf.type() )
+  {
+    throw MPException (
+      JEM_FUNC,
+      "send and receive buffers have different types"
+    );
+  }
+
+  // Messages are sent as raw bytes so that the parts can be addressed
+  // without knowing the element type.
+
+  offset = 0;
+
+  for ( int i = 0; i < srcCount; i++ )
+  {
+    n = rcounts[i];
+
+    if ( n > 0 )
+    {
+      reqs->addRequest ( RecvBuffer( rdata + typeSize * offset,
+                                     typeSize * n ),
+                         sources[i], tag );
+    }
+
+    offset += n;
+  }
+
+  JEM_PRECHECK2 ( offset <= rbuf.size(), "receive buffer too small" );
+
+  reqs->startAll ();
+
+  offset = 0;
+
+  for ( int i = 0; i < destCount; i++ )
+  {
+    n = scounts[i];
+
+    if ( n > 0 )
+    {
+      JEM_PRECHECK2 ( offset + n <= sbuf.size(),
+                      "send buffer too small" );
+
+      send ( SendBuffer( sdata + typeSize * offset, typeSize * n ),
+             dests[i], tag );
+    }
+
+    offset += n;
+  }
+
+  reqs->waitAll ();
+}
+
+
 JEM_END_PACKAGE( mp )
@@ -32,9 +32,13 @@
 #ifdef JEM_USE_MPI
 
 #include <jem/base/limits.h>
+#include <jem/base/Array.h>
+#include <jem/base/PrecheckException.h>
+#include <jem/base/EnvParams.h>
 #include <jem/base/SerialSection.h>
 #include <jem/mp/MPIContext.h>
 #include "mpi/error.h"
+#include "mpi/Hierarchy.h"
 #include "mpi/utilities.h"
 #include "mpi/Request.h"
 #include "mpi/RequestList.h"
@@ -56,10 +60,12 @@ using mpi::convertType;
 //-----------------------------------------------------------------------
 
 
-MPI_Op  MPIContext::OP_TABLE_[OPCODE_COUNT];
+const idx_t  MPIContext::HIER_MAX_SIZE = 4096;
 
-bool    MPIContext::finalized_     = false;
-int     MPIContext::instanceCount_ = 0;
+MPI_Op       MPIContext::OP_TABLE_[OPCODE_COUNT];
+
+bool         MPIContext::finalized_     = false;
+int          MPIContext::instanceCount_ = 0;
 
 
 //-----------------------------------------------------------------------
@@ -67,7 +73,11 @@ int     MPIContext::instanceCount_ = 0;
 //-----------------------------------------------------------------------
 
 
-MPIContext::MPIContext ( MPI_Comm comm ) : comm_ ( comm )
+MPIContext::MPIContext ( MPI_Comm comm ) :
+
+  comm_        ( comm ),
+  hierMaxSize_ ( 0 )
+
 {
   int  err;
 
@@ -91,6 +101,11 @@ MPIContext::~MPIContext ()
 {
   SerialSection  section;
 
+  // The node and leader contexts must be released before MPI is
+  // shut down.
+
+  hier_ = nullptr;
+
   instanceCount_--;
 
   if ( ! finalized_ )
@@ -120,7 +135,8 @@ MPIContext::~MPIContext ()
 Ref<MPIContext> MPIContext::init ( int* argc, char*** argv )
 {
   SerialSection  section;
-  MPI_Comm       world;
+  Ref<Self>      world;
+  lint           maxSize;
 
 
   if ( instanceCount_ == 0 )
@@ -175,9 +191,17 @@ Ref<MPIContext> MPIContext::init ( int* argc, char*** argv )
 
   instanceCount_++;
 
-  world = MPI_COMM_WORLD;
+  world = newInstance<Self> ( MPI_COMM_WORLD );
 
-  return newInstance<Self> ( world );
+  // Enable the hierarchical collectives if so requested through the
+  // environment; the value is the maximum message size in bytes.
+
+  if ( igetenv( maxSize, "JEM_MP_HIER_COLL" ) && maxSize > 0 )
+  {
+    world->setHierColl ( true, (idx_t) maxSize );
+  }
+
+  return world;
 }
 
 
@@ -234,7 +258,14 @@ Ref<Context> MPIContext::clone ()
 
   instanceCount_++;
 
-  return newInstance<Self> ( comm );
+  Ref<Self>  ctx = newInstance<Self> ( comm );
+
+  if ( hier_ )
+  {
+    ctx->setHierColl ( true, hierMaxSize_ );
+  }
+
+  return ctx;
 }
 
 
@@ -406,6 +437,16 @@ void MPIContext::broadcast ( const SendBuffer& buf )
     mpi::sizeOverflowError ( JEM_FUNC, buf.size() );
   }
 
+  if ( useHier_( buf.size(), buf.type() ) )
+  {
+    hier_->broadcast ( buf.addr (),
+                       (int) buf.size (),
+                       convertType ( buf.type() ),
+                       myRank_ );
+
+    return;
+  }
+
   int  err = MPI_Bcast ( buf.addr (),
                          (int) buf.size (),
                          convertType ( buf.type() ),
@@ -425,6 +466,16 @@ void MPIContext::broadcast ( const RecvBuffer& buf, int root )
     mpi::sizeOverflowError ( JEM_FUNC, buf.size() );
   }
 
+  if ( useHier_( buf.size(), buf.type() ) )
+  {
+    hier_->broadcast ( buf.addr (),
+                       (int) buf.size (),
+                       convertType ( buf.type() ),
+                       root );
+
+    return;
+  }
+
   int  err = MPI_Bcast ( buf.addr (),
                          (int) buf.size (),
                          convertType ( buf.type() ),
@@ -509,6 +560,17 @@ void MPIContext::allreduce
                                      (int) sbuf.size() );
   }
 
+  if ( useHier_( sbuf.size(), sbuf.type() ) )
+  {
+    hier_->allreduce ( sbuf.addr (),
+                       rbuf.addr (),
+                       (int) sbuf.size (),
+                       convertType ( sbuf.type() ),
+                       OP_TABLE_[opcode] );
+
+    return;
+  }
+
   int  err = MPI_Allreduce ( sbuf.addr (),
                              rbuf.addr (),
                              (int) sbuf.size (),
@@ -523,6 +585,197 @@ void MPIContext::allreduce
 }
 
 
+//-----------------------------------------------------------------------
+//   alltoallv
+//-----------------------------------------------------------------------
+
+
+void MPIContext::alltoallv
+
+  ( const RecvBuffer&  rbuf,
+    const idx_t*       rcounts,
+    const SendBuffer&  sbuf,
+    const idx_t*       scounts )
+
+{
+  if ( rbuf.type() != sbuf.type() )
+  {
+    mpi::bufferTypeError ( JEM_FUNC, rbuf.type(), sbuf.type() );
+  }
+
+  Array<int>  ibuf     ( 4 * size_ );
+
+  int*        rcounts2 = ibuf.addr ();
+  int*        rdispls  = rcounts2 + size_;
+  int*        scounts2 = rdispls  + size_;
+  int*        sdispls  = scounts2 + size_;
+  idx_t       roffset  = 0;
+  idx_t       soffset  = 0;
+
+
+  for ( int i = 0; i < size_; i++ )
+  {
+    rcounts2[i] = (int) rcounts[i];
+    scounts2[i] = (int) scounts[i];
+    rdispls[i]  = (int) roffset;
+    sdispls[i]  = (int) soffset;
+    roffset    += rcounts[i];
+    soffset    += scounts[i];
+  }
+
+  if ( roffset > maxOf<int>() )
+  {
+    mpi::sizeOverflowError ( JEM_FUNC, roffset );
+  }
+
+  if ( soffset > maxOf<int>() )
+  {
+    mpi::sizeOverflowError ( JEM_FUNC, soffset );
+  }
+
+  JEM_PRECHECK2 ( roffset <= rbuf.size() &&
+                  soffset <= sbuf.size(),
+                  "buffer too small" );
+
+  int  err = MPI_Alltoallv ( sbuf.addr (), scounts2, sdispls,
+                             convertType ( sbuf.type() ),
+                             rbuf.addr (), rcounts2, rdispls,
+                             convertType ( rbuf.type() ),
+                             comm_ );
+
+  if ( err )
+  {
+    mpi::raiseError ( JEM_FUNC, err );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   split
+//-----------------------------------------------------------------------
+
+// This is a collective operation. Processes that pass a negative
+// color are not included in any new context and get a NULL pointer.
+
+
+Ref<MPIContext> MPIContext::split
+
+  ( int  color,
+    int  key )
+
+{
+  SerialSection  section;
+  MPI_Comm       comm;
+  int            err;
+
+
+  if ( color < 0 )
+  {
+    color = MPI_UNDEFINED;
+  }
+
+  err = MPI_Comm_split ( comm_, color, key, & comm );
+
+  if ( err )
+  {
+    mpi::raiseError ( JEM_FUNC, err );
+  }
+
+  if ( comm == MPI_COMM_NULL )
+  {
+    return nullptr;
+  }
+
+  instanceCount_++;
+
+  return newInstance<Self> ( comm );
+}
+
+
+//-----------------------------------------------------------------------
+//   splitShared
+//-----------------------------------------------------------------------
+
+// Returns a new context containing the processes that can share
+// memory with this process; that is, the processes on the same node.
+
+
+Ref<MPIContext> MPIContext::splitShared ()
+{
+#if MPI_VERSION >= 3
+
+  SerialSection  section;
+  MPI_Comm       comm;
+  int            err;
+
+
+  err = MPI_Comm_split_type ( comm_, MPI_COMM_TYPE_SHARED, myRank_,
+                              MPI_INFO_NULL, & comm );
+
+  if ( err )
+  {
+    mpi::raiseError ( JEM_FUNC, err );
+  }
+
+  instanceCount_++;
+
+  return newInstance<Self> ( comm );
+
+#else
+
+  char  name[MPI_MAX_PROCESSOR_NAME + 1];
+  int   color;
+  int   len;
+
+  MPI_Get_processor_name ( name, &len );
+
+  color = 0;
+
+  for ( int i = 0; i < len; i++ )
+  {
+    color = (31 * color + (int) name[i]) & 0x7fffffff;
+  }
+
+  return split ( color, myRank_ );
+
+#endif
+}
+
+
+//-----------------------------------------------------------------------
+//   setHierColl
+//-----------------------------------------------------------------------
+
+// Enables or disables the hierarchical implementations of the
+// broadcast and allreduce operations for messages up to maxSize
+// bytes. They first combine the data within a node, then among the
+// node leaders, and finally distribute the data within each node.
+// This is a collective operation.
+
+
+void MPIContext::setHierColl
+
+  ( bool   choice,
+    idx_t  maxSize )
+
+{
+  if ( ! choice || maxSize <= 0 )
+  {
+    hier_        = nullptr;
+    hierMaxSize_ = 0;
+  }
+  else
+  {
+    if ( ! hier_ )
+    {
+      hier_ = newInstance<mpi::Hierarchy> ( *this );
+    }
+
+    hierMaxSize_ = maxSize;
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   finalize
 //-----------------------------------------------------------------------
@@ -546,6 +799,22 @@ void MPIContext::finalize ()
 }
 
 
+//-----------------------------------------------------------------------
+//   useHier_
+//-----------------------------------------------------------------------
+
+
+inline bool MPIContext::useHier_
+
+  ( idx_t  count,
+    Type   type ) const noexcept
+
+{
+  return (hier_ && hier_->isUseful() &&
+          count * sizeOf( type ) <= hierMaxSize_);
+}
+
+
 JEM_END_PACKAGE( mp )
 
 #endif
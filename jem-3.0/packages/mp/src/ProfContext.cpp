@@ -0,0 +1,1650 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <jem/base/assert.h>
+#include <jem/base/Time.h>
+#include <jem/base/Array.h>
+#include <jem/base/Collectable.h>
+#include <jem/io/PrintWriter.h>
+#include <jem/util/Flex.h>
+#include <jem/util/HashMap.h>
+#include <jem/mp/Buffer.h>
+#include <jem/mp/Status.h>
+#include <jem/mp/Request.h>
+#include <jem/mp/RequestList.h>
+#include <jem/mp/ProfContext.h>
+
+
+JEM_BEGIN_PACKAGE( mp )
+
+
+using jem::util::Flex;
+using jem::util::HashMap;
+
+
+//=======================================================================
+//   class ProfContext::Stats_
+//=======================================================================
+
+
+class ProfContext::Stats_ : public Collectable
+{
+ public:
+
+  static const int          BARRIER    = 0;
+  static const int          BCAST      = 1;
+  static const int          REDUCE     = 2;
+  static const int          ALLREDUCE  = 3;
+  static const int          ALLTOALLV  = 4;
+  static const int          COLL_KINDS = 5;
+
+  static const char*        COLL_NAMES[COLL_KINDS];
+
+
+  class                     Traffic
+  {
+   public:
+
+    idx_t                     sendCount;
+    idx_t                     sendBytes;
+    idx_t                     recvCount;
+    idx_t                     recvBytes;
+    double                    blockTime;
+
+  };
+
+  class                     Coll
+  {
+   public:
+
+    idx_t                     count;
+    idx_t                     bytes;
+    double                    time;
+    double                    maxTime;
+
+  };
+
+
+  explicit                  Stats_
+
+    ( int                     procCount );
+
+  void                      reset       ();
+
+  void                      addSend
+
+    ( int                     dest,
+      int                     tag,
+      idx_t                   bytes,
+      double                  t );
+
+  void                      addRecv
+
+    ( int                     src,
+      int                     tag,
+      idx_t                   bytes,
+      double                  t );
+
+  inline void               addWait
+
+    ( double                  t );
+
+  void                      addColl
+
+    ( int                     kind,
+      idx_t                   bytes,
+      double                  t );
+
+  double                    blockTime   () const;
+  double                    collTime    () const;
+
+
+ public:
+
+  double                    startTime;
+  double                    waitTime;
+  idx_t                     waitCount;
+
+  Flex<Traffic>             peers;
+  Flex<Traffic>             tags;
+  Flex<int>                 tagIDs;
+  Coll                      colls[COLL_KINDS];
+
+
+ private:
+
+  Traffic&                  getTag_
+
+    ( int                     tag );
+
+
+ private:
+
+  HashMap<int,idx_t>        tagMap_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+const char*  ProfContext::Stats_::COLL_NAMES[COLL_KINDS] =
+{
+  "barrier",
+  "broadcast",
+  "reduce",
+  "allreduce",
+  "alltoallv"
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+ProfContext::Stats_::Stats_ ( int procCount )
+{
+  peers.resize ( procCount );
+  reset        ();
+}
+
+
+//-----------------------------------------------------------------------
+//   reset
+//-----------------------------------------------------------------------
+
+
+void ProfContext::Stats_::reset ()
+{
+  const idx_t  n = peers.size ();
+
+  startTime = Time::now().toDouble ();
+  waitTime  = 0.0;
+  waitCount = 0;
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    peers[i] = Traffic ();
+  }
+
+  for ( int i = 0; i < COLL_KINDS; i++ )
+  {
+    colls[i] = Coll ();
+  }
+
+  tags   .clear ();
+  tagIDs .clear ();
+  tagMap_.clear ();
+}
+
+
+//-----------------------------------------------------------------------
+//   addSend
+//-----------------------------------------------------------------------
+
+
+void ProfContext::Stats_::addSend
+
+  ( int     dest,
+    int     tag,
+    idx_t   bytes,
+    double  t )
+
+{
+  Traffic&  tt = getTag_ ( tag );
+
+  tt.sendCount++;
+  tt.sendBytes += bytes;
+  tt.blockTime += t;
+
+  if ( dest >= 0 && dest < peers.size() )
+  {
+    Traffic&  pt = peers[dest];
+
+    pt.sendCount++;
+    pt.sendBytes += bytes;
+    pt.blockTime += t;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   addRecv
+//-----------------------------------------------------------------------
+
+
+void ProfContext::Stats_::addRecv
+
+  ( int     src,
+    int     tag,
+    idx_t   bytes,
+    double  t )
+
+{
+  Traffic&  tt = getTag_ ( tag );
+
+  tt.recvCount++;
+  tt.recvBytes += bytes;
+  tt.blockTime += t;
+
+  if ( src >= 0 && src < peers.size() )
+  {
+    Traffic&  pt = peers[src];
+
+    pt.recvCount++;
+    pt.recvBytes += bytes;
+    pt.blockTime += t;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   addWait
+//-----------------------------------------------------------------------
+
+
+inline void ProfContext::Stats_::addWait ( double t )
+{
+  waitTime += t;
+  waitCount++;
+}
+
+
+//-----------------------------------------------------------------------
+//   addColl
+//-----------------------------------------------------------------------
+
+
+void ProfContext::Stats_::addColl
+
+  ( int     kind,
+    idx_t   bytes,
+    double  t )
+
+{
+  Coll&  c = colls[kind];
+
+  c.count++;
+  c.bytes += bytes;
+  c.time  += t;
+
+  if ( t > c.maxTime )
+  {
+    c.maxTime = t;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   blockTime
+//-----------------------------------------------------------------------
+
+
+double ProfContext::Stats_::blockTime () const
+{
+  const idx_t  n = peers.size ();
+  double       t = 0.0;
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    t += peers[i].blockTime;
+  }
+
+  return t;
+}
+
+
+//-----------------------------------------------------------------------
+//   collTime
+//-----------------------------------------------------------------------
+
+
+double ProfContext::Stats_::collTime () const
+{
+  double  t = 0.0;
+
+  for ( int i = 0; i < COLL_KINDS; i++ )
+  {
+    t += colls[i].time;
+  }
+
+  return t;
+}
+
+
+//-----------------------------------------------------------------------
+//   getTag_
+//-----------------------------------------------------------------------
+
+
+ProfContext::Stats_::Traffic& ProfContext::Stats_::getTag_ ( int tag )
+{
+  HashMap<int,idx_t>::Iterator  it = tagMap_.find ( tag );
+
+  idx_t  i;
+
+  if ( it == tagMap_.end() )
+  {
+    i = tags.size ();
+
+    tags   .pushBack ( Traffic() );
+    tagIDs .pushBack ( tag );
+    tagMap_.insert   ( tag, i );
+  }
+  else
+  {
+    i = it->second;
+  }
+
+  return tags[i];
+}
+
+
+//=======================================================================
+//   class ProfContext::Utils_
+//=======================================================================
+
+
+class ProfContext::Utils_
+{
+ public:
+
+  // Processes beyond this number are not included in the
+  // communication matrix of the merged report.
+
+  static const int          MAX_MATRIX_SIZE = 32;
+
+  static inline double      now         ();
+
+  static inline idx_t       sizeOf
+
+    ( const Buffer&           buf );
+
+  static void               printTraffic
+
+    ( io::PrintWriter&        out,
+      const char*             label,
+      int                     id,
+      const Stats_::Traffic&  t );
+
+};
+
+
+//-----------------------------------------------------------------------
+//   now
+//-----------------------------------------------------------------------
+
+
+inline double ProfContext::Utils_::now ()
+{
+  return Time::now().toDouble ();
+}
+
+
+//-----------------------------------------------------------------------
+//   sizeOf
+//-----------------------------------------------------------------------
+
+
+inline idx_t ProfContext::Utils_::sizeOf ( const Buffer& buf )
+{
+  return buf.size() * (idx_t) mp::sizeOf ( buf.type() );
+}
+
+
+//-----------------------------------------------------------------------
+//   printTraffic
+//-----------------------------------------------------------------------
+
+
+void ProfContext::Utils_::printTraffic
+
+  ( io::PrintWriter&        out,
+    const char*             label,
+    int                     id,
+    const Stats_::Traffic&  t )
+
+{
+  if ( t.sendCount + t.recvCount == 0 )
+  {
+    return;
+  }
+
+  print ( out, String::format ( "\n  %-5s %5d : %10d %14d %10d %14d %12.4e",
+                                label, id,
+                                t.sendCount, t.sendBytes,
+                                t.recvCount, t.recvBytes,
+                                t.blockTime ) );
+}
+
+
+//=======================================================================
+//   class ProfContext::Request_
+//=======================================================================
+
+
+class ProfContext::Request_ : public Request
+{
+ public:
+
+  typedef Request           Super;
+
+
+                            Request_
+
+    ( const Ref<Request>&     inner,
+      const Ref<Stats_>&      stats,
+      bool                    send,
+      int                     peer,
+      int                     tag,
+      idx_t                   bytes,
+      int                     typeSize );
+
+  virtual void              start     () override;
+
+  virtual bool              test
+
+    ( Status*                 stat )     override;
+
+  virtual void              wait
+
+    ( Status*                 stat )     override;
+
+  virtual void              cancel    () override;
+
+
+ private:
+
+  void                      record_
+
+    ( const Status&           stat );
+
+
+ private:
+
+  Ref<Request>              inner_;
+  Ref<Stats_>               stats_;
+  bool                      send_;
+  bool                      active_;
+  int                       peer_;
+  int                       tag_;
+  idx_t                     bytes_;
+  int                       typeSize_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+ProfContext::Request_::Request_
+
+  ( const Ref<Request>&  inner,
+    const Ref<Stats_>&   stats,
+    bool                 send,
+    int                  peer,
+    int                  tag,
+    idx_t                bytes,
+    int                  typeSize ) :
+
+    inner_    ( inner ),
+    stats_    ( stats ),
+    send_     ( send ),
+    active_   ( false ),
+    peer_     ( peer ),
+    tag_      ( tag ),
+    bytes_    ( bytes ),
+    typeSize_ ( typeSize )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   start
+//-----------------------------------------------------------------------
+
+
+void ProfContext::Request_::start ()
+{
+  inner_->start ();
+
+  active_ = true;
+}
+
+
+//-----------------------------------------------------------------------
+//   test
+//-----------------------------------------------------------------------
+
+
+bool ProfContext::Request_::test ( Status* stat )
+{
+  Status  tmp;
+
+  if ( ! stat )
+  {
+    stat = &tmp;
+  }
+
+  double  t0   = Utils_::now ();
+  bool    done = inner_->test ( stat );
+
+  stats_->addWait ( Utils_::now() - t0 );
+
+  if ( done )
+  {
+    record_ ( *stat );
+  }
+
+  return done;
+}
+
+
+//-----------------------------------------------------------------------
+//   wait
+//-----------------------------------------------------------------------
+
+
+void ProfContext::Request_::wait ( Status* stat )
+{
+  Status  tmp;
+
+  if ( ! stat )
+  {
+    stat = &tmp;
+  }
+
+  double  t0 = Utils_::now ();
+
+  inner_->wait    ( stat );
+  stats_->addWait ( Utils_::now() - t0 );
+
+  record_ ( *stat );
+}
+
+
+//-----------------------------------------------------------------------
+//   cancel
+//-----------------------------------------------------------------------
+
+
+void ProfContext::Request_::cancel ()
+{
+  inner_->cancel ();
+
+  active_ = false;
+}
+
+
+//-----------------------------------------------------------------------
+//   record_
+//-----------------------------------------------------------------------
+
+
+void ProfContext::Request_::record_ ( const Status& stat )
+{
+  if ( ! active_ )
+  {
+    return;
+  }
+
+  active_ = false;
+
+  if ( send_ )
+  {
+    stats_->addSend ( peer_, tag_, bytes_, 0.0 );
+  }
+  else
+  {
+    stats_->addRecv ( stat.source, stat.tag,
+                      stat.size * typeSize_, 0.0 );
+  }
+}
+
+
+//=======================================================================
+//   class ProfContext::RequestList_
+//=======================================================================
+
+
+class ProfContext::RequestList_ : public RequestList
+{
+ public:
+
+  typedef RequestList       Super;
+
+
+                            RequestList_
+
+    ( const Ref<RequestList>& inner,
+      const Ref<Stats_>&      stats );
+
+  virtual idx_t             size         () const override;
+
+  virtual void              clear
+
+    ( Status*                 stats )            override;
+
+  virtual idx_t             addRequest
+
+    ( const SendBuffer&       buf,
+      int                     dest,
+      int                     tag )              override;
+
+  virtual idx_t             addRequest
+
+    ( const RecvBuffer&       buf,
+      int                     src,
+      int                     tag )              override;
+
+  virtual void              startOne
+
+    ( idx_t                   ireq )             override;
+
+  virtual void              startAll     ()      override;
+
+  virtual bool              testOne
+
+    ( idx_t                   ireq,
+      Status*                 stat )             override;
+
+  virtual void              testSome
+
+    ( idx_t&                  count,
+      idx_t*                  ireqs,
+      Status*                 stats )            override;
+
+  virtual bool              testAll
+
+    ( Status*                 stats )            override;
+
+  virtual void              waitOne
+
+    ( idx_t                   ireq,
+      Status*                 stat )             override;
+
+  virtual void              waitSome
+
+    ( idx_t&                  count,
+      idx_t*                  ireqs,
+      Status*                 stats )            override;
+
+  virtual void              waitAll
+
+    ( Status*                 stats )            override;
+
+  virtual void              cancelOne
+
+    ( idx_t                   ireq )             override;
+
+  virtual void              cancelAll
+
+    ( Status*                 stats )            override;
+
+
+ private:
+
+  class                     Entry_
+  {
+   public:
+
+    bool                      send;
+    bool                      active;
+    int                       peer;
+    int                       tag;
+    idx_t                     bytes;
+    int                       typeSize;
+
+  };
+
+
+  Status*                   getStats_
+
+    ( Status*                 stats );
+
+  void                      record_
+
+    ( idx_t                   ireq,
+      const Status&           stat );
+
+  void                      recordAll_
+
+    ( const Status*           stats );
+
+
+ private:
+
+  Ref<RequestList>          inner_;
+  Ref<Stats_>               stats_;
+  Flex<Entry_>              entries_;
+  Flex<Status>              scratch_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+ProfContext::RequestList_::RequestList_
+
+  ( const Ref<RequestList>&  inner,
+    const Ref<Stats_>&       stats ) :
+
+    inner_ ( inner ),
+    stats_ ( stats )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   size
+//-----------------------------------------------------------------------
+
+
+idx_t ProfContext::RequestList_::size () const
+{
+  return inner_->size ();
+}
+
+
+//-----------------------------------------------------------------------
+//   clear
+//-----------------------------------------------------------------------
+
+
+void ProfContext::RequestList_::clear ( Status* stats )
+{
+  inner_  ->clear ( stats );
+  entries_ .clear ();
+}
+
+
+//-----------------------------------------------------------------------
+//   addRequest (send mode)
+//-----------------------------------------------------------------------
+
+
+idx_t ProfContext::RequestList_::addRequest
+
+  ( const SendBuffer&  buf,
+    int                dest,
+    int                tag )
+
+{
+  idx_t   ireq = inner_->addRequest ( buf, dest, tag );
+  Entry_  e;
+
+  e.send     = true;
+  e.active   = false;
+  e.peer     = dest;
+  e.tag      = tag;
+  e.bytes    = Utils_::sizeOf ( buf );
+  e.typeSize = sizeOf ( buf.type() );
+
+  entries_.pushBack ( e );
+
+  return ireq;
+}
+
+
+//-----------------------------------------------------------------------
+//   addRequest (recv mode)
+//-----------------------------------------------------------------------
+
+
+idx_t ProfContext::RequestList_::addRequest
+
+  ( const RecvBuffer&  buf,
+    int                src,
+    int                tag )
+
+{
+  idx_t   ireq = inner_->addRequest ( buf, src, tag );
+  Entry_  e;
+
+  e.send     = false;
+  e.active   = false;
+  e.peer     = src;
+  e.tag      = tag;
+  e.bytes    = Utils_::sizeOf ( buf );
+  e.typeSize = sizeOf ( buf.type() );
+
+  entries_.pushBack ( e );
+
+  return ireq;
+}
+
+
+//-----------------------------------------------------------------------
+//   startOne
+//-----------------------------------------------------------------------
+
+
+void ProfContext::RequestList_::startOne ( idx_t ireq )
+{
+  inner_->startOne ( ireq );
+
+  entries_[ireq].active = true;
+}
+
+
+//-----------------------------------------------------------------------
+//   startAll
+//-----------------------------------------------------------------------
+
+
+void ProfContext::RequestList_::startAll ()
+{
+  const idx_t  n = entries_.size ();
+
+  inner_->startAll ();
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    entries_[i].active = true;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   testOne
+//-----------------------------------------------------------------------
+
+
+bool ProfContext::RequestList_::testOne
+
+  ( idx_t    ireq,
+    Status*  stat )
+
+{
+  Status  tmp;
+
+  if ( ! stat )
+  {
+    stat = &tmp;
+  }
+
+  double  t0   = Utils_::now ();
+  bool    done = inner_->testOne ( ireq, stat );
+
+  stats_->addWait ( Utils_::now() - t0 );
+
+  if ( done )
+  {
+    record_ ( ireq, *stat );
+  }
+
+  return done;
+}
+
+
+//-----------------------------------------------------------------------
+//   testSome
+//-----------------------------------------------------------------------
+
+
+void ProfContext::RequestList_::testSome
+
+  ( idx_t&   count,
+    idx_t*   ireqs,
+    Status*  stats )
+
+{
+  stats = getStats_ ( stats );
+
+  double  t0 = Utils_::now ();
+
+  inner_->testSome ( count, ireqs, stats );
+  stats_->addWait  ( Utils_::now() - t0 );
+
+  for ( idx_t i = 0; i < count; i++ )
+  {
+    record_ ( ireqs[i], stats[i] );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   testAll
+//-----------------------------------------------------------------------
+
+
+bool ProfContext::RequestList_::testAll ( Status* stats )
+{
+  stats = getStats_ ( stats );
+
+  double  t0   = Utils_::now ();
+  bool    done = inner_->testAll ( stats );
+
+  stats_->addWait ( Utils_::now() - t0 );
+
+  if ( done )
+  {
+    recordAll_ ( stats );
+  }
+
+  return done;
+}
+
+
+//-----------------------------------------------------------------------
+//   waitOne
+//-----------------------------------------------------------------------
+
+
+void ProfContext::RequestList_::waitOne
+
+  ( idx_t    ireq,
+    Status*  stat )
+
+{
+  Status  tmp;
+
+  if ( ! stat )
+  {
+    stat = &tmp;
+  }
+
+  double  t0 = Utils_::now ();
+
+  inner_->waitOne ( ireq, stat );
+  stats_->addWait ( Utils_::now() - t0 );
+
+  record_ ( ireq, *stat );
+}
+
+
+//-----------------------------------------------------------------------
+//   waitSome
+//-----------------------------------------------------------------------
+
+
+void ProfContext::RequestList_::waitSome
+
+  ( idx_t&   count,
+    idx_t*   ireqs,
+    Status*  stats )
+
+{
+  stats = getStats_ ( stats );
+
+  double  t0 = Utils_::now ();
+
+  inner_->waitSome ( count, ireqs, stats );
+  stats_->addWait  ( Utils_::now() - t0 );
+
+  for ( idx_t i = 0; i < count; i++ )
+  {
+    record_ ( ireqs[i], stats[i] );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   waitAll
+//-----------------------------------------------------------------------
+
+
+void ProfContext::RequestList_::waitAll ( Status* stats )
+{
+  stats = getStats_ ( stats );
+
+  double  t0 = Utils_::now ();
+
+  inner_->waitAll ( stats );
+  stats_->addWait ( Utils_::now() - t0 );
+
+  recordAll_ ( stats );
+}
+
+
+//-----------------------------------------------------------------------
+//   cancelOne
+//-----------------------------------------------------------------------
+
+
+void ProfContext::RequestList_::cancelOne ( idx_t ireq )
+{
+  inner_->cancelOne ( ireq );
+
+  entries_[ireq].active = false;
+}
+
+
+//-----------------------------------------------------------------------
+//   cancelAll
+//-----------------------------------------------------------------------
+
+
+void ProfContext::RequestList_::cancelAll ( Status* stats )
+{
+  const idx_t  n = entries_.size ();
+
+  inner_->cancelAll ( stats );
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    entries_[i].active = false;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   getStats_
+//-----------------------------------------------------------------------
+
+
+inline Status* ProfContext::RequestList_::getStats_ ( Status* stats )
+{
+  if ( stats )
+  {
+    return stats;
+  }
+
+  if ( scratch_.size() < entries_.size() )
+  {
+    scratch_.resize ( entries_.size() );
+  }
+
+  return scratch_.addr ();
+}
+
+
+//-----------------------------------------------------------------------
+//   record_
+//-----------------------------------------------------------------------
+
+
+void ProfContext::RequestList_::record_
+
+  ( idx_t          ireq,
+    const Status&  stat )
+
+{
+  Entry_&  e = entries_[ireq];
+
+  if ( ! e.active )
+  {
+    return;
+  }
+
+  e.active = false;
+
+  if ( e.send )
+  {
+    stats_->addSend ( e.peer, e.tag, e.bytes, 0.0 );
+  }
+  else
+  {
+    stats_->addRecv ( stat.source, stat.tag,
+                      stat.size * e.typeSize, 0.0 );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   recordAll_
+//-----------------------------------------------------------------------
+
+
+void ProfContext::RequestList_::recordAll_ ( const Status* stats )
+{
+  const idx_t  n = entries_.size ();
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    record_ ( i, stats[i] );
+  }
+}
+
+
+//=======================================================================
+//   class ProfContext
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructors & destructor
+//-----------------------------------------------------------------------
+
+
+ProfContext::ProfContext ( const Ref<Context>& ctx ) :
+
+  inner_ ( ctx )
+
+{
+  JEM_PRECHECK2 ( ctx, "NULL Context" );
+
+  stats_ = newInstance<Stats_> ( ctx->size() );
+}
+
+
+ProfContext::~ProfContext ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   getErrorString
+//-----------------------------------------------------------------------
+
+
+String ProfContext::getErrorString ( int err ) const
+{
+  return inner_->getErrorString ( err );
+}
+
+
+//-----------------------------------------------------------------------
+//   size & myRank
+//-----------------------------------------------------------------------
+
+
+int ProfContext::size () const
+{
+  return inner_->size ();
+}
+
+
+int ProfContext::myRank () const
+{
+  return inner_->myRank ();
+}
+
+
+//-----------------------------------------------------------------------
+//   isShared
+//-----------------------------------------------------------------------
+
+
+bool ProfContext::isShared () const
+{
+  return inner_->isShared ();
+}
+
+
+//-----------------------------------------------------------------------
+//   abort
+//-----------------------------------------------------------------------
+
+
+void ProfContext::abort ( int err )
+{
+  inner_->abort ( err );
+}
+
+
+//-----------------------------------------------------------------------
+//   clone
+//-----------------------------------------------------------------------
+
+
+Ref<Context> ProfContext::clone ()
+{
+  Ref<Self>  ctx = newInstance<Self> ( inner_->clone() );
+
+  ctx->stats_ = stats_;
+
+  return ctx;
+}
+
+
+//-----------------------------------------------------------------------
+//   newRequestList
+//-----------------------------------------------------------------------
+
+
+Ref<RequestList> ProfContext::newRequestList ()
+{
+  return newInstance<RequestList_> ( inner_->newRequestList(),
+                                     stats_ );
+}
+
+
+//-----------------------------------------------------------------------
+//   send
+//-----------------------------------------------------------------------
+
+
+void ProfContext::send
+
+  ( const SendBuffer&  buf,
+    int                dest,
+    int                tag )
+
+{
+  double  t0 = Utils_::now ();
+
+  inner_->send    ( buf, dest, tag );
+  stats_->addSend ( dest, tag, Utils_::sizeOf( buf ),
+                    Utils_::now() - t0 );
+}
+
+
+//-----------------------------------------------------------------------
+//   recv
+//-----------------------------------------------------------------------
+
+
+void ProfContext::recv
+
+  ( const RecvBuffer&  buf,
+    int                src,
+    int                tag,
+    Status*            stat )
+
+{
+  Status  tmp;
+
+  if ( ! stat )
+  {
+    stat = &tmp;
+  }
+
+  double  t0 = Utils_::now ();
+
+  inner_->recv    ( buf, src, tag, stat );
+  stats_->addRecv ( stat->source, stat->tag,
+                    stat->size * sizeOf( buf.type() ),
+                    Utils_::now() - t0 );
+}
+
+
+//-----------------------------------------------------------------------
+//   initSend
+//-----------------------------------------------------------------------
+
+
+Ref<Request> ProfContext::initSend
+
+  ( const SendBuffer&  buf,
+    int                dest,
+    int                tag )
+
+{
+  return newInstance<Request_> ( inner_->initSend( buf, dest, tag ),
+                                 stats_, true, dest, tag,
+                                 Utils_::sizeOf ( buf ),
+                                 sizeOf ( buf.type() ) );
+}
+
+
+//-----------------------------------------------------------------------
+//   initRecv
+//-----------------------------------------------------------------------
+
+
+Ref<Request> ProfContext::initRecv
+
+  ( const RecvBuffer&  buf,
+    int                src,
+    int                tag )
+
+{
+  return newInstance<Request_> ( inner_->initRecv( buf, src, tag ),
+                                 stats_, false, src, tag,
+                                 Utils_::sizeOf ( buf ),
+                                 sizeOf ( buf.type() ) );
+}
+
+
+//-----------------------------------------------------------------------
+//   barrier
+//-----------------------------------------------------------------------
+
+
+void ProfContext::barrier ()
+{
+  double  t0 = Utils_::now ();
+
+  inner_->barrier ();
+  stats_->addColl ( Stats_::BARRIER, 0, Utils_::now() - t0 );
+}
+
+
+//-----------------------------------------------------------------------
+//   broadcast
+//-----------------------------------------------------------------------
+
+
+void ProfContext::broadcast ( const SendBuffer& buf )
+{
+  double  t0 = Utils_::now ();
+
+  inner_->broadcast ( buf );
+  stats_->addColl   ( Stats_::BCAST, Utils_::sizeOf( buf ),
+                      Utils_::now() - t0 );
+}
+
+
+void ProfContext::broadcast
+
+  ( const RecvBuffer&  buf,
+    int                root )
+
+{
+  double  t0 = Utils_::now ();
+
+  inner_->broadcast ( buf, root );
+  stats_->addColl   ( Stats_::BCAST, Utils_::sizeOf( buf ),
+                      Utils_::now() - t0 );
+}
+
+
+//-----------------------------------------------------------------------
+//   reduce
+//-----------------------------------------------------------------------
+
+
+void ProfContext::reduce
+
+  ( const RecvBuffer&  in,
+    const SendBuffer&  out,
+    int                root,
+    Opcode             opcode )
+
+{
+  double  t0 = Utils_::now ();
+
+  inner_->reduce  ( in, out, root, opcode );
+  stats_->addColl ( Stats_::REDUCE, Utils_::sizeOf( out ),
+                    Utils_::now() - t0 );
+}
+
+
+//-----------------------------------------------------------------------
+//   allreduce
+//-----------------------------------------------------------------------
+
+
+void ProfContext::allreduce
+
+  ( const RecvBuffer&  in,
+    const SendBuffer&  out,
+    Opcode             opcode )
+
+{
+  double  t0 = Utils_::now ();
+
+  inner_->allreduce ( in, out, opcode );
+  stats_->addColl   ( Stats_::ALLREDUCE, Utils_::sizeOf( out ),
+                      Utils_::now() - t0 );
+}
+
+
+//-----------------------------------------------------------------------
+//   alltoallv
+//-----------------------------------------------------------------------
+
+
+void ProfContext::alltoallv
+
+  ( const RecvBuffer&  rbuf,
+    const idx_t*       rcounts,
+    const SendBuffer&  sbuf,
+    const idx_t*       scounts )
+
+{
+  const int  procCount = inner_->size ();
+
+  double     t0        = Utils_::now ();
+  idx_t      n         = 0;
+
+
+  inner_->alltoallv ( rbuf, rcounts, sbuf, scounts );
+
+  for ( int i = 0; i < procCount; i++ )
+  {
+    n += scounts[i];
+  }
+
+  stats_->addColl   ( Stats_::ALLTOALLV,
+                      n * (idx_t) sizeOf( sbuf.type() ),
+                      Utils_::now() - t0 );
+}
+
+
+//-----------------------------------------------------------------------
+//   resetStats
+//-----------------------------------------------------------------------
+
+
+void ProfContext::resetStats ()
+{
+  stats_->reset ();
+}
+
+
+//-----------------------------------------------------------------------
+//   printStats
+//-----------------------------------------------------------------------
+
+
+void ProfContext::printStats ( io::PrintWriter& out ) const
+{
+  const Stats_&  st      = *stats_;
+
+  const double   elapsed = Utils_::now() - st.startTime;
+  const double   commt   = st.blockTime() + st.waitTime + st.collTime();
+
+
+  print ( out, String::format (
+            "Communication profile of process %d of %d\n\n",
+            myRank(), size() ) );
+
+  print ( out, String::format (
+            "  elapsed time       : %12.4e s\n", elapsed ) );
+  print ( out, String::format (
+            "  communication time : %12.4e s (%.1f %%)\n",
+            commt, elapsed > 0.0 ? 100.0 * commt / elapsed : 0.0 ) );
+  print ( out, String::format (
+            "  request wait time  : %12.4e s in %d calls\n\n",
+            st.waitTime, st.waitCount ) );
+
+  print ( out, String::format (
+            "  %-5s %5s : %10s %14s %10s %14s %12s",
+            "", "", "sends", "send bytes",
+            "recvs", "recv bytes", "block time" ) );
+
+  for ( idx_t i = 0; i < st.peers.size(); i++ )
+  {
+    Utils_::printTraffic ( out, "peer", (int) i, st.peers[i] );
+  }
+
+  print ( out, '\n' );
+
+  for ( idx_t i = 0; i < st.tags.size(); i++ )
+  {
+    Utils_::printTraffic ( out, "tag", st.tagIDs[i], st.tags[i] );
+  }
+
+  print ( out, String::format (
+            "\n\n  %-12s %10s %14s %12s %12s\n",
+            "", "calls", "bytes", "total time", "max time" ) );
+
+  for ( int i = 0; i < Stats_::COLL_KINDS; i++ )
+  {
+    const Stats_::Coll&  c = st.colls[i];
+
+    print ( out, String::format (
+              "  %-12s %10d %14d %12.4e %12.4e\n",
+              Stats_::COLL_NAMES[i],
+              c.count, c.bytes, c.time, c.maxTime ) );
+  }
+
+  out.flush ();
+}
+
+
+//-----------------------------------------------------------------------
+//   printReport
+//-----------------------------------------------------------------------
+
+// Collective operation: merges the statistics of all processes and
+// prints the minimum, average and maximum of each quantity on the
+// root process. The ratio of the maximum to the average indicates
+// the load imbalance.
+
+
+void ProfContext::printReport ( io::PrintWriter& out )
+{
+  static const int    QTY_COUNT = 8 + Stats_::COLL_KINDS;
+
+  static const char*  QTY_NAMES[QTY_COUNT] =
+  {
+    "elapsed time",
+    "comm. time",
+    "messages sent",
+    "bytes sent",
+    "messages recvd",
+    "bytes recvd",
+    "p2p block time",
+    "req. wait time",
+    "barrier time",
+    "bcast time",
+    "reduce time",
+    "allreduce time",
+    "alltoallv time"
+  };
+
+  const Stats_&  st    = *stats_;
+  const int      procs = size ();
+  const int      rank  = myRank ();
+
+  Array<double>  local ( QTY_COUNT );
+  Array<double>  sums  ( QTY_COUNT );
+  Array<double>  mins  ( QTY_COUNT );
+  Array<double>  maxs  ( QTY_COUNT );
+  Stats_::Traffic  total = Stats_::Traffic ();
+
+
+  for ( idx_t i = 0; i < st.peers.size(); i++ )
+  {
+    const Stats_::Traffic&  t = st.peers[i];
+
+    total.sendCount += t.sendCount;
+    total.sendBytes += t.sendBytes;
+    total.recvCount += t.recvCount;
+    total.recvBytes += t.recvBytes;
+  }
+
+  local[0] = Utils_::now() - st.startTime;
+  local[1] = st.blockTime() + st.waitTime + st.collTime();
+  local[2] = (double) total.sendCount;
+  local[3] = (double) total.sendBytes;
+  local[4] = (double) total.recvCount;
+  local[5] = (double) total.recvBytes;
+  local[6] = st.blockTime ();
+  local[7] = st.waitTime;
+
+  for ( int i = 0; i < Stats_::COLL_KINDS; i++ )
+  {
+    local[8 + i] = st.colls[i].time;
+  }
+
+  inner_->reduce ( RecvBuffer( sums.addr(), QTY_COUNT ),
+                   SendBuffer( local.addr(), QTY_COUNT ), 0, SUM );
+  inner_->reduce ( RecvBuffer( mins.addr(), QTY_COUNT ),
+                   SendBuffer( local.addr(), QTY_COUNT ), 0, MIN );
+  inner_->reduce ( RecvBuffer( maxs.addr(), QTY_COUNT ),
+                   SendBuffer( local.addr(), QTY_COUNT ), 0, MAX );
+
+  // Gather the number of bytes sent between each pair of processes.
+
+  Array<double>  matrix;
+
+  if ( procs <= Utils_::MAX_MATRIX_SIZE )
+  {
+    const idx_t    n = (idx_t) procs * procs;
+
+    Array<double>  row ( n );
+
+    row = 0.0;
+
+    for ( int j = 0; j < procs; j++ )
+    {
+      row[(idx_t) rank * procs + j] = (double) st.peers[j].sendBytes;
+    }
+
+    matrix.resize  ( n );
+
+    inner_->reduce ( RecvBuffer( matrix.addr(), n ),
+                     SendBuffer( row   .addr(), n ), 0, SUM );
+  }
+
+  if ( rank != 0 )
+  {
+    return;
+  }
+
+  print ( out, String::format (
+            "Communication profile of %d processes\n\n", procs ) );
+
+  print ( out, String::format (
+            "  %-16s %12s %12s %12s %8s\n",
+            "", "min", "avg", "max", "max/avg" ) );
+
+  for ( int i = 0; i < QTY_COUNT; i++ )
+  {
+    double  avg = sums[i] / procs;
+
+    print ( out, String::format (
+              "  %-16s %12.4e %12.4e %12.4e %8.3f\n",
+              QTY_NAMES[i], mins[i], avg, maxs[i],
+              avg > 0.0 ? maxs[i] / avg : 1.0 ) );
+  }
+
+  if ( matrix.size() > 0 )
+  {
+    print ( out, "\n  Bytes sent (row: source, column: destination):\n" );
+
+    for ( int i = 0; i < procs; i++ )
+    {
+      print ( out, String::format ( "\n  %5d :", i ) );
+
+      for ( int j = 0; j < procs; j++ )
+      {
+        print ( out, String::format (
+                  " %10.3e", matrix[(idx_t) i * procs + j] ) );
+      }
+    }
+
+    print ( out, '\n' );
+  }
+
+  out.flush ();
+}
+
+
+JEM_END_PACKAGE( mp )
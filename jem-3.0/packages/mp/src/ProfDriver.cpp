@@ -0,0 +1,231 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <jem/base/assert.h>
+#include <jem/base/System.h>
+#include <jem/io/FileWriter.h>
+#include <jem/io/PrintWriter.h>
+#include <jem/mp/Task.h>
+#include <jem/mp/ProfContext.h>
+#include <jem/mp/ProfDriver.h>
+
+
+JEM_BEGIN_PACKAGE( mp )
+
+
+using jem::io::FileWriter;
+using jem::io::PrintWriter;
+
+
+//=======================================================================
+//   class ProfDriver::Task_
+//=======================================================================
+
+
+class ProfDriver::Task_ : public Task
+{
+ public:
+
+  typedef Task              Super;
+
+
+                            Task_
+
+    ( const Ref<Task>&        task,
+      const Ref<ProfContext>& ctx );
+
+  virtual void              run  () override;
+
+
+ private:
+
+  Ref<Task>                 task_;
+  Ref<ProfContext>          context_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+ProfDriver::Task_::Task_
+
+  ( const Ref<Task>&         task,
+    const Ref<ProfContext>&  ctx ) :
+
+    task_    ( task ),
+    context_ ( ctx )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+void ProfDriver::Task_::run ()
+{
+  task_->run ();
+
+  // Release the task so that its contexts and resources are no
+  // longer used while the reports are written.
+
+  task_ = nullptr;
+
+  String  prefix = System::getenv ( "JEM_MP_PROF_FILE", "mp-prof" );
+  int     rank   = context_->myRank ();
+
+  Ref<PrintWriter>  out =
+
+    newInstance<PrintWriter> (
+      newInstance<FileWriter> (
+        String::format ( "%s.%d", prefix, rank )
+      )
+    );
+
+  context_->printStats ( *out );
+
+  // The merged report is only printed by the root process; the other
+  // processes just take part in the collective operations.
+
+  if ( rank == 0 )
+  {
+    out->close ();
+
+    out = newInstance<PrintWriter> ( newInstance<FileWriter>( prefix ) );
+  }
+
+  context_->printReport ( *out );
+
+  out->close ();
+}
+
+
+//=======================================================================
+//   class ProfDriver::TaskFactory_
+//=======================================================================
+
+
+class ProfDriver::TaskFactory_ : public TaskFactory
+{
+ public:
+
+  explicit                  TaskFactory_
+
+    ( TaskFactory&            factory );
+
+  virtual Ref<Task>         newTask
+
+    ( const Ref<Context>&     ctx,
+      int                     argc,
+      char**                  argv )       override;
+
+
+ private:
+
+  TaskFactory&              factory_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+ProfDriver::TaskFactory_::TaskFactory_ ( TaskFactory& factory ) :
+
+  factory_ ( factory )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   newTask
+//-----------------------------------------------------------------------
+
+
+Ref<Task> ProfDriver::TaskFactory_::newTask
+
+  ( const Ref<Context>&  ctx,
+    int                  argc,
+    char**               argv )
+
+{
+  Ref<ProfContext>  pctx = newInstance<ProfContext> ( ctx );
+
+  return newInstance<Task_> ( factory_.newTask( pctx, argc, argv ),
+                              pctx );
+}
+
+
+//=======================================================================
+//   class ProfDriver
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+ProfDriver::ProfDriver ( const Ref<Driver>& driver ) :
+
+  driver_ ( driver )
+
+{
+  JEM_PRECHECK2 ( driver, "NULL Driver" );
+}
+
+
+ProfDriver::~ProfDriver ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   start
+//-----------------------------------------------------------------------
+
+
+void ProfDriver::start
+
+  ( TaskFactory&  factory,
+    int           argc,
+    char**        argv )
+
+{
+  TaskFactory_  wrapper ( factory );
+
+  driver_->start ( wrapper, argc, argv );
+}
+
+
+JEM_END_PACKAGE( mp )
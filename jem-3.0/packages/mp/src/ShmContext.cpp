@@ -0,0 +1,757 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <jem/defines.h>
+
+#ifdef JEM_OS_POSIX
+
+#include <cstring>
+#include <jem/base/assert.h>
+#include <jem/base/Once.h>
+#include <jem/base/MemCache.h>
+#include <jem/mp/error.h>
+#include <jem/mp/AbortException.h>
+#include <jem/mp/ShmContext.h>
+#include "mt/Optable.h"
+#include "shm/error.h"
+#include "shm/Engine.h"
+#include "shm/Message.h"
+#include "shm/Request.h"
+#include "shm/RequestList.h"
+
+
+JEM_BEGIN_PACKAGE( mp )
+
+
+using jem::mp::mt::Optable;
+using jem::mp::shm::Engine;
+using jem::mp::shm::Message;
+
+
+//=======================================================================
+//   class ShmContext::Utils_
+//=======================================================================
+
+
+class ShmContext::Utils_
+{
+ public:
+
+  // Tags used by the collective operations. They are sent through a
+  // separate channel, so they can not clash with user tags.
+
+  static const int  BARRIER_TAG = 1;
+  static const int  BCAST_TAG   = 2;
+  static const int  REDUCE_TAG  = 3;
+  static const int  CLONE_TAG   = 4;
+
+  static inline int       p2pChannel
+
+    ( int                   context );
+
+  static inline int       collChannel
+
+    ( int                   context );
+
+};
+
+
+//-----------------------------------------------------------------------
+//   p2pChannel & collChannel
+//-----------------------------------------------------------------------
+
+
+inline int ShmContext::Utils_::p2pChannel ( int context )
+{
+  return (2 * context);
+}
+
+
+inline int ShmContext::Utils_::collChannel ( int context )
+{
+  return (2 * context + 1);
+}
+
+
+//=======================================================================
+//   class ShmContext
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+ShmContext::ShmContext
+
+  ( const Ref<Engine>&  engine,
+    int                 context ) :
+
+    engine_  (  engine ),
+    context_ ( context )
+
+{
+  JEM_PRECHECK ( engine && context >= 0 );
+
+  static Once  once = JEM_ONCE_INITIALIZER;
+
+  runOnce ( once, & initOnce_ );
+}
+
+
+ShmContext::~ShmContext ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   getErrorString
+//-----------------------------------------------------------------------
+
+
+String ShmContext::getErrorString ( int err ) const
+{
+  return shm::makeErrorString ( err );
+}
+
+
+//-----------------------------------------------------------------------
+//   size
+//-----------------------------------------------------------------------
+
+
+int ShmContext::size () const
+{
+  return engine_->size ();
+}
+
+
+//-----------------------------------------------------------------------
+//   myRank
+//-----------------------------------------------------------------------
+
+
+int ShmContext::myRank () const
+{
+  return engine_->myRank ();
+}
+
+
+//-----------------------------------------------------------------------
+//   abort
+//-----------------------------------------------------------------------
+
+
+void ShmContext::abort ( int err )
+{
+  throw AbortException ( JEM_FUNC, err );
+}
+
+
+//-----------------------------------------------------------------------
+//   clone
+//-----------------------------------------------------------------------
+
+
+Ref<Context> ShmContext::clone ()
+{
+  int  count = engine_->getContextCount ();
+  int  err;
+
+
+  err = reduce_ ( RecvBuffer ( &count, 1 ),
+                  SendBuffer ( &count, 1 ), 0, MAX );
+  err = broadcast_ ( Buffer ( INT, &count, 1 ), 0, err );
+
+  if ( err )
+  {
+    shm::raiseError ( JEM_FUNC, err );
+  }
+
+  engine_->setContextCount ( count + 1 );
+
+  return newInstance<Self> ( engine_, count );
+}
+
+
+//-----------------------------------------------------------------------
+//   newRequestList
+//-----------------------------------------------------------------------
+
+
+Ref<RequestList> ShmContext::newRequestList ()
+{
+  return newInstance<shm::RequestList> (
+    engine_,
+    Utils_::p2pChannel ( context_ )
+  );
+}
+
+
+//-----------------------------------------------------------------------
+//   send
+//-----------------------------------------------------------------------
+
+
+void ShmContext::send
+
+  ( const SendBuffer&  buf,
+    int                dest,
+    int                tag )
+
+{
+  if ( dest < 0 || dest >= engine_->size() )
+  {
+    sendRankError ( JEM_FUNC, dest, engine_->size() );
+  }
+
+  if ( tag < 0 )
+  {
+    sendTagError  ( JEM_FUNC, tag );
+  }
+
+  Ref<Message>  msg =
+
+    newInstance<Message> ( Message::SEND_MODE, buf, dest, tag,
+                           Utils_::p2pChannel( context_ ) );
+
+  engine_->start ( msg );
+  engine_->wait  ( *msg );
+
+  if ( msg->status.error )
+  {
+    shm::raiseError ( JEM_FUNC, msg->status.error );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   recv
+//-----------------------------------------------------------------------
+
+
+void ShmContext::recv
+
+  ( const RecvBuffer&  buf,
+    int                src,
+    int                tag,
+    Status*            stat )
+
+{
+  if ( src >= engine_->size() || (src < 0 && src != ANY_SOURCE) )
+  {
+    recvRankError ( JEM_FUNC, src, engine_->size() );
+  }
+
+  if ( tag < 0 && tag != ANY_TAG )
+  {
+    recvTagError  ( JEM_FUNC, tag );
+  }
+
+  Ref<Message>  msg =
+
+    newInstance<Message> ( Message::RECV_MODE, buf, src, tag,
+                           Utils_::p2pChannel( context_ ) );
+
+  engine_->start ( msg );
+  engine_->wait  ( *msg );
+
+  if ( msg->status.error )
+  {
+    shm::raiseError ( JEM_FUNC, msg->status.error );
+  }
+
+  if ( stat )
+  {
+    *stat = msg->status;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   initSend
+//-----------------------------------------------------------------------
+
+
+Ref<jem::mp::Request> ShmContext::initSend
+
+  ( const SendBuffer&  buf,
+    int                dest,
+    int                tag )
+
+{
+  if ( dest < 0 || dest >= engine_->size() )
+  {
+    sendRankError ( JEM_FUNC, dest, engine_->size() );
+  }
+
+  if ( tag < 0 )
+  {
+    sendTagError  ( JEM_FUNC, tag );
+  }
+
+  Ref<Message>  msg =
+
+    newInstance<Message> ( Message::SEND_MODE, buf, dest, tag,
+                           Utils_::p2pChannel( context_ ) );
+
+  return newInstance<shm::Request> ( engine_, msg );
+}
+
+
+//-----------------------------------------------------------------------
+//   initRecv
+//-----------------------------------------------------------------------
+
+
+Ref<jem::mp::Request> ShmContext::initRecv
+
+  ( const RecvBuffer&  buf,
+    int                src,
+    int                tag )
+
+{
+  if ( src >= engine_->size() || (src < 0 && src != ANY_SOURCE) )
+  {
+    recvRankError ( JEM_FUNC, src, engine_->size() );
+  }
+
+  if ( tag < 0 && tag != ANY_TAG )
+  {
+    recvTagError  ( JEM_FUNC, tag );
+  }
+
+  Ref<Message>  msg =
+
+    newInstance<Message> ( Message::RECV_MODE, buf, src, tag,
+                           Utils_::p2pChannel( context_ ) );
+
+  return newInstance<shm::Request> ( engine_, msg );
+}
+
+
+//-----------------------------------------------------------------------
+//   barrier
+//-----------------------------------------------------------------------
+
+// Implements the dissemination barrier: in round k, each process
+// signals process (rank + 2^k) and waits for process (rank - 2^k).
+
+
+void ShmContext::barrier ()
+{
+  const int  n    = engine_->size   ();
+  const int  rank = engine_->myRank ();
+
+  Buffer     none ( INT, (void*) nullptr, 0 );
+
+  int        err  = 0;
+
+
+  for ( int k = 1; k < n; k <<= 1 )
+  {
+    err |= exchange_ ( none, (rank + k) % n,
+                       none, (rank - k + n) % n,
+                       Utils_::BARRIER_TAG );
+  }
+
+  if ( err )
+  {
+    shm::raiseError ( JEM_FUNC, err );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   broadcast
+//-----------------------------------------------------------------------
+
+
+void ShmContext::broadcast ( const SendBuffer& buf )
+{
+  int  err = broadcast_ ( buf, engine_->myRank(), 0 );
+
+  if ( err )
+  {
+    shm::raiseError ( JEM_FUNC, err );
+  }
+}
+
+
+void ShmContext::broadcast
+
+  ( const RecvBuffer&  buf,
+    int                root )
+
+{
+  if ( root < 0 || root >= engine_->size() )
+  {
+    sendRankError ( JEM_FUNC, root, engine_->size() );
+  }
+
+  int  err = broadcast_ ( buf, root, 0 );
+
+  if ( err )
+  {
+    shm::raiseError ( JEM_FUNC, err );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   reduce
+//-----------------------------------------------------------------------
+
+
+void ShmContext::reduce
+
+  ( const RecvBuffer&  in,
+    const SendBuffer&  out,
+    int                root,
+    Opcode             opcode )
+
+{
+  if ( root < 0 || root >= engine_->size() )
+  {
+    sendRankError ( JEM_FUNC, root, engine_->size() );
+  }
+
+  int  err = reduce_ ( in, out, root, opcode );
+
+  if ( err )
+  {
+    shm::raiseError ( JEM_FUNC, err );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   allreduce
+//-----------------------------------------------------------------------
+
+
+void ShmContext::allreduce
+
+  ( const RecvBuffer&  in,
+    const SendBuffer&  out,
+    Opcode             opcode )
+
+{
+  int  err = reduce_ ( in, out, 0, opcode );
+
+  err = broadcast_ ( in, 0, err );
+
+  if ( err )
+  {
+    shm::raiseError ( JEM_FUNC, err );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   broadcast_
+//-----------------------------------------------------------------------
+
+// Broadcasts a buffer along a binomial tree rooted at the specified
+// process. A process that has detected an error forwards an empty
+// message so that the error is propagated to all processes below it.
+// Returns the combined error code.
+
+
+int ShmContext::broadcast_
+
+  ( const Buffer&  buf,
+    int            root,
+    int            err )
+
+{
+  const int  n    = engine_->size   ();
+  const int  rank = engine_->myRank ();
+  const int  rel  = (rank - root + n) % n;
+
+  Buffer     none ( buf.type(), (void*) nullptr, 0 );
+
+  int        mask = 1;
+
+
+  while ( mask < n )
+  {
+    if ( rel & mask )
+    {
+      Status  stat;
+
+      err |= exchange_ ( none, -1,
+                         buf,  (rank - mask + n) % n,
+                         Utils_::BCAST_TAG, &stat );
+
+      if ( stat.size != buf.size() )
+      {
+        err |= shm::COLLECTIVE_ERROR;
+      }
+
+      break;
+    }
+
+    mask <<= 1;
+  }
+
+  for ( mask >>= 1; mask > 0; mask >>= 1 )
+  {
+    if ( rel + mask < n )
+    {
+      err |= exchange_ ( (err ? none : buf), (rank + mask) % n,
+                         none, -1,
+                         Utils_::BCAST_TAG );
+    }
+  }
+
+  return err;
+}
+
+
+//-----------------------------------------------------------------------
+//   reduce_
+//-----------------------------------------------------------------------
+
+// Reduces the send buffers along a binomial tree. Each process combines
+// the partial results of its children with its own data and passes the
+// result on to its parent. As in broadcast_(), errors are signalled to
+// the parent by sending an empty message.
+
+
+int ShmContext::reduce_
+
+  ( const RecvBuffer&  in,
+    const SendBuffer&  out,
+    int                root,
+    Opcode             opcode )
+
+{
+  const int         n     = engine_->size   ();
+  const int         rank  = engine_->myRank ();
+  const int         rel   = (rank - root + n) % n;
+  const Type        type  = out.type ();
+  const idx_t       count = out.size ();
+  const size_t      bytes = (size_t) sizeOf( type ) * (size_t) count;
+
+  Optable::Handler  op    = Optable::get ( opcode, type );
+
+  void*             acc   = nullptr;
+  void*             tmp   = nullptr;
+
+  int               err   = 0;
+  int               mask  = 1;
+
+
+  if ( ! op )
+  {
+    err |= shm::REDUCE_TYPE_ERROR;
+  }
+
+  if ( rank == root )
+  {
+    if ( in.type() != type )
+    {
+      err |= shm::BUFFER_TYPE_ERROR;
+    }
+
+    if ( in.size() != count )
+    {
+      err |= shm::BUFFER_SIZE_ERROR;
+    }
+  }
+
+  if ( bytes > 0 )
+  {
+    if ( rank == root && ! err )
+    {
+      acc = in.addr ();
+    }
+    else
+    {
+      acc = MemCache::alloc ( bytes );
+    }
+
+    tmp = MemCache::alloc ( bytes );
+
+    if ( acc != out.addr() )
+    {
+      std::memcpy ( acc, out.addr(), bytes );
+    }
+  }
+
+  try
+  {
+    Buffer  accBuf  ( type, acc, count );
+    Buffer  tmpBuf  ( type, tmp, count );
+    Buffer  none    ( type, (void*) nullptr, 0 );
+
+    while ( mask < n )
+    {
+      if ( rel & mask )
+      {
+        err |= exchange_ ( (err ? none : accBuf),
+                           (rank - mask + n) % n,
+                           none, -1,
+                           Utils_::REDUCE_TAG );
+        break;
+      }
+
+      if ( rel + mask < n )
+      {
+        Status  stat;
+
+        err |= exchange_ ( none, -1,
+                           tmpBuf, (rank + mask) % n,
+                           Utils_::REDUCE_TAG, &stat );
+
+        if ( stat.size != count )
+        {
+          err |= shm::COLLECTIVE_ERROR;
+        }
+
+        if ( ! err )
+        {
+          op ( accBuf, tmpBuf );
+        }
+      }
+
+      mask <<= 1;
+    }
+  }
+  catch ( ... )
+  {
+    if ( tmp )
+    {
+      MemCache::dealloc ( tmp, bytes );
+    }
+
+    if ( acc && acc != in.addr() )
+    {
+      MemCache::dealloc ( acc, bytes );
+    }
+
+    throw;
+  }
+
+  if ( tmp )
+  {
+    MemCache::dealloc ( tmp, bytes );
+  }
+
+  if ( acc && acc != in.addr() )
+  {
+    if ( rank == root && ! err )
+    {
+      std::memcpy ( in.addr(), acc, bytes );
+    }
+
+    MemCache::dealloc ( acc, bytes );
+  }
+
+  return err;
+}
+
+
+//-----------------------------------------------------------------------
+//   exchange_
+//-----------------------------------------------------------------------
+
+// Sends a buffer to process dest and receives a buffer from process
+// src through the collective channel. A negative rank means that the
+// corresponding operation is to be skipped. Returns the combined error
+// code of the two operations.
+
+
+int ShmContext::exchange_
+
+  ( const Buffer&  sbuf,
+    int            dest,
+    const Buffer&  rbuf,
+    int            src,
+    int            tag,
+    Status*        stat )
+
+{
+  const int     channel = Utils_::collChannel ( context_ );
+
+  Ref<Message>  smsg;
+  Ref<Message>  rmsg;
+
+  int           err = 0;
+
+
+  if ( dest >= 0 )
+  {
+    smsg = newInstance<Message> ( Message::SEND_MODE, sbuf,
+                                  dest, tag, channel );
+
+    engine_->start ( smsg );
+  }
+
+  if ( src >= 0 )
+  {
+    rmsg = newInstance<Message> ( Message::RECV_MODE, rbuf,
+                                  src,  tag, channel );
+
+    engine_->start ( rmsg );
+    engine_->wait  ( *rmsg );
+
+    err |= rmsg->status.error;
+
+    if ( stat )
+    {
+      *stat = rmsg->status;
+    }
+  }
+
+  if ( smsg )
+  {
+    engine_->wait ( *smsg );
+
+    err |= smsg->status.error;
+  }
+
+  return err;
+}
+
+
+//-----------------------------------------------------------------------
+//   initOnce_
+//-----------------------------------------------------------------------
+
+
+void ShmContext::initOnce_ ()
+{
+  Optable::init ();
+}
+
+
+JEM_END_PACKAGE( mp )
+
+#endif
@@ -0,0 +1,522 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <jem/defines.h>
+
+#ifdef JEM_OS_POSIX
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
+#include <ctime>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#ifdef JEM_OS_LINUX
+#  include <sys/prctl.h>
+#endif
+
+#include <jem/base/limits.h>
+#include <jem/base/System.h>
+#include <jem/base/Throwable.h>
+#include <jem/util/Flex.h>
+#include <jem/mp/Task.h>
+#include <jem/mp/MPException.h>
+#include <jem/mp/AbortException.h>
+#include <jem/mp/DriverException.h>
+#include <jem/mp/UniContext.h>
+#include <jem/mp/ShmContext.h>
+#include <jem/mp/ShmDriver.h>
+#include "shm/Engine.h"
+#include "shm/Segment.h"
+
+
+JEM_BEGIN_PACKAGE( mp )
+
+
+using jem::util::Flex;
+using jem::mp::shm::Engine;
+using jem::mp::shm::Segment;
+
+
+//=======================================================================
+//   class ShmDriver::Utils_
+//=======================================================================
+
+
+class ShmDriver::Utils_
+{
+ public:
+
+  static int              runChild
+
+    ( const Ref<Segment>&   seg,
+      int                   rank,
+      TaskFactory&          factory,
+      int                   argc,
+      char**                argv );
+
+  static int              reap
+
+    ( Flex<pid_t>&          pids,
+      bool                  block );
+
+  static void             sleep
+
+    ( long                  msec );
+
+};
+
+
+//-----------------------------------------------------------------------
+//   runChild
+//-----------------------------------------------------------------------
+
+// Executes the task in a child process and returns its exit code.
+
+
+int ShmDriver::Utils_::runChild
+
+  ( const Ref<Segment>&  seg,
+    int                  rank,
+    TaskFactory&         factory,
+    int                  argc,
+    char**               argv )
+
+{
+  int  code = 0;
+
+#ifdef JEM_OS_LINUX
+
+  // Allow the other processes to read from the address space of
+  // this process; this is needed for the direct copy of large
+  // messages.
+
+  prctl ( PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0 );
+
+#endif
+
+  seg->setProcID ( rank, (lint) ::getpid() );
+
+  try
+  {
+    Ref<Engine>   engine = newInstance<Engine>     ( seg, rank );
+    Ref<Context>  ctx    = newInstance<ShmContext> ( engine );
+    Ref<Task>     task   = factory.newTask ( ctx, argc, argv );
+
+    task->run ();
+  }
+  catch ( const AbortException& ex )
+  {
+    code = ex.abortCode;
+
+    if ( code == 0 )
+    {
+      code = 1;
+    }
+
+    seg->setAborted ( code );
+  }
+  catch ( const Throwable& ex )
+  {
+    System::printException ( System::err(), ex );
+
+    code = 1;
+
+    seg->setAborted ( code );
+  }
+  catch ( ... )
+  {
+    print ( System::err(), "\nUnknown exception caught\n" );
+
+    code = 1;
+
+    seg->setAborted ( code );
+  }
+
+  System::flush ();
+  std::fflush   ( nullptr );
+
+  return code;
+}
+
+
+//-----------------------------------------------------------------------
+//   reap
+//-----------------------------------------------------------------------
+
+// Collects the exit status of one of the worker processes. Returns -1
+// if no worker has exited or if waitpid() failed, 0 if a worker has
+// exited normally, and the exit code otherwise. Only the processes in
+// the array pids are waited for, so that other child processes are
+// left alone. As waitpid() can not block on a set of processes, a
+// blocking call polls the workers until one of them has exited.
+
+
+int ShmDriver::Utils_::reap
+
+  ( Flex<pid_t>&  pids,
+    bool          block )
+
+{
+  const idx_t  n = pids.size ();
+
+  int          status;
+  pid_t        pid;
+  idx_t        i, k;
+
+
+  while ( true )
+  {
+    k = 0;
+
+    for ( i = 0; i < n; i++ )
+    {
+      if ( pids[i] <= 0 )
+      {
+        continue;
+      }
+
+      k++;
+
+      do
+      {
+        pid = ::waitpid ( pids[i], &status, WNOHANG );
+      }
+      while ( pid < 0 && errno == EINTR );
+
+      if ( pid == 0 )
+      {
+        continue;
+      }
+
+      pids[i] = 0;
+
+      if ( pid < 0 )
+      {
+        // The process has already been reaped elsewhere (ECHILD) or
+        // can not be waited for; its exit status is not available.
+
+        return -1;
+      }
+
+      if ( WIFEXITED( status ) )
+      {
+        return WEXITSTATUS ( status );
+      }
+      else
+      {
+        return 128 + WTERMSIG ( status );
+      }
+    }
+
+    if ( ! block || k == 0 )
+    {
+      return -1;
+    }
+
+    sleep ( 10 );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   sleep
+//-----------------------------------------------------------------------
+
+
+void ShmDriver::Utils_::sleep ( long msec )
+{
+  struct timespec  ts;
+
+  ts.tv_sec  = msec / 1000;
+  ts.tv_nsec = (msec % 1000) * 1000000;
+
+  ::nanosleep ( &ts, nullptr );
+}
+
+
+//=======================================================================
+//   class ShmDriver
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+ShmDriver::ShmDriver ()
+{}
+
+
+ShmDriver::~ShmDriver ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   start
+//-----------------------------------------------------------------------
+
+
+void ShmDriver::start
+
+  ( TaskFactory&  factory,
+    int           argc,
+    char**        argv )
+
+{
+  scrubArgs ( argc, argv );
+
+  int  n = getProcCount_ ( argc, argv );
+
+  if ( n > 1 )
+  {
+    startProcs_ ( factory, n, argc, argv );
+  }
+  else
+  {
+    Ref<Context>  ctx  = newInstance<UniContext> ();
+    Ref<Task>     task = factory.newTask ( ctx, argc, argv );
+
+    task->run ();
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   startProcs_
+//-----------------------------------------------------------------------
+
+
+void ShmDriver::startProcs_
+
+  ( TaskFactory&  factory,
+    int           n,
+    int           argc,
+    char**        argv )
+
+{
+  Ref<Segment>  seg;
+  Flex<pid_t>   pids;
+
+  int           busyCount = 0;
+
+
+  try
+  {
+    seg = newInstance<Segment> ( n );
+  }
+  catch ( const MPException& ex )
+  {
+    throw DriverException ( JEM_FUNC, ex.what() );
+  }
+
+  pids.resize ( n );
+
+  pids = 0;
+
+  // Make sure that buffered output is not duplicated.
+
+  System::flush ();
+  std::fflush   ( nullptr );
+
+  for ( int i = 0; i < n; i++ )
+  {
+    pid_t  pid = ::fork ();
+
+    if ( pid == 0 )
+    {
+      ::_exit ( Utils_::runChild( seg, i, factory, argc, argv ) );
+    }
+
+    if ( pid < 0 )
+    {
+      String  msg = String::format (
+        "failed to create process %d: %s",
+        i,
+        std::strerror ( errno )
+      );
+
+      seg->setAborted ( 1 );
+
+      while ( busyCount > 0 && Utils_::reap( pids, true ) >= 0 )
+      {
+        busyCount--;
+      }
+
+      throw DriverException ( JEM_FUNC, msg );
+    }
+
+    pids[i] = pid;
+
+    busyCount++;
+  }
+
+  while ( busyCount > 0 && ! seg->isAborted() )
+  {
+    int  code = Utils_::reap ( pids, true );
+
+    if ( code < 0 )
+    {
+      break;
+    }
+
+    busyCount--;
+
+    if ( code > 0 )
+    {
+      seg->setAborted ( code );
+    }
+  }
+
+  if ( ! seg->isAborted() )
+  {
+    return;
+  }
+
+  if ( busyCount > 0 )
+  {
+    print ( System::err(), "\nWaiting for processes to exit ...\n" );
+
+    // Give all processes two seconds to close down.
+
+    for ( int i = 0; i < 200 && busyCount > 0; i++ )
+    {
+      while ( busyCount > 0 && Utils_::reap( pids, false ) >= 0 )
+      {
+        busyCount--;
+      }
+
+      if ( busyCount > 0 )
+      {
+        Utils_::sleep ( 10 );
+      }
+    }
+
+    if ( busyCount > 0 )
+    {
+      print ( System::err(), "Killing processes ...\n" );
+
+      for ( idx_t i = 0; i < pids.size(); i++ )
+      {
+        if ( pids[i] > 0 )
+        {
+          ::kill ( pids[i], SIGKILL );
+        }
+      }
+
+      while ( busyCount > 0 && Utils_::reap( pids, true ) >= 0 )
+      {
+        busyCount--;
+      }
+    }
+  }
+
+  print ( System::err(), "Terminating program.\n\n" );
+
+  std::exit ( seg->abortCode() );
+}
+
+
+//-----------------------------------------------------------------------
+//   getProcCount_
+//-----------------------------------------------------------------------
+
+
+int ShmDriver::getProcCount_ ( int& argc, char** argv )
+{
+  char*  end;
+  char*  arg;
+  long   n;
+  int    i;
+
+
+  for ( i = 1; i < argc; i++ )
+  {
+    if ( std::strcmp( argv[i], "-np" ) == 0 )
+    {
+      break;
+    }
+  }
+
+  if ( i == argc )
+  {
+    return 1;
+  }
+
+  if ( i == argc - 1 )
+  {
+    throw DriverException (
+      JEM_FUNC,
+      "missing number of processes"
+    );
+  }
+
+  arg = argv[i + 1];
+  n   = std::strtol ( arg, & end, 0 );
+
+  if ( *arg == '\0' || *end != '\0' || n <= 0 )
+  {
+    throw DriverException (
+      JEM_FUNC,
+      String::format (
+        "illegal number of processes specified: %s", arg
+      )
+    );
+  }
+
+  if ( n > maxOf<int>() )
+  {
+    throw DriverException (
+      JEM_FUNC,
+      String::format (
+        "too many processes specified: %d", n
+      )
+    );
+  }
+
+  // Shift the remaining arguments to the left
+
+  for ( i += 2; i < argc; i++ )
+  {
+    argv[i - 2] = argv[i];
+  }
+
+  argc -= 2;
+
+  return (int) n;
+}
+
+
+JEM_END_PACKAGE( mp )
+
+#endif
@@ -31,6 +31,11 @@
 #include <jem/mp/config.h>
 #include <jem/mp/MTDriver.h>
 #include <jem/mp/UniDriver.h>
+#include <jem/mp/ProfDriver.h>
+
+#ifdef JEM_OS_POSIX
+#  include <jem/mp/ShmDriver.h>
+#endif
 
 #ifdef JEM_USE_MPI
 #  include <jem/mp/MPIDriver.h>
@@ -70,6 +75,14 @@ StdDriverFactory::StdDriverFactory ()
 
   drivers->insert ( "uni",     driver );
 
+#ifdef JEM_OS_POSIX
+
+  driver  = jem::newInstance<ShmDriver> ();
+
+  drivers->insert ( "shm",     driver );
+
+#endif
+
 #ifdef JEM_USE_MPI
 
   driver  = jem::newInstance<MPIDriver> ();
@@ -101,6 +114,19 @@ Ref<Driver> StdDriverFactory::newDriver ( const String& name ) const
     driver = staticCast<Driver> ( drivers_->get ( name ) );
   }
 
+  // A name of the form "prof:<name>" selects the driver <name> with
+  // communication profiling enabled.
+
+  if ( ! driver && name.startsWith( "prof:" ) )
+  {
+    driver = newDriver ( name[slice(5,END)] );
+
+    if ( driver )
+    {
+      driver = jem::newInstance<ProfDriver> ( driver );
+    }
+  }
+
   return driver;
 }
 
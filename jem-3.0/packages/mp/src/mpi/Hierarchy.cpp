@@ -0,0 +1,211 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+#include <jem/mp/config.h>
+
+#ifdef JEM_USE_MPI
+
+#include <jem/base/array/utilities.h>
+#include <jem/mp/MPIContext.h>
+#include "error.h"
+#include "Hierarchy.h"
+
+
+JEM_BEGIN_PACKAGE   ( mp )
+JEM_BEGIN_NAMESPACE ( mpi )
+
+
+//=======================================================================
+//   class Hierarchy
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+Hierarchy::Hierarchy ( MPIContext& ctx ) :
+
+  nodeComm_   ( MPI_COMM_NULL ),
+  leaderComm_ ( MPI_COMM_NULL ),
+  nodeRank_   ( 0 ),
+  nodeIndex_  ( 0 ),
+  useful_     ( false )
+
+{
+  MPI_Comm    comm      = ctx.getComm ();
+  int         procCount = ctx.size    ();
+  int         myRank    = ctx.myRank  ();
+
+  Array<int>  buf;
+
+  int         err;
+
+
+  nodeCtx_   = ctx.splitShared ();
+  nodeComm_  = nodeCtx_->getComm ();
+  nodeRank_  = nodeCtx_->myRank  ();
+
+  leaderCtx_ = ctx.split ( (nodeRank_ == 0) ? 0 : -1, myRank );
+
+  if ( leaderCtx_ )
+  {
+    leaderComm_ = leaderCtx_->getComm ();
+    nodeIndex_  = leaderCtx_->myRank  ();
+  }
+
+  err = MPI_Bcast ( &nodeIndex_, 1, MPI_INT, 0, nodeComm_ );
+
+  if ( err )
+  {
+    raiseError ( JEM_FUNC, err );
+  }
+
+  // Find out where all other processes are located.
+
+  buf.resize ( 2 * procCount );
+
+  buf[2 * myRank + 0] = nodeIndex_;
+  buf[2 * myRank + 1] = nodeRank_;
+
+  err = MPI_Allgather ( MPI_IN_PLACE, 2, MPI_INT,
+                        buf.addr(),   2, MPI_INT, comm );
+
+  if ( err )
+  {
+    raiseError ( JEM_FUNC, err );
+  }
+
+  nodeIndices_.ref ( buf[slice(0,END,2)].clone() );
+  nodeRanks_  .ref ( buf[slice(1,END,2)].clone() );
+
+  // A hierarchy only pays off if there are multiple nodes and at
+  // least one node runs multiple processes.
+
+  int  nodeCount = max ( nodeIndices_ ) + 1;
+
+  useful_ = (nodeCount > 1 && nodeCount < procCount);
+}
+
+
+Hierarchy::~Hierarchy ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   broadcast
+//-----------------------------------------------------------------------
+
+// The node containing the root process broadcasts first, so that the
+// root never receives its own data.
+
+
+void Hierarchy::broadcast
+
+  ( void*         addr,
+    int           count,
+    MPI_Datatype  type,
+    int           root )
+
+{
+  const int  rootIndex = nodeIndices_[root];
+
+  int        err       = 0;
+
+
+  if ( nodeIndex_ == rootIndex )
+  {
+    err = MPI_Bcast ( addr, count, type,
+                      nodeRanks_[root], nodeComm_ );
+
+    if ( ! err && nodeRank_ == 0 )
+    {
+      err = MPI_Bcast ( addr, count, type, rootIndex, leaderComm_ );
+    }
+  }
+  else
+  {
+    if ( nodeRank_ == 0 )
+    {
+      err = MPI_Bcast ( addr, count, type, rootIndex, leaderComm_ );
+    }
+
+    if ( ! err )
+    {
+      err = MPI_Bcast ( addr, count, type, 0, nodeComm_ );
+    }
+  }
+
+  if ( err )
+  {
+    raiseError ( JEM_FUNC, err );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   allreduce
+//-----------------------------------------------------------------------
+
+
+void Hierarchy::allreduce
+
+  ( const void*   sbuf,
+    void*         rbuf,
+    int           count,
+    MPI_Datatype  type,
+    MPI_Op        op )
+
+{
+  int  err;
+
+  err = MPI_Reduce ( const_cast<void*> ( sbuf ), rbuf,
+                     count, type, op, 0, nodeComm_ );
+
+  if ( ! err && nodeRank_ == 0 )
+  {
+    err = MPI_Allreduce ( MPI_IN_PLACE, rbuf,
+                          count, type, op, leaderComm_ );
+  }
+
+  if ( ! err )
+  {
+    err = MPI_Bcast ( rbuf, count, type, 0, nodeComm_ );
+  }
+
+  if ( err )
+  {
+    raiseError ( JEM_FUNC, err );
+  }
+}
+
+
+JEM_END_NAMESPACE ( mpi )
+JEM_END_PACKAGE   ( mp )
+
+#endif
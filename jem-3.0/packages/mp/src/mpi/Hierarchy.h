@@ -0,0 +1,124 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+#ifndef JEM_MP_MPI_HIERARCHY_H
+#define JEM_MP_MPI_HIERARCHY_H
+
+#include <jem/base/Object.h>
+#include <jem/base/array/Array.h>
+#include <jem/mp/mpi.h>
+#include <jem/mp/Buffer.h>
+#include <jem/mp/MPIContext.h>
+
+
+JEM_BEGIN_PACKAGE   ( mp )
+JEM_BEGIN_NAMESPACE ( mpi )
+
+
+//-----------------------------------------------------------------------
+//   class Hierarchy
+//-----------------------------------------------------------------------
+
+// Splits a context into one context per (shared-memory) node and
+// one context containing the node leaders. The latter is the process
+// with local rank zero on each node.
+
+
+class Hierarchy : public Object
+{
+ public:
+
+  typedef Hierarchy         Self;
+  typedef Object            Super;
+
+
+  explicit                  Hierarchy
+
+    ( MPIContext&             ctx );
+
+  inline bool               isUseful    () const noexcept;
+
+  void                      broadcast
+
+    ( void*                   addr,
+      int                     count,
+      MPI_Datatype            type,
+      int                     root );
+
+  void                      allreduce
+
+    ( const void*             sbuf,
+      void*                   rbuf,
+      int                     count,
+      MPI_Datatype            type,
+      MPI_Op                  op );
+
+
+ protected:
+
+  virtual                  ~Hierarchy   ();
+
+
+ private:
+
+  Ref<MPIContext>           nodeCtx_;
+  Ref<MPIContext>           leaderCtx_;
+
+  MPI_Comm                  nodeComm_;
+  MPI_Comm                  leaderComm_;
+
+  int                       nodeRank_;
+  int                       nodeIndex_;
+
+  Array<int>                nodeIndices_;
+  Array<int>                nodeRanks_;
+
+  bool                      useful_;
+
+};
+
+
+//#######################################################################
+//   Implementation
+//#######################################################################
+
+//-----------------------------------------------------------------------
+//   isUseful
+//-----------------------------------------------------------------------
+
+
+inline bool Hierarchy::isUseful () const noexcept
+{
+  return useful_;
+}
+
+
+JEM_END_NAMESPACE ( mpi )
+JEM_END_PACKAGE   ( mp )
+
+#endif
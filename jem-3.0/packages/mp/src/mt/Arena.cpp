@@ -53,7 +53,7 @@ Arena::Arena ( int n ) :
 {
   for ( int i = 0; i < n; i++ )
   {
-    mpools[i] = newInstance<MessagePool> ();
+    mpools[i] = newInstance<MessagePool> ( n );
   }
 }
 
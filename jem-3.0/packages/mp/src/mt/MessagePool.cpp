@@ -40,21 +40,122 @@ JEM_BEGIN_NAMESPACE ( mt )
 using jem::util::ListNode;
 
 
+//=======================================================================
+//   class MessagePool::Utils_
+//=======================================================================
+
+
+class MessagePool::Utils_
+{
+ public:
+
+  static inline Message*  findRecv
+
+    ( ListNode&             list,
+      int                   tag );
+
+  static inline Message*  findSend
+
+    ( ListNode&             list,
+      int                   tag );
+
+};
+
+
+//-----------------------------------------------------------------------
+//   findRecv
+//-----------------------------------------------------------------------
+
+// Returns the first receive message in a list that matches a send
+// message with the given tag.
+
+
+inline Message* MessagePool::Utils_::findRecv
+
+  ( ListNode&  list,
+    int        tag )
+
+{
+  for ( ListNode* node = list.next(); node != &list;
+        node = node->next() )
+  {
+    Message*  rmsg = static_cast<Message*> ( node );
+
+    if ( rmsg->tag == tag || rmsg->tag == ANY_TAG )
+    {
+      return rmsg;
+    }
+  }
+
+  return nullptr;
+}
+
+
+//-----------------------------------------------------------------------
+//   findSend
+//-----------------------------------------------------------------------
+
+// Returns the first send message in a list that matches a receive
+// message with the given tag.
+
+
+inline Message* MessagePool::Utils_::findSend
+
+  ( ListNode&  list,
+    int        tag )
+
+{
+  for ( ListNode* node = list.next(); node != &list;
+        node = node->next() )
+  {
+    Message*  smsg = static_cast<Message*> ( node );
+
+    if ( smsg->tag == tag || tag == ANY_TAG )
+    {
+      return smsg;
+    }
+  }
+
+  return nullptr;
+}
+
+
 //=======================================================================
 //   class MessagePool
 //=======================================================================
 
+// Each pool has a separate queue for each source process, protected by
+// its own spin lock, so that processes sending to the same destination
+// do not contend with each other. Only receives from any source go
+// through the pool-wide lock. The number of pending any-source receives
+// is tracked in anyCount_, so that a sender only needs to take the
+// pool-wide lock when such a receive may match its message.
+//
+// The lock order is: first anyLock_, then the lock of a queue.
+
 //-----------------------------------------------------------------------
 //   constructor & destructor
 //-----------------------------------------------------------------------
 
 
-MessagePool::MessagePool ()
-{}
+MessagePool::MessagePool ( int size ) :
+
+  size_     ( size ),
+  anyCount_ ( 0 )
+
+{
+  JEM_PRECHECK ( size > 0 );
+
+  mqueues_ = new Queue_[size];
+}
 
 
 MessagePool::~MessagePool ()
-{}
+{
+  delete [] mqueues_;
+
+  mqueues_ = nullptr;
+}
 
 
 //-----------------------------------------------------------------------
@@ -64,60 +165,79 @@ MessagePool::~MessagePool ()
 
 bool MessagePool::queueSend ( Message& smsg )
 {
-  Queue_&    mqueue = mqueues_[smsg.rank & QUEUE_MASK_];
-
-  ListNode*  list;
-  ListNode*  node;
+  JEM_ASSERT_NOTHROW ( ! smsg.enqueued &&
+                       smsg.rank >= 0 && smsg.rank < size_ );
 
+  Queue_&   mqueue = mqueues_[smsg.rank];
+  Message*  rmsg;
 
-  JEM_ASSERT_NOTHROW ( ! smsg.enqueued );
 
-  list = & mqueue.recvList;
-
-  spinlock_.lock ();
+  mqueue.spinlock.lock ();
 
   // Check the recv list.
 
-  for ( node = list->next(); node != list; node = node->next() )
+  rmsg = Utils_::findRecv ( mqueue.recvList, smsg.tag );
+
+  if ( rmsg )
   {
-    Message&  rmsg = static_cast<Message&> ( *node );
+    rmsg->unlink ();
+    mqueue.spinlock.unlock ();
+    rmsg->copy   ( smsg );
+    rmsg->notify ();
 
-    if ( rmsg.rank == smsg.rank &&
-         (rmsg.tag == smsg.tag  || rmsg.tag == ANY_TAG) )
-    {
-      rmsg     .unlink ();
-      spinlock_.unlock ();
-      rmsg     .copy   ( smsg );
-      rmsg     .notify ();
+    return false;
+  }
 
-      return false;
-    }
+  // Add the message to the send list if there are no pending
+  // any-source receives. Note that anyCount_ is incremented before
+  // the send lists are scanned in queueAnyRecv().
+
+  if ( anyCount_.load() == 0 )
+  {
+    smsg.enqueued = true;
+    mqueue.sendList.pushFront ( & smsg );
+    mqueue.spinlock.unlock ();
+
+    return true;
   }
 
-  // Check the any-source recv list.
+  mqueue.spinlock.unlock ();
 
-  list = & anyList_;
+  // Check both the recv list and the any-source recv list while
+  // holding both locks.
 
-  for ( node = list->next(); node != list; node = node->next() )
+  anyLock_       .lock ();
+  mqueue.spinlock.lock ();
+
+  rmsg = Utils_::findRecv ( mqueue.recvList, smsg.tag );
+
+  if ( ! rmsg )
   {
-    Message&  rmsg = static_cast<Message&> ( *node );
+    rmsg = Utils_::findRecv ( anyList_, smsg.tag );
 
-    if ( rmsg.tag == smsg.tag || rmsg.tag == ANY_TAG )
+    if ( rmsg )
     {
-      rmsg     .unlink ();
-      spinlock_.unlock ();
-      rmsg     .copy   ( smsg );
-      rmsg     .notify ();
-
-      return false;
+      anyCount_--;
     }
   }
 
+  if ( rmsg )
+  {
+    rmsg->unlink ();
+    mqueue.spinlock.unlock ();
+    anyLock_.unlock ();
+    rmsg->copy   ( smsg );
+    rmsg->notify ();
+
+    return false;
+  }
+
   // Add the message to the send list.
 
   smsg.enqueued = true;
   mqueue.sendList.pushFront ( & smsg );
-  spinlock_.unlock ();
+  mqueue.spinlock.unlock ();
+  anyLock_.unlock ();
 
   return true;
 }
@@ -130,41 +250,34 @@ bool MessagePool::queueSend ( Message& smsg )
 
 bool MessagePool::queueRecv ( Message& rmsg )
 {
-  Queue_&    mqueue = mqueues_[rmsg.rank & QUEUE_MASK_];
+  JEM_ASSERT_NOTHROW ( ! rmsg.enqueued &&
+                       rmsg.rank >= 0 && rmsg.rank < size_ );
 
-  ListNode*  list;
-  ListNode*  node;
+  Queue_&   mqueue = mqueues_[rmsg.rank];
+  Message*  smsg;
 
 
-  JEM_ASSERT_NOTHROW ( ! rmsg.enqueued );
-
-  list = & mqueue.sendList;
-
-  spinlock_.lock ();
+  mqueue.spinlock.lock ();
 
   // Check the send list.
 
-  for ( node = list->next(); node != list; node = node->next() )
-  {
-    Message&  smsg = static_cast<Message&> ( *node );
+  smsg = Utils_::findSend ( mqueue.sendList, rmsg.tag );
 
-    if ( smsg.rank == rmsg.rank &&
-         (rmsg.tag == smsg.tag || rmsg.tag == ANY_TAG) )
-    {
-      smsg     .unlink ();
-      spinlock_.unlock ();
-      rmsg     .copy   ( smsg );
-      smsg     .notify ();
+  if ( smsg )
+  {
+    smsg->unlink ();
+    mqueue.spinlock.unlock ();
+    rmsg .copy   ( *smsg );
+    smsg->notify ();
 
-      return false;
-    }
+    return false;
   }
 
   // Add the message to the recv list.
 
   rmsg.enqueued = true;
   mqueue.recvList.pushFront ( & rmsg );
-  spinlock_.unlock ();
+  mqueue.spinlock.unlock ();
 
   return true;
 }
@@ -177,44 +290,47 @@ bool MessagePool::queueRecv ( Message& rmsg )
 
 bool MessagePool::queueAnyRecv ( Message& rmsg )
 {
-  Queue_*    mqueue;
-  ListNode*  list;
-  ListNode*  node;
-  int        i;
+  JEM_ASSERT_NOTHROW ( ! rmsg.enqueued );
 
+  Message*  smsg;
 
-  JEM_ASSERT_NOTHROW ( ! rmsg.enqueued );
 
-  spinlock_.lock ();
+  // Force senders to take the slow path before scanning the send
+  // lists; see queueSend().
+
+  anyCount_++;
+  anyLock_.lock ();
 
   // Check all send lists.
 
-  for ( i = 0; i < QUEUE_COUNT_; i++ )
+  for ( int i = 0; i < size_; i++ )
   {
-    mqueue = mqueues_ + i;
-    list   = & mqueue->sendList;
+    Queue_&  mqueue = mqueues_[i];
 
-    for ( node = list->next(); node != list; node = node->next() )
-    {
-      Message&  smsg = static_cast<Message&> ( *node );
+    mqueue.spinlock.lock ();
+
+    smsg = Utils_::findSend ( mqueue.sendList, rmsg.tag );
 
-      if ( rmsg.tag == smsg.tag || rmsg.tag == ANY_TAG )
-      {
-        smsg     .unlink ();
-        spinlock_.unlock ();
-        rmsg     .copy   ( smsg );
-        smsg     .notify ();
+    if ( smsg )
+    {
+      smsg->unlink ();
+      mqueue.spinlock.unlock ();
+      anyCount_--;
+      anyLock_.unlock ();
+      rmsg .copy   ( *smsg );
+      smsg->notify ();
 
-        return false;
-      }
+      return false;
     }
+
+    mqueue.spinlock.unlock ();
   }
 
   // Add the message to the any-source recv list.
 
   rmsg.enqueued = true;
-  anyList_ .pushFront ( & rmsg );
-  spinlock_.unlock    ();
+  anyList_.pushFront ( & rmsg );
+  anyLock_.unlock    ();
 
   return true;
 }
@@ -229,17 +345,32 @@ void MessagePool::cancel ( Message& msg )
 {
   ListNode*  node     = & msg;
   bool       dequeued = false;
+  SpinLock*  spinlock;
 
 
-  spinlock_.lock ();
+  if ( msg.rank < 0 )
+  {
+    spinlock = & anyLock_;
+  }
+  else
+  {
+    spinlock = & mqueues_[msg.rank].spinlock;
+  }
+
+  spinlock->lock ();
 
   if ( node->next() != node )
   {
     node->unlink ();
     dequeued = true;
+
+    if ( msg.rank < 0 )
+    {
+      anyCount_--;
+    }
   }
 
-  spinlock_.unlock ();
+  spinlock->unlock ();
 
   if ( dequeued )
   {
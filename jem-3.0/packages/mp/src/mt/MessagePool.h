@@ -29,6 +29,7 @@
 #ifndef JEM_MP_MT_MESSAGEPOOL_H
 #define JEM_MP_MT_MESSAGEPOOL_H
 
+#include <atomic>
 #include <jem/base/Object.h>
 #include <jem/base/SpinLock.h>
 #include <jem/util/ListNode.h>
@@ -54,7 +55,9 @@ class MessagePool : public Object
   typedef Object        Super;
 
 
-                        MessagePool  ();
+  explicit              MessagePool
+
+    ( int                 size );
 
   bool                  queueSend
 
@@ -80,23 +83,32 @@ class MessagePool : public Object
 
  private:
 
-  static const int      QUEUE_COUNT_ = 8;
-  static const int      QUEUE_MASK_  = QUEUE_COUNT_ - 1;
-
-
   class                 Queue_
   {
    public:
 
+    SpinLock              spinlock;
     util::ListNode        sendList;
     util::ListNode        recvList;
 
+    // Keeps the queues of different source processes in different
+    // cache lines.
+
+    char                  padding[64];
+
   };
 
 
-  Queue_                mqueues_ [ QUEUE_COUNT_ ];
+  class                 Utils_;
+
+
+ private:
+
+  const int             size_;
+  Queue_*               mqueues_;
   util::ListNode        anyList_;
-  SpinLock              spinlock_;
+  SpinLock              anyLock_;
+  std::atomic_int       anyCount_;
 
 };
 
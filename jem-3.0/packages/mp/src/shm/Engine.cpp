@@ -0,0 +1,1143 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <jem/defines.h>
+
+#ifdef JEM_OS_POSIX
+
+#include <cerrno>
+#include <cstring>
+#include <sched.h>
+#include <time.h>
+#include <jem/base/assert.h>
+#include <jem/base/MemCache.h>
+#include <jem/mp/params.h>
+#include <jem/mp/AbortException.h>
+#include "error.h"
+#include "Engine.h"
+
+#ifdef JEM_OS_LINUX
+#  include <sys/types.h>
+#  include <sys/uio.h>
+#endif
+
+
+JEM_BEGIN_PACKAGE   ( mp )
+JEM_BEGIN_NAMESPACE ( shm )
+
+
+//=======================================================================
+//   class Engine::Utils_
+//=======================================================================
+
+
+class Engine::Utils_
+{
+ public:
+
+  static const int      EAGER_PACKET = 1;
+  static const int      RTS_PACKET   = 2;
+  static const int      CTS_PACKET   = 3;
+  static const int      FIN_PACKET   = 4;
+  static const int      CHUNK_PACKET = 5;
+
+
+  static inline ulint   packetSize
+
+    ( ulint               payload );
+
+  static inline bool    matches
+
+    ( const Message&      msg,
+      int                 src,
+      int                 context,
+      int                 tag );
+
+  static inline int     checkBuffer
+
+    ( const Buffer&       buf,
+      int                 type,
+      lint                count );
+
+  static inline void    setStatus
+
+    ( Message&            msg,
+      int                 src,
+      const Packet_&      p );
+
+  static bool           writePacket
+
+    ( Ring&               ring,
+      const Packet_&      p,
+      const void*         payload );
+
+  static void           backoff
+
+    ( idx_t               idle );
+
+};
+
+
+//-----------------------------------------------------------------------
+//   packetSize
+//-----------------------------------------------------------------------
+
+
+inline ulint Engine::Utils_::packetSize ( ulint payload )
+{
+  return (sizeof(Packet_) + ((payload + 7_ulint) & ~7_ulint));
+}
+
+
+//-----------------------------------------------------------------------
+//   matches
+//-----------------------------------------------------------------------
+
+
+inline bool Engine::Utils_::matches
+
+  ( const Message&  msg,
+    int             src,
+    int             context,
+    int             tag )
+
+{
+  return (msg.context == context &&
+          (msg.rank == src || msg.rank == ANY_SOURCE) &&
+          (msg.tag  == tag || msg.tag  == ANY_TAG));
+}
+
+
+//-----------------------------------------------------------------------
+//   checkBuffer
+//-----------------------------------------------------------------------
+
+
+inline int Engine::Utils_::checkBuffer
+
+  ( const Buffer&  buf,
+    int            type,
+    lint           count )
+
+{
+  if      ( buf.type() != type )
+  {
+    return BUFFER_TYPE_ERROR;
+  }
+  else if ( buf.size() < count )
+  {
+    return BUFFER_SIZE_ERROR;
+  }
+  else
+  {
+    return 0;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   setStatus
+//-----------------------------------------------------------------------
+
+
+inline void Engine::Utils_::setStatus
+
+  ( Message&        msg,
+    int             src,
+    const Packet_&  p )
+
+{
+  msg.status.source = src;
+  msg.status.tag    = p.tag;
+  msg.status.size   = (idx_t) p.count;
+  msg.status.error  = checkBuffer ( msg.buffer, p.type, p.count );
+}
+
+
+//-----------------------------------------------------------------------
+//   writePacket
+//-----------------------------------------------------------------------
+
+
+bool Engine::Utils_::writePacket
+
+  ( Ring&           ring,
+    const Packet_&  p,
+    const void*     payload )
+
+{
+  const ulint  n = packetSize ( (ulint) p.size );
+
+  if ( ring.freeSpace() < n )
+  {
+    return false;
+  }
+
+  ring.put ( 0, &p, sizeof(Packet_) );
+
+  if ( p.size > 0 )
+  {
+    ring.put ( sizeof(Packet_), payload, (ulint) p.size );
+  }
+
+  ring.commit ( n );
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------
+//   backoff
+//-----------------------------------------------------------------------
+
+// Gives up the processor after a number of idle polling rounds, so
+// that more processes than processors can be used.
+
+
+void Engine::Utils_::backoff ( idx_t idle )
+{
+  if      ( idle < 16 )
+  {
+    return;
+  }
+  else if ( idle < 4096 )
+  {
+    ::sched_yield ();
+  }
+  else
+  {
+    struct timespec  ts;
+
+    ts.tv_sec  = 0;
+    ts.tv_nsec = 20000;
+
+    ::nanosleep ( &ts, nullptr );
+  }
+}
+
+
+//=======================================================================
+//   class Engine
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+Engine::Engine
+
+  ( const Ref<Segment>&  seg,
+    int                  rank ) :
+
+    segment_ ( seg ),
+    myRank_  ( rank ),
+    size_    ( seg->procCount() )
+
+{
+  JEM_PRECHECK ( rank >= 0 && rank < seg->procCount() );
+
+  eagerLimit_   = seg->ringSize() / 8;
+  chunkSize_    = seg->ringSize() / 4;
+  nextHandle_   = 1;
+  contextCount_ = 1;
+
+#ifdef JEM_OS_LINUX
+  canCopy_      = true;
+#else
+  canCopy_      = false;
+#endif
+
+  outbox_ .resize ( size_ );
+  control_.resize ( size_ );
+}
+
+
+Engine::~Engine ()
+{
+  const idx_t  n = unexpected_.size ();
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    Envelope_&  env = unexpected_[i];
+
+    if ( env.data )
+    {
+      MemCache::dealloc ( env.data, (size_t) env.packet.size );
+
+      env.data = nullptr;
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   start
+//-----------------------------------------------------------------------
+
+
+void Engine::start ( const Ref<Message>& msg )
+{
+  Lock<Mutex>  lock ( mutex_ );
+
+  JEM_PRECHECK ( msg->state == Message::IDLE ||
+                 msg->state == Message::DONE );
+
+  msg->status       = EMPTY_STATUS;
+  msg->status.error = 0;
+  msg->handle       = -1;
+  msg->peer         = -1;
+  msg->offset       = 0;
+  msg->bytes        = (ulint) (sizeOf( msg->buffer.type() ) *
+                               msg->buffer.size());
+
+  if ( msg->mode == Message::SEND_MODE )
+  {
+    startSend_ ( msg );
+  }
+  else
+  {
+    startRecv_ ( msg );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   test
+//-----------------------------------------------------------------------
+
+
+bool Engine::test ( Message& msg )
+{
+  Lock<Mutex>  lock ( mutex_ );
+
+  if ( msg.state != Message::DONE )
+  {
+    progress_ ();
+  }
+
+  return (msg.state == Message::DONE || msg.state == Message::IDLE);
+}
+
+
+//-----------------------------------------------------------------------
+//   wait
+//-----------------------------------------------------------------------
+
+
+void Engine::wait ( Message& msg )
+{
+  idx_t  idle = 0;
+
+  while ( true )
+  {
+    bool  busy;
+
+    {
+      Lock<Mutex>  lock ( mutex_ );
+
+      if ( msg.state == Message::DONE || msg.state == Message::IDLE )
+      {
+        break;
+      }
+
+      busy = progress_ ();
+    }
+
+    if ( busy )
+    {
+      idle = 0;
+    }
+    else
+    {
+      pause ( idle++ );
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   poll
+//-----------------------------------------------------------------------
+
+// Processes all incoming and outgoing packets that can be processed
+// without waiting. Returns true if there was anything to do.
+
+
+bool Engine::poll ()
+{
+  Lock<Mutex>  lock ( mutex_ );
+
+  return progress_ ();
+}
+
+
+//-----------------------------------------------------------------------
+//   pause
+//-----------------------------------------------------------------------
+
+// Must be called when poll() returns false; idle is the number of
+// consecutive times that poll() had nothing to do.
+
+
+void Engine::pause ( idx_t idle ) const
+{
+  checkAborted    ();
+  Utils_::backoff ( idle );
+}
+
+
+//-----------------------------------------------------------------------
+//   cancel
+//-----------------------------------------------------------------------
+
+// Cancels a message that has not been matched yet. A message that is
+// being transferred can not be cancelled; this function then waits
+// until the transfer has been completed.
+
+
+void Engine::cancel ( Message& msg )
+{
+  {
+    Lock<Mutex>  lock ( mutex_ );
+
+    MsgQueue_*  queue = nullptr;
+
+    if      ( msg.state == Message::POSTED )
+    {
+      queue = & posted_;
+    }
+    else if ( msg.state == Message::QUEUED )
+    {
+      queue = & outbox_[msg.rank];
+    }
+
+    if ( queue )
+    {
+      const idx_t  n = queue->size ();
+
+      for ( idx_t i = 0; i < n; i++ )
+      {
+        if ( (*queue)[i].get() == &msg )
+        {
+          queue->erase ( queue->begin() + i );
+          break;
+        }
+      }
+
+      msg.state = Message::IDLE;
+    }
+  }
+
+  wait ( msg );
+}
+
+
+//-----------------------------------------------------------------------
+//   checkAborted
+//-----------------------------------------------------------------------
+
+
+void Engine::checkAborted () const
+{
+  if ( segment_->isAborted() )
+  {
+    throw AbortException ( JEM_FUNC, segment_->abortCode() );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   getContextCount & setContextCount
+//-----------------------------------------------------------------------
+
+
+int Engine::getContextCount ()
+{
+  Lock<Mutex>  lock ( mutex_ );
+
+  return contextCount_;
+}
+
+
+void Engine::setContextCount ( int count )
+{
+  Lock<Mutex>  lock ( mutex_ );
+
+  contextCount_ = count;
+}
+
+
+//-----------------------------------------------------------------------
+//   progress_
+//-----------------------------------------------------------------------
+
+
+bool Engine::progress_ ()
+{
+  bool  busy = false;
+
+  for ( int i = 0; i < size_; i++ )
+  {
+    if ( i == myRank_ )
+    {
+      continue;
+    }
+
+    if ( drainIn_( i ) )
+    {
+      busy = true;
+    }
+
+    if ( control_[i].size() || outbox_[i].size() )
+    {
+      if ( flushOut_( i ) )
+      {
+        busy = true;
+      }
+    }
+  }
+
+  return busy;
+}
+
+
+//-----------------------------------------------------------------------
+//   startSend_
+//-----------------------------------------------------------------------
+
+
+void Engine::startSend_ ( const Ref<Message>& msg )
+{
+  const int  dest = msg->rank;
+
+  msg->status.source = myRank_;
+  msg->status.tag    = msg->tag;
+  msg->status.size   = msg->buffer.size ();
+
+  if ( dest != myRank_ )
+  {
+    msg->state = Message::QUEUED;
+
+    outbox_[dest].pushBack ( msg );
+    flushOut_ ( dest );
+
+    return;
+  }
+
+  // Messages to self are delivered directly, or are copied to the
+  // list of unexpected messages.
+
+  Ref<Message>  recv;
+  Packet_       p;
+
+  p.kind    = Utils_::EAGER_PACKET;
+  p.context = msg->context;
+  p.tag     = msg->tag;
+  p.type    = msg->buffer.type ();
+  p.count   = msg->buffer.size ();
+  p.size    = (lint) msg->bytes;
+  p.handle  = 0;
+  p.addr    = 0;
+
+  recv = matchPosted_ ( myRank_, p.context, p.tag );
+
+  if ( recv )
+  {
+    Utils_::setStatus ( *recv, myRank_, p );
+
+    if ( ! recv->status.error && p.size > 0 )
+    {
+      std::memcpy ( recv->buffer.addr(), msg->buffer.addr(),
+                    (size_t) p.size );
+    }
+
+    recv->state = Message::DONE;
+  }
+  else
+  {
+    Envelope_  env;
+
+    env.packet = p;
+    env.source = myRank_;
+    env.data   = nullptr;
+
+    if ( p.size > 0 )
+    {
+      env.data = MemCache::alloc ( (size_t) p.size );
+
+      std::memcpy ( env.data, msg->buffer.addr(), (size_t) p.size );
+    }
+
+    unexpected_.pushBack ( env );
+  }
+
+  msg->state = Message::DONE;
+}
+
+
+//-----------------------------------------------------------------------
+//   startRecv_
+//-----------------------------------------------------------------------
+
+
+void Engine::startRecv_ ( const Ref<Message>& msg )
+{
+  const idx_t  n = unexpected_.size ();
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    Envelope_  env = unexpected_[i];
+
+    if ( ! Utils_::matches( *msg, env.source,
+                            env.packet.context, env.packet.tag ) )
+    {
+      continue;
+    }
+
+    unexpected_.erase ( unexpected_.begin() + i );
+
+    if ( env.packet.kind == Utils_::RTS_PACKET )
+    {
+      startPull_ ( *msg, env.source, env.packet );
+    }
+    else
+    {
+      Utils_::setStatus ( *msg, env.source, env.packet );
+
+      if ( env.data )
+      {
+        if ( ! msg->status.error )
+        {
+          std::memcpy ( msg->buffer.addr(), env.data,
+                        (size_t) env.packet.size );
+        }
+
+        MemCache::dealloc ( env.data, (size_t) env.packet.size );
+      }
+
+      msg->state = Message::DONE;
+    }
+
+    return;
+  }
+
+  msg->state = Message::POSTED;
+
+  posted_.pushBack ( msg );
+}
+
+
+//-----------------------------------------------------------------------
+//   matchPosted_
+//-----------------------------------------------------------------------
+
+
+Ref<Message> Engine::matchPosted_
+
+  ( int  src,
+    int  context,
+    int  tag )
+
+{
+  const idx_t   n = posted_.size ();
+
+  Ref<Message>  msg;
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    if ( Utils_::matches( *posted_[i], src, context, tag ) )
+    {
+      msg = posted_[i];
+
+      posted_.erase ( posted_.begin() + i );
+      break;
+    }
+  }
+
+  return msg;
+}
+
+
+//-----------------------------------------------------------------------
+//   findPending_
+//-----------------------------------------------------------------------
+
+
+Ref<Message> Engine::findPending_
+
+  ( Message::Mode  mode,
+    int            peer,
+    lint           handle )
+
+{
+  const idx_t   n = pending_.size ();
+
+  Ref<Message>  msg;
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    Message&  m = *pending_[i];
+
+    if ( m.mode == mode && m.peer == peer && m.handle == handle )
+    {
+      msg = pending_[i];
+
+      pending_.erase ( pending_.begin() + i );
+      break;
+    }
+  }
+
+  return msg;
+}
+
+
+//-----------------------------------------------------------------------
+//   startPull_
+//-----------------------------------------------------------------------
+
+// Starts the second half of the rendezvous protocol after a request
+// to send (RTS) packet has been matched with a receive operation.
+
+
+void Engine::startPull_
+
+  ( Message&        msg,
+    int             src,
+    const Packet_&  p )
+
+{
+  Utils_::setStatus ( msg, src, p );
+
+  msg.bytes = (ulint) (sizeOf( (Type) p.type ) * p.count);
+
+  if ( msg.status.error == 0 && msg.bytes > 0 )
+  {
+    if ( directCopy_( msg.buffer.addr(), src, p.addr, msg.bytes ) )
+    {
+      msg.offset = msg.bytes;
+    }
+    else
+    {
+      // Ask the sender to stream the data.
+
+      msg.state  = Message::STREAMING;
+      msg.peer   = src;
+      msg.handle = p.handle;
+      msg.offset = 0;
+
+      pending_.pushBack ( &msg );
+      sendControl_      ( src, Utils_::CTS_PACKET, p.handle );
+
+      return;
+    }
+  }
+
+  msg.state = Message::DONE;
+
+  sendControl_ ( src, Utils_::FIN_PACKET, p.handle );
+}
+
+
+//-----------------------------------------------------------------------
+//   directCopy_
+//-----------------------------------------------------------------------
+
+// Copies data directly from the address space of another process. If
+// this is not permitted by the operating system, then direct copying
+// is disabled and the function returns false.
+
+
+bool Engine::directCopy_
+
+  ( void*  dest,
+    int    src,
+    lint   addr,
+    ulint  bytes )
+
+{
+#ifdef JEM_OS_LINUX
+
+  if ( ! canCopy_ )
+  {
+    return false;
+  }
+
+  const pid_t   pid = (pid_t) segment_->getProcID ( src );
+
+  struct iovec  local;
+  struct iovec  remote;
+  ulint         done = 0;
+
+
+  while ( done < bytes )
+  {
+    local .iov_base = (char*) dest + done;
+    local .iov_len  = (size_t) (bytes - done);
+    remote.iov_base = (char*) addr + done;
+    remote.iov_len  = (size_t) (bytes - done);
+
+    ssize_t  n = ::process_vm_readv ( pid, &local, 1, &remote, 1, 0 );
+
+    if ( n <= 0 )
+    {
+      if ( n < 0 && errno == EINTR )
+      {
+        continue;
+      }
+
+      canCopy_    = false;
+
+      return false;
+    }
+
+    done += (ulint) n;
+  }
+
+  return true;
+
+#else
+
+  return false;
+
+#endif
+}
+
+
+//-----------------------------------------------------------------------
+//   sendControl_
+//-----------------------------------------------------------------------
+
+
+void Engine::sendControl_
+
+  ( int   dest,
+    int   kind,
+    lint  handle )
+
+{
+  Packet_  p;
+
+  p.kind    = kind;
+  p.context = 0;
+  p.tag     = 0;
+  p.type    = 0;
+  p.count   = 0;
+  p.size    = 0;
+  p.handle  = handle;
+  p.addr    = 0;
+
+  control_[dest].pushBack ( p );
+
+  flushOut_ ( dest );
+}
+
+
+//-----------------------------------------------------------------------
+//   flushOut_
+//-----------------------------------------------------------------------
+
+// Writes as many queued packets as possible to the ring of the given
+// destination process. Returns true if any packets were written.
+
+
+bool Engine::flushOut_ ( int dest )
+{
+  Ring           ring = segment_->getRing ( myRank_, dest );
+  PacketQueue_&  ctrl = control_[dest];
+  MsgQueue_&     out  = outbox_ [dest];
+
+  bool           busy = false;
+  idx_t          k    = 0;
+
+
+  while ( k < ctrl.size() )
+  {
+    if ( ! Utils_::writePacket( ring, ctrl[k], nullptr ) )
+    {
+      break;
+    }
+
+    k++;
+  }
+
+  if ( k > 0 )
+  {
+    ctrl.erase ( ctrl.begin(), ctrl.begin() + k );
+
+    busy = true;
+  }
+
+  if ( ctrl.size() )
+  {
+    return busy;
+  }
+
+  for ( k = 0; k < out.size(); k++ )
+  {
+    Message&  msg = *out[k];
+    Packet_   p;
+
+    p.context = msg.context;
+    p.tag     = msg.tag;
+    p.type    = msg.buffer.type ();
+    p.count   = msg.buffer.size ();
+    p.handle  = 0;
+    p.addr    = 0;
+
+    if      ( msg.state == Message::QUEUED )
+    {
+      if ( msg.bytes <= eagerLimit_ )
+      {
+        p.kind = Utils_::EAGER_PACKET;
+        p.size = (lint) msg.bytes;
+
+        if ( ! Utils_::writePacket( ring, p, msg.buffer.addr() ) )
+        {
+          break;
+        }
+
+        msg.state = Message::DONE;
+      }
+      else
+      {
+        p.kind   = Utils_::RTS_PACKET;
+        p.size   = 0;
+        p.handle = nextHandle_;
+        p.addr   = (lint) msg.buffer.addr ();
+
+        if ( ! Utils_::writePacket( ring, p, nullptr ) )
+        {
+          break;
+        }
+
+        msg.state  = Message::WAITING;
+        msg.peer   = dest;
+        msg.handle = nextHandle_++;
+
+        pending_.pushBack ( out[k] );
+      }
+    }
+    else if ( msg.state == Message::STREAMING )
+    {
+      const char*  data = (const char*) msg.buffer.addr ();
+
+      p.kind   = Utils_::CHUNK_PACKET;
+      p.handle = msg.handle;
+
+      while ( msg.offset < msg.bytes )
+      {
+        ulint  n = msg.bytes - msg.offset;
+
+        if ( n > chunkSize_ )
+        {
+          n = chunkSize_;
+        }
+
+        p.size = (lint) n;
+        p.addr = (lint) msg.offset;
+
+        if ( ! Utils_::writePacket( ring, p, data + msg.offset ) )
+        {
+          break;
+        }
+
+        msg.offset += n;
+        busy        = true;
+      }
+
+      if ( msg.offset < msg.bytes )
+      {
+        break;
+      }
+
+      msg.state = Message::DONE;
+    }
+
+    busy = true;
+  }
+
+  if ( k > 0 )
+  {
+    out.erase ( out.begin(), out.begin() + k );
+  }
+
+  return busy;
+}
+
+
+//-----------------------------------------------------------------------
+//   drainIn_
+//-----------------------------------------------------------------------
+
+// Processes all packets in the ring of the given source process.
+// Returns true if any packets were processed.
+
+
+bool Engine::drainIn_ ( int src )
+{
+  Ring          ring  = segment_->getRing ( src, myRank_ );
+  ulint         avail = ring.available ();
+
+  bool          busy  = false;
+
+  Ref<Message>  msg;
+  Packet_       p;
+
+
+  while ( avail >= sizeof(Packet_) )
+  {
+    ring.get ( &p, 0, sizeof(Packet_) );
+
+    switch ( p.kind )
+    {
+    case Utils_::EAGER_PACKET:
+
+      msg = matchPosted_ ( src, p.context, p.tag );
+
+      if ( msg )
+      {
+        Utils_::setStatus ( *msg, src, p );
+
+        if ( ! msg->status.error && p.size > 0 )
+        {
+          ring.get ( msg->buffer.addr(), sizeof(Packet_),
+                     (ulint) p.size );
+        }
+
+        msg->state = Message::DONE;
+      }
+      else
+      {
+        Envelope_  env;
+
+        env.packet = p;
+        env.source = src;
+        env.data   = nullptr;
+
+        if ( p.size > 0 )
+        {
+          env.data = MemCache::alloc ( (size_t) p.size );
+
+          ring.get ( env.data, sizeof(Packet_), (ulint) p.size );
+        }
+
+        unexpected_.pushBack ( env );
+      }
+
+      break;
+
+    case Utils_::RTS_PACKET:
+
+      msg = matchPosted_ ( src, p.context, p.tag );
+
+      if ( msg )
+      {
+        startPull_ ( *msg, src, p );
+      }
+      else
+      {
+        Envelope_  env;
+
+        env.packet = p;
+        env.source = src;
+        env.data   = nullptr;
+
+        unexpected_.pushBack ( env );
+      }
+
+      break;
+
+    case Utils_::CTS_PACKET:
+
+      msg = findPending_ ( Message::SEND_MODE, src, p.handle );
+
+      JEM_ASSERT ( msg );
+
+      msg->state  = Message::STREAMING;
+      msg->offset = 0;
+
+      outbox_[src].pushBack ( msg );
+
+      break;
+
+    case Utils_::FIN_PACKET:
+
+      msg = findPending_ ( Message::SEND_MODE, src, p.handle );
+
+      JEM_ASSERT ( msg );
+
+      msg->state = Message::DONE;
+
+      break;
+
+    case Utils_::CHUNK_PACKET:
+
+      msg = findPending_ ( Message::RECV_MODE, src, p.handle );
+
+      JEM_ASSERT ( msg );
+
+      ring.get ( (char*) msg->buffer.addr() + p.addr,
+                 sizeof(Packet_), (ulint) p.size );
+
+      msg->offset += (ulint) p.size;
+
+      if ( msg->offset < msg->bytes )
+      {
+        pending_.pushBack ( msg );
+      }
+      else
+      {
+        msg->state = Message::DONE;
+      }
+
+      break;
+
+    default:
+
+      JEM_ASSERT ( false );
+    }
+
+    const ulint  n = Utils_::packetSize ( (ulint) p.size );
+
+    ring.consume ( n );
+
+    msg    = nullptr;
+    avail -= n;
+    busy   = true;
+  }
+
+  return busy;
+}
+
+
+JEM_END_NAMESPACE ( shm )
+JEM_END_PACKAGE   ( mp )
+
+#endif
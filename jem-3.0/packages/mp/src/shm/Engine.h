@@ -0,0 +1,235 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+#ifndef JEM_MP_SHM_ENGINE_H
+#define JEM_MP_SHM_ENGINE_H
+
+#include <jem/base/Mutex.h>
+#include <jem/util/Flex.h>
+#include "Segment.h"
+#include "Message.h"
+
+
+JEM_BEGIN_PACKAGE   ( mp )
+JEM_BEGIN_NAMESPACE ( shm )
+
+
+//-----------------------------------------------------------------------
+//   class Engine
+//-----------------------------------------------------------------------
+
+// Moves messages between the processes connected by a Segment. There
+// is one Engine per process; it makes progress only when one of its
+// member functions is called.
+//
+// Small messages are copied into the ring of the destination process
+// (the eager protocol). Larger messages are announced with a request
+// packet, after which the receiver copies the data directly from the
+// address space of the sender, or, if that is not permitted, asks the
+// sender to stream the data through the ring in chunks (the
+// rendezvous protocol).
+
+
+class Engine : public Collectable
+{
+ public:
+
+  typedef Engine          Self;
+  typedef Collectable     Super;
+
+
+                          Engine
+
+    ( const Ref<Segment>&   seg,
+      int                   rank );
+
+  inline int              size          () const noexcept;
+  inline int              myRank        () const noexcept;
+
+  void                    start
+
+    ( const Ref<Message>&   msg );
+
+  bool                    test
+
+    ( Message&              msg );
+
+  void                    wait
+
+    ( Message&              msg );
+
+  void                    cancel
+
+    ( Message&              msg );
+
+  bool                    poll          ();
+
+  void                    pause
+
+    ( idx_t                 idle )      const;
+
+  void                    checkAborted  () const;
+  int                     getContextCount ();
+
+  void                    setContextCount
+
+    ( int                   count );
+
+
+ protected:
+
+  virtual                ~Engine        ();
+
+
+ private:
+
+  class                   Utils_;
+  friend class            Utils_;
+
+  struct                  Packet_
+  {
+    int                     kind;
+    int                     context;
+    int                     tag;
+    int                     type;
+    lint                    count;
+    lint                    size;
+    lint                    handle;
+    lint                    addr;
+  };
+
+  struct                  Envelope_
+  {
+    Packet_                 packet;
+    int                     source;
+    void*                   data;
+  };
+
+  typedef util::Flex
+    < Ref<Message> >      MsgQueue_;
+  typedef util::Flex
+    < Packet_ >           PacketQueue_;
+
+  bool                    progress_     ();
+
+  void                    startSend_
+
+    ( const Ref<Message>&   msg );
+
+  void                    startRecv_
+
+    ( const Ref<Message>&   msg );
+
+  Ref<Message>            matchPosted_
+
+    ( int                   src,
+      int                   context,
+      int                   tag );
+
+  Ref<Message>            findPending_
+
+    ( Message::Mode         mode,
+      int                   peer,
+      lint                  handle );
+
+  void                    startPull_
+
+    ( Message&              msg,
+      int                   src,
+      const Packet_&        p );
+
+  bool                    directCopy_
+
+    ( void*                 dest,
+      int                   src,
+      lint                  addr,
+      ulint                 bytes );
+
+  void                    sendControl_
+
+    ( int                   dest,
+      int                   kind,
+      lint                  handle );
+
+  bool                    flushOut_
+
+    ( int                   dest );
+
+  bool                    drainIn_
+
+    ( int                   src );
+
+
+ private:
+
+  Ref<Segment>            segment_;
+  Mutex                   mutex_;
+
+  const int               myRank_;
+  const int               size_;
+  ulint                   eagerLimit_;
+  ulint                   chunkSize_;
+  lint                    nextHandle_;
+  int                     contextCount_;
+  bool                    canCopy_;
+
+  MsgQueue_               posted_;
+  MsgQueue_               pending_;
+  util::Flex<MsgQueue_>   outbox_;
+  util::Flex
+    < PacketQueue_ >      control_;
+  util::Flex<Envelope_>   unexpected_;
+
+};
+
+
+
+
+
+
+//#######################################################################
+//   Implementation
+//#######################################################################
+
+
+inline int Engine::size () const noexcept
+{
+  return size_;
+}
+
+
+inline int Engine::myRank () const noexcept
+{
+  return myRank_;
+}
+
+
+JEM_END_NAMESPACE ( shm )
+JEM_END_PACKAGE   ( mp )
+
+#endif
@@ -0,0 +1,144 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+#ifndef JEM_MP_SHM_MESSAGE_H
+#define JEM_MP_SHM_MESSAGE_H
+
+#include <jem/base/Ref.h>
+#include <jem/base/Collectable.h>
+#include <jem/mp/Status.h>
+#include <jem/mp/Buffer.h>
+
+
+JEM_BEGIN_PACKAGE   ( mp )
+JEM_BEGIN_NAMESPACE ( shm )
+
+
+//-----------------------------------------------------------------------
+//   class Message
+//-----------------------------------------------------------------------
+
+// Holds the state of a send or receive operation that is being
+// processed by an Engine.
+
+
+class Message : public Collectable
+{
+ public:
+
+  typedef Message         Self;
+  typedef Collectable     Super;
+
+  enum                    Mode
+  {
+                            SEND_MODE,
+                            RECV_MODE
+  };
+
+  enum                    State
+  {
+                            IDLE,
+                            QUEUED,
+                            POSTED,
+                            WAITING,
+                            STREAMING,
+                            DONE
+  };
+
+
+  inline                  Message
+
+    ( Mode                  mode,
+      const Buffer&         buf,
+      int                   rank,
+      int                   tag,
+      int                   context )        noexcept;
+
+  inline bool             isDone      () const noexcept;
+
+
+ public:
+
+  const Mode              mode;
+  const Buffer            buffer;
+  const int               rank;
+  const int               tag;
+  const int               context;
+
+  State                   state;
+  Status                  status;
+  lint                    handle;
+  int                     peer;
+  ulint                   offset;
+  ulint                   bytes;
+
+};
+
+
+
+
+
+
+//#######################################################################
+//   Implementation
+//#######################################################################
+
+
+inline Message::Message
+
+  ( Mode           m,
+    const Buffer&  buf,
+    int            rnk,
+    int            tg,
+    int            ctx ) noexcept :
+
+    mode    (    m ),
+    buffer  (  buf ),
+    rank    (  rnk ),
+    tag     (   tg ),
+    context (  ctx ),
+    state   ( IDLE ),
+    status  ( EMPTY_STATUS ),
+    handle  (   -1 ),
+    peer    (   -1 ),
+    offset  (    0 ),
+    bytes   (    0 )
+
+{}
+
+
+inline bool Message::isDone () const noexcept
+{
+  return (state == DONE);
+}
+
+
+JEM_END_NAMESPACE ( shm )
+JEM_END_PACKAGE   ( mp )
+
+#endif
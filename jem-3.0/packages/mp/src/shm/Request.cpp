@@ -0,0 +1,177 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <jem/defines.h>
+
+#ifdef JEM_OS_POSIX
+
+#include "error.h"
+#include "Engine.h"
+#include "Request.h"
+
+
+JEM_BEGIN_PACKAGE   ( mp )
+JEM_BEGIN_NAMESPACE ( shm )
+
+
+//=======================================================================
+//   class Request
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+Request::Request
+
+  ( const Ref<Engine>&   eng,
+    const Ref<Message>&  msg ) :
+
+    engine  (   eng ),
+    message (   msg ),
+    active  ( false )
+
+{}
+
+
+Request::~Request ()
+{
+  if ( active )
+  {
+    try
+    {
+      engine->cancel ( *message );
+    }
+    catch ( ... ) {}
+
+    active = false;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   start
+//-----------------------------------------------------------------------
+
+
+void Request::start ()
+{
+  if ( ! active )
+  {
+    engine->start ( message );
+
+    active = true;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   test
+//-----------------------------------------------------------------------
+
+
+bool Request::test ( Status* stat )
+{
+  if ( active )
+  {
+    if ( engine->test( *message ) )
+    {
+      active = false;
+
+      if ( stat )
+      {
+        *stat = message->status;
+      }
+
+      if ( message->status.error )
+      {
+        raiseError ( JEM_FUNC, message->status.error );
+      }
+    }
+  }
+  else if ( stat )
+  {
+    *stat = EMPTY_STATUS;
+  }
+
+  return ( ! active );
+}
+
+
+//-----------------------------------------------------------------------
+//   wait
+//-----------------------------------------------------------------------
+
+
+void Request::wait ( Status* stat )
+{
+  if ( active )
+  {
+    engine->wait ( *message );
+
+    active = false;
+
+    if ( stat )
+    {
+      *stat = message->status;
+    }
+
+    if ( message->status.error )
+    {
+      raiseError ( JEM_FUNC, message->status.error );
+    }
+  }
+  else if ( stat )
+  {
+    *stat = EMPTY_STATUS;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   cancel
+//-----------------------------------------------------------------------
+
+
+void Request::cancel ()
+{
+  if ( active )
+  {
+    engine->cancel ( *message );
+
+    active = false;
+  }
+}
+
+
+JEM_END_NAMESPACE ( shm )
+JEM_END_PACKAGE   ( mp )
+
+#endif
@@ -0,0 +1,500 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <jem/defines.h>
+
+#ifdef JEM_OS_POSIX
+
+#include <jem/base/IllegalIndexException.h>
+#include <jem/mp/error.h>
+#include "error.h"
+#include "Engine.h"
+#include "Request.h"
+#include "RequestList.h"
+
+
+JEM_BEGIN_PACKAGE   ( mp )
+JEM_BEGIN_NAMESPACE ( shm )
+
+
+//=======================================================================
+//   class RequestList
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+RequestList::RequestList
+
+  ( const Ref<Engine>&  engine,
+    int                 context ) :
+
+    engine_  (  engine ),
+    context_ ( context )
+
+{}
+
+
+RequestList::~RequestList ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   size
+//-----------------------------------------------------------------------
+
+
+idx_t RequestList::size () const
+{
+  return reqs_.size ();
+}
+
+
+//-----------------------------------------------------------------------
+//   clear
+//-----------------------------------------------------------------------
+
+
+void RequestList::clear ( Status* )
+{
+  reqs_.clear ();
+}
+
+
+//-----------------------------------------------------------------------
+//   addRequest (send mode)
+//-----------------------------------------------------------------------
+
+
+idx_t RequestList::addRequest
+
+  ( const SendBuffer&  buf,
+    int                dest,
+    int                tag )
+
+{
+  if ( dest < 0 || dest >= engine_->size() )
+  {
+    sendRankError ( JEM_FUNC, dest, engine_->size() );
+  }
+
+  if ( tag < 0 )
+  {
+    sendTagError  ( JEM_FUNC, tag );
+  }
+
+  Ref<Message>  msg =
+
+    newInstance<Message> ( Message::SEND_MODE, buf,
+                           dest, tag, context_ );
+
+  reqs_.pushBack ( newInstance<Request>( engine_, msg ) );
+
+  return (reqs_.size() - 1);
+}
+
+
+//-----------------------------------------------------------------------
+//   addRequest (recv mode)
+//-----------------------------------------------------------------------
+
+
+idx_t RequestList::addRequest
+
+  ( const RecvBuffer&  buf,
+    int                src,
+    int                tag )
+
+{
+  if ( src >= engine_->size() || (src < 0 && src != ANY_SOURCE) )
+  {
+    recvRankError ( JEM_FUNC, src, engine_->size() );
+  }
+
+  if ( tag < 0 && tag != ANY_TAG )
+  {
+    recvTagError  ( JEM_FUNC, tag );
+  }
+
+  Ref<Message>  msg =
+
+    newInstance<Message> ( Message::RECV_MODE, buf,
+                           src, tag, context_ );
+
+  reqs_.pushBack ( newInstance<Request>( engine_, msg ) );
+
+  return (reqs_.size() - 1);
+}
+
+
+//-----------------------------------------------------------------------
+//   startOne
+//-----------------------------------------------------------------------
+
+
+void RequestList::startOne ( idx_t ireq )
+{
+  checkIndex_ ( JEM_FUNC, ireq );
+
+  reqs_[ireq]->start ();
+}
+
+
+//-----------------------------------------------------------------------
+//   startAll
+//-----------------------------------------------------------------------
+
+
+void RequestList::startAll ()
+{
+  const idx_t  n = reqs_.size ();
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    reqs_[i]->start ();
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   testOne
+//-----------------------------------------------------------------------
+
+
+bool RequestList::testOne ( idx_t ireq, Status* stat )
+{
+  checkIndex_ ( JEM_FUNC, ireq );
+
+  return reqs_[ireq]->test ( stat );
+}
+
+
+//-----------------------------------------------------------------------
+//   testSome
+//-----------------------------------------------------------------------
+
+
+void RequestList::testSome
+
+  ( idx_t&   count,
+    idx_t*   ireqs,
+    Status*  stats )
+
+{
+  const idx_t  n   = reqs_.size ();
+
+  int          err = 0;
+
+
+  engine_->poll ();
+
+  count = 0;
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    Request&  req = *reqs_[i];
+
+    if ( req.active && req.message->isDone() )
+    {
+      req.active = false;
+
+      if ( stats )
+      {
+        stats[count] = req.message->status;
+      }
+
+      ireqs[count++] = i;
+      err           |= req.message->status.error;
+    }
+  }
+
+  if ( err )
+  {
+    raiseError ( JEM_FUNC, err );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   testAll
+//-----------------------------------------------------------------------
+
+
+bool RequestList::testAll ( Status* stats )
+{
+  const idx_t  n   = reqs_.size ();
+
+  int          err = 0;
+
+
+  engine_->poll ();
+
+  if ( ! testActive_( err ) )
+  {
+    return false;
+  }
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    Request&  req = *reqs_[i];
+
+    if ( stats )
+    {
+      if ( req.active )
+      {
+        stats[i] = req.message->status;
+      }
+      else
+      {
+        stats[i] = EMPTY_STATUS;
+      }
+    }
+
+    req.active = false;
+  }
+
+  if ( err )
+  {
+    raiseError ( JEM_FUNC, err );
+  }
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------
+//   waitOne
+//-----------------------------------------------------------------------
+
+
+void RequestList::waitOne ( idx_t ireq, Status* stat )
+{
+  checkIndex_ ( JEM_FUNC, ireq );
+
+  reqs_[ireq]->wait ( stat );
+}
+
+
+//-----------------------------------------------------------------------
+//   waitSome
+//-----------------------------------------------------------------------
+
+
+void RequestList::waitSome
+
+  ( idx_t&   count,
+    idx_t*   ireqs,
+    Status*  stats )
+
+{
+  const idx_t  n    = reqs_.size ();
+
+  idx_t        idle = 0;
+
+
+  while ( true )
+  {
+    bool  active = false;
+
+    testSome ( count, ireqs, stats );
+
+    if ( count > 0 )
+    {
+      break;
+    }
+
+    for ( idx_t i = 0; i < n && ! active; i++ )
+    {
+      active = reqs_[i]->active;
+    }
+
+    if ( ! active )
+    {
+      break;
+    }
+
+    engine_->pause ( idle++ );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   waitAll
+//-----------------------------------------------------------------------
+
+
+void RequestList::waitAll ( Status* stats )
+{
+  const idx_t  n    = reqs_.size ();
+
+  idx_t        idle = 0;
+  int          err  = 0;
+
+
+  while ( ! testActive_( err ) )
+  {
+    if ( engine_->poll() )
+    {
+      idle = 0;
+    }
+    else
+    {
+      engine_->pause ( idle++ );
+    }
+  }
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    Request&  req = *reqs_[i];
+
+    if ( stats )
+    {
+      if ( req.active )
+      {
+        stats[i] = req.message->status;
+      }
+      else
+      {
+        stats[i] = EMPTY_STATUS;
+      }
+    }
+
+    req.active = false;
+  }
+
+  if ( err )
+  {
+    raiseError ( JEM_FUNC, err );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   cancelOne
+//-----------------------------------------------------------------------
+
+
+void RequestList::cancelOne ( idx_t ireq )
+{
+  checkIndex_ ( JEM_FUNC, ireq );
+
+  reqs_[ireq]->cancel ();
+}
+
+
+//-----------------------------------------------------------------------
+//   cancelAll
+//-----------------------------------------------------------------------
+
+
+void RequestList::cancelAll ( Status* stats )
+{
+  const idx_t  n = reqs_.size ();
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    Request&  req = *reqs_[i];
+
+    if ( req.active )
+    {
+      req.cancel ();
+
+      if ( stats )
+      {
+        stats[i] = req.message->status;
+      }
+    }
+    else if ( stats )
+    {
+      stats[i] = EMPTY_STATUS;
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   checkIndex_
+//-----------------------------------------------------------------------
+
+
+void RequestList::checkIndex_
+
+  ( const String&  where,
+    idx_t          ireq ) const
+
+{
+  if ( ireq < 0 || ireq >= reqs_.size() )
+  {
+    throw IllegalIndexException (
+      where,
+      String::format ( "illegal request index: %d", ireq )
+    );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   testActive_
+//-----------------------------------------------------------------------
+
+// Returns true if all active requests have been completed, and sets
+// err to the combined error code of the active requests.
+
+
+bool RequestList::testActive_ ( int& err )
+{
+  const idx_t  n = reqs_.size ();
+
+  err = 0;
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    const Request&  req = *reqs_[i];
+
+    if ( req.active )
+    {
+      if ( ! req.message->isDone() )
+      {
+        return false;
+      }
+
+      err |= req.message->status.error;
+    }
+  }
+
+  return true;
+}
+
+
+JEM_END_NAMESPACE ( shm )
+JEM_END_PACKAGE   ( mp )
+
+#endif
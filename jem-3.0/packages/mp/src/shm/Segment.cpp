@@ -0,0 +1,214 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+
+#include <jem/defines.h>
+
+#ifdef JEM_OS_POSIX
+
+#include <new>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <jem/base/assert.h>
+#include <jem/mp/MPException.h>
+#include "Segment.h"
+
+
+JEM_BEGIN_PACKAGE   ( mp )
+JEM_BEGIN_NAMESPACE ( shm )
+
+
+//=======================================================================
+//   class Segment
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+Segment::Segment ( int procCount ) :
+
+  addr_      ( nullptr ),
+  size_      ( 0 ),
+  procCount_ ( procCount )
+
+{
+  JEM_PRECHECK ( procCount > 0 );
+
+  // Limit the total size of the rings, as their number grows with
+  // the square of the number of processes.
+
+  const ulint  MAX_RING_SIZE  = 256_ulint * 1024_ulint;
+  const ulint  MIN_RING_SIZE  =   8_ulint * 1024_ulint;
+  const ulint  MAX_TOTAL_SIZE =  64_ulint * 1024_ulint * 1024_ulint;
+
+  const ulint  ringCount      = (ulint) procCount * (ulint) procCount;
+
+  ulint        ctrlSize;
+  ulint        totalSize;
+  char*        addr;
+
+
+  ringSize_ = MAX_RING_SIZE;
+
+  while ( ringSize_ > MIN_RING_SIZE &&
+          ringSize_ * ringCount > MAX_TOTAL_SIZE )
+  {
+    ringSize_ /= 2;
+  }
+
+  ringStride_ = sizeof(Ring::Header) + ringSize_;
+  ctrlSize    = sizeof(Control_) + (ulint) procCount * sizeof(lint);
+  ctrlSize    = (ctrlSize + 63_ulint) & ~63_ulint;
+  totalSize   = ctrlSize + ringCount * ringStride_;
+
+  addr_ = ::mmap ( nullptr, (size_t) totalSize,
+                   PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0 );
+
+  if ( addr_ == MAP_FAILED )
+  {
+    int  err = errno;
+
+    addr_ = nullptr;
+
+    throw MPException (
+      JEM_FUNC,
+      String::format (
+        "failed to create a shared memory segment of %d bytes: %s",
+        (lint) totalSize,
+        std::strerror ( err )
+      )
+    );
+  }
+
+  size_    = (size_t) totalSize;
+  addr     = (char*) addr_;
+  control_ = new (addr) Control_;
+  procIDs_ = (lint*) (addr + sizeof(Control_));
+  rings_   = addr + ctrlSize;
+
+  control_->aborted.store ( 0 );
+  control_->claimed.store ( 0 );
+
+  control_->abortCode = 0;
+  control_->procCount = procCount;
+  control_->ringSize  = ringSize_;
+
+  for ( int i = 0; i < procCount; i++ )
+  {
+    procIDs_[i] = 0;
+  }
+
+  for ( ulint i = 0; i < ringCount; i++ )
+  {
+    Ring::Header*  hdr =
+
+      new (rings_ + i * ringStride_) Ring::Header;
+
+    hdr->head.store ( 0_ulint );
+    hdr->tail.store ( 0_ulint );
+  }
+}
+
+
+Segment::~Segment ()
+{
+  if ( addr_ )
+  {
+    ::munmap ( addr_, size_ );
+
+    addr_ = nullptr;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   setProcID
+//-----------------------------------------------------------------------
+
+
+void Segment::setProcID ( int rank, lint pid )
+{
+  JEM_PRECHECK ( rank >= 0 && rank < procCount_ );
+
+  std::atomic_thread_fence ( std::memory_order_release );
+
+  procIDs_[rank] = pid;
+}
+
+
+//-----------------------------------------------------------------------
+//   getProcID
+//-----------------------------------------------------------------------
+
+
+lint Segment::getProcID ( int rank ) const
+{
+  JEM_PRECHECK ( rank >= 0 && rank < procCount_ );
+
+  lint  pid = procIDs_[rank];
+
+  std::atomic_thread_fence ( std::memory_order_acquire );
+
+  return pid;
+}
+
+
+//-----------------------------------------------------------------------
+//   setAborted
+//-----------------------------------------------------------------------
+
+// Records that the program has been aborted with the given exit code.
+// Only the first call has effect; returns false if the program had
+// been aborted already.
+
+
+bool Segment::setAborted ( int code )
+{
+  int  expected = 0;
+
+  if ( ! control_->claimed.compare_exchange_strong( expected, 1 ) )
+  {
+    return false;
+  }
+
+  control_->abortCode = code;
+
+  control_->aborted.store ( 1, std::memory_order_release );
+
+  return true;
+}
+
+
+JEM_END_NAMESPACE ( shm )
+JEM_END_PACKAGE   ( mp )
+
+#endif
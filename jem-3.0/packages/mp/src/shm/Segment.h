@@ -0,0 +1,351 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jem, a general purpose programming toolkit.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *
+ *  Jem version: 3.0
+ *  Date:        Fri 20 Dec 14:27:58 CET 2019
+ */
+
+#ifndef JEM_MP_SHM_SEGMENT_H
+#define JEM_MP_SHM_SEGMENT_H
+
+#include <atomic>
+#include <cstring>
+#include <jem/base/Collectable.h>
+
+
+JEM_BEGIN_PACKAGE   ( mp )
+JEM_BEGIN_NAMESPACE ( shm )
+
+
+//-----------------------------------------------------------------------
+//   class Ring
+//-----------------------------------------------------------------------
+
+// A single-producer, single-consumer byte queue that lives in shared
+// memory. The producer owns the head index and the consumer owns the
+// tail index; both are free running and wrap modulo the capacity,
+// which is a power of two.
+
+
+class Ring
+{
+ public:
+
+  struct                  Header
+  {
+    std::atomic<ulint>      head;
+    char                    pad0_[64 - sizeof(ulint)];
+    std::atomic<ulint>      tail;
+    char                    pad1_[64 - sizeof(ulint)];
+  };
+
+
+  inline                  Ring       ()       noexcept;
+
+  inline                  Ring
+
+    ( Header*               hdr,
+      char*                 data,
+      ulint                 cap )             noexcept;
+
+  inline ulint            freeSpace  () const noexcept;
+  inline ulint            available  () const noexcept;
+
+  inline void             put
+
+    ( ulint                 offset,
+      const void*           src,
+      ulint                 n )               noexcept;
+
+  inline void             get
+
+    ( void*                 dest,
+      ulint                 offset,
+      ulint                 n )         const noexcept;
+
+  inline void             commit
+
+    ( ulint                 n )               noexcept;
+
+  inline void             consume
+
+    ( ulint                 n )               noexcept;
+
+
+ public:
+
+  Header*                 header;
+  char*                   data;
+  ulint                   capacity;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   class Segment
+//-----------------------------------------------------------------------
+
+// The shared memory segment that connects the processes started by
+// the ShmDriver. It is created before the processes are forked, so
+// that all processes map it at the same address. It contains a
+// control block and one ring for each ordered pair of processes.
+
+
+class Segment : public Collectable
+{
+ public:
+
+  typedef Segment         Self;
+  typedef Collectable     Super;
+
+
+  explicit                Segment
+
+    ( int                   procCount );
+
+  inline int              procCount  () const noexcept;
+  inline ulint            ringSize   () const noexcept;
+
+  inline Ring             getRing
+
+    ( int                   src,
+      int                   dest )      const noexcept;
+
+  void                    setProcID
+
+    ( int                   rank,
+      lint                  pid );
+
+  lint                    getProcID
+
+    ( int                   rank )      const;
+
+  bool                    setAborted
+
+    ( int                   code );
+
+  inline bool             isAborted  () const noexcept;
+  inline int              abortCode  () const noexcept;
+
+
+ protected:
+
+  virtual                ~Segment    ();
+
+
+ private:
+
+  struct                  Control_
+  {
+    std::atomic<int>        aborted;
+    std::atomic<int>        claimed;
+    int                     abortCode;
+    int                     procCount;
+    ulint                   ringSize;
+  };
+
+
+  void*                   addr_;
+  size_t                  size_;
+  Control_*               control_;
+  lint*                   procIDs_;
+  char*                   rings_;
+  int                     procCount_;
+  ulint                   ringSize_;
+  ulint                   ringStride_;
+
+};
+
+
+
+
+
+
+//#######################################################################
+//   Implementation
+//#######################################################################
+
+//=======================================================================
+//   class Ring
+//=======================================================================
+
+
+inline Ring::Ring () noexcept :
+
+  header   ( nullptr ),
+  data     ( nullptr ),
+  capacity ( 0 )
+
+{}
+
+
+inline Ring::Ring
+
+  ( Header*  hdr,
+    char*    dat,
+    ulint    cap ) noexcept :
+
+    header   ( hdr ),
+    data     ( dat ),
+    capacity ( cap )
+
+{}
+
+
+inline ulint Ring::freeSpace () const noexcept
+{
+  const ulint  head = header->head.load ( std::memory_order_relaxed );
+  const ulint  tail = header->tail.load ( std::memory_order_acquire );
+
+  return (capacity - (head - tail));
+}
+
+
+inline ulint Ring::available () const noexcept
+{
+  const ulint  head = header->head.load ( std::memory_order_acquire );
+  const ulint  tail = header->tail.load ( std::memory_order_relaxed );
+
+  return (head - tail);
+}
+
+
+// Copies data into the ring, at the given offset from the head. The
+// data are not visible to the consumer until commit() is called.
+
+inline void Ring::put
+
+  ( ulint        offset,
+    const void*  src,
+    ulint        n ) noexcept
+
+{
+  const ulint  mask = capacity - 1;
+  const ulint  pos  =
+
+    (header->head.load( std::memory_order_relaxed ) + offset) & mask;
+
+  const ulint  k    = capacity - pos;
+
+  if ( n <= k )
+  {
+    std::memcpy ( data + pos, src, (size_t) n );
+  }
+  else
+  {
+    std::memcpy ( data + pos, src, (size_t) k );
+    std::memcpy ( data, (const char*) src + k, (size_t) (n - k) );
+  }
+}
+
+
+inline void Ring::get
+
+  ( void*  dest,
+    ulint  offset,
+    ulint  n ) const noexcept
+
+{
+  const ulint  mask = capacity - 1;
+  const ulint  pos  =
+
+    (header->tail.load( std::memory_order_relaxed ) + offset) & mask;
+
+  const ulint  k    = capacity - pos;
+
+  if ( n <= k )
+  {
+    std::memcpy ( dest, data + pos, (size_t) n );
+  }
+  else
+  {
+    std::memcpy ( dest, data + pos, (size_t) k );
+    std::memcpy ( (char*) dest + k, data, (size_t) (n - k) );
+  }
+}
+
+
+inline void Ring::commit ( ulint n ) noexcept
+{
+  header->head.store ( header->head.load( std::memory_order_relaxed ) + n,
+                       std::memory_order_release );
+}
+
+
+inline void Ring::consume ( ulint n ) noexcept
+{
+  header->tail.store ( header->tail.load( std::memory_order_relaxed ) + n,
+                       std::memory_order_release );
+}
+
+
+//=======================================================================
+//   class Segment
+//=======================================================================
+
+
+inline int Segment::procCount () const noexcept
+{
+  return procCount_;
+}
+
+
+inline ulint Segment::ringSize () const noexcept
+{
+  return ringSize_;
+}
+
+
+inline Ring Segment::getRing
+
+  ( int  src,
+    int  dest ) const noexcept
+
+{
+  char*  addr = rings_ + ringStride_ *
+
+    ((ulint) src * (ulint) procCount_ + (ulint) dest);
+
+  return Ring ( (Ring::Header*) addr,
+                addr + sizeof(Ring::Header),
+                ringSize_ );
+}
+
+
+inline bool Segment::isAborted () const noexcept
+{
+  return (control_->aborted.load( std::memory_order_acquire ) != 0);
+}
+
+
+inline int Segment::abortCode () const noexcept
+{
+  return control_->abortCode;
+}
+
+
+JEM_END_NAMESPACE ( shm )
+JEM_END_PACKAGE   ( mp )
+
+#endif
@@ -131,7 +131,7 @@ idx_t RequestList::addRequest
     recvRankError ( JEM_FUNC, src, 1 );
   }
 
-  if ( tag < 0 || tag != ANY_TAG )
+  if ( tag < 0 && tag != ANY_TAG )
   {
     recvTagError ( JEM_FUNC, tag );
   }
@@ -32,6 +32,7 @@
 #include <cstdio>
 #include <jem/base/limits.h>
 #include <jem/base/ParseException.h>
+#include <jem/io/FloatConv.h>
 #include <jem/io/StringReader.h>
 #include <jem/util/BasicScanner.h>
 
@@ -380,7 +381,7 @@ int BasicScanner::tryReadNumber ()
       token += (char) c;
       token += (char) next;
 
-      readFraction_  ();
+      readFloat ();
 
       return FLOAT;
     }
@@ -695,10 +696,17 @@ void BasicScanner::setHexInt_ ()
 
 void BasicScanner::setFloat_ ()
 {
-  char*   end = token.xalloc ( 1 );
+  char*   end;
   double  value;
 
 
+  if ( io::FloatConv::parse( value, token.addr(), token.size() ) )
+  {
+    xvalue_ = value;
+    return;
+  }
+
+  end    = token.xalloc ( 1 );
   end[0] = '\0';
   value  = strtod ( token.addr(), &end );
 
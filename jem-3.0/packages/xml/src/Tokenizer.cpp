@@ -900,6 +900,92 @@ int Tokenizer::readText ( TextOutput& out )
 }
 
 
+//-----------------------------------------------------------------------
+//   readRawText
+//-----------------------------------------------------------------------
+
+// Appends the text up to the next tag to a buffer without splitting it
+// into tokens. Comments are replaced by the newlines they contain, or
+// by a single space if they fit on one line, so that line numbers
+// computed from the text remain correct. The next token to be
+// returned is the tag that terminates the text.
+
+
+idx_t Tokenizer::readRawText ( StringBuffer& buf )
+{
+  JEM_PRECHECK2 ( pushedToken_ == NULL_TOKEN,
+                  "a token has been pushed back" );
+
+  const idx_t  CHUNK_SIZE = 4096;
+
+  const idx_t  start      = buf.size ();
+
+  char*        text;
+  idx_t        i, n;
+  lint         lineno;
+  int          c;
+
+
+  token_ = NULL_TOKEN;
+
+  scanner_.token.clear ();
+
+  while ( true )
+  {
+    text = buf.xalloc ( CHUNK_SIZE );
+    n    = scanner_.buffer.readUntil ( *scanner_.input,
+                                       text, CHUNK_SIZE, '<' );
+
+    for ( i = 0; i < n; i++ )
+    {
+      if ( text[i] == '\n' )
+      {
+        scanner_.lineno++;
+      }
+    }
+
+    buf.commit ( n );
+
+    if ( n == CHUNK_SIZE )
+    {
+      continue;
+    }
+
+    c = scanner_.read ();
+
+    if ( c < 0 )
+    {
+      break;
+    }
+
+    if ( c == '<' && scanner_.scan( "!--", 3 ) )
+    {
+      lineno = scanner_.lineno;
+
+      scanner_.readComment ();
+      scanner_.token.clear ();
+
+      if ( scanner_.lineno == lineno )
+      {
+        buf += ' ';
+      }
+
+      for ( ; lineno < scanner_.lineno; lineno++ )
+      {
+        buf += '\n';
+      }
+    }
+    else
+    {
+      scanner_.unread ( c );
+      break;
+    }
+  }
+
+  return (buf.size() - start);
+}
+
+
 //-----------------------------------------------------------------------
 //   init_
 //-----------------------------------------------------------------------
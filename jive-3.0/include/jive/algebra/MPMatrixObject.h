@@ -115,6 +115,11 @@ class MPMatrixObject : public  AbstractMatrix,
 
     ( int                     mode );
 
+  void                      setSplitMatmul
+
+    ( bool                    choice );
+
+  inline bool               getSplitMatmul    () const;
   inline AbstractMatrix*    getInner          () const;
 
 
@@ -136,16 +141,28 @@ class MPMatrixObject : public  AbstractMatrix,
 
  private:
 
+  class                     Split_;
+
+
   void                      connect_          ();
   void                      valuesChanged_    ();
   void                      structChanged_    ();
 
+  bool                      splitMatmul_
+
+    ( const Vector&           lhs,
+      const Vector&           rhs )              const;
+
+  Split_*                   getSplit_         () const;
+
 
  private:
 
   Ref<AbstractMatrix>       inner_;
   Ref<VectorExchanger>      exchanger_;
   int                       xmode_;
+  bool                      split_;
+  Ref<Split_>               splitData_;
 
 };
 
@@ -164,6 +181,17 @@ typedef MPMatrixObject      MPMatrixObj;
 //   Implementation
 //#######################################################################
 
+//-----------------------------------------------------------------------
+//   getSplitMatmul
+//-----------------------------------------------------------------------
+
+
+inline bool MPMatrixObject::getSplitMatmul () const
+{
+  return split_;
+}
+
+
 //-----------------------------------------------------------------------
 //   getInner
 //-----------------------------------------------------------------------
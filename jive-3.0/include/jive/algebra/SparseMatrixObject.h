@@ -192,6 +192,13 @@ class SparseMatrixObject : public AbstractMatrix,
   virtual                  ~SparseMatrixObject  ();
 
 
+ private:
+
+  class                     MatmulWork_;
+
+  friend class              MatmulWork_;
+
+
  private:
 
   void                      init_               ();
@@ -199,11 +206,18 @@ class SparseMatrixObject : public AbstractMatrix,
   void                      initSuperRows_      ();
   void                      resetMCounter_      ();
 
-  void                      normalMatmul_
+  void                      matmul_
 
     ( const Vector&           lhs,
       const Vector&           rhs  )               const;
 
+  void                      normalMatmul_
+
+    ( const Vector&           lhs,
+      const Vector&           rhs,
+      idx_t                   first,
+      idx_t                   last )               const;
+
   void                      normalMatmul4_
 
     ( const Matrix&           lhs,
@@ -212,7 +226,9 @@ class SparseMatrixObject : public AbstractMatrix,
   void                      packedMatmul_
 
     ( const Vector&           lhs,
-      const Vector&           rhs  )               const;
+      const Vector&           rhs,
+      idx_t                   ifirst,
+      idx_t                   ilast )              const;
 
   void                      packedMatmul4_
 
@@ -101,6 +101,16 @@ class StdVectorSpace : public VectorSpace,
   virtual                  ~StdVectorSpace  ();
 
 
+ private:
+
+  class                     DotWork_;
+
+  static double             dot_
+
+    ( const Vector&           x,
+      const Vector*           y );
+
+
  private:
 
   Ref<DofSpace>             dofs_;
@@ -64,6 +64,7 @@ class Commands
   static const char*      HELP;
   static const char*      REHASH;
   static const char*      DUMP;
+  static const char*      MEM_STATS;
 
 };
 
@@ -82,6 +82,11 @@ class InfoModule : public Module
     ( PrintWriter&            out,
       const Properties&       globdat );
 
+  static void               printMemStats
+
+    ( PrintWriter&            out,
+      bool                    perThread = false );
+
   static Ref<Module>        makeNew
 
     ( const String&           name,
@@ -104,6 +109,11 @@ class InfoModule : public Module
     ( const String&           arg,
       const Properties&       globdat );
 
+  void                      exeMemStatsCmd_
+
+    ( const String&           arg,
+      const Properties&       globdat );
+
 
  private:
 
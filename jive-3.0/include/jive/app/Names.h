@@ -63,6 +63,7 @@ class PropertyNames
  public:
 
   static const char*    APPEND;
+  static const char*    ASYNC;
   static const char*    BACKUPS;
   static const char*    BUFSIZE;
   static const char*    CMD_FILE;
@@ -97,6 +98,7 @@ class PropertyNames
   static const char*    SYNC;
   static const char*    TABLES;
   static const char*    TEMP;
+  static const char*    THREADS;
   static const char*    VECTORS;
 
 };
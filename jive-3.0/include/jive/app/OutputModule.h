@@ -121,6 +121,7 @@ class OutputModule : public Module,
   int                       precision_;
   int                       pageWidth_;
   idx_t                     bufsize_;
+  bool                      async_;
 
   Ref<Specs_>               vecSpecs_;
   Ref<Specs_>               tabSpecs_;
@@ -0,0 +1,196 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+
+#ifndef JIVE_FEM_ELEMDOFTABLE_H
+#define JIVE_FEM_ELEMDOFTABLE_H
+
+#include <jem/base/Object.h>
+#include <jive/fem/import.h>
+#include <jive/fem/ElementGroup.h>
+
+
+JIVE_BEGIN_PACKAGE( fem )
+
+
+//-----------------------------------------------------------------------
+//   class ElemDofTable
+//-----------------------------------------------------------------------
+
+// Stores the DOF indices of all elements in an element group for a
+// given set of DOF types. The indices of one element are stored
+// contiguously, in the same order as returned by
+// DofSpace::getDofIndices. The table is built when it is first
+// accessed and is rebuilt after the DOF space, the element group or
+// the element topology has changed.
+//
+// The elements are indexed by their position in the element group;
+// this is the ipos member of an ElementIterator that iterates over
+// the same group.
+
+class ElemDofTable : public Object
+{
+ public:
+
+  JEM_DECLARE_CLASS       ( ElemDofTable, Object );
+
+
+                            ElemDofTable
+
+    ( const ElementGroup&     group,
+      const Ref<DofSpace>&    dofs,
+      idx_t                   itype );
+
+                            ElemDofTable
+
+    ( const ElementGroup&     group,
+      const Ref<DofSpace>&    dofs,
+      const IdxVector&        itypes );
+
+  void                      update          ();
+
+  inline IdxVector          getDofIndices
+
+    ( idx_t                   ipos )          const;
+
+  inline idx_t              getDofCount
+
+    ( idx_t                   ipos )          const;
+
+  IdxVector                 getOffsets      () const;
+  IdxVector                 getIndices      () const;
+
+  inline ElementGroup       getElemGroup    () const;
+  inline DofSpace*          getDofSpace     () const;
+  inline IdxVector          getDofTypes     () const;
+
+
+ protected:
+
+  virtual                  ~ElemDofTable    ();
+
+
+ private:
+
+  void                      init_           ();
+  void                      invalidate_     ();
+  void                      update_         ();
+
+
+ private:
+
+  ElementGroup              elemGroup_;
+  Ref<DofSpace>             dofs_;
+  IdxVector                 itypes_;
+
+  IdxVector                 offsets_;
+  IdxVector                 indices_;
+
+  bool                      updated_;
+
+};
+
+
+
+
+
+//#######################################################################
+//   Implementation
+//#######################################################################
+
+//-----------------------------------------------------------------------
+//   getDofIndices
+//-----------------------------------------------------------------------
+
+
+inline IdxVector ElemDofTable::getDofIndices ( idx_t ipos ) const
+{
+  if ( ! updated_ )
+  {
+    const_cast<Self*> ( this ) -> update_ ();
+  }
+
+  return indices_[slice(offsets_[ipos],offsets_[ipos + 1])];
+}
+
+
+//-----------------------------------------------------------------------
+//   getDofCount
+//-----------------------------------------------------------------------
+
+
+inline idx_t ElemDofTable::getDofCount ( idx_t ipos ) const
+{
+  if ( ! updated_ )
+  {
+    const_cast<Self*> ( this ) -> update_ ();
+  }
+
+  return (offsets_[ipos + 1] - offsets_[ipos]);
+}
+
+
+//-----------------------------------------------------------------------
+//   getElemGroup
+//-----------------------------------------------------------------------
+
+
+inline ElementGroup ElemDofTable::getElemGroup () const
+{
+  return elemGroup_;
+}
+
+
+//-----------------------------------------------------------------------
+//   getDofSpace
+//-----------------------------------------------------------------------
+
+
+inline DofSpace* ElemDofTable::getDofSpace () const
+{
+  return dofs_.get ();
+}
+
+
+//-----------------------------------------------------------------------
+//   getDofTypes
+//-----------------------------------------------------------------------
+
+
+inline IdxVector ElemDofTable::getDofTypes () const
+{
+  return itypes_;
+}
+
+
+JIVE_END_PACKAGE( fem )
+
+#endif
@@ -95,6 +95,24 @@ class ElementIterator : public FEIterator,
 
     ( VirtualElement&         elem );
 
+  // Stores the indices of the next elements that have the same
+  // shape in ielems, and returns the number of elements stored.
+  // At most ielems.size() elements are returned in one block.
+
+  idx_t                     toNextBlock
+
+    ( const IdxVector&        ielems,
+      Ref<geom::Shape>&       shape );
+
+  // Stores the node coordinates of a block of elements in the
+  // structure-of-arrays layout expected by
+  // InternalShape::getBlockGradients.
+
+  void                      getBlockCoords
+
+    ( const Cubix&            coords,
+      const IdxVector&        ielems )      const;
+
   virtual void              checkShapes     ()       override;
 
   inline ElementSet         getElements     () const;
@@ -0,0 +1,280 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+
+#ifndef JIVE_FEM_HISTORYSTORE_H
+#define JIVE_FEM_HISTORYSTORE_H
+
+#include <jem/base/Object.h>
+#include <jem/io/Serializable.h>
+#include <jive/Array.h>
+#include <jive/fem/import.h>
+
+
+JIVE_BEGIN_PACKAGE( fem )
+
+
+//-----------------------------------------------------------------------
+//   class HistoryStore
+//-----------------------------------------------------------------------
+
+// Stores history variables, such as plastic strains, in the
+// integration points of a set of elements. The elements are indexed
+// by their position in an element group, and each element may have
+// a different number of points.
+//
+// The store holds two buffers: the old values from the last
+// converged state, and the new values for the current iteration.
+// Each buffer is a (point x variable) matrix in which the values of
+// one variable form a contiguous column. The commit() function just
+// swaps the two buffers, and cancel() does nothing at all. This
+// means that the new values must be computed from the old values in
+// every iteration, as is done by a return-mapping algorithm. Until
+// then they contain the values of an earlier state.
+//
+// The store has no internal state that is updated on access. As a
+// result, multiple threads may read and write the values of
+// different elements concurrently, as long as commit() and cancel()
+// are not called at the same time.
+
+class HistoryStore : public Object,
+                     public Serializable
+{
+ public:
+
+  JEM_DECLARE_CLASS       ( HistoryStore, Object );
+
+
+                            HistoryStore    ();
+
+                            HistoryStore
+
+    ( idx_t                   varCount,
+      idx_t                   elemCount,
+      idx_t                   pointCount );
+
+                            HistoryStore
+
+    ( idx_t                   varCount,
+      const IdxVector&        pointCounts );
+
+  virtual void              readFrom
+
+    ( ObjectInput&            in )                  override;
+
+  virtual void              writeTo
+
+    ( ObjectOutput&           out )           const override;
+
+  inline void               commit          ()      noexcept;
+  inline void               cancel          ()      noexcept;
+
+  void                      setToZero       ();
+
+  inline idx_t              elemCount       () const noexcept;
+  inline idx_t              pointCount      () const noexcept;
+  inline idx_t              varCount        () const noexcept;
+
+  inline idx_t              getPointOffset
+
+    ( idx_t                   ipos )          const;
+
+  inline idx_t              getPointCount
+
+    ( idx_t                   ipos )          const;
+
+  inline IdxVector          getPointOffsets () const;
+
+  inline Matrix             getOldValues
+
+    ( idx_t                   ipos )          const;
+
+  inline Matrix             getNewValues
+
+    ( idx_t                   ipos )          const;
+
+  inline Matrix             getOldValues    () const;
+  inline Matrix             getNewValues    () const;
+
+
+ protected:
+
+  virtual                  ~HistoryStore    ();
+
+
+ private:
+
+  void                      init_
+
+    ( idx_t                   varCount );
+
+
+ private:
+
+  IdxVector                 offsets_;
+  Matrix                    values_[2];
+  int                       inew_;
+
+};
+
+
+
+
+
+//#######################################################################
+//   Implementation
+//#######################################################################
+
+//-----------------------------------------------------------------------
+//   commit
+//-----------------------------------------------------------------------
+
+
+inline void HistoryStore::commit () noexcept
+{
+  inew_ = 1 - inew_;
+}
+
+
+//-----------------------------------------------------------------------
+//   cancel
+//-----------------------------------------------------------------------
+
+
+inline void HistoryStore::cancel () noexcept
+{}
+
+
+//-----------------------------------------------------------------------
+//   elemCount
+//-----------------------------------------------------------------------
+
+
+inline idx_t HistoryStore::elemCount () const noexcept
+{
+  return (offsets_.size() - 1);
+}
+
+
+//-----------------------------------------------------------------------
+//   pointCount
+//-----------------------------------------------------------------------
+
+
+inline idx_t HistoryStore::pointCount () const noexcept
+{
+  return values_[0].size (0);
+}
+
+
+//-----------------------------------------------------------------------
+//   varCount
+//-----------------------------------------------------------------------
+
+
+inline idx_t HistoryStore::varCount () const noexcept
+{
+  return values_[0].size (1);
+}
+
+
+//-----------------------------------------------------------------------
+//   getPointOffset
+//-----------------------------------------------------------------------
+
+
+inline idx_t HistoryStore::getPointOffset ( idx_t ipos ) const
+{
+  return offsets_[ipos];
+}
+
+
+//-----------------------------------------------------------------------
+//   getPointCount
+//-----------------------------------------------------------------------
+
+
+inline idx_t HistoryStore::getPointCount ( idx_t ipos ) const
+{
+  return (offsets_[ipos + 1] - offsets_[ipos]);
+}
+
+
+//-----------------------------------------------------------------------
+//   getPointOffsets
+//-----------------------------------------------------------------------
+
+
+inline IdxVector HistoryStore::getPointOffsets () const
+{
+  return offsets_;
+}
+
+
+//-----------------------------------------------------------------------
+//   getOldValues
+//-----------------------------------------------------------------------
+
+
+inline Matrix HistoryStore::getOldValues ( idx_t ipos ) const
+{
+  return values_[1 - inew_]
+    ( slice(offsets_[ipos],offsets_[ipos + 1]), ALL );
+}
+
+
+inline Matrix HistoryStore::getOldValues () const
+{
+  return values_[1 - inew_];
+}
+
+
+//-----------------------------------------------------------------------
+//   getNewValues
+//-----------------------------------------------------------------------
+
+
+inline Matrix HistoryStore::getNewValues ( idx_t ipos ) const
+{
+  return values_[inew_]
+    ( slice(offsets_[ipos],offsets_[ipos + 1]), ALL );
+}
+
+
+inline Matrix HistoryStore::getNewValues () const
+{
+  return values_[inew_];
+}
+
+
+JIVE_END_PACKAGE( fem )
+
+#endif
@@ -94,6 +94,14 @@ class InputModule : public Module
       const Properties&       globdat,
       int                     mask     = READ_ALL );
 
+  static void               initReader
+
+    ( util::BinaryDataReader& reader,
+      const Properties&       conf,
+      const Properties&       props,
+      const Properties&       globdat,
+      int                     mask     = READ_ALL );
+
   static Ref<Module>        makeNew
 
     ( const String&           name,
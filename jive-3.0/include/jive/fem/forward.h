@@ -58,10 +58,12 @@ class                     ElementGroup;
 class                     Element;
 class                     ElementIterator;
 class                     ElementSet;
+class                     ElemDofTable;
 class                     ElemGroupConverter;
 class                     FEIterator;
 class                     FEMatrixBuilder;
 class                     GroupconvModule;
+class                     HistoryStore;
 class                     IBoundaryIterator;
 class                     InitModule;
 class                     InputModule;
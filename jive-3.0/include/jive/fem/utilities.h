@@ -40,7 +40,9 @@
 JIVE_BEGIN_PACKAGE( fem )
 
 
+class XNodeSet;
 class ElementSet;
+class XElementSet;
 class ElementIterator;
 class BoundarySet;
 class XBoundarySet;
@@ -57,6 +59,15 @@ void                      reorderDofs
   ( XDofSpace&              dofs,
     const ElementSet&       elems   );
 
+IdxVector                 getCurveOrder
+
+  ( const Matrix&           coords  );
+
+void                      reorderMesh
+
+  ( const XNodeSet&         nodes,
+    const XElementSet&      elems   );
+
 void                      recvBoundaries
 
   ( MPContext&              mpx,
@@ -61,6 +61,7 @@ using jive::fem::ElementSet;
 using jive::fem::ElementGroup;
 using jive::fem::IElement;
 using jive::fem::ElemIter;
+using jive::fem::ElemDofTable;
 
 
 JIVE_END_PACKAGE( femodel )
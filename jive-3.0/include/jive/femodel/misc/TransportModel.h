@@ -136,6 +136,7 @@ class TransportModel : public Model, public Serializable
 
   Ref<IElement>             element_;
   Ref<ElemIter>             elemIter_;
+  Ref<ElemDofTable>         dofTable_;
 
   Ref<XDofSpace>            dofs_;
   String                    dofName_;
@@ -115,6 +115,10 @@ class BoxArray
     ( const Matrix&           boxes,
       const IdxVector&        iboxes )       const;
 
+  inline const double*      getCorners
+
+    ( idx_t                   ibox   )       const;
+
   inline idx_t              getColor
 
     ( idx_t                   ibox   )       const;
@@ -307,6 +311,17 @@ inline void BoxArray::checkIndex ( idx_t ibox ) const
 }
 
 
+//-----------------------------------------------------------------------
+//   getCorners
+//-----------------------------------------------------------------------
+
+
+inline const double* BoxArray::getCorners ( idx_t ibox ) const
+{
+  return boxes_.addr ( ibox * rank2_ );
+}
+
+
 //-----------------------------------------------------------------------
 //   getColor
 //-----------------------------------------------------------------------
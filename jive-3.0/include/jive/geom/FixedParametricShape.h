@@ -0,0 +1,139 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+#ifndef JIVE_GEOM_FIXEDPARAMETRICSHAPE_H
+#define JIVE_GEOM_FIXEDPARAMETRICSHAPE_H
+
+#include <jive/geom/Tuple.h>
+#include <jive/geom/ParametricShape.h>
+
+
+JIVE_BEGIN_PACKAGE( geom )
+
+
+//-----------------------------------------------------------------------
+//   class FixedParametricShape
+//-----------------------------------------------------------------------
+
+// Specializes a parametric shape (the Base class) with N nodes and
+// P integration points. The shape functions and their gradients in
+// the integration points are stored in fixed-size tuples, so that
+// the Jacobi matrices, integration weights and shape function
+// gradients can be computed without any heap-allocated temporaries.
+// The gradients are only specialized if the geometric and the
+// interpolation shape functions are the same.
+//
+// If the geometry of an element is affine -- as is always the case
+// for linear simplices, and for parallelograms and parallelepipeds
+// -- the Jacobi matrix is constant. It is then computed and inverted
+// only once per element instead of once per integration point.
+//
+// Note that the class of a specialized shape is the class of its
+// Base; a serialized shape is restored as an instance of Base.
+
+
+template <class Base, int N, int P>
+
+  class FixedParametricShape : public Base
+
+{
+ public:
+
+  typedef FixedParametricShape  Self;
+  typedef Base                  Super;
+
+  static const int              RANK         = Base::RANK;
+  static const int              NODE_COUNT   = N;
+  static const int              IPOINT_COUNT = P;
+
+
+                                FixedParametricShape
+
+    ( const String&               name,
+      const Matrix&               ischeme,
+      const ShapeBoundary&        boundary,
+      const Ref<StdShape>&        xshape,
+      const Ref<StdShape>&        sshape = nullptr );
+
+  virtual void                  getGlobalIntegrationPoints
+
+    ( const Matrix&               x,
+      const Matrix&               c )              const override;
+
+  virtual void                  getIntegrationWeights
+
+    ( const Vector&               w,
+      const Matrix&               c )              const override;
+
+  virtual void                  getShapeGradients
+
+    ( const Cubix&                g,
+      const Vector&               w,
+      const Matrix&               c )              const override;
+
+
+ protected:
+
+  virtual                      ~FixedParametricShape ();
+
+
+ private:
+
+  static inline void            loadCoords_
+
+    ( Tuple<double,N,RANK>&       ct,
+      const Matrix&               c );
+
+  inline bool                   isAffine_
+
+    ( const Tuple<double,N,RANK>&     ct,
+      const Tuple<double,RANK,RANK>&  ja )         const;
+
+
+ private:
+
+  Tuple<double,N>               xfuncs_  [P];
+  Tuple<double,RANK,N>          xgrads_  [P];
+  double                        weights_ [P];
+  Tuple<double,N,RANK>          xnodes_;
+
+  bool                          isoParam_;
+  bool                          constGrads_;
+  bool                          checkAffine_;
+
+};
+
+
+JIVE_END_PACKAGE( geom )
+
+#include <jive/geom/FixedParametricShape.tcc>
+
+#endif
@@ -0,0 +1,396 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+#ifndef JIVE_GEOM_FIXEDPARAMETRICSHAPE_TCC
+#define JIVE_GEOM_FIXEDPARAMETRICSHAPE_TCC
+
+#include <cmath>
+#include <jem/base/limits.h>
+#include <jem/base/assert.h>
+#include <jem/base/utilities.h>
+#include <jem/numeric/algebra/matmul.h>
+#include <jem/numeric/algebra/LUSolver.h>
+#include <jive/geom/error.h>
+
+
+JIVE_BEGIN_PACKAGE( geom )
+
+
+//=======================================================================
+//   class FixedParametricShape
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+template <class B, int N, int P>
+
+  FixedParametricShape<B,N,P>::FixedParametricShape
+
+  ( const String&         name,
+    const Matrix&         ischeme,
+    const ShapeBoundary&  boundary,
+    const Ref<StdShape>&  xshape,
+    const Ref<StdShape>&  sshape ) :
+
+    Super ( name, ischeme, boundary, xshape, sshape )
+
+{
+  JEM_PRECHECK2 ( this->nodeCount_ == N &&
+                  this->ipCount_   == P,
+                  "invalid fixed-size parametric shape" );
+
+  const Matrix&  xfuncs = this->ipoints_.xfuncs;
+  const Cubix&   xgrads = this->ipoints_.xgrads;
+
+
+  this->updateFuncs_ ( this->ipoints_ );
+  this->updateGrads_ ( this->ipoints_ );
+
+  for ( int ip = 0; ip < P; ip++ )
+  {
+    weights_[ip] = this->iweights_[ip];
+
+    for ( int j = 0; j < N; j++ )
+    {
+      xfuncs_[ip][j] = xfuncs(j,ip);
+
+      for ( int i = 0; i < RANK; i++ )
+      {
+        xgrads_[ip](i,j) = xgrads(i,j,ip);
+      }
+    }
+  }
+
+  isoParam_   = (this->sshape_ == this->xshape_);
+  constGrads_ = true;
+
+  for ( int ip = 1; ip < P && constGrads_; ip++ )
+  {
+    for ( int j = 0; j < N; j++ )
+    {
+      for ( int i = 0; i < RANK; i++ )
+      {
+        if ( xgrads_[ip](i,j) != xgrads_[0](i,j) )
+        {
+          constGrads_ = false;
+        }
+      }
+    }
+  }
+
+  // The local node coordinates, relative to the first node, are
+  // needed to check whether an element is affine. They are only
+  // available if the nodes coincide with the vertices.
+
+  Matrix  vx = this->xshape_->getVertexCoords ();
+
+  checkAffine_ = (vx.size(0) == RANK && vx.size(1) == N);
+
+  if ( checkAffine_ )
+  {
+    for ( int j = 0; j < N; j++ )
+    {
+      for ( int i = 0; i < RANK; i++ )
+      {
+        xnodes_(j,i) = vx(i,j) - vx(i,0);
+      }
+    }
+  }
+  else
+  {
+    xnodes_ = 0.0;
+  }
+}
+
+
+template <class B, int N, int P>
+
+  FixedParametricShape<B,N,P>::~FixedParametricShape ()
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   getGlobalIntegrationPoints
+//-----------------------------------------------------------------------
+
+
+template <class B, int N, int P>
+
+  void FixedParametricShape<B,N,P>::getGlobalIntegrationPoints
+
+  ( const Matrix&  x,
+    const Matrix&  c ) const
+
+{
+  using jem::numeric::matmul;
+
+  Tuple<double,N,RANK>  ct;
+  Tuple<double,RANK>    xp;
+
+  loadCoords_ ( ct, c );
+
+  for ( int ip = 0; ip < P; ip++ )
+  {
+    matmul ( xp, xfuncs_[ip], ct );
+
+    for ( int i = 0; i < RANK; i++ )
+    {
+      x(i,ip) = xp[i];
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   getIntegrationWeights
+//-----------------------------------------------------------------------
+
+
+template <class B, int N, int P>
+
+  void FixedParametricShape<B,N,P>::getIntegrationWeights
+
+  ( const Vector&  w,
+    const Matrix&  c ) const
+
+{
+  using jem::numeric::det;
+  using jem::numeric::matmul;
+
+  Tuple<double,N,RANK>     ct;
+  Tuple<double,RANK,RANK>  ja;
+
+  double                   jdet;
+
+
+  loadCoords_ ( ct, c );
+  matmul      ( ja, xgrads_[0], ct );
+
+  jdet = std::fabs ( det( ja ) );
+
+  if ( isAffine_( ct, ja ) )
+  {
+    for ( int ip = 0; ip < P; ip++ )
+    {
+      w[ip] = weights_[ip] * jdet;
+    }
+
+    return;
+  }
+
+  w[0] = weights_[0] * jdet;
+
+  for ( int ip = 1; ip < P; ip++ )
+  {
+    matmul ( ja, xgrads_[ip], ct );
+
+    w[ip] = weights_[ip] * std::fabs ( det( ja ) );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   getShapeGradients
+//-----------------------------------------------------------------------
+
+
+template <class B, int N, int P>
+
+  void FixedParametricShape<B,N,P>::getShapeGradients
+
+  ( const Cubix&   g,
+    const Vector&  w,
+    const Matrix&  c ) const
+
+{
+  using jem::numeric::matmul;
+  using jem::numeric::invert;
+
+  if ( ! isoParam_ )
+  {
+    Super::getShapeGradients ( g, w, c );
+
+    return;
+  }
+
+  Tuple<double,N,RANK>     ct;
+  Tuple<double,RANK,RANK>  ja;
+  Tuple<double,RANK,N>     gp;
+
+  double                   jdet;
+
+
+  loadCoords_ ( ct, c );
+  matmul      ( ja, xgrads_[0], ct );
+
+  const bool  contiguous = g.isContiguous ();
+  const bool  affine     = isAffine_ ( ct, ja );
+
+  if ( ! invert( ja, jdet ) )
+  {
+    singularMatrixError ( this->getContext(), "Jacobi" );
+  }
+
+  matmul ( gp, ja, xgrads_[0] );
+
+  for ( int ip = 0; ip < P; ip++ )
+  {
+    // The inverse Jacobi matrix of an affine element is computed in
+    // the first point and re-used in the other points.
+
+    if ( ip > 0 && ! affine )
+    {
+      matmul ( ja, xgrads_[ip], ct );
+
+      if ( ! invert( ja, jdet ) )
+      {
+        singularMatrixError ( this->getContext(), "Jacobi" );
+      }
+    }
+
+    if ( ip > 0 && ! (affine && constGrads_) )
+    {
+      matmul ( gp, ja, xgrads_[ip] );
+    }
+
+    if ( contiguous )
+    {
+      double* JEM_RESTRICT  dest = g.addr() + ip * (RANK * N);
+
+      for ( int k = 0; k < RANK * N; k++ )
+      {
+        dest[k] = gp.addr()[k];
+      }
+    }
+    else
+    {
+      for ( int j = 0; j < N; j++ )
+      {
+        for ( int i = 0; i < RANK; i++ )
+        {
+          g(i,j,ip) = gp(i,j);
+        }
+      }
+    }
+
+    w[ip] = weights_[ip] * std::fabs ( jdet );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   loadCoords_
+//-----------------------------------------------------------------------
+
+
+template <class B, int N, int P>
+
+  inline void FixedParametricShape<B,N,P>::loadCoords_
+
+  ( Tuple<double,N,RANK>&  ct,
+    const Matrix&          c )
+
+{
+  JEM_ASSERT2 ( c.size(0) == RANK && c.size(1) == N,
+                "Array shape mismatch" );
+
+  for ( int j = 0; j < N; j++ )
+  {
+    for ( int i = 0; i < RANK; i++ )
+    {
+      ct(j,i) = c(i,j);
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   isAffine_
+//-----------------------------------------------------------------------
+
+// Returns true if the Jacobi matrix ja, evaluated in an arbitrary
+// point, maps the local node coordinates onto the global node
+// coordinates ct up to a few rounding errors. The Jacobi matrix is
+// then the same in all points. The tolerance is relative to the size
+// of the element, not to the magnitude of its coordinates, as small
+// elements far from the origin would otherwise always pass.
+
+
+template <class B, int N, int P>
+
+  inline bool FixedParametricShape<B,N,P>::isAffine_
+
+  ( const Tuple<double,N,RANK>&     ct,
+    const Tuple<double,RANK,RANK>&  ja ) const
+
+{
+  if ( constGrads_ )
+  {
+    return true;
+  }
+
+  if ( ! checkAffine_ )
+  {
+    return false;
+  }
+
+  double  scale = 0.0;
+  double  error = 0.0;
+
+
+  for ( int j = 0; j < N; j++ )
+  {
+    for ( int i = 0; i < RANK; i++ )
+    {
+      double  d = ct(j,i) - ct(0,i);
+      double  r = d;
+
+      for ( int k = 0; k < RANK; k++ )
+      {
+        r -= xnodes_(j,k) * ja(k,i);
+      }
+
+      scale = jem::max ( scale, std::fabs( d ) );
+      error = jem::max ( error, std::fabs( r ) );
+    }
+  }
+
+  return (error <= 64.0 * jem::Limits<double>::EPSILON * scale);
+}
+
+
+JIVE_END_PACKAGE( geom )
+
+#endif
@@ -55,6 +55,8 @@ class InternalShape : public Shape
   JEM_DECLARE_CLASS       ( InternalShape, Shape );
 
   typedef util::Topology    Topology;
+  typedef
+    jem::Array<double,4>    GradBlock;
 
 
   explicit                  InternalShape
@@ -99,6 +101,21 @@ class InternalShape : public Shape
       const Vector&           w,
       const Matrix&           c )                  const = 0;
 
+  // Computes the shape function gradients and integration point
+  // weights of a block of elements with this shape. The element
+  // index comes first so that the loops over the elements in a
+  // block can be vectorized:
+  //
+  //   c(k,i,j)    : coordinate i of node j of element k;
+  //   g(k,i,f,p)  : gradient i of shape function f in point p;
+  //   w(k,p)      : weight of integration point p.
+
+  virtual void              getBlockGradients
+
+    ( const GradBlock&        g,
+      const Matrix&           w,
+      const Cubix&            c )                  const;
+
   virtual void              getVertexGradients
 
     ( const Cubix&            g,
@@ -111,6 +111,12 @@ class ParametricArea : public ParametricShape
       const Vector&           u,
       const Matrix&           c )             const override;
 
+  virtual void              getBlockGradients
+
+    ( const GradBlock&        g,
+      const Matrix&           w,
+      const Cubix&            c )             const override;
+
   virtual void              calcGradients
 
     ( const Cubix&            g,
@@ -70,6 +70,7 @@ class                     StdEdge;
 class                     StdPumShape;
 class                     StdShape;
 class                     StdShapeTable;
+class                     TreeBoxManager;
 class                     TrueMaskMatrix;
 
 typedef                   StdShape            SShape;
@@ -0,0 +1,163 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+#ifndef JIVE_GRAPH_MPPARTITIONER_H
+#define JIVE_GRAPH_MPPARTITIONER_H
+
+#include <jem/mp/forward.h>
+#include <jive/graph/import.h>
+#include <jive/graph/Partitioner.h>
+
+
+JIVE_BEGIN_PACKAGE( graph )
+
+
+//-----------------------------------------------------------------------
+//   class MPPartitioner
+//-----------------------------------------------------------------------
+
+// A multilevel partitioner for graphs that are distributed over a
+// set of processes. Each process owns a contiguous range of the
+// global nodes. The graph is coarsened by means of a parallel
+// heavy-edge matching until it is small enough to be partitioned on
+// the first process. The partition is then projected back to the
+// finer graphs and refined by label propagation.
+//
+// When used through the Partitioner interface, the partitioner runs
+// the same algorithm on the calling process only.
+
+
+class MPPartitioner : public Partitioner
+{
+ public:
+
+  JEM_DECLARE_CLASS         ( MPPartitioner, Partitioner );
+
+  typedef jem::mp::Context    MPContext;
+
+  static const char*          TYPE_NAME;
+  static const int            MAX_PASSES;
+
+
+  explicit                    MPPartitioner
+
+    ( const String&             name   = "",
+      const Ref<Random>&        rand   = nullptr,
+      const Ref<Partitioner>&   parter = nullptr );
+
+  virtual void                configure
+
+    ( const Properties&         props )                override;
+
+  virtual void                getConfig
+
+    ( const Properties&         props )          const override;
+
+  using                       Super::partition;
+
+  // Collective operation. The local graph contains the nodes in the
+  // range [nodeDist[rank], nodeDist[rank + 1]); its adjacency array
+  // contains global node indices. The partition indices of the
+  // local nodes are stored in nodeMap.
+
+  void                        partition
+
+    ( MPContext&                mpx,
+      const IdxVector&          nodeMap,
+      const WGraph&             graph,
+      const IdxVector&          nodeDist,
+      const Control&            ctrl );
+
+  static Ref<Partitioner>     makeNew
+
+    ( const String&             name,
+      const Properties&         conf,
+      const Properties&         props,
+      const Properties&         globdat );
+
+  static void                 declare         ();
+
+
+ protected:
+
+  virtual                    ~MPPartitioner   ();
+
+  virtual void                partition_
+
+    ( Partition&                part,
+      const Control&            ctrl )                 override;
+
+
+ private:
+
+  class                       Halo_;
+  class                       Level_;
+  class                       Utils_;
+
+  friend class                Utils_;
+
+
+ private:
+
+  Ref<Level_>                 coarsen_
+
+    ( MPContext&                mpx,
+      Level_&                   fine,
+      idx_t                     level );
+
+  void                        partitionCoarsest_
+
+    ( MPContext&                mpx,
+      const IdxVector&          nodeMap,
+      const Level_&             coarse,
+      const Control&            ctrl );
+
+  void                        refine_
+
+    ( MPContext&                mpx,
+      const IdxVector&          nodeMap,
+      Level_&                   level,
+      const Control&            ctrl );
+
+
+ private:
+
+  Ref<Random>                 rand_;
+  Ref<Partitioner>            parter_;
+
+  int                         maxPasses_;
+
+};
+
+
+JIVE_END_PACKAGE( graph )
+
+#endif
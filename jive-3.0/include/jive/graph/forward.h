@@ -47,6 +47,7 @@ class                     GreedyOptimizer;
 class                     GreedyPartitioner;
 class                     GrowBisectioner;
 class                     MLPartitioner;
+class                     MPPartitioner;
 class                     Optimizer;
 class                     PartitionBorder;
 class                     PartitionControl;
@@ -149,6 +149,8 @@ class MPModel : public Model,
   jem::util::Flex<String>   vecActions_;
   jem::util::Flex<String>   vecNames_;
 
+  bool                      splitMatmul_;
+
 };
 
 
@@ -81,6 +81,7 @@ class PropertyNames
   static const char*    MODELS;
   static const char*    NOISE_LEVEL;
   static const char*    SCALE_FUNC;
+  static const char*    SPLIT_MATMUL;
   static const char*    SYMMETRIC;
   static const char*    TABLES;
   static const char*    VECTORS;
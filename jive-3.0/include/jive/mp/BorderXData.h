@@ -66,6 +66,7 @@ class BorderXData : public jem::Collectable
   idx_t                   borderCount;
 
   IdxVector               borderIDs;
+  IntVector               borderRanks;
   IdxVector               borderOffsets;
   IdxVector               borderItems;
 
@@ -114,6 +114,11 @@ class DataExchanger : public Object
       const BorderSet&        recvBorders,
       const BorderSet&        sendBorders );
 
+  void                      exchange_
+
+    ( const IntColArray&      icols,
+      const FloatColArray&    fcols );
+
   void                      update_       ();
   void                      invalidate_   ();
 
@@ -85,6 +85,10 @@ class VectorExchanger : public Object
 
     ( int                     mode );
 
+  void                      sendOne
+
+    ( const Vector&           sendVec );
+
   inline void               endOne
 
     ( const Vector&           vec );
@@ -206,6 +210,7 @@ class VectorExchanger : public Object
   int                       xmode_;
   bool                      overlap_;
   bool                      updated_;
+  bool                      sending_;
 
   Ref<XData_>               xdata_[2];
 
@@ -67,11 +67,66 @@ class ScatterCodec : public jem::Interface
 };
 
 
+//-----------------------------------------------------------------------
+//   interface ScatterWriter
+//-----------------------------------------------------------------------
+
+
+class ScatterWriter : public jem::Interface
+{
+ public:
+
+  virtual void              writeData
+
+    ( DataOutput&             out )          = 0;
+
+
+ protected:
+
+  virtual                  ~ScatterWriter ();
+
+};
+
+
+//-----------------------------------------------------------------------
+//   interface ScatterReader
+//-----------------------------------------------------------------------
+
+
+class ScatterReader : public jem::Interface
+{
+ public:
+
+  virtual void              readData
+
+    ( DataInput&              in )           = 0;
+
+
+ protected:
+
+  virtual                  ~ScatterReader ();
+
+};
+
+
 //-----------------------------------------------------------------------
 //   public functions
 //-----------------------------------------------------------------------
 
 
+void                        recvStream
+
+  ( Context&                  mpx,
+    ScatterReader&            reader,
+    int                       root = 0 );
+
+void                        scatterStream
+
+  ( Context&                  mpx,
+    ScatterReader&            reader,
+    ScatterWriter&            writer );
+
+
 void                        recvObjects
 
   ( Context&                  mpx,
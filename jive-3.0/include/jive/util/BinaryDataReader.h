@@ -0,0 +1,147 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+#ifndef JIVE_UTIL_BINARYDATAREADER_H
+#define JIVE_UTIL_BINARYDATAREADER_H
+
+#include <jem/base/Object.h>
+#include <jive/util/import.h>
+#include <jive/util/typedefs.h>
+
+
+JIVE_BEGIN_PACKAGE( util )
+
+
+class ItemSet;
+class XPointSet;
+class XGroupSet;
+class XMemberSet;
+
+
+//-----------------------------------------------------------------------
+//   class BinaryDataReader
+//-----------------------------------------------------------------------
+
+
+class BinaryDataReader : public Object
+{
+ public:
+
+  JEM_DECLARE_CLASS       ( BinaryDataReader, Object );
+
+  static const char*        FILE_EXTENSION;
+
+
+                            BinaryDataReader ();
+
+  void                      readFile
+
+    ( const String&           fname,
+      const Ref<Writer>&      logger  = nullptr );
+
+  void                      skipUnknownItems
+
+    ( bool                    choice  = true );
+
+  void                      addPointSet
+
+    ( const Ref<XPointSet>&   points );
+
+  void                      addGroupSet
+
+    ( const Ref<XGroupSet>&   groups );
+
+  void                      addMemberSet
+
+    ( const Ref<XMemberSet>&  members );
+
+  void                      addItemGroups
+
+    ( const Ref<ItemSet>&     items,
+      const Ref<Dictionary>&  groups,
+      const String&           filter  = "*" );
+
+  void                      addItemGroups
+
+    ( const Properties&       globdat,
+      const String&           filter  = "*" );
+
+  void                      addTables
+
+    ( const Ref<ItemSet>&     items,
+      const Ref<Dictionary>&  tables,
+      const String&           filter  = "*" );
+
+  void                      addTables
+
+    ( const Properties&       globdat,
+      const String&           filter  = "*" );
+
+  void                      addConstraints
+
+    ( const Ref<ConParser>&   conParser );
+
+  void                      addConstraints
+
+    ( const Properties&       globdat );
+
+  static bool               isBinaryFile
+
+    ( const String&           fname );
+
+
+ protected:
+
+  virtual                  ~BinaryDataReader ();
+
+
+ private:
+
+  class                     Target_;
+  class                     Input_;
+  class                     Utils_;
+
+  Target_*                  getTarget_
+
+    ( const String&           itemName );
+
+
+ private:
+
+  Ref<Dictionary>           targets_;
+  bool                      skipUnknown_;
+
+};
+
+
+JIVE_END_PACKAGE( util )
+
+#endif
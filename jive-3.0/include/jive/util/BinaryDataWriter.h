@@ -0,0 +1,162 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+#ifndef JIVE_UTIL_BINARYDATAWRITER_H
+#define JIVE_UTIL_BINARYDATAWRITER_H
+
+#include <jem/base/Object.h>
+#include <jive/Array.h>
+#include <jive/util/import.h>
+#include <jive/util/typedefs.h>
+
+
+JIVE_BEGIN_PACKAGE( util )
+
+
+class ItemSet;
+class PointSet;
+class GroupSet;
+class MemberSet;
+class ItemGroup;
+class Table;
+
+
+//-----------------------------------------------------------------------
+//   class BinaryDataWriter
+//-----------------------------------------------------------------------
+
+// Writes the data that can be read by a BinaryDataReader. The item sets
+// must be written before the data that refers to their items.
+
+
+class BinaryDataWriter : public Object
+{
+ public:
+
+  JEM_DECLARE_CLASS       ( BinaryDataWriter, Object );
+
+
+  explicit                  BinaryDataWriter
+
+    ( const String&           fname );
+
+  void                      close             ();
+
+  void                      writePointSet
+
+    ( const PointSet&         points );
+
+  void                      writeGroupSet
+
+    ( const GroupSet&         groups );
+
+  void                      writeMemberSet
+
+    ( const MemberSet&        members );
+
+  void                      writeItemGroup
+
+    ( const String&           name,
+      const ItemGroup&        group );
+
+  void                      writeTable
+
+    ( const String&           name,
+      const Table&            table );
+
+  void                      writeConstraints
+
+    ( const ConParser&        conParser );
+
+  void                      writeAll
+
+    ( const Properties&       globdat );
+
+
+ protected:
+
+  virtual                  ~BinaryDataWriter  ();
+
+
+ private:
+
+  class                     Utils_;
+
+  void                      beginSection_
+
+    ( int                     kind,
+      lint                    size,
+      const ItemSet&          items );
+
+  void                      endSection_       ();
+
+  void                      writeLint_
+
+    ( lint                    value );
+
+  void                      writeString_
+
+    ( const String&           str );
+
+  void                      writeIndices_
+
+    ( const IdxVector&        idx );
+
+  void                      writeIDs_
+
+    ( const IdxVector&        iitems,
+      const ItemSet&          items );
+
+  void                      writeDoubles_
+
+    ( const double*           buf,
+      idx_t                   count );
+
+  void                      write_
+
+    ( const void*             buf,
+      lint                    size );
+
+
+ private:
+
+  Ref<jem::io
+    ::OutputStream>         output_;
+
+  lint                      position_;
+  lint                      sectionEnd_;
+
+};
+
+
+JIVE_END_PACKAGE( util )
+
+#endif
@@ -84,6 +84,24 @@ class ConstraintsParser : public jem::xml::Parser
     ( Constraints&            cons,
       const String&           context )          const;
 
+  void                      getData
+
+    ( StringVector&           typeNames,
+      IdxVector&              offsets,
+      IdxVector&              iitems,
+      IdxVector&              itypes,
+      Vector&                 values,
+      BoolVector&             rmask   )          const;
+
+  void                      addData
+
+    ( const StringVector&     typeNames,
+      const IdxVector&        offsets,
+      const IdxVector&        iitems,
+      const IdxVector&        itypes,
+      const Vector&           values,
+      const BoolVector&       rmask   );
+
   void                      store
 
     ( const Properties&       globdat )          const;
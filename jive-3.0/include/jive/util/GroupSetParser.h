@@ -83,6 +83,13 @@ class GroupSetParser : public jem::xml::Parser
   virtual                  ~GroupSetParser  ();
 
 
+ private:
+
+  void                      parseBlock_
+
+    ( State&                  state );
+
+
  private:
 
   class                     Utils_;
@@ -89,6 +89,10 @@ class PointSetParser : public jem::xml::Parser
 
     ( State&                  state );
 
+  void                      parseBlock_
+
+    ( State&                  state );
+
   void                      scan_
 
     ( State&                  state );
@@ -40,6 +40,8 @@ JIVE_BEGIN_PACKAGE( util )
 
 class                     AllItemGroup;
 class                     ArrayItemGroup;
+class                     BinaryDataReader;
+class                     BinaryDataWriter;
 class                     ColoredItemGroup;
 class                     Constraints;
 class                     ConstraintsParser;
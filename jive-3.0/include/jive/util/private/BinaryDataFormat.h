@@ -0,0 +1,108 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+#ifndef JIVE_UTIL_PRIVATE_BINARYDATAFORMAT_H
+#define JIVE_UTIL_PRIVATE_BINARYDATAFORMAT_H
+
+#include <jive/defines.h>
+
+
+JIVE_BEGIN_PACKAGE( util )
+
+
+//-----------------------------------------------------------------------
+//   class BinaryDataFormat
+//-----------------------------------------------------------------------
+
+// A binary data file starts with three 64-bit integers: the magic
+// number, the byte order mark and the format version. They are followed
+// by a sequence of sections. Each section starts with its kind and the
+// size of its body in bytes. The body starts with the name of the item
+// type that the section belongs to. All integers are stored as 64-bit
+// integers and all reals as doubles in the native byte order. Strings
+// are stored as their length followed by their characters. Everything
+// is padded to a multiple of eight bytes so that the arrays in a
+// memory-mapped file are properly aligned.
+//
+// The section bodies are laid out as follows:
+//
+//   POINT_SET   : rank, count, ids[count], coords[count * rank]
+//   GROUP_SET   : count, ids[count], offsets[count + 1],
+//                 memberIDs[offsets[count]]
+//   MEMBER_SET  : count, ids[count], itemIDs[count], ilocals[count]
+//   ITEM_GROUP  : name, count, itemIDs[count]
+//   TABLE       : name, dense, colCount, colNames[colCount],
+//                 rowCount, rowIDs[rowCount], offsets[rowCount + 1],
+//                 jcols[nnz], values[nnz]
+//   CONSTRAINTS : typeCount, typeNames[typeCount], conCount,
+//                 offsets[conCount + 1], itemIDs[n], itypes[n],
+//                 values[n], rmask[conCount]
+
+
+class BinaryDataFormat
+{
+ public:
+
+  static const lint         MAGIC       = 0x5441444256494A23LL;
+  static const lint         ORDER_MARK  = 0x0102030405060708LL;
+  static const lint         VERSION     = 1;
+
+  static const int          END         = 0;
+  static const int          POINT_SET   = 1;
+  static const int          GROUP_SET   = 2;
+  static const int          MEMBER_SET  = 3;
+  static const int          ITEM_GROUP  = 4;
+  static const int          TABLE       = 5;
+  static const int          CONSTRAINTS = 6;
+
+
+  static inline lint        padSize
+
+    ( lint                    n )
+
+  {
+    return ((n + 7) & ~((lint) 7));
+  }
+
+  static inline lint        stringSize
+
+    ( idx_t                   len )
+
+  {
+    return (8 + padSize( (lint) len ));
+  }
+
+};
+
+
+JIVE_END_PACKAGE( util )
+
+#endif
@@ -34,12 +34,17 @@
 #include <jem/base/System.h>
 #include <jem/base/ClassTemplate.h>
 #include <jem/base/IllegalArgumentException.h>
+#include <jem/base/array/select.h>
 #include <jem/base/array/operators.h>
+#include <jem/base/array/utilities.h>
 #include <jem/io/ObjectInput.h>
 #include <jem/io/ObjectOutput.h>
 #include <jem/util/Event.h>
+#include <jem/numeric/sparse/matmul.h>
+#include <jem/numeric/sparse/select.h>
 #include <jive/mp/VectorExchanger.h>
 #include <jive/algebra/typedefs.h>
+#include <jive/algebra/SparseMatrixObject.h>
 #include <jive/algebra/MPMatrixObject.h>
 
 
@@ -55,6 +60,29 @@ using jive::mp::EXCHANGE;
 using jive::mp::SCATTER;
 
 
+//=======================================================================
+//   class MPMatrixObject::Split_
+//=======================================================================
+
+// Stores the rows of the local matrix in two parts: the border rows
+// that are sent to other processes, and the remaining interior rows.
+
+
+class MPMatrixObject::Split_ : public jem::Collectable
+{
+ public:
+
+  IdxVector               sendDofs;
+  IdxVector               borderRows;
+  IdxVector               innerRows;
+  SparseMatrix            borderMatrix;
+  SparseMatrix            innerMatrix;
+  Vector                  borderBuffer;
+  Vector                  innerBuffer;
+
+};
+
+
 //=======================================================================
 //   class MPMatrixObject
 //=======================================================================
@@ -63,7 +91,10 @@ using jive::mp::SCATTER;
 //-----------------------------------------------------------------------
 
 
-MPMatrixObject::MPMatrixObject ()
+MPMatrixObject::MPMatrixObject () :
+
+  split_ ( false )
+
 {}
 
 
@@ -73,7 +104,8 @@ MPMatrixObject::MPMatrixObject
     Ref<VectorExchanger>  vex ) :
 
     inner_     ( inner ),
-    exchanger_ ( vex   )
+    exchanger_ ( vex   ),
+    split_     ( false )
 
 {
   using jem::System;
@@ -125,6 +157,7 @@ MPMatrixObject::MPMatrixObject ( const Self& rhs )
   inner_     = checkedCast<AbstractMatrix> ( rhs.inner_->clone() );
   exchanger_ = rhs.exchanger_;
   xmode_     = rhs.xmode_;
+  split_     = rhs.split_;
 
   connect_ ();
 }
@@ -152,14 +185,14 @@ void MPMatrixObject::resetEvents ()
 
 void MPMatrixObject::readFrom ( ObjectInput& in )
 {
-  decode   ( in, inner_, exchanger_, xmode_ );
+  decode   ( in, inner_, exchanger_, xmode_, split_ );
   connect_ ();
 }
 
 
 void MPMatrixObject::writeTo ( ObjectOutput& out ) const
 {
-  encode ( out, inner_, exchanger_, xmode_ );
+  encode ( out, inner_, exchanger_, xmode_, split_ );
 }
 
 
@@ -196,6 +229,11 @@ void MPMatrixObject::matmul
     const Vector& rhs ) const
 
 {
+  if ( split_ && splitMatmul_( lhs, rhs ) )
+  {
+    return;
+  }
+
   exchanger_->startOne ( xmode_ );
   inner_    ->matmul   ( lhs, rhs );
   exchanger_->endOne   ( lhs );
@@ -345,6 +383,28 @@ void MPMatrixObject::setExchangeMode ( int mode )
 }
 
 
+//-----------------------------------------------------------------------
+//   setSplitMatmul
+//-----------------------------------------------------------------------
+
+// When enabled, the matmul() function first computes the rows that
+// are sent to other processes, posts the send requests, and then
+// computes the remaining rows while the messages are in transit. This
+// only works if the inner matrix is a SparseMatrixObject; otherwise
+// this setting is ignored.
+
+
+void MPMatrixObject::setSplitMatmul ( bool choice )
+{
+  split_ = choice;
+
+  if ( ! split_ )
+  {
+    splitData_ = nullptr;
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   getDiagonal
 //-----------------------------------------------------------------------
@@ -409,6 +469,8 @@ void MPMatrixObject::connect_ ()
 
 void MPMatrixObject::valuesChanged_ ()
 {
+  splitData_ = nullptr;
+
   newValuesEvent.emit ( *this );
 }
 
@@ -420,8 +482,144 @@ void MPMatrixObject::valuesChanged_ ()
 
 void MPMatrixObject::structChanged_ ()
 {
+  splitData_ = nullptr;
+
   newStructEvent.emit ( *this );
 }
 
 
+//-----------------------------------------------------------------------
+//   splitMatmul_
+//-----------------------------------------------------------------------
+
+// Returns false if the matrix-vector product can not be split, in
+// which case nothing has been done.
+
+
+bool MPMatrixObject::splitMatmul_
+
+  ( const Vector&  lhs,
+    const Vector&  rhs ) const
+
+{
+  using jem::numeric::matmul;
+
+  Split_*  split = getSplit_ ();
+
+  if ( ! split )
+  {
+    return false;
+  }
+
+  JEM_PRECHECK2 ( lhs.size() == inner_->size(0) &&
+                  rhs.size() == inner_->size(1),
+                  "Array size mismatch" );
+
+  exchanger_->startOne ( xmode_ );
+
+  matmul ( split->borderBuffer, split->borderMatrix, rhs );
+
+  lhs[split->borderRows] = split->borderBuffer;
+
+  exchanger_->sendOne  ( lhs );
+
+  matmul ( split->innerBuffer,  split->innerMatrix,  rhs );
+
+  lhs[split->innerRows]  = split->innerBuffer;
+
+  exchanger_->endOne   ( lhs );
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------
+//   getSplit_
+//-----------------------------------------------------------------------
+
+// Returns the split matrix data, or NULL if the inner matrix can not
+// be split. The data are rebuilt when the matrix or the set of send
+// DOFs has changed.
+
+
+MPMatrixObject::Split_* MPMatrixObject::getSplit_ () const
+{
+  using jem::ALL;
+  using jem::testall;
+  using jem::numeric::select;
+
+  SparseMatrixObject*  sparse =
+
+    jem::dynamicCast<SparseMatrixObject*> ( inner_ );
+
+  if ( ! sparse )
+  {
+    return nullptr;
+  }
+
+  IdxVector  sendDofs = exchanger_->getSendDofs ( xmode_ );
+  Split_*    split    = splitData_.get ();
+
+  if ( split )
+  {
+    if ( split->sendDofs.size() == sendDofs.size() &&
+         testall( split->sendDofs == sendDofs ) )
+    {
+      return split;
+    }
+  }
+
+  Self*         self      = const_cast<Self*> ( this );
+  Ref<Split_>   data      = newInstance<Split_> ();
+  SparseMatrix  matrix    = sparse->toSparseMatrix ();
+
+  const idx_t   rowCount  = matrix.size (0);
+
+  BoolVector    mask      ( rowCount );
+  idx_t         nb, ni;
+
+
+  mask           = false;
+  mask[sendDofs] = true;
+
+  nb = 0;
+
+  for ( idx_t irow = 0; irow < rowCount; irow++ )
+  {
+    if ( mask[irow] )
+    {
+      nb++;
+    }
+  }
+
+  data->sendDofs  .ref    ( sendDofs.clone() );
+  data->borderRows.resize ( nb );
+  data->innerRows .resize ( rowCount - nb );
+
+  nb = ni = 0;
+
+  for ( idx_t irow = 0; irow < rowCount; irow++ )
+  {
+    if ( mask[irow] )
+    {
+      data->borderRows[nb++] = irow;
+    }
+    else
+    {
+      data->innerRows [ni++] = irow;
+    }
+  }
+
+  data->borderMatrix = select ( matrix, data->borderRows, ALL );
+  data->innerMatrix  = select ( matrix, data->innerRows,  ALL );
+
+  data->borderBuffer.resize ( data->borderRows.size() );
+  data->innerBuffer .resize ( data->innerRows .size() );
+
+  self->splitData_ = data;
+
+  return data.get ();
+}
+
+
 JIVE_END_PACKAGE( algebra )
@@ -33,6 +33,8 @@
 #include <cmath>
 #include <jem/base/Error.h>
 #include <jem/base/System.h>
+#include <jem/base/MemCache.h>
+#include <jem/base/ThreadTeam.h>
 #include <jem/base/ClassTemplate.h>
 #include <jem/base/OutOfMemoryException.h>
 #include <jem/base/tuple/utilities.h>
@@ -52,10 +54,90 @@ JEM_DEFINE_SERIABLE_CLASS( jive::algebra::SparseMatrixObject );
 JIVE_BEGIN_PACKAGE( algebra )
 
 
+using jem::MemCache;
+using jem::ThreadTeam;
 using jive::util::sizeError;
 using jive::util::indexError;
 
 
+//=======================================================================
+//   class SparseMatrixObject::MatmulWork_
+//=======================================================================
+
+/*
+  Executes a range of (super) rows of a matrix-vector product. Each
+  row is written by exactly one thread, so the result does not depend
+  on the number of threads.
+*/
+
+
+class SparseMatrixObject::MatmulWork_ : public ThreadTeam::Work
+{
+ public:
+
+  inline                    MatmulWork_
+
+    ( const SparseMatrixObject&  mat,
+      const Vector&              lhs,
+      const Vector&              rhs );
+
+  virtual void              run
+
+    ( idx_t                     first,
+      idx_t                     last )   override;
+
+
+ private:
+
+  const SparseMatrixObject&  mat_;
+  const Vector&              lhs_;
+  const Vector&              rhs_;
+  const idx_t                offset_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline SparseMatrixObject::MatmulWork_::MatmulWork_
+
+  ( const SparseMatrixObject&  mat,
+    const Vector&              lhs,
+    const Vector&              rhs ) :
+
+    mat_    ( mat ),
+    lhs_    ( lhs ),
+    rhs_    ( rhs ),
+    offset_ ( mat.supOffsets_[1] )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+void SparseMatrixObject::MatmulWork_::run
+
+  ( idx_t  first,
+    idx_t  last )
+
+{
+  if ( mat_.status_ & PACKED_ )
+  {
+    mat_.packedMatmul_ ( lhs_, rhs_, first + offset_, last + offset_ );
+  }
+  else
+  {
+    mat_.normalMatmul_ ( lhs_, rhs_, first, last );
+  }
+}
+
+
 //=======================================================================
 //   class SparseMatrixObject
 //=======================================================================
@@ -181,14 +263,7 @@ void SparseMatrixObject::matmul
     }
   }
 
-  if ( status_ & PACKED_ )
-  {
-    packedMatmul_ ( lhs, rhs );
-  }
-  else
-  {
-    normalMatmul_ ( lhs, rhs );
-  }
+  matmul_ ( lhs, rhs );
 }
 
 
@@ -255,14 +330,7 @@ void SparseMatrixObject::multiMatmul
     Vector  lhs = lhsVecs[jcol];
     Vector  rhs = rhsVecs[jcol];
 
-    if ( status_ & PACKED_ )
-    {
-      packedMatmul_ ( lhs, rhs );
-    }
-    else
-    {
-      normalMatmul_ ( lhs, rhs );
-    }
+    matmul_ ( lhs, rhs );
   }
 }
 
@@ -640,6 +708,8 @@ void SparseMatrixObject::setMatrix ( const SparseMatrix&  matrix )
 
   JEM_PRECHECK2 ( matrix.isValid(), "invalid sparse matrix" );
 
+  MemCache::TagScope  tag ( CLASS_NAME );
+
   shape_ = matrix.shape ();
 
   if ( ! matrix.isContiguous() )
@@ -708,6 +778,8 @@ void SparseMatrixObject::addMatrix
 
   idx_t        k;
 
+  MemCache::TagScope  tag ( CLASS_NAME );
+
   // Common case: identical structures.
 
   if ( equal( rhOffsets, myOffsets ) &&
@@ -944,6 +1016,8 @@ void SparseMatrixObject::packValues_ ()
   idx_t         iend;
 
 
+  MemCache::TagScope  tag ( CLASS_NAME );
+
   print ( System::debug( myName_ ), myName_,
           " : packing matrix for better cache utilization ...\n" );
 
@@ -1212,6 +1286,54 @@ void SparseMatrixObject::resetMCounter_ ()
 }
 
 
+//-----------------------------------------------------------------------
+//   matmul_
+//-----------------------------------------------------------------------
+
+
+void SparseMatrixObject::matmul_
+
+  ( const Vector&  lhs,
+    const Vector&  rhs ) const
+
+{
+  // Each thread should get a few thousand rows at least to make up
+  // for the cost of waking up the team.
+
+  const idx_t  GRAIN = 4096;
+
+  Ref<ThreadTeam>  team = ThreadTeam::getCurrent ();
+
+  idx_t  count;
+
+
+  if ( status_ & PACKED_ )
+  {
+    count = supOffsets_[MAX_BLOCK_SIZE_ + 1] - supOffsets_[1];
+  }
+  else
+  {
+    count = shape_[0];
+  }
+
+  if ( team && team->size() > 1 && count > GRAIN )
+  {
+    MatmulWork_  work ( *this, lhs, rhs );
+
+    team->execute ( work, count, GRAIN );
+  }
+  else if ( status_ & PACKED_ )
+  {
+    packedMatmul_ ( lhs, rhs,
+                    supOffsets_[1], supOffsets_[MAX_BLOCK_SIZE_ + 1] );
+  }
+  else
+  {
+    normalMatmul_ ( lhs, rhs, 0, count );
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   normalMatmul_
 //-----------------------------------------------------------------------
@@ -1220,7 +1342,9 @@ void SparseMatrixObject::resetMCounter_ ()
 void SparseMatrixObject::normalMatmul_
 
   ( const Vector&  lhs,
-    const Vector&  rhs ) const
+    const Vector&  rhs,
+    idx_t          first,
+    idx_t          last ) const
 
 {
   const idx_t*  JEM_RESTRICT  rowOffsets = rowOffsets_.addr ();
@@ -1228,15 +1352,14 @@ void SparseMatrixObject::normalMatmul_
   const double* JEM_RESTRICT  matValues  = matValues_ .addr ();
   const double* JEM_RESTRICT  rhsValues  = rhs        .addr ();
 
-  const idx_t   rowCount = shape_     [0];
-  const idx_t   rst      = rhs.stride ();
+  const idx_t   rst = rhs.stride ();
 
   double        t;
 
 
   if ( rst == 1_idx )
   {
-    for ( idx_t irow = 0; irow < rowCount; irow++ )
+    for ( idx_t irow = first; irow < last; irow++ )
     {
       idx_t  rend = rowOffsets[irow + 1];
 
@@ -1252,7 +1375,7 @@ void SparseMatrixObject::normalMatmul_
   }
   else
   {
-    for ( idx_t irow = 0; irow < rowCount; irow++ )
+    for ( idx_t irow = first; irow < last; irow++ )
     {
       idx_t  rend = rowOffsets[irow + 1];
 
@@ -1331,7 +1454,9 @@ void SparseMatrixObject::normalMatmul4_
 void SparseMatrixObject::packedMatmul_
 
   ( const Vector&  lhs,
-    const Vector&  rhs ) const
+    const Vector&  rhs,
+    idx_t          ifirst,
+    idx_t          ilast ) const
 
 {
   const idx_t*  JEM_RESTRICT  rowOffsets = rowOffsets_.addr ();
@@ -1346,17 +1471,19 @@ void SparseMatrixObject::packedMatmul_
 
   double        t0, t1, t2, t3;
   idx_t         ssize;
+  idx_t         ibegin;
   idx_t         iend;
 
 
   // Multiply all super rows with size 1.
 
-  ssize = 1;
-  iend  = supOffsets_[ssize + 1];
+  ssize  = 1;
+  ibegin = jem::max ( supOffsets_[ssize],     ifirst );
+  iend   = jem::min ( supOffsets_[ssize + 1], ilast  );
 
   if ( rst == 1L )
   {
-    for ( idx_t isup = supOffsets_[ssize]; isup < iend; isup++ )
+    for ( idx_t isup = ibegin; isup < iend; isup++ )
     {
       idx_t  irow = supRows   [isup];
       idx_t  rend = rowOffsets[irow + 1];
@@ -1373,7 +1500,7 @@ void SparseMatrixObject::packedMatmul_
   }
   else
   {
-    for ( idx_t isup = supOffsets_[ssize]; isup < iend; isup++ )
+    for ( idx_t isup = ibegin; isup < iend; isup++ )
     {
       idx_t  irow = supRows   [isup];
       idx_t  rend = rowOffsets[irow + 1];
@@ -1391,10 +1518,11 @@ void SparseMatrixObject::packedMatmul_
 
   // Multiply all super rows with size 2.
 
-  ssize = 2;
-  iend  = supOffsets_[ssize + 1];
+  ssize  = 2;
+  ibegin = jem::max ( supOffsets_[ssize],     ifirst );
+  iend   = jem::min ( supOffsets_[ssize + 1], ilast  );
 
-  for ( idx_t isup = supOffsets_[ssize]; isup < iend; isup++ )
+  for ( idx_t isup = ibegin; isup < iend; isup++ )
   {
     idx_t  irow   = supRows   [isup];
     idx_t  rbegin = rowOffsets[irow];
@@ -1417,10 +1545,11 @@ void SparseMatrixObject::packedMatmul_
 
   // Multiply all super rows with size 3.
 
-  ssize = 3;
-  iend  = supOffsets_[ssize + 1];
+  ssize  = 3;
+  ibegin = jem::max ( supOffsets_[ssize],     ifirst );
+  iend   = jem::min ( supOffsets_[ssize + 1], ilast  );
 
-  for ( idx_t isup = supOffsets_[ssize]; isup < iend; isup++ )
+  for ( idx_t isup = ibegin; isup < iend; isup++ )
   {
     idx_t  irow   = supRows   [isup];
     idx_t  rbegin = rowOffsets[irow];
@@ -1445,10 +1574,11 @@ void SparseMatrixObject::packedMatmul_
 
   // Multiply all super rows with size 4.
 
-  ssize = 4;
-  iend  = supOffsets_[ssize + 1];
+  ssize  = 4;
+  ibegin = jem::max ( supOffsets_[ssize],     ifirst );
+  iend   = jem::min ( supOffsets_[ssize + 1], ilast  );
 
-  for ( idx_t isup = supOffsets_[ssize]; isup < iend; isup++ )
+  for ( idx_t isup = ibegin; isup < iend; isup++ )
   {
     idx_t  irow   = supRows   [isup];
     idx_t  rbegin = rowOffsets[irow];
@@ -30,7 +30,9 @@
  */
 
 
+#include <cmath>
 #include <jem/base/assert.h>
+#include <jem/base/ThreadTeam.h>
 #include <jem/base/ClassTemplate.h>
 #include <jem/base/array/operators.h>
 #include <jem/base/array/utilities.h>
@@ -49,6 +51,150 @@ JIVE_BEGIN_PACKAGE( algebra )
 
 
 using jem::dot;
+using jem::ThreadTeam;
+
+
+//=======================================================================
+//   class StdVectorSpace::DotWork_
+//=======================================================================
+
+/*
+  Computes the partial dot products of fixed-size blocks of two
+  vectors, or of one vector with itself if the second vector is a
+  NULL pointer. The partial products are summed in block order so
+  that the result does not depend on the number of threads.
+*/
+
+
+class StdVectorSpace::DotWork_ : public ThreadTeam::Work
+{
+ public:
+
+  static const idx_t        BLOCK_SIZE;
+
+
+  inline                    DotWork_
+
+    ( const Vector&           x,
+      const Vector*           y );
+
+  virtual void              run
+
+    ( idx_t                   first,
+      idx_t                   last )   override;
+
+  inline double             sum             () const;
+
+  static inline double      blockDot
+
+    ( const Vector&           x,
+      const Vector*           y,
+      idx_t                   ib );
+
+
+ public:
+
+  Vector                    partials;
+
+
+ private:
+
+  const Vector&             x_;
+  const Vector*             y_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+const idx_t  StdVectorSpace::DotWork_::BLOCK_SIZE = 2048;
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline StdVectorSpace::DotWork_::DotWork_
+
+  ( const Vector&  x,
+    const Vector*  y ) :
+
+    x_ ( x ),
+    y_ ( y )
+
+{
+  const idx_t  n = x.size ();
+
+  partials.resize ( (n + BLOCK_SIZE - 1) / BLOCK_SIZE );
+}
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+void StdVectorSpace::DotWork_::run
+
+  ( idx_t  first,
+    idx_t  last )
+
+{
+  for ( idx_t ib = first; ib < last; ib++ )
+  {
+    partials[ib] = blockDot ( x_, y_, ib );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   sum
+//-----------------------------------------------------------------------
+
+
+inline double StdVectorSpace::DotWork_::sum () const
+{
+  const idx_t  m = partials.size ();
+
+  double       s = 0.0;
+
+  for ( idx_t i = 0; i < m; i++ )
+  {
+    s += partials[i];
+  }
+
+  return s;
+}
+
+
+//-----------------------------------------------------------------------
+//   blockDot
+//-----------------------------------------------------------------------
+
+
+inline double StdVectorSpace::DotWork_::blockDot
+
+  ( const Vector&  x,
+    const Vector*  y,
+    idx_t          ib )
+
+{
+  const idx_t  i = ib * BLOCK_SIZE;
+  const idx_t  j = jem::min ( i + BLOCK_SIZE, x.size() );
+
+  if ( y )
+  {
+    return dot ( x[slice(i,j)], (*y)[slice(i,j)] );
+  }
+  else
+  {
+    return dot ( x[slice(i,j)] );
+  }
+}
 
 
 //=======================================================================
@@ -130,7 +276,17 @@ double StdVectorSpace::norm2 ( const Vector& x ) const
 {
   JEM_ASSERT2 ( x.size() == this->size(), "Array has wrong size" );
 
-  return jem::numeric::norm2 ( x );
+  // Both branches compute the square root of the sum of squares;
+  // the second one sums the squares in blocks.
+
+  if ( x.size() <= DotWork_::BLOCK_SIZE )
+  {
+    return jem::numeric::norm2 ( x );
+  }
+  else
+  {
+    return std::sqrt ( dot_( x, nullptr ) );
+  }
 }
 
 
@@ -148,7 +304,7 @@ double StdVectorSpace::product
   JEM_ASSERT2   ( x.size() == this->size(), "Array has wrong size" );
   JEM_PRECHECK2 ( x.size() == y    .size(), "Array size mismatch" );
 
-  return dot ( x, y );
+  return dot_ ( x, &y );
 }
 
 
@@ -229,4 +385,61 @@ DofSpace* StdVectorSpace::getDofSpace () const
 }
 
 
+//-----------------------------------------------------------------------
+//   dot_
+//-----------------------------------------------------------------------
+
+
+double StdVectorSpace::dot_
+
+  ( const Vector&  x,
+    const Vector*  y )
+
+{
+  const idx_t      n = x.size ();
+
+  Ref<ThreadTeam>  team;
+  double           s;
+
+
+  // A single block is summed directly; this is also what the
+  // blocked summation below amounts to.
+
+  if ( n <= DotWork_::BLOCK_SIZE )
+  {
+    if ( y )
+    {
+      return dot ( x, *y );
+    }
+    else
+    {
+      return dot ( x );
+    }
+  }
+
+  team = ThreadTeam::getCurrent ();
+
+  if ( team && team->size() > 1 && n > 4 * DotWork_::BLOCK_SIZE )
+  {
+    DotWork_  work ( x, y );
+
+    team->execute ( work, work.partials.size() );
+
+    return work.sum ();
+  }
+
+  // Sum the blocks in the same order as DotWork_::sum(), but without
+  // allocating a buffer for the partial products.
+
+  s = 0.0;
+
+  for ( idx_t ib = 0; ib * DotWork_::BLOCK_SIZE < n; ib++ )
+  {
+    s += DotWork_::blockDot ( x, y, ib );
+  }
+
+  return s;
+}
+
+
 JIVE_END_PACKAGE( algebra )
@@ -37,6 +37,7 @@
 #include <jem/base/System.h>
 #include <jem/base/Signals.h>
 #include <jem/base/Throwable.h>
+#include <jem/base/ThreadTeam.h>
 #include <jem/base/StringBuffer.h>
 #include <jem/base/IllegalInputException.h>
 #include <jem/io/TermInput.h>
@@ -1051,14 +1052,27 @@ void Application::initGlobdat
     Ref<ProgramArgs>    args )
 
 {
+  using jem::ThreadTeam;
   using jem::util::Dict;
   using jive::util::Random;
   using jive::util::Runtime;
 
   Properties  params;
+  int         threads = 1;
 
   util::Globdat::init ( globdat );
 
+  // Create a team of threads that can be used by the numerical
+  // kernels within this process (or MPI rank).
+
+  props.find ( threads, PropNames::THREADS, 1, 1024 );
+  conf .set  ( PropNames::THREADS, threads );
+
+  if ( threads > 1 )
+  {
+    ThreadTeam::setCurrent ( newInstance<ThreadTeam>( threads ) );
+  }
+
   if ( props.find( params, PropNames::PARAMS ) )
   {
     mergeAndReplace ( conf.makeProps( PropNames::PARAMS ),
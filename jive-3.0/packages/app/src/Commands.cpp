@@ -58,6 +58,7 @@ const char*  Commands::LIST      = "list";
 const char*  Commands::HELP      = "help";
 const char*  Commands::REHASH    = "rehash";
 const char*  Commands::DUMP      = "dump";
+const char*  Commands::MEM_STATS = "mem-stats";
 
 
 JIVE_END_PACKAGE( app )
@@ -31,6 +31,8 @@
 
 
 #include <jem/base/System.h>
+#include <jem/base/MemCache.h>
+#include <jem/base/MemStats.h>
 #include <jem/base/ClassTemplate.h>
 #include <jem/base/IllegalInputException.h>
 #include <jem/io/list.h>
@@ -492,16 +494,23 @@ bool InfoModule::takeAction
     params.get ( cmd, ActionParams::COMMAND );
     params.get ( arg, ActionParams::COMMAND_ARG );
 
-    if ( cmd == Commands::LIST )
+    if      ( cmd == Commands::LIST )
     {
       exeListCmd_ ( arg, globdat );
 
+      result = true;
+    }
+    else if ( cmd == Commands::MEM_STATS )
+    {
+      exeMemStatsCmd_ ( arg, globdat );
+
       result = true;
     }
   }
   else if ( action == Actions::GET_COMMANDS )
   {
     params.set ( Commands::LIST, "item-sets groups tables dbases" );
+    params.set ( Commands::MEM_STATS, "on off threads" );
 
     result = true;
   }
@@ -539,6 +548,19 @@ void InfoModule::printHelp ( PrintWriter& out ) const
   print ( out,   "<pattern> are printed. Else, all names are " );
   print ( out,   "printed." );
   print ( out, endItem );
+
+  print ( out, beginItem( "mem-stats [on|off|threads]" ) );
+  print ( out,   "Print the memory allocation statistics of " );
+  print ( out,   "this process. The arguments `on\' and `off\' " );
+  print ( out,   "enable and disable the collection of these " );
+  print ( out,   "statistics, and the argument `threads\' " );
+  print ( out,   "prints the statistics of each thread before " );
+  print ( out,   "the totals for all threads. As memory may be " );
+  print ( out,   "released by another thread, the bytes in use " );
+  print ( out,   "of a single thread are only indicative. The " );
+  print ( out,   "statistics can also be enabled by setting the " );
+  print ( out,   "environment variable JEM_MEM_PROFILE to 1." );
+  print ( out, endItem );
 }
 
 
@@ -576,6 +598,40 @@ void InfoModule::printSummary
 }
 
 
+//-----------------------------------------------------------------------
+//   printMemStats
+//-----------------------------------------------------------------------
+
+
+void InfoModule::printMemStats
+
+  ( PrintWriter&  out,
+    bool          perThread )
+
+{
+  using jem::MemCache;
+  using jem::MemStats;
+
+  if ( ! MemCache::isProfiling() )
+  {
+    print ( out, "Memory profiling is disabled.", endl );
+    return;
+  }
+
+  if ( perThread )
+  {
+    jem::Array<MemStats>  list = MemStats::getThreads ();
+
+    for ( idx_t i = 0; i < list.size(); i++ )
+    {
+      list[i].printTo ( out );
+    }
+  }
+
+  MemStats::getTotal().printTo ( out );
+}
+
+
 //-----------------------------------------------------------------------
 //   makeNew
 //-----------------------------------------------------------------------
@@ -750,4 +806,49 @@ void InfoModule::exeListCmd_
 }
 
 
+//-----------------------------------------------------------------------
+//   exeMemStatsCmd_
+//-----------------------------------------------------------------------
+
+
+void InfoModule::exeMemStatsCmd_
+
+  ( const String&      arg,
+    const Properties&  globdat )
+
+{
+  using jem::IllegalInputException;
+  using jem::MemCache;
+
+  const String  what = arg.stripWhite ();
+
+  Ref<PrintWriter>  pr =
+
+    newInstance<PrintWriter> ( & System::out() );
+
+
+  if      ( what == "on" )
+  {
+    MemCache::setProfiling ( true );
+  }
+  else if ( what == "off" )
+  {
+    MemCache::setProfiling ( false );
+  }
+  else if ( what.size() == 0 || what == "threads" )
+  {
+    print ( *pr, endl );
+    printMemStats ( *pr, what.size() > 0 );
+    print ( *pr, flush );
+  }
+  else
+  {
+    throw IllegalInputException (
+      getContext (),
+      "invalid argument: " + what
+    );
+  }
+}
+
+
 JIVE_END_PACKAGE( app )
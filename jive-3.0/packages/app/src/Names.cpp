@@ -51,6 +51,7 @@ const char*  RunvarNames::RUNTIME        = "runtime";
 
 
 const char*  PropertyNames::APPEND       = "append";
+const char*  PropertyNames::ASYNC        = "async";
 const char*  PropertyNames::BACKUPS      = "backups";
 const char*  PropertyNames::BUFSIZE      = "bufsize";
 const char*  PropertyNames::CMD_FILE     = "cmdFile";
@@ -85,6 +86,7 @@ const char*  PropertyNames::SEPARATOR    = "separator";
 const char*  PropertyNames::SYNC         = "sync";
 const char*  PropertyNames::TABLES       = "tables";
 const char*  PropertyNames::TEMP         = "temp";
+const char*  PropertyNames::THREADS      = "threads";
 const char*  PropertyNames::VECTORS      = "vectors";
 
 
@@ -43,6 +43,7 @@
 #include <jem/io/utilities.h>
 #include <jem/io/IOException.h>
 #include <jem/io/FileOutputStream.h>
+#include <jem/io/AsyncOutputStream.h>
 #include <jem/io/GzipOutputStream.h>
 #include <jem/mp/utilities.h>
 #include <jem/mp/GatherPrinter.h>
@@ -260,7 +261,8 @@ class OutputModule::RunData_ : public jem::Collectable
       OpenFlags               flags,
       int                     prec,
       int                     width,
-      idx_t                   bufsize );
+      idx_t                   bufsize,
+      bool                    async );
 
   inline bool               isOpen      () const;
   inline void               flushFile   ();
@@ -363,11 +365,13 @@ void OutputModule::RunData_::openFile
     OpenFlags      flags,
     int            prec,
     int            width,
-    idx_t          bufsize )
+    idx_t          bufsize,
+    bool           async )
 
 {
   using jem::io::NumberFormat;
   using jem::io::OutputStream;
+  using jem::io::AsyncOutputStream;
   using jem::io::FileOutputStream;
   using jem::io::GzipOutputStream;
 
@@ -402,6 +406,14 @@ void OutputModule::RunData_::openFile
       {
         out = newInstance<GzipOutputStream> ( out );
       }
+
+      // Note that the compression is also done by the writer
+      // thread of the asynchronous output stream.
+
+      if ( async )
+      {
+        out = newInstance<AsyncOutputStream> ( out );
+      }
     }
 
     output_ = GatherPrinter::open ( 0, mpContext, out, bufsize );
@@ -908,6 +920,7 @@ OutputModule::OutputModule
   precision_ = 6;
   pageWidth_ = 200;
   bufsize_   = -1_idx;
+  async_     = false;
   saveCond_  = FuncUtils::newCond ();
 }
 
@@ -995,7 +1008,8 @@ Module::Status OutputModule::run ( const Properties& globdat )
 
     String  fname = StringUtils::expand ( fileName_, d.istep );
 
-    d.openFile ( fname, fflags_, precision_, pageWidth_, bufsize_ );
+    d.openFile ( fname, fflags_, precision_,
+                 pageWidth_, bufsize_, async_ );
 
     if ( todo & SAVE_VECTORS )
     {
@@ -1061,6 +1075,7 @@ void OutputModule::configure
   myProps.find ( append,   PropNames::APPEND  );
   myProps.find ( fname,    PropNames::FILE    );
   myProps.find ( bufsize_, PropNames::BUFSIZE );
+  myProps.find ( async_,   PropNames::ASYNC   );
 
   flags = 0;
 
@@ -1182,6 +1197,7 @@ void OutputModule::getConfig
   myConf.set ( PropNames::PRECISION,  precision_ );
   myConf.set ( PropNames::PAGE_WIDTH, pageWidth_ );
   myConf.set ( PropNames::BUFSIZE,    bufsize_   );
+  myConf.set ( PropNames::ASYNC,      async_     );
 
   if ( vecSpecs_ )
   {
@@ -0,0 +1,177 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+
+/************************************************************************
+ *
+ *  This example converts a text data file into the binary format that
+ *  is read by the BinaryDataReader class. The converted file can be
+ *  specified as the input file of the InputModule and MPInputModule
+ *  classes; it is memory-mapped and read without parsing. Data bases
+ *  and functions can not be stored in binary form and are skipped.
+ *
+ *  The binary reader does not support <Part> blocks. If the input file
+ *  contains such blocks, the maximum number of parts must be specified
+ *  with the -p option; the part-scoped IDs are then expanded before
+ *  the data are written.
+ *
+ *  Usage: dataconv [-p <max parts>] <input file> [<output file>]
+ *
+ ***********************************************************************/
+
+#include <jem/base/System.h>
+#include <jem/base/Integer.h>
+#include <jem/io/FileName.h>
+#include <jem/util/Timer.h>
+#include <jem/util/Properties.h>
+#include <jive/util/BinaryDataReader.h>
+#include <jive/util/BinaryDataWriter.h>
+#include <jive/fem/DataParser.h>
+#include <jive/fem/InputModule.h>
+
+
+using namespace jem;
+
+using jem::io::Writer;
+using jem::io::FileName;
+using jem::util::Timer;
+using jem::util::Properties;
+using jive::util::BinaryDataReader;
+using jive::util::BinaryDataWriter;
+using jive::fem::DataParser;
+using jive::fem::InputModule;
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+int run ( int argc, char** argv )
+{
+  const int              mask = InputModule::READ_ALL &
+    ~(InputModule::READ_DBASES | InputModule::READ_FUNCS);
+
+  Writer&                out  = System::out ();
+
+  Properties             globdat ( "data"  );
+  Properties             conf    ( "conf"  );
+  Properties             props   ( "props" );
+
+  Ref<DataParser>        parser;
+  Ref<BinaryDataWriter>  writer;
+
+  String                 inName;
+  String                 outName;
+
+  Timer                  timer;
+
+  lint                   maxParts = 0;
+  int                    iarg     = 1;
+
+
+  if ( argc > 1 && String( argv[1] ) == "-p" )
+  {
+    if ( argc < 3 || ! Integer::parse( maxParts, argv[2] ) ||
+         maxParts <= 0 )
+    {
+      print ( System::err(), "Invalid number of parts\n" );
+
+      return 1;
+    }
+
+    iarg += 2;
+  }
+
+  if ( argc - iarg < 1 || argc - iarg > 2 )
+  {
+    print ( System::err(), "Usage: ", argv[0],
+            " [-p <max parts>] <input file> [<output file>]\n" );
+
+    return 1;
+  }
+
+  inName = argv[iarg];
+
+  if ( argc - iarg > 1 )
+  {
+    outName = argv[iarg + 1];
+  }
+  else
+  {
+    idx_t  n = inName.size() - FileName::getSuffix( inName ).size();
+
+    outName = inName[slice(BEGIN,n)] + BinaryDataReader::FILE_EXTENSION;
+  }
+
+  InputModule::initData ( globdat,
+                          FileName::getBaseFileName( inName ),
+                          mask );
+
+  parser = newInstance<DataParser> ();
+
+  InputModule::initParser ( *parser, conf, props, globdat, mask );
+
+  parser->setMaxParts     ( (idx_t) maxParts );
+  parser->skipUnknownTags ( true );
+
+  timer.start ();
+
+  print ( out, "Parsing input file `", inName, "\' ...\n\n" );
+
+  parser->parseFile ( inName, &out );
+
+  print ( out, "\nReady in ", timer, "\n\n" );
+
+  timer.reset ();
+
+  print ( out, "Writing binary data to `", outName, "\' ...\n" );
+
+  writer = newInstance<BinaryDataWriter> ( outName );
+
+  writer->writeAll ( globdat );
+  writer->close    ();
+
+  print ( out, "Ready in ", timer, "\n\n" );
+
+  return 0;
+}
+
+
+//-----------------------------------------------------------------------
+//   main
+//-----------------------------------------------------------------------
+
+
+int main ( int argc, char** argv )
+{
+  return System::exec ( & run, argc, argv );
+}
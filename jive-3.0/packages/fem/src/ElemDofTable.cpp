@@ -0,0 +1,226 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+
+#include <jem/base/assert.h>
+#include <jem/base/ClassTemplate.h>
+#include <jem/util/Event.h>
+#include <jive/util/DofSpace.h>
+#include <jive/fem/ElemDofTable.h>
+
+
+JEM_DEFINE_CLASS( jive::fem::ElemDofTable );
+
+
+JIVE_BEGIN_PACKAGE( fem )
+
+
+//=======================================================================
+//   class ElemDofTable
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructors & destructor
+//-----------------------------------------------------------------------
+
+
+ElemDofTable::ElemDofTable
+
+  ( const ElementGroup&   group,
+    const Ref<DofSpace>&  dofs,
+    idx_t                 itype ) :
+
+    elemGroup_ ( group ),
+    dofs_      ( dofs ),
+    itypes_    ( 1 )
+
+{
+  JEM_PRECHECK ( group && dofs );
+
+  itypes_[0] = itype;
+
+  init_ ();
+}
+
+
+ElemDofTable::ElemDofTable
+
+  ( const ElementGroup&   group,
+    const Ref<DofSpace>&  dofs,
+    const IdxVector&      itypes ) :
+
+    elemGroup_ ( group ),
+    dofs_      ( dofs ),
+    itypes_    ( itypes.clone() )
+
+{
+  JEM_PRECHECK ( group && dofs );
+
+  init_ ();
+}
+
+
+ElemDofTable::~ElemDofTable ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   update
+//-----------------------------------------------------------------------
+
+// Call this function before accessing the table from multiple
+// threads, as the table is otherwise built on first access.
+
+void ElemDofTable::update ()
+{
+  if ( ! updated_ )
+  {
+    update_ ();
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   getOffsets
+//-----------------------------------------------------------------------
+
+
+IdxVector ElemDofTable::getOffsets () const
+{
+  if ( ! updated_ )
+  {
+    const_cast<Self*> ( this ) -> update_ ();
+  }
+
+  return offsets_;
+}
+
+
+//-----------------------------------------------------------------------
+//   getIndices
+//-----------------------------------------------------------------------
+
+
+IdxVector ElemDofTable::getIndices () const
+{
+  if ( ! updated_ )
+  {
+    const_cast<Self*> ( this ) -> update_ ();
+  }
+
+  return indices_;
+}
+
+
+//-----------------------------------------------------------------------
+//   init_
+//-----------------------------------------------------------------------
+
+
+void ElemDofTable::init_ ()
+{
+  using jem::util::connect;
+
+  ElementSet  elems = elemGroup_.getElements ();
+
+  connect ( dofs_->newSizeEvent,         this, & Self::invalidate_ );
+  connect ( dofs_->newOrderEvent,        this, & Self::invalidate_ );
+  connect ( elemGroup_.newSizeEvent  (), this, & Self::invalidate_ );
+  connect ( elemGroup_.newOrderEvent (), this, & Self::invalidate_ );
+  connect ( elems.newTopoEvent       (), this, & Self::invalidate_ );
+
+  updated_ = false;
+}
+
+
+//-----------------------------------------------------------------------
+//   invalidate_
+//-----------------------------------------------------------------------
+
+
+void ElemDofTable::invalidate_ ()
+{
+  updated_ = false;
+}
+
+
+//-----------------------------------------------------------------------
+//   update_
+//-----------------------------------------------------------------------
+
+
+void ElemDofTable::update_ ()
+{
+  ElementSet    elems     = elemGroup_.getElements ();
+  IdxVector     ielems    = elemGroup_.getIndices  ();
+
+  const idx_t   elemCount = ielems .size ();
+  const idx_t   typeCount = itypes_.size ();
+
+  IdxVector     offsets   ( elemCount + 1 );
+  IdxVector     indices;
+  IdxVector     inodes;
+
+  idx_t         i, n;
+
+
+  offsets[0] = 0;
+
+  for ( i = 0; i < elemCount; i++ )
+  {
+    offsets[i + 1] = offsets[i] +
+
+      typeCount * elems.getElemNodeCount ( ielems[i] );
+  }
+
+  indices.resize ( offsets[elemCount] );
+  inodes .resize ( elems.maxElemNodeCountOf( ielems ) );
+
+  for ( i = 0; i < elemCount; i++ )
+  {
+    n = elems.getElemNodes ( inodes, ielems[i] );
+
+    dofs_->getDofIndices ( indices[slice(offsets[i],offsets[i + 1])],
+                           inodes[slice(BEGIN,n)], itypes_ );
+  }
+
+  offsets_.ref ( offsets );
+  indices_.ref ( indices );
+
+  updated_ = true;
+
+  elemGroup_ .resetEvents ();
+  elems      .getData()->resetEvents ();
+  dofs_     ->resetEvents ();
+}
+
+
+JIVE_END_PACKAGE( fem )
@@ -180,6 +180,12 @@ void ElementIterator::rewind ()
 
 bool ElementIterator::toNext ( VirtualElement& elem )
 {
+  if ( ! updated_ )
+  {
+    update_ ();
+    reset_  ();
+  }
+
   if ( inext_ >= iperm_.size() )
   {
     return false;
@@ -207,6 +213,112 @@ bool ElementIterator::toNext ( VirtualElement& elem )
 }
 
 
+//-----------------------------------------------------------------------
+//   toNextBlock
+//-----------------------------------------------------------------------
+
+
+idx_t ElementIterator::toNextBlock
+
+  ( const IdxVector&   ielems,
+    Ref<geom::Shape>&  shape )
+
+{
+  const idx_t  maxCount = ielems.size ();
+
+  idx_t        count    = 0;
+  idx_t        jpos;
+
+
+  if ( ! updated_ )
+  {
+    update_ ();
+    reset_  ();
+  }
+
+  // On return, ipos points to the last element in the block, just
+  // like after a call to toNext().
+
+  while ( inext_ < iperm_.size() && count < maxCount )
+  {
+    jpos = iperm_[inext_];
+
+    if ( jpos < 0 )
+    {
+      if ( count > 0 )
+      {
+        break;
+      }
+
+      jpos = -jpos - 1;
+    }
+
+    if ( count == 0 )
+    {
+      shape = shapes_[shapeMap_[jpos]];
+    }
+
+    ipos            = jpos;
+    ielems[count++] = ielems_[jpos];
+
+    inext_++;
+  }
+
+  return count;
+}
+
+
+//-----------------------------------------------------------------------
+//   getBlockCoords
+//-----------------------------------------------------------------------
+
+
+void ElementIterator::getBlockCoords
+
+  ( const Cubix&      coords,
+    const IdxVector&  ielems ) const
+
+{
+  const ElementSet  elems     = getElements ();
+  const NodeSet     nodes     = elems.getNodes ();
+
+  const idx_t       count     = ielems.size   ();
+  const idx_t       rank      = coords.size (1);
+  const idx_t       nodeCount = coords.size (2);
+
+  JEM_PRECHECK2 ( coords.size(0) >= count &&
+                  rank           == nodes.rank(),
+                  "Array shape mismatch" );
+
+  IdxVector         inodes    ( nodeCount );
+  Matrix            xnodes    ( rank, nodeCount );
+
+
+  for ( idx_t k = 0; k < count; k++ )
+  {
+    if ( elems.getElemNodes( inodes, ielems[k] ) != nodeCount )
+    {
+      throw jem::RuntimeException (
+        context_,
+        String::format (
+          "element %d has an invalid number of nodes", ielems[k]
+        )
+      );
+    }
+
+    nodes.getSomeCoords ( xnodes, inodes );
+
+    for ( idx_t j = 0; j < nodeCount; j++ )
+    {
+      for ( idx_t i = 0; i < rank; i++ )
+      {
+        coords(k,i,j) = xnodes(i,j);
+      }
+    }
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   checkShapes
 //-----------------------------------------------------------------------
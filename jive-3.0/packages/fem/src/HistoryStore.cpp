@@ -0,0 +1,178 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+
+#include <jem/base/assert.h>
+#include <jem/base/ClassTemplate.h>
+#include <jem/base/array/operators.h>
+#include <jem/base/array/utilities.h>
+#include <jem/io/ObjectInput.h>
+#include <jem/io/ObjectOutput.h>
+#include <jive/fem/HistoryStore.h>
+
+
+JEM_DEFINE_SERIABLE_CLASS( jive::fem::HistoryStore );
+
+
+JIVE_BEGIN_PACKAGE( fem )
+
+
+//=======================================================================
+//   class HistoryStore
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructors & destructor
+//-----------------------------------------------------------------------
+
+
+HistoryStore::HistoryStore () :
+
+  offsets_ ( 1 )
+
+{
+  offsets_[0] = 0;
+
+  init_ ( 0 );
+}
+
+
+HistoryStore::HistoryStore
+
+  ( idx_t  varCount,
+    idx_t  elemCount,
+    idx_t  pointCount ) :
+
+    offsets_ ( elemCount + 1 )
+
+{
+  JEM_PRECHECK2 ( varCount   >= 0 &&
+                  elemCount  >= 0 &&
+                  pointCount >= 0,
+                  "invalid history store dimensions" );
+
+  for ( idx_t i = 0; i <= elemCount; i++ )
+  {
+    offsets_[i] = i * pointCount;
+  }
+
+  init_ ( varCount );
+}
+
+
+HistoryStore::HistoryStore
+
+  ( idx_t             varCount,
+    const IdxVector&  pointCounts ) :
+
+    offsets_ ( pointCounts.size() + 1 )
+
+{
+  JEM_PRECHECK2 ( varCount >= 0 &&
+                  jem::testall( pointCounts >= 0_idx ),
+                  "invalid history store dimensions" );
+
+  const idx_t  elemCount = pointCounts.size ();
+
+  offsets_[0] = 0;
+
+  for ( idx_t i = 0; i < elemCount; i++ )
+  {
+    offsets_[i + 1] = offsets_[i] + pointCounts[i];
+  }
+
+  init_ ( varCount );
+}
+
+
+HistoryStore::~HistoryStore ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   readFrom
+//-----------------------------------------------------------------------
+
+
+void HistoryStore::readFrom ( ObjectInput& in )
+{
+  decode ( in, offsets_, values_[0] );
+
+  values_[1].ref ( values_[0].clone() );
+
+  inew_ = 1;
+}
+
+
+//-----------------------------------------------------------------------
+//   writeTo
+//-----------------------------------------------------------------------
+
+// Only the old values are written, as these define the converged
+// state. Both buffers are contiguous, so they are written in one go.
+
+void HistoryStore::writeTo ( ObjectOutput& out ) const
+{
+  encode ( out, offsets_, values_[1 - inew_] );
+}
+
+
+//-----------------------------------------------------------------------
+//   setToZero
+//-----------------------------------------------------------------------
+
+
+void HistoryStore::setToZero ()
+{
+  values_[0] = 0.0;
+  values_[1] = 0.0;
+}
+
+
+//-----------------------------------------------------------------------
+//   init_
+//-----------------------------------------------------------------------
+
+
+void HistoryStore::init_ ( idx_t varCount )
+{
+  const idx_t  pointCount = offsets_[offsets_.size() - 1];
+
+  values_[0].resize ( pointCount, varCount );
+  values_[1].resize ( pointCount, varCount );
+
+  values_[0] = 0.0;
+  values_[1] = 0.0;
+  inew_      = 0;
+}
+
+
+JIVE_END_PACKAGE( fem )
@@ -38,6 +38,7 @@
 #include <jive/util/utilities.h>
 #include <jive/util/Assignable.h>
 #include <jive/util/ParserActions.h>
+#include <jive/util/BinaryDataReader.h>
 #include <jive/mp/Globdat.h>
 #include <jive/app/ModuleFactory.h>
 #include <jive/fem/typedefs.h>
@@ -47,6 +48,7 @@
 #include <jive/fem/XNodeSet.h>
 #include <jive/fem/XElementSet.h>
 #include <jive/fem/XBoundarySet.h>
+#include <jive/fem/utilities.h>
 #include <jive/fem/InputModule.h>
 
 
@@ -61,6 +63,7 @@ using jem::System;
 using jem::io::Writer;
 using jem::io::IOException;
 using jive::util::StorageMode;
+using jive::util::BinaryDataReader;
 
 
 //=======================================================================
@@ -138,12 +141,11 @@ Module::Status InputModule::init
 
   StorageMode       smode   = util::DEFAULT_STORAGE;
 
-  Ref<DataParser>   parser;
-
   String            fname;
   String            baseName;
 
   idx_t             maxParts;
+  bool              reorder;
   int               mask;
 
 
@@ -156,12 +158,15 @@ Module::Status InputModule::init
   }
 
   maxParts = 0;
+  reorder  = false;
 
   myProps.find ( fname,    PropNames::FILE );
   myProps.find ( maxParts, PropNames::MAX_PARTS, 0, 10000 );
+  myProps.find ( reorder,  PropNames::REORDER );
 
   myConf.set ( PropNames::FILE,      fname    );
   myConf.set ( PropNames::MAX_PARTS, maxParts );
+  myConf.set ( PropNames::REORDER,   reorder  );
 
   fname = util::expandString ( fname, globdat );
   mask  = readMask_;
@@ -182,36 +187,88 @@ Module::Status InputModule::init
     return DONE;
   }
 
-  parser = newInstance<DataParser> ( mpx );
+  if ( BinaryDataReader::isBinaryFile( fname ) )
+  {
+    // Binary files are mapped directly by each process; there is
+    // no need to parse and broadcast them.
 
-  initParser_ ( *parser, myConf, myProps, globdat, mask );
+    Ref<BinaryDataReader>  reader =
 
-  parser->setMaxParts     ( maxParts );
-  parser->skipUnknownTags ( true     );
+      newInstance<BinaryDataReader> ();
 
-  if ( mpSize > 1 )
-  {
-    Properties  params ( "parserParams" );
+    initReader ( *reader, myConf, myProps, globdat, mask );
 
-    params.set         ( ParserOptions::SKIP_UNKNOWN, true   );
-    parser->takeAction ( ParserActions::SET_OPTIONS,  params );
-  }
+    reader->skipUnknownItems ( mpSize > 1 );
 
-  print ( System::out(),
-          "Reading data from `", fname, "\' ...\n\n" );
+    if ( maxParts > 0 )
+    {
+      print ( System::warn(), myName_, " : property `",
+              PropNames::MAX_PARTS, "\' is ignored for binary file `",
+              fname, "\'; specify it when converting the file\n\n" );
+    }
 
-  try
-  {
-    parser->parseFile ( fname, &info );
+    print ( System::out(),
+            "Reading binary data from `", fname, "\' ...\n\n" );
+
+    try
+    {
+      reader->readFile ( fname, &info );
+    }
+    catch ( IOException& ex )
+    {
+      ex.setContext ( getContext() );
+      throw;
+    }
   }
-  catch ( IOException& ex )
+  else
   {
-    ex.setContext ( getContext() );
-    throw;
+    Ref<DataParser>  parser = newInstance<DataParser> ( mpx );
+
+
+    initParser_ ( *parser, myConf, myProps, globdat, mask );
+
+    parser->setMaxParts     ( maxParts );
+    parser->skipUnknownTags ( true     );
+
+    if ( mpSize > 1 )
+    {
+      Properties  params ( "parserParams" );
+
+      params.set         ( ParserOptions::SKIP_UNKNOWN, true   );
+      parser->takeAction ( ParserActions::SET_OPTIONS,  params );
+    }
+
+    print ( System::out(),
+            "Reading data from `", fname, "\' ...\n\n" );
+
+    try
+    {
+      parser->parseFile ( fname, &info );
+    }
+    catch ( IOException& ex )
+    {
+      ex.setContext ( getContext() );
+      throw;
+    }
   }
 
   print ( info, '\n' );
 
+  if ( reorder && (mask & READ_NODES) )
+  {
+    XNodeSet     nodes = XNodeSet::find ( globdat );
+    XElementSet  elems = (mask & READ_ELEMS) ?
+
+      XElementSet::find ( globdat ) : XElementSet ();
+
+    if ( nodes )
+    {
+      print ( System::out(), "Reordering nodes and elements ...\n\n" );
+
+      reorderMesh ( nodes, elems );
+    }
+  }
+
   return DONE;
 }
 
@@ -360,6 +417,62 @@ void InputModule::initParser
 }
 
 
+//-----------------------------------------------------------------------
+//   initReader
+//-----------------------------------------------------------------------
+
+
+void InputModule::initReader
+
+  ( BinaryDataReader&  reader,
+    const Properties&  conf,
+    const Properties&  props,
+    const Properties&  globdat,
+    int                mask )
+
+{
+  XNodeSet      nodes  = XNodeSet     :: find ( globdat );
+  XElementSet   elems  = XElementSet  :: find ( globdat );
+  XBoundarySet  bounds = XBoundarySet :: find ( globdat );
+
+
+  if ( (mask & READ_NODES) && nodes )
+  {
+    reader.addPointSet ( nodes.getData() );
+  }
+
+  if ( (mask & READ_ELEMS) && elems )
+  {
+    reader.addGroupSet ( elems.getData() );
+  }
+
+  if ( (mask & READ_BOUNDS) && bounds )
+  {
+    reader.addMemberSet ( bounds.getData() );
+  }
+
+  if ( mask & READ_CONS )
+  {
+    reader.addConstraints ( globdat );
+  }
+
+  if ( mask & READ_GROUPS )
+  {
+    reader.addItemGroups ( globdat );
+  }
+
+  if ( mask & READ_TABLES )
+  {
+    String  filter = "*";
+
+    props.find ( filter, PropNames::TABLE_FILTER );
+    conf .set  ( PropNames::TABLE_FILTER, filter );
+
+    reader.addTables ( globdat, filter );
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   makeNew
 //-----------------------------------------------------------------------
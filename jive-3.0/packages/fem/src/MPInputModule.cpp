@@ -42,6 +42,7 @@
 #include <jive/util/StorageMode.h>
 #include <jive/util/Assignable.h>
 #include <jive/util/ConstraintsParser.h>
+#include <jive/util/BinaryDataReader.h>
 #include <jive/app/ModuleFactory.h>
 #include <jive/mp/Globdat.h>
 #include <jive/fem/typedefs.h>
@@ -208,6 +209,7 @@ void MPInputModule::readMesh_
   using jive::util::joinNames;
   using jive::util::getStorageMode;
   using jive::util::ConParser;
+  using jive::util::BinaryDataReader;
   using jive::util::StorageMode;
   using jive::util::Assignable;
 
@@ -229,7 +231,6 @@ void MPInputModule::readMesh_
 
   StorageMode      smode   = util::DEFAULT_STORAGE;
 
-  Ref<DataParser>  parser;
   String           fname;
   String           baseName;
 
@@ -296,28 +297,64 @@ void MPInputModule::readMesh_
   elemConParser = newInstance<ConParser> ( elems.getData (),
                                            elemGroups );
 
-  parser = newInstance<DataParser> ();
-
-  parser->addNodesParser       ( nodes );
-  parser->addElementsParser    ( elems );
-  parser->addItemGroupsParser  ( nodes.getData(), nodeGroups );
-  parser->addItemGroupsParser  ( elems.getData(), elemGroups );
-  parser->addConstraintsParser ( nodeConParser );
-  parser->addConstraintsParser ( elemConParser );
-  parser->setMaxParts          ( maxParts );
-  parser->skipUnknownTags      ( true );
-
-  print ( System::out(),
-          "Reading mesh from `", fname, "\' ...\n\n" );
-
-  try
+  if ( BinaryDataReader::isBinaryFile( fname ) )
   {
-    parser->parseFile ( fname, &info );
+    Ref<BinaryDataReader>  reader =
+
+      newInstance<BinaryDataReader> ();
+
+    reader->addPointSet    ( nodes.getData() );
+    reader->addGroupSet    ( elems.getData() );
+    reader->addItemGroups  ( nodes.getData(), nodeGroups );
+    reader->addItemGroups  ( elems.getData(), elemGroups );
+    reader->addConstraints ( nodeConParser );
+    reader->addConstraints ( elemConParser );
+
+    if ( maxParts > 0 )
+    {
+      print ( System::warn(), myName_, " : property `",
+              PropNames::MAX_PARTS, "\' is ignored for binary file `",
+              fname, "\'; specify it when converting the file\n\n" );
+    }
+
+    print ( System::out(),
+            "Reading binary mesh from `", fname, "\' ...\n\n" );
+
+    try
+    {
+      reader->readFile ( fname, &info );
+    }
+    catch ( IOException& ex )
+    {
+      ex.setContext ( getContext() );
+      throw;
+    }
   }
-  catch ( IOException& ex )
+  else
   {
-    ex.setContext ( getContext() );
-    throw;
+    Ref<DataParser>  parser = newInstance<DataParser> ();
+
+    parser->addNodesParser       ( nodes );
+    parser->addElementsParser    ( elems );
+    parser->addItemGroupsParser  ( nodes.getData(), nodeGroups );
+    parser->addItemGroupsParser  ( elems.getData(), elemGroups );
+    parser->addConstraintsParser ( nodeConParser );
+    parser->addConstraintsParser ( elemConParser );
+    parser->setMaxParts          ( maxParts );
+    parser->skipUnknownTags      ( true );
+
+    print ( System::out(),
+            "Reading mesh from `", fname, "\' ...\n\n" );
+
+    try
+    {
+      parser->parseFile ( fname, &info );
+    }
+    catch ( IOException& ex )
+    {
+      ex.setContext ( getContext() );
+      throw;
+    }
   }
 
   print ( info, '\n' );
@@ -0,0 +1,254 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+
+#include <jem/base/assert.h>
+#include <jem/base/array/utilities.h>
+#include <jive/util/Reordering.h>
+#include <jive/fem/XNodeSet.h>
+#include <jive/fem/XElementSet.h>
+#include <jive/fem/utilities.h>
+
+
+JIVE_BEGIN_PACKAGE( fem )
+
+
+using jem::lint;
+
+
+//-----------------------------------------------------------------------
+//   getCurveOrder
+//-----------------------------------------------------------------------
+
+// Returns the permutation that visits the points stored in the columns
+// of a coordinate matrix in the order of a Hilbert curve through their
+// bounding box. The keys are computed with the transposed Hilbert index
+// algorithm by J. Skilling.
+
+
+IdxVector             getCurveOrder
+
+  ( const Matrix&       coords )
+
+{
+  const idx_t  rank  = coords.size (0);
+  const idx_t  count = coords.size (1);
+
+  IdxVector    iperm ( jem::iarray( count ) );
+
+  if ( rank == 0 || count < 2 )
+  {
+    return iperm;
+  }
+
+  const int    bits  = (int) jem::min ( 20_idx, 62_idx / rank );
+  const lint   top   = ((lint) 1 << bits) - 1;
+
+  jem::Array<lint>  keys   ( count );
+  jem::Array<lint>  x      ( rank  );
+
+  Vector       xmin  ( rank );
+  Vector       scale ( rank );
+
+  lint         key, p, q, t;
+  idx_t        i, j;
+  int          b;
+
+
+  for ( i = 0; i < rank; i++ )
+  {
+    double  lo = coords(i,0);
+    double  hi = coords(i,0);
+
+    for ( j = 1; j < count; j++ )
+    {
+      lo = jem::min ( lo, coords(i,j) );
+      hi = jem::max ( hi, coords(i,j) );
+    }
+
+    xmin[i]  = lo;
+    scale[i] = 0.0;
+
+    if ( hi > lo )
+    {
+      scale[i] = (double) top / (hi - lo);
+    }
+  }
+
+  for ( j = 0; j < count; j++ )
+  {
+    for ( i = 0; i < rank; i++ )
+    {
+      x[i] = jem::min ( top, (lint)
+                        ((coords(i,j) - xmin[i]) * scale[i]) );
+    }
+
+    if ( rank > 1 )
+    {
+      // Undo the excess work of the inverse transform.
+
+      for ( q = (lint) 1 << (bits - 1); q > 1; q >>= 1 )
+      {
+        p = q - 1;
+
+        for ( i = 0; i < rank; i++ )
+        {
+          if ( x[i] & q )
+          {
+            x[0] ^= p;
+          }
+          else
+          {
+            t     = (x[0] ^ x[i]) & p;
+            x[0] ^= t;
+            x[i] ^= t;
+          }
+        }
+      }
+
+      // Gray encode.
+
+      for ( i = 1; i < rank; i++ )
+      {
+        x[i] ^= x[i - 1];
+      }
+
+      t = 0;
+
+      for ( q = (lint) 1 << (bits - 1); q > 1; q >>= 1 )
+      {
+        if ( x[rank - 1] & q )
+        {
+          t ^= q - 1;
+        }
+      }
+
+      for ( i = 0; i < rank; i++ )
+      {
+        x[i] ^= t;
+      }
+    }
+
+    // Interleave the transposed index into a single key.
+
+    key = 0;
+
+    for ( b = bits - 1; b >= 0; b-- )
+    {
+      for ( i = 0; i < rank; i++ )
+      {
+        key = (key << 1) | ((x[i] >> b) & 1);
+      }
+    }
+
+    keys[j] = key;
+  }
+
+  jem::sort ( iperm, keys );
+
+  return iperm;
+}
+
+
+//-----------------------------------------------------------------------
+//   reorderMesh
+//-----------------------------------------------------------------------
+
+
+void                  reorderMesh
+
+  ( const XNodeSet&     nodes,
+    const XElementSet&  elems )
+
+{
+  using jive::util::Reordering;
+
+  JEM_PRECHECK2 ( nodes, "invalid NodeSet" );
+  JEM_PRECHECK2 ( ! elems ||
+                  elems.getNodes().getData() == nodes.getData(),
+                  "ElementSet not attached to the given NodeSet" );
+
+  const idx_t  rank      = nodes.rank ();
+  const idx_t  nodeCount = nodes.size ();
+
+  Matrix       coords    ( rank, nodeCount );
+
+
+  nodes.getCoords    ( coords );
+  nodes.reorderNodes ( Reordering( getCurveOrder( coords ),
+                                   nodeCount ) );
+
+  if ( ! elems )
+  {
+    return;
+  }
+
+  const idx_t  elemCount = elems.size ();
+
+  IdxVector    inodes    ( elems.maxElemNodeCount() );
+  Matrix       centers   ( rank, elemCount );
+
+  idx_t        i, j, n;
+
+
+  nodes.getCoords ( coords );
+
+  centers = 0.0;
+
+  for ( idx_t ielem = 0; ielem < elemCount; ielem++ )
+  {
+    n = elems.getElemNodes ( inodes, ielem );
+
+    if ( n == 0 )
+    {
+      continue;
+    }
+
+    for ( j = 0; j < n; j++ )
+    {
+      for ( i = 0; i < rank; i++ )
+      {
+        centers(i,ielem) += coords(i,inodes[j]);
+      }
+    }
+
+    for ( i = 0; i < rank; i++ )
+    {
+      centers(i,ielem) /= (double) n;
+    }
+  }
+
+  elems.reorderElements ( Reordering( getCurveOrder( centers ),
+                                      elemCount ) );
+}
+
+
+JIVE_END_PACKAGE( fem )
@@ -49,6 +49,7 @@
 #include <jive/model/StateVector.h>
 #include <jive/fem/InternalElement.h>
 #include <jive/fem/ElementIterator.h>
+#include <jive/fem/ElemDofTable.h>
 #include <jive/femodel/Names.h>
 #include <jive/femodel/misc/declare.h>
 #include <jive/femodel/misc/TransportModel.h>
@@ -132,6 +133,9 @@ TransportModel::TransportModel
 
   dofs_->addDofs ( et.getNodeIndices(), dofType_ );
 
+  dofTable_ = newInstance<ElemDofTable> ( et.elemGroup,
+                                          dofs_, dofType_ );
+
   flowCols_ .resize ( rank );
   diffusion_.resize ( rank );
 
@@ -166,7 +170,9 @@ void TransportModel::readFrom ( ObjectInput& in )
            flowCols_,
            diffusion_ );
 
-  element_ = newInstance<IElement> ( elemIter_->getElements() );
+  element_  = newInstance<IElement>     ( elemIter_->getElements() );
+  dofTable_ = newInstance<ElemDofTable> ( elemIter_->elemGroup,
+                                          dofs_, dofType_ );
 }
 
 
@@ -406,13 +412,12 @@ void TransportModel::getIntVector_
       stateGrads.resize ( e.rank      );
       elemState .resize ( e.nodeCount );
       elemVec   .resize ( e.nodeCount );
-      idofs     .resize ( e.nodeCount );
 
       ipFlow = 0.0;
     }
 
-    dofs_->getDofIndices ( idofs, e.inodes, dofType_ );
-    e.getShapeGrads      ();
+    idofs.ref         ( dofTable_->getDofIndices( et.ipos ) );
+    e.getShapeGrads   ();
 
     if ( flow )
     {
@@ -487,13 +492,12 @@ void TransportModel::getMatrix0_
       ipFlow   .resize ( e.rank,      e.pntCount  );
       elemState.resize ( e.nodeCount );
       elemVec  .resize ( e.nodeCount );
-      idofs    .resize ( e.nodeCount );
 
       ipFlow = 0.0;
     }
 
-    dofs_->getDofIndices ( idofs, e.inodes, dofType_ );
-    e.getShapeGrads      ();
+    idofs.ref         ( dofTable_->getDofIndices( et.ipos ) );
+    e.getShapeGrads   ();
 
     elemMat(i,j) =
 
@@ -548,10 +552,9 @@ void TransportModel::getMatrix1_ ( MBuilder&  mbld ) const
     if ( e.newShape )
     {
       elemMat.resize ( e.nodeCount, e.nodeCount );
-      idofs  .resize ( e.nodeCount );
     }
 
-    dofs_->getDofIndices ( idofs, e.inodes, dofType_ );
+    idofs.ref ( dofTable_->getDofIndices( et.ipos ) );
 
     e.getShapeFuncs   ();
     e.getPointWeights ();
@@ -660,13 +663,12 @@ void TransportModel::getNodeFluxes_
       elemFlux  .resize ( e.nodeCount, e.rank );
       stateGrads.resize ( e.rank      );
       elemState .resize ( e.nodeCount );
-      idofs     .resize ( e.nodeCount );
 
       elemFlow = 0.0;
     }
 
-    dofs_->getDofIndices ( idofs, e.inodes, dofType_ );
-    e.getShapeGrads      ();
+    idofs.ref         ( dofTable_->getDofIndices( et.ipos ) );
+    e.getShapeGrads   ();
 
     if ( flow )
     {
@@ -45,6 +45,7 @@
 #include <jive/geom/StdShapeFactory.h>
 #include <jive/geom/ParametricVolume.h>
 #include <jive/geom/ParametricSurface.h>
+#include <jive/geom/FixedParametricShape.h>
 #include <jive/geom/Hexahedron.h>
 
 
@@ -627,20 +628,30 @@ Ref<IShape> Hexahedron8::getShape
   Ref<SShape>  xshape = newInstance<StdCube8> ();
   Ref<SShape>  sshape = sfuncs ? sfuncs : xshape;
 
-  return newInstance<ParametricVolume> (
+  ShapeBoundary  bnd = Utils_::getBoundary (
     name,
-    ischeme[0],
-    Utils_::getBoundary (
-      name,
-      & BoundaryQuad4::getShape,
-      & BoundaryQuad4::getShape,
-      ischeme[slice(1,END)],
-      getBoundaryTopology (),
-      sshape
-    ),
-    xshape,
+    & BoundaryQuad4::getShape,
+    & BoundaryQuad4::getShape,
+    ischeme[slice(1,END)],
+    getBoundaryTopology (),
     sshape
   );
+
+  // Use the fixed-size kernels for the common integration
+  // schemes.
+
+  if ( ! sfuncs )
+  {
+    if ( ischeme[0].size(1) == 8 )
+    {
+      return newInstance< FixedParametricShape<ParametricVolume,8,8> > (
+        name, ischeme[0], bnd, xshape, sshape
+      );
+    }
+  }
+
+  return newInstance<ParametricVolume> ( name, ischeme[0], bnd,
+                                         xshape, sshape );
 }
 
 
@@ -150,6 +150,65 @@ void InternalShape::getBoundaryCoords
 }
 
 
+//-----------------------------------------------------------------------
+//   getBlockGradients
+//-----------------------------------------------------------------------
+
+
+void InternalShape::getBlockGradients
+
+  ( const GradBlock&  g,
+    const Matrix&     w,
+    const Cubix&      c ) const
+
+{
+  const idx_t  blockSize = c.size(0);
+  const idx_t  rank      = c.size(1);
+  const idx_t  nodeCount = c.size(2);
+  const idx_t  funcCount = g.size(2);
+  const idx_t  ipCount   = g.size(3);
+
+  JEM_PRECHECK2 ( g.size(0) == blockSize &&
+                  g.size(1) == rank      &&
+                  w.size(0) == blockSize &&
+                  w.size(1) == ipCount,
+                  "Array shape mismatch" );
+
+  Matrix       xe ( rank, nodeCount );
+  Cubix        ge ( rank, funcCount, ipCount );
+  Vector       we ( ipCount );
+
+  idx_t        i, j, k, p;
+
+
+  for ( k = 0; k < blockSize; k++ )
+  {
+    for ( j = 0; j < nodeCount; j++ )
+    {
+      for ( i = 0; i < rank; i++ )
+      {
+        xe(i,j) = c(k,i,j);
+      }
+    }
+
+    getShapeGradients ( ge, we, xe );
+
+    for ( p = 0; p < ipCount; p++ )
+    {
+      w(k,p) = we[p];
+
+      for ( j = 0; j < funcCount; j++ )
+      {
+        for ( i = 0; i < rank; i++ )
+        {
+          g(k,i,j,p) = ge(i,j,p);
+        }
+      }
+    }
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   getNodeGradients
 //-----------------------------------------------------------------------
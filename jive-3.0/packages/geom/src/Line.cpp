@@ -49,6 +49,7 @@
 #include <jive/geom/BoundaryPoint.h>
 #include <jive/geom/IShapeFactory.h>
 #include <jive/geom/StdShapeFactory.h>
+#include <jive/geom/FixedParametricShape.h>
 #include <jive/geom/Line.h>
 
 
@@ -727,13 +728,31 @@ Ref<IShape> Line2::getShape
   Ref<SShape>  xshape = newInstance<StdLine2> ();
   Ref<SShape>  sshape = sfuncs ? sfuncs : xshape;
 
-  return newInstance<Line2Shape> (
-    name,
-    ischeme,
-    Utils_::getBoundary ( name, getBoundaryTopology(), sshape ),
-    xshape,
-    sshape
-  );
+  ShapeBoundary  bnd  =
+
+    Utils_::getBoundary ( name, getBoundaryTopology(), sshape );
+
+  // Use the fixed-size kernels for the common integration
+  // schemes.
+
+  if ( ! sfuncs )
+  {
+    if ( ischeme.size(1) == 1 )
+    {
+      return newInstance< FixedParametricShape<Line2Shape,2,1> > (
+        name, ischeme, bnd, xshape, sshape
+      );
+    }
+    else if ( ischeme.size(1) == 2 )
+    {
+      return newInstance< FixedParametricShape<Line2Shape,2,2> > (
+        name, ischeme, bnd, xshape, sshape
+      );
+    }
+  }
+
+  return newInstance<Line2Shape> ( name, ischeme, bnd,
+                                   xshape, sshape );
 }
 
 
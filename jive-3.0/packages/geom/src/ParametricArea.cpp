@@ -405,6 +405,138 @@ void ParametricArea::evalShapeGradGrads
 }
 
 
+//-----------------------------------------------------------------------
+//   getBlockGradients
+//-----------------------------------------------------------------------
+
+
+void ParametricArea::getBlockGradients
+
+  ( const GradBlock&  g,
+    const Matrix&     w,
+    const Cubix&      c ) const
+
+{
+  if ( ! (g.isContiguous() && w.isContiguous() && c.isContiguous()) )
+  {
+    Super::getBlockGradients ( g, w, c );
+
+    return;
+  }
+
+  const idx_t  bsize = c.size(0);
+
+  JEM_PRECHECK2 ( c.size(1) == RANK       &&
+                  c.size(2) == nodeCount_ &&
+                  g.size(0) == bsize      &&
+                  g.size(1) == RANK       &&
+                  g.size(2) == funcCount_ &&
+                  g.size(3) == ipCount_   &&
+                  w.size(0) == bsize      &&
+                  w.size(1) == ipCount_,
+                  "Array shape mismatch" );
+
+  updateGrads_ ( ipoints_ );
+
+  const Cubix&  xgrads = ipoints_.xgrads;
+  const Cubix&  sgrads = ipoints_.sgrads;
+
+  Matrix        jbuf   ( bsize, RANK * RANK );
+
+  double* JEM_RESTRICT  j00 = jbuf.addr ();
+  double* JEM_RESTRICT  j10 = j00 + bsize;
+  double* JEM_RESTRICT  j01 = j10 + bsize;
+  double* JEM_RESTRICT  j11 = j01 + bsize;
+
+  idx_t         k;
+
+
+  // The inner loops run over the elements in the block.
+
+  for ( idx_t ip = 0; ip < ipCount_; ip++ )
+  {
+    double* JEM_RESTRICT  wp = w.addr() + ip * bsize;
+
+JEM_IVDEP
+
+    for ( k = 0; k < bsize; k++ )
+    {
+      j00[k] = j10[k] = j01[k] = j11[k] = 0.0;
+    }
+
+    for ( idx_t j = 0; j < nodeCount_; j++ )
+    {
+      const double* JEM_RESTRICT  x0 = c.addr() + RANK * j * bsize;
+      const double* JEM_RESTRICT  x1 = x0 + bsize;
+
+      const double  a0 = xgrads(0,j,ip);
+      const double  a1 = xgrads(1,j,ip);
+
+JEM_IVDEP
+
+      for ( k = 0; k < bsize; k++ )
+      {
+        j00[k] += a0 * x0[k];
+        j10[k] += a1 * x0[k];
+        j01[k] += a0 * x1[k];
+        j11[k] += a1 * x1[k];
+      }
+    }
+
+JEM_IVDEP
+
+    for ( k = 0; k < bsize; k++ )
+    {
+      wp[k] = j00[k] * j11[k] - j01[k] * j10[k];
+    }
+
+    for ( k = 0; k < bsize; k++ )
+    {
+      if ( jem::isTiny( wp[k] ) )
+      {
+        singularMatrixError ( getContext(), "Jacobi" );
+      }
+    }
+
+    const double  wt = iweights_[ip];
+
+JEM_IVDEP
+
+    for ( k = 0; k < bsize; k++ )
+    {
+      double  s = 1.0 / wp[k];
+      double  t = j00[k];
+
+      j00[k] =  j11[k] * s;
+      j10[k] = -j10[k] * s;
+      j01[k] = -j01[k] * s;
+      j11[k] =  t      * s;
+      wp [k] =  wt * std::fabs( wp[k] );
+    }
+
+    for ( idx_t f = 0; f < funcCount_; f++ )
+    {
+      double* JEM_RESTRICT  g0 =
+
+        g.addr() + RANK * (f + funcCount_ * ip) * bsize;
+
+      double* JEM_RESTRICT  g1 = g0 + bsize;
+
+      const double  s0 = sgrads(0,f,ip);
+      const double  s1 = sgrads(1,f,ip);
+
+JEM_IVDEP
+
+      for ( k = 0; k < bsize; k++ )
+      {
+        g0[k] = j00[k] * s0 + j01[k] * s1;
+        g1[k] = j10[k] * s0 + j11[k] * s1;
+      }
+    }
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   calcGradients
 //-----------------------------------------------------------------------
@@ -406,6 +406,172 @@ void ParametricVolume::evalShapeGradGrads
 }
 
 
+//-----------------------------------------------------------------------
+//   getBlockGradients
+//-----------------------------------------------------------------------
+
+
+void ParametricVolume::getBlockGradients
+
+  ( const GradBlock&  g,
+    const Matrix&     w,
+    const Cubix&      c ) const
+
+{
+  if ( ! (g.isContiguous() && w.isContiguous() && c.isContiguous()) )
+  {
+    Super::getBlockGradients ( g, w, c );
+
+    return;
+  }
+
+  const idx_t  bsize = c.size(0);
+
+  JEM_PRECHECK2 ( c.size(1) == RANK       &&
+                  c.size(2) == nodeCount_ &&
+                  g.size(0) == bsize      &&
+                  g.size(1) == RANK       &&
+                  g.size(2) == funcCount_ &&
+                  g.size(3) == ipCount_   &&
+                  w.size(0) == bsize      &&
+                  w.size(1) == ipCount_,
+                  "Array shape mismatch" );
+
+  updateGrads_ ( ipoints_ );
+
+  const Cubix&  xgrads = ipoints_.xgrads;
+  const Cubix&  sgrads = ipoints_.sgrads;
+
+  // The Jacobi matrices and their inverses are stored column-wise;
+  // entry (i,j) starts at offset (i + j * RANK) * bsize.
+
+  Matrix        jbuf   ( bsize, 2 * RANK * RANK );
+
+  double* JEM_RESTRICT  ja = jbuf.addr ();
+  double* JEM_RESTRICT  jb = ja + RANK * RANK * bsize;
+
+  idx_t         i, k;
+
+
+  // The inner loops run over the elements in the block.
+
+  for ( idx_t ip = 0; ip < ipCount_; ip++ )
+  {
+    double* JEM_RESTRICT  wp = w.addr() + ip * bsize;
+
+JEM_IVDEP
+
+    for ( k = 0; k < RANK * RANK * bsize; k++ )
+    {
+      ja[k] = 0.0;
+    }
+
+    for ( idx_t j = 0; j < nodeCount_; j++ )
+    {
+      const double* JEM_RESTRICT  xp = c.addr() + RANK * j * bsize;
+
+      for ( i = 0; i < RANK; i++ )
+      {
+        const double  a = xgrads(i,j,ip);
+
+        double* JEM_RESTRICT  j0 = ja + i * bsize;
+        double* JEM_RESTRICT  j1 = j0 + RANK * bsize;
+        double* JEM_RESTRICT  j2 = j1 + RANK * bsize;
+
+JEM_IVDEP
+
+        for ( k = 0; k < bsize; k++ )
+        {
+          j0[k] += a * xp[k];
+          j1[k] += a * xp[k + bsize];
+          j2[k] += a * xp[k + 2 * bsize];
+        }
+      }
+    }
+
+JEM_IVDEP
+
+    for ( k = 0; k < bsize; k++ )
+    {
+      const double  m00 = ja[k];
+      const double  m10 = ja[k + 1 * bsize];
+      const double  m20 = ja[k + 2 * bsize];
+      const double  m01 = ja[k + 3 * bsize];
+      const double  m11 = ja[k + 4 * bsize];
+      const double  m21 = ja[k + 5 * bsize];
+      const double  m02 = ja[k + 6 * bsize];
+      const double  m12 = ja[k + 7 * bsize];
+      const double  m22 = ja[k + 8 * bsize];
+
+      jb[k]             = m11 * m22 - m12 * m21;
+      jb[k + 1 * bsize] = m12 * m20 - m10 * m22;
+      jb[k + 2 * bsize] = m10 * m21 - m11 * m20;
+      jb[k + 3 * bsize] = m02 * m21 - m01 * m22;
+      jb[k + 4 * bsize] = m00 * m22 - m02 * m20;
+      jb[k + 5 * bsize] = m01 * m20 - m00 * m21;
+      jb[k + 6 * bsize] = m01 * m12 - m02 * m11;
+      jb[k + 7 * bsize] = m02 * m10 - m00 * m12;
+      jb[k + 8 * bsize] = m00 * m11 - m01 * m10;
+
+      wp[k] = m00 * jb[k]             +
+              m01 * jb[k + 1 * bsize] +
+              m02 * jb[k + 2 * bsize];
+    }
+
+    for ( k = 0; k < bsize; k++ )
+    {
+      if ( jem::isTiny( wp[k] ) )
+      {
+        singularMatrixError ( getContext(), "Jacobi" );
+      }
+    }
+
+    const double  wt = iweights_[ip];
+
+JEM_IVDEP
+
+    for ( k = 0; k < bsize; k++ )
+    {
+      const double  s = 1.0 / wp[k];
+
+      for ( i = 0; i < RANK * RANK; i++ )
+      {
+        jb[k + i * bsize] *= s;
+      }
+
+      wp[k] = wt * std::fabs( wp[k] );
+    }
+
+    for ( idx_t f = 0; f < funcCount_; f++ )
+    {
+      double* JEM_RESTRICT  gp =
+
+        g.addr() + RANK * (f + funcCount_ * ip) * bsize;
+
+      const double  s0 = sgrads(0,f,ip);
+      const double  s1 = sgrads(1,f,ip);
+      const double  s2 = sgrads(2,f,ip);
+
+      for ( i = 0; i < RANK; i++ )
+      {
+        const double* JEM_RESTRICT  b0 = jb + i * bsize;
+        const double* JEM_RESTRICT  b1 = b0 + RANK * bsize;
+        const double* JEM_RESTRICT  b2 = b1 + RANK * bsize;
+
+        double* JEM_RESTRICT        gi = gp + i * bsize;
+
+JEM_IVDEP
+
+        for ( k = 0; k < bsize; k++ )
+        {
+          gi[k] = b0[k] * s0 + b1[k] * s1 + b2[k] * s2;
+        }
+      }
+    }
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   calcGradients
 //-----------------------------------------------------------------------
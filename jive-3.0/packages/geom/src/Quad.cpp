@@ -45,6 +45,7 @@
 #include <jive/geom/BoundaryLine.h>
 #include <jive/geom/IShapeFactory.h>
 #include <jive/geom/StdShapeFactory.h>
+#include <jive/geom/FixedParametricShape.h>
 #include <jive/geom/Quad.h>
 
 
@@ -643,19 +644,29 @@ Ref<IShape> Quad4::getShape
   Ref<SShape>  xshape = newInstance<StdSquare4> ();
   Ref<SShape>  sshape = sfuncs ? sfuncs : xshape;
 
-  return newInstance<ParametricArea> (
+  ShapeBoundary  bnd = Utils_::getBoundary (
     name,
-    ischeme[0],
-    Utils_::getBoundary (
-      name,
-      & BoundaryLine2::getShape,
-      ischeme[slice(1,END)],
-      getBoundaryTopology (),
-      sshape
-    ),
-    xshape,
+    & BoundaryLine2::getShape,
+    ischeme[slice(1,END)],
+    getBoundaryTopology (),
     sshape
   );
+
+  // Use the fixed-size kernels for the common integration
+  // schemes.
+
+  if ( ! sfuncs )
+  {
+    if ( ischeme[0].size(1) == 4 )
+    {
+      return newInstance< FixedParametricShape<ParametricArea,4,4> > (
+        name, ischeme[0], bnd, xshape, sshape
+      );
+    }
+  }
+
+  return newInstance<ParametricArea> ( name, ischeme[0], bnd,
+                                       xshape, sshape );
 }
 
 
@@ -45,6 +45,7 @@
 #include <jive/geom/BoundaryTriangle.h>
 #include <jive/geom/IShapeFactory.h>
 #include <jive/geom/StdShapeFactory.h>
+#include <jive/geom/FixedParametricShape.h>
 #include <jive/geom/Tetrahedron.h>
 
 
@@ -611,19 +612,35 @@ Ref<IShape> Tetrahedron4::getShape
   Ref<SShape>  xshape = newInstance<StdTetrahedron4> ();
   Ref<SShape>  sshape = sfuncs ? sfuncs : xshape;
 
-  return newInstance<ParametricVolume> (
+  ShapeBoundary  bnd = Utils_::getBoundary (
     name,
-    ischeme[0],
-    Utils_::getBoundary (
-      name,
-      & BoundaryTriangle3::getShape,
-      ischeme[slice(1,END)],
-      getBoundaryTopology (),
-      sshape
-    ),
-    xshape,
+    & BoundaryTriangle3::getShape,
+    ischeme[slice(1,END)],
+    getBoundaryTopology (),
     sshape
   );
+
+  // Use the fixed-size kernels for the common integration
+  // schemes.
+
+  if ( ! sfuncs )
+  {
+    if ( ischeme[0].size(1) == 1 )
+    {
+      return newInstance< FixedParametricShape<ParametricVolume,4,1> > (
+        name, ischeme[0], bnd, xshape, sshape
+      );
+    }
+    else if ( ischeme[0].size(1) == 4 )
+    {
+      return newInstance< FixedParametricShape<ParametricVolume,4,4> > (
+        name, ischeme[0], bnd, xshape, sshape
+      );
+    }
+  }
+
+  return newInstance<ParametricVolume> ( name, ischeme[0], bnd,
+                                         xshape, sshape );
 }
 
 
@@ -0,0 +1,1808 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+
+#include <cstring>
+#include <jem/pragmas.h>
+#include <jem/base/assert.h>
+#include <jem/base/limits.h>
+#include <jem/base/ThreadTeam.h>
+#include <jem/base/ClassTemplate.h>
+#include <jem/base/array/operators.h>
+#include <jem/base/array/utilities.h>
+#include <jem/io/ObjectInput.h>
+#include <jem/io/ObjectOutput.h>
+#include <jem/util/Flex.h>
+#include <jem/xutil/IListArray.h>
+#include <jive/geom/MaskMatrix.h>
+#include <jive/geom/BoxArray.h>
+#include <jive/geom/TreeBoxManager.h>
+
+
+JEM_DEFINE_SERIABLE_CLASS( jive::geom::TreeBoxManager );
+
+
+JIVE_BEGIN_PACKAGE( geom )
+
+
+using jem::newInstance;
+using jem::ThreadTeam;
+using jem::util::Flex;
+using jem::xutil::IListArray;
+
+
+//=======================================================================
+//   class TreeBoxManager::Tree_
+//=======================================================================
+
+/*
+  A bounding volume hierarchy stored in flat arrays. Node 0 is the
+  root. The two children of an internal node are stored next to each
+  other, at higher indices than their parent, so that the bounds of
+  all nodes can be recomputed in a single backward sweep. A leaf
+  node refers to a contiguous range in the box permutation array.
+
+  Empty boxes are stored at the end of the permutation array and are
+  not part of the hierarchy.
+*/
+
+
+class TreeBoxManager::Tree_
+{
+ public:
+
+  static const int        BIN_COUNT     = 16;
+  static const int        REBUILD_RATIO = 2;
+
+
+  explicit                Tree_
+
+    ( idx_t                 rank );
+
+  void                    clear       ();
+
+  void                    build
+
+    ( const BoxArray&       boxes,
+      idx_t                 leafSize );
+
+  bool                    refit
+
+    ( const BoxArray&       boxes );
+
+  inline idx_t            stackSize   () const;
+
+  void                    findBoxes
+
+    ( Flex<idx_t>&          list,
+      const double*         box,
+      const BoxArray&       boxes,
+      idx_t*                stack )      const;
+
+
+ public:
+
+  idx_t                   boxCount;
+
+
+ private:
+
+  idx_t                   split_
+
+    ( idx_t                 first,
+      idx_t                 last,
+      const BoxArray&       boxes,
+      const double*         centers );
+
+  void                    setBounds_
+
+    ( const BoxArray&       boxes );
+
+  double                  getCost_    () const;
+
+  inline double           getArea_
+
+    ( const double*         box )        const;
+
+  inline void             clearBox_
+
+    ( double*               box )        const;
+
+  inline void             growBox_
+
+    ( double*               box,
+      const double*         x )          const;
+
+  inline bool             overlap_
+
+    ( const double*         box,
+      const double*         x )          const;
+
+
+ private:
+
+  const idx_t             rank_;
+  const idx_t             rank2_;
+
+  IdxVector               perm_;
+  IdxVector               first_;
+  IdxVector               count_;
+  Vector                  bounds_;
+
+  idx_t                   nodeCount_;
+  idx_t                   treeSize_;
+  idx_t                   depth_;
+  double                  cost_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+TreeBoxManager::Tree_::Tree_ ( idx_t rank ) :
+
+  rank_  ( rank ),
+  rank2_ ( 2 * rank )
+
+{
+  clear ();
+}
+
+
+//-----------------------------------------------------------------------
+//   clear
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::Tree_::clear ()
+{
+  boxCount   = -1;
+  nodeCount_ =  0;
+  treeSize_  =  0;
+  depth_     =  0;
+  cost_      =  0.0;
+}
+
+
+//-----------------------------------------------------------------------
+//   build
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::Tree_::build
+
+  ( const BoxArray&  boxes,
+    idx_t            leafSize )
+
+{
+  const idx_t    n = boxes.size ();
+  const idx_t    r = rank_;
+
+  Vector         centers ( r * n );
+  Flex<idx_t>    stack;
+
+  const double*  x;
+
+  idx_t          node, left, right;
+  idx_t          first, last;
+  idx_t          level, mid;
+  idx_t          i, j, k;
+
+
+  perm_.resize ( n );
+
+  // Store the non-empty boxes in front of the empty boxes.
+
+  j = 0;
+  k = n;
+
+  for ( i = 0; i < n; i++ )
+  {
+    x = boxes.getCorners ( i );
+
+    if ( x[0] > x[r] )
+    {
+      perm_[--k] = i;
+
+      continue;
+    }
+
+    perm_[j++] = i;
+
+    for ( idx_t d = 0; d < r; d++ )
+    {
+      centers[i * r + d] = 0.5 * (x[d] + x[d + r]);
+    }
+  }
+
+  boxCount   = n;
+  treeSize_  = j;
+  nodeCount_ = 0;
+  depth_     = 0;
+
+  if ( treeSize_ == 0 )
+  {
+    cost_ = 0.0;
+
+    return;
+  }
+
+  first_ .resize ( 2 * treeSize_ - 1 );
+  count_ .resize ( 2 * treeSize_ - 1 );
+  bounds_.resize ( rank2_ * (2 * treeSize_ - 1) );
+
+  nodeCount_ = 1;
+
+  stack.pushBack ( { 0_idx, 0_idx, treeSize_, 0_idx } );
+
+  while ( stack.size() )
+  {
+    level = stack.back (); stack.popBack ();
+    last  = stack.back (); stack.popBack ();
+    first = stack.back (); stack.popBack ();
+    node  = stack.back (); stack.popBack ();
+
+    if ( level > depth_ )
+    {
+      depth_ = level;
+    }
+
+    if ( last - first <= leafSize )
+    {
+      first_[node] = first;
+      count_[node] = last - first;
+
+      continue;
+    }
+
+    mid   = split_ ( first, last, boxes, centers.addr() );
+    left  = nodeCount_;
+    right = left + 1;
+
+    first_[node] = left;
+    count_[node] = 0;
+    nodeCount_  += 2;
+    level++;
+
+    stack.pushBack ( { left,  first, mid,  level } );
+    stack.pushBack ( { right, mid,   last, level } );
+  }
+
+  setBounds_ ( boxes );
+
+  cost_ = getCost_ ();
+}
+
+
+//-----------------------------------------------------------------------
+//   refit
+//-----------------------------------------------------------------------
+
+// Recomputes the bounds of all nodes after the boxes have been moved.
+// Returns false if the hierarchy must be rebuilt: when an empty box
+// has become non-empty, or when the quality of the hierarchy has
+// degraded too much.
+
+
+bool TreeBoxManager::Tree_::refit ( const BoxArray& boxes )
+{
+  const idx_t    n = boxes.size ();
+  const idx_t    r = rank_;
+
+  const double*  x;
+
+
+  if ( boxCount != n )
+  {
+    return false;
+  }
+
+  for ( idx_t i = treeSize_; i < n; i++ )
+  {
+    x = boxes.getCorners ( perm_[i] );
+
+    if ( x[0] <= x[r] )
+    {
+      return false;
+    }
+  }
+
+  if ( nodeCount_ == 0 )
+  {
+    return true;
+  }
+
+  setBounds_ ( boxes );
+
+  return (getCost_() <= REBUILD_RATIO * cost_);
+}
+
+
+//-----------------------------------------------------------------------
+//   stackSize
+//-----------------------------------------------------------------------
+
+
+inline idx_t TreeBoxManager::Tree_::stackSize () const
+{
+  return (depth_ + 2);
+}
+
+
+//-----------------------------------------------------------------------
+//   findBoxes
+//-----------------------------------------------------------------------
+
+// Appends the indices of the boxes that overlap with the given box to
+// a list. The stack must have at least stackSize() entries.
+
+
+void TreeBoxManager::Tree_::findBoxes
+
+  ( Flex<idx_t>&     list,
+    const double*    box,
+    const BoxArray&  boxes,
+    idx_t*           stack ) const
+
+{
+  const idx_t    r = rank_;
+
+  const double*  x;
+
+  idx_t          node;
+  idx_t          ibox;
+  idx_t          i, j, n;
+
+
+  if ( nodeCount_ == 0 || box[0] > box[r] )
+  {
+    return;
+  }
+
+  stack[0] = 0;
+  n        = 1;
+
+  while ( n > 0 )
+  {
+    node = stack[--n];
+
+    if ( ! overlap_( box, bounds_.addr( node * rank2_ ) ) )
+    {
+      continue;
+    }
+
+    if ( count_[node] == 0 )
+    {
+      stack[n++] = first_[node];
+      stack[n++] = first_[node] + 1;
+
+      continue;
+    }
+
+    i = first_[node];
+    j = i + count_[node];
+
+    for ( ; i < j; i++ )
+    {
+      ibox = perm_[i];
+      x    = boxes.getCorners ( ibox );
+
+      if ( x[0] <= x[r] && overlap_( box, x ) )
+      {
+        list.pushBack ( ibox );
+      }
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   split_
+//-----------------------------------------------------------------------
+
+// Splits a range of boxes with the binned surface area heuristic and
+// returns the index of the first box in the right half.
+
+
+idx_t TreeBoxManager::Tree_::split_
+
+  ( idx_t            first,
+    idx_t            last,
+    const BoxArray&  boxes,
+    const double*    centers )
+
+{
+  const idx_t    r      = rank_;
+  const idx_t    r2     = rank2_;
+  const double   maxval = jem::Limits<double>::MAX_VALUE;
+
+  Vector         cbox     ( r2 );
+  Vector         bins     ( r2 * BIN_COUNT );
+  Vector         costs    ( BIN_COUNT );
+  Vector         acc      ( r2 );
+  IdxVector      counts   ( BIN_COUNT );
+
+  const double*  c;
+
+  double         bestCost = maxval;
+  idx_t          bestAxis = -1;
+  idx_t          bestBin  = 0;
+  double         scale    = 0.0;
+  double         cost;
+  idx_t          ibin;
+  idx_t          i, j, k;
+
+
+  // Compute the bounds of the box centers.
+
+  clearBox_ ( cbox.addr() );
+
+  for ( i = first; i < last; i++ )
+  {
+    c = centers + perm_[i] * r;
+
+    for ( k = 0; k < r; k++ )
+    {
+      cbox[k]     = jem::min ( cbox[k],     c[k] );
+      cbox[k + r] = jem::max ( cbox[k + r], c[k] );
+    }
+  }
+
+  for ( idx_t axis = 0; axis < r; axis++ )
+  {
+    double  ext = cbox[axis + r] - cbox[axis];
+
+    if ( ext <= 0.0 )
+    {
+      continue;
+    }
+
+    scale = BIN_COUNT / ext;
+
+    for ( j = 0; j < BIN_COUNT; j++ )
+    {
+      clearBox_ ( bins.addr( j * r2 ) );
+
+      counts[j] = 0;
+    }
+
+    for ( i = first; i < last; i++ )
+    {
+      ibin = (idx_t) ((centers[perm_[i] * r + axis] -
+                       cbox[axis]) * scale);
+      ibin = jem::min ( ibin, (idx_t) BIN_COUNT - 1 );
+
+      counts[ibin]++;
+
+      growBox_ ( bins.addr( ibin * r2 ),
+                 boxes.getCorners( perm_[i] ) );
+    }
+
+    // Sweep from right to left to get the cost of the right halves,
+    // then from left to right to get the total cost of each split.
+
+    clearBox_ ( acc.addr() );
+
+    for ( j = BIN_COUNT - 1, k = 0; j > 0; j-- )
+    {
+      growBox_ ( acc.addr(), bins.addr( j * r2 ) );
+
+      k       += counts[j];
+      costs[j] = (double) k * getArea_ ( acc.addr() );
+    }
+
+    clearBox_ ( acc.addr() );
+
+    for ( j = 1, k = 0; j < BIN_COUNT; j++ )
+    {
+      growBox_ ( acc.addr(), bins.addr( (j - 1) * r2 ) );
+
+      k   += counts[j - 1];
+      cost = (double) k * getArea_ ( acc.addr() ) + costs[j];
+
+      if ( k > 0 && k < last - first && cost < bestCost )
+      {
+        bestCost = cost;
+        bestAxis = axis;
+        bestBin  = j;
+      }
+    }
+  }
+
+  if ( bestAxis < 0 )
+  {
+    return (first + (last - first) / 2);
+  }
+
+  // Move the boxes in the left bins to the front of the range.
+
+  scale = BIN_COUNT / (cbox[bestAxis + r] - cbox[bestAxis]);
+  j     = last;
+
+  for ( i = first; i < j; )
+  {
+    ibin = (idx_t) ((centers[perm_[i] * r + bestAxis] -
+                     cbox[bestAxis]) * scale);
+
+    if ( ibin < bestBin )
+    {
+      i++;
+    }
+    else
+    {
+      jem::swap ( perm_[i], perm_[--j] );
+    }
+  }
+
+  if ( j == first || j == last )
+  {
+    j = first + (last - first) / 2;
+  }
+
+  return j;
+}
+
+
+//-----------------------------------------------------------------------
+//   setBounds_
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::Tree_::setBounds_ ( const BoxArray& boxes )
+{
+  const idx_t  r2 = rank2_;
+
+  double*      b;
+  idx_t        i, j, k;
+
+
+  for ( idx_t node = nodeCount_ - 1; node >= 0; node-- )
+  {
+    b = bounds_.addr ( node * r2 );
+    i = first_[node];
+
+    clearBox_ ( b );
+
+    if ( count_[node] == 0 )
+    {
+      growBox_ ( b, bounds_.addr(  i      * r2 ) );
+      growBox_ ( b, bounds_.addr( (i + 1) * r2 ) );
+
+      continue;
+    }
+
+    j = i + count_[node];
+
+    for ( k = i; k < j; k++ )
+    {
+      const double*  x = boxes.getCorners ( perm_[k] );
+
+      if ( x[0] <= x[rank_] )
+      {
+        growBox_ ( b, x );
+      }
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   getCost_
+//-----------------------------------------------------------------------
+
+// Returns the expected number of overlap tests for a small query box,
+// relative to the area of the root node.
+
+
+double TreeBoxManager::Tree_::getCost_ () const
+{
+  double  cost = 0.0;
+  double  area;
+
+
+  for ( idx_t node = 0; node < nodeCount_; node++ )
+  {
+    area = getArea_ ( bounds_.addr( node * rank2_ ) );
+
+    if ( count_[node] == 0 )
+    {
+      cost += area;
+    }
+    else
+    {
+      cost += area * (double) count_[node];
+    }
+  }
+
+  area = getArea_ ( bounds_.addr() );
+
+  if ( area > 0.0 )
+  {
+    cost /= area;
+  }
+
+  return cost;
+}
+
+
+//-----------------------------------------------------------------------
+//   getArea_
+//-----------------------------------------------------------------------
+
+// Returns the surface area of a box in three dimensions, and the sum
+// of its edge lengths otherwise. An empty box has zero area.
+
+
+inline double TreeBoxManager::Tree_::getArea_
+
+  ( const double*  box ) const
+
+{
+  const idx_t  r = rank_;
+
+  double       area = 0.0;
+
+
+  if ( box[0] > box[r] )
+  {
+    return 0.0;
+  }
+
+  if ( r == 3 )
+  {
+    double  dx = box[3] - box[0];
+    double  dy = box[4] - box[1];
+    double  dz = box[5] - box[2];
+
+    area = dx * dy + dy * dz + dz * dx;
+  }
+  else
+  {
+    for ( idx_t k = 0; k < r; k++ )
+    {
+      area += box[k + r] - box[k];
+    }
+  }
+
+  return area;
+}
+
+
+//-----------------------------------------------------------------------
+//   clearBox_
+//-----------------------------------------------------------------------
+
+
+inline void TreeBoxManager::Tree_::clearBox_ ( double* box ) const
+{
+  const double  maxval = jem::Limits<double>::MAX_VALUE;
+
+  for ( idx_t k = 0; k < rank_; k++ )
+  {
+    box[k]         =  maxval;
+    box[k + rank_] = -maxval;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   growBox_
+//-----------------------------------------------------------------------
+
+
+inline void TreeBoxManager::Tree_::growBox_
+
+  ( double*        box,
+    const double*  x ) const
+
+{
+  const idx_t  r = rank_;
+
+  for ( idx_t k = 0; k < r; k++ )
+  {
+    box[k]     = jem::min ( box[k],     x[k]     );
+    box[k + r] = jem::max ( box[k + r], x[k + r] );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   overlap_
+//-----------------------------------------------------------------------
+
+
+inline bool TreeBoxManager::Tree_::overlap_
+
+  ( const double*  box,
+    const double*  x ) const
+
+{
+  const idx_t  r = rank_;
+
+  for ( idx_t k = 0; k < r; k++ )
+  {
+    if ( box[k] > x[k + r] || x[k] > box[k + r] )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+//=======================================================================
+//   class TreeBoxManager::Data_
+//=======================================================================
+
+
+class TreeBoxManager::Data_ : public jem::Collectable
+{
+ public:
+
+  typedef jem::Array
+    < Flex<idx_t> >       Lists;
+
+  static const int        BLOCK_SIZE = 64;
+
+
+                          Data_
+
+    ( idx_t                 rank,
+      idx_t                 leafSize );
+
+  void                    update        ();
+
+  void                    updateSome
+
+    ( const IdxVector&      iboxes );
+
+  inline bool             isUpToDate    () const;
+  void                    invalidate    ();
+  inline void             moveBoxes     ();
+  inline void             clearTree     ();
+  void                    syncTree      ();
+
+  void                    findBoxes
+
+    ( Flex<idx_t>&          list,
+      const double*         box,
+      idx_t                 color,
+      idx_t*                stack )        const;
+
+  void                    findBoxes
+
+    ( Lists&                lists,
+      const IdxVector&      iboxes );
+
+
+ public:
+
+  BoxArray                boxes;
+  Tree_                   tree;
+  IListArray              boxBoxMap;
+  Ref<MaskMatrix>         maskMatrix;
+  const idx_t             leafSize;
+
+
+ private:
+
+  void                    updateAll_    ();
+
+  void                    updateSome_
+
+    ( const IdxVector&      iboxes );
+
+
+ private:
+
+  static const int        TREE_VALID_   = 0;
+  static const int        TREE_MOVED_   = 1;
+  static const int        TREE_INVALID_ = 2;
+
+  idx_t                   updated_;
+  int                     treeState_;
+
+};
+
+
+//=======================================================================
+//   class TreeBoxManager::FindWork_
+//=======================================================================
+
+/*
+  Finds the neighbors of a range of blocks of boxes. The neighbors of
+  each block are stored in a separate list, so that the results do
+  not depend on the number of threads.
+*/
+
+
+class TreeBoxManager::FindWork_ : public ThreadTeam::Work
+{
+ public:
+
+  inline                  FindWork_
+
+    ( const Data_&          data,
+      Data_::Lists&         lists,
+      const IdxVector&      iboxes );
+
+  virtual void            run
+
+    ( idx_t                 first,
+      idx_t                 last )         override;
+
+
+ private:
+
+  const Data_&            data_;
+  Data_::Lists&           lists_;
+  const IdxVector&        iboxes_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline TreeBoxManager::FindWork_::FindWork_
+
+  ( const Data_&      data,
+    Data_::Lists&     lists,
+    const IdxVector&  iboxes ) :
+
+    data_   ( data   ),
+    lists_  ( lists  ),
+    iboxes_ ( iboxes )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::FindWork_::run
+
+  ( idx_t  first,
+    idx_t  last )
+
+{
+  const BoxArray&  boxes  = data_.boxes;
+  const idx_t      icount = iboxes_.size ();
+
+  IdxVector        stack  ( data_.tree.stackSize() );
+
+  idx_t            ibox;
+  idx_t            i, j, k;
+
+
+  for ( idx_t iblock = first; iblock < last; iblock++ )
+  {
+    Flex<idx_t>&  list = lists_[iblock];
+
+    i = iblock * Data_::BLOCK_SIZE;
+    j = jem::min ( icount, i + Data_::BLOCK_SIZE );
+
+    list.clear ();
+
+    // Each box is stored as its neighbor count followed by its
+    // neighbors.
+
+    for ( ; i < j; i++ )
+    {
+      ibox = iboxes_[i];
+      k    = list.size ();
+
+      list.pushBack ( 0 );
+
+      data_.findBoxes ( list,
+                        boxes.getCorners ( ibox ),
+                        boxes.getColor   ( ibox ),
+                        stack.addr () );
+
+      list[k] = list.size() - k - 1;
+    }
+  }
+}
+
+
+//=======================================================================
+//   class TreeBoxManager::Data_ (implementation)
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+TreeBoxManager::Data_::Data_
+
+  ( idx_t  rank,
+    idx_t  lsize ) :
+
+    boxes    ( rank  ),
+    tree     ( rank  ),
+    leafSize ( lsize )
+
+{
+  updated_   = -1;
+  treeState_ = TREE_INVALID_;
+}
+
+
+//-----------------------------------------------------------------------
+//   update
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::Data_::update ()
+{
+  const idx_t  boxCount = boxes.size ();
+
+  idx_t        todo;
+
+
+  if ( boxCount != boxBoxMap.size() )
+  {
+    boxBoxMap.resize ( boxCount );
+  }
+
+  todo = boxCount - updated_;
+
+  if      ( todo >= boxCount / 4 )
+  {
+    updateAll_ ();
+  }
+  else if ( todo > 0 )
+  {
+    IdxVector  iboxes ( todo );
+
+    for ( idx_t i = 0; i < todo; i++ )
+    {
+      iboxes[i] = i + updated_;
+    }
+
+    updateSome_ ( iboxes );
+
+    updated_ = boxCount;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   updateSome
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::Data_::updateSome ( const IdxVector& iboxes )
+{
+  using jem::count;
+
+  const idx_t  boxCount  = boxes .size ();
+  const idx_t  iboxCount = iboxes.size ();
+
+  IdxVector    jboxes;
+  idx_t        todo;
+
+
+  if ( boxCount != boxBoxMap.size() )
+  {
+    boxBoxMap.resize ( boxCount );
+  }
+
+  todo = boxCount - updated_;
+
+  if ( todo >= boxCount / 4 )
+  {
+    invalidate ();
+
+    return;
+  }
+
+  todo = count ( iboxes < updated_ );
+
+  if ( todo >= boxCount / 4 )
+  {
+    invalidate ();
+
+    return;
+  }
+
+  if ( todo == iboxCount )
+  {
+    jboxes.ref ( iboxes );
+  }
+  else
+  {
+    idx_t  ibox;
+    idx_t  i, j;
+
+    jboxes.resize ( todo );
+
+    for ( i = j = 0; i < iboxCount; i++ )
+    {
+      ibox = iboxes[i];
+
+      if ( ibox < updated_ )
+      {
+        jboxes[j++] = ibox;
+      }
+    }
+  }
+
+  updateSome_ ( jboxes );
+}
+
+
+//-----------------------------------------------------------------------
+//   isUpToDate
+//-----------------------------------------------------------------------
+
+
+inline bool TreeBoxManager::Data_::isUpToDate () const
+{
+  return (updated_ == boxes.size());
+}
+
+
+//-----------------------------------------------------------------------
+//   invalidate
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::Data_::invalidate ()
+{
+  if ( updated_ >= 0 )
+  {
+    boxBoxMap.clear ();
+
+    updated_ = -1;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   moveBoxes
+//-----------------------------------------------------------------------
+
+
+inline void TreeBoxManager::Data_::moveBoxes ()
+{
+  if ( treeState_ == TREE_VALID_ )
+  {
+    treeState_ = TREE_MOVED_;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   clearTree
+//-----------------------------------------------------------------------
+
+
+inline void TreeBoxManager::Data_::clearTree ()
+{
+  treeState_ = TREE_INVALID_;
+}
+
+
+//-----------------------------------------------------------------------
+//   syncTree
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::Data_::syncTree ()
+{
+  if ( treeState_ == TREE_VALID_ && tree.boxCount == boxes.size() )
+  {
+    return;
+  }
+
+  if ( treeState_ == TREE_INVALID_ || ! tree.refit( boxes ) )
+  {
+    tree.build ( boxes, leafSize );
+  }
+
+  treeState_ = TREE_VALID_;
+}
+
+
+//-----------------------------------------------------------------------
+//   findBoxes (given a box)
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::Data_::findBoxes
+
+  ( Flex<idx_t>&   list,
+    const double*  box,
+    idx_t          color,
+    idx_t*         stack ) const
+
+{
+  const idx_t  first = list.size ();
+
+  idx_t        jbox;
+  idx_t        i, j, n;
+
+
+  tree.findBoxes ( list, box, boxes, stack );
+
+  if ( maskMatrix )
+  {
+    n = list.size ();
+
+    for ( i = j = first; i < n; i++ )
+    {
+      jbox = list[i];
+
+      if ( maskMatrix->getValue( color, boxes.getColor( jbox ) ) )
+      {
+        list[j++] = jbox;
+      }
+    }
+
+    list.resize ( j );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   findBoxes (given a set of box indices)
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::Data_::findBoxes
+
+  ( Lists&            lists,
+    const IdxVector&  iboxes )
+
+{
+  const idx_t  blockCount =
+
+    (iboxes.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+  Ref<ThreadTeam>  team = ThreadTeam::getCurrent ();
+
+
+  syncTree ();
+
+  lists.resize ( blockCount );
+
+  FindWork_  work ( *this, lists, iboxes );
+
+  if ( team && team->size() > 1 && blockCount > 1 )
+  {
+    team->execute ( work, blockCount );
+  }
+  else
+  {
+    work.run ( 0, blockCount );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   updateAll_
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::Data_::updateAll_ ()
+{
+  const idx_t   boxCount = boxes.size ();
+
+  IdxVector     iboxes   ( boxCount );
+  Lists         lists;
+
+  const idx_t*  ilist;
+
+  idx_t         ibox;
+  idx_t         jbox;
+  idx_t         i, j, n;
+
+
+  boxes.checkBoxes ( CLASS_NAME );
+
+  for ( ibox = 0; ibox < boxCount; ibox++ )
+  {
+    iboxes[ibox] = ibox;
+  }
+
+  findBoxes ( lists, iboxes );
+
+  boxBoxMap.clear     ();
+  boxBoxMap.setZLevel ( 1 );
+
+  for ( i = ibox = 0; i < lists.size(); i++ )
+  {
+    ilist = lists[i].addr ();
+
+    for ( j = 0; j < lists[i].size(); j += n + 1, ibox++ )
+    {
+      n = ilist[j];
+
+      for ( idx_t k = 1; k <= n; k++ )
+      {
+        jbox = ilist[j + k];
+
+        if ( jbox != ibox )
+        {
+          boxBoxMap.addToList ( ibox, jbox );
+        }
+      }
+    }
+  }
+
+  boxBoxMap.setZLevel ( 2 );
+  boxBoxMap.compress  ();
+
+  updated_ = boxCount;
+}
+
+
+//-----------------------------------------------------------------------
+//   updateSome_
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::Data_::updateSome_ ( const IdxVector& iboxes )
+{
+  const idx_t   boxCount  = boxes.size  ();
+  const idx_t   iboxCount = iboxes.size ();
+
+  IdxVector     jboxes    ( boxCount );
+  BoolVector    mask      ( boxCount );
+  Lists         lists;
+
+  const idx_t*  ilist;
+
+  idx_t         jboxCount;
+  idx_t         ibox;
+  idx_t         jbox;
+  idx_t         i, j, k, n;
+
+
+  // Remove all modified boxes from the box -> box map.
+
+  jboxCount = 0;
+  mask      = false;
+
+  for ( i = 0; i < iboxCount; i++ )
+  {
+    mask[iboxes[i]] = true;
+  }
+
+  for ( i = 0; i < iboxCount; i++ )
+  {
+    ilist = boxBoxMap.getList ( n, iboxes[i] );
+
+    for ( j = 0; j < n; j++ )
+    {
+      jbox = ilist[j];
+
+      if ( ! mask[jbox] )
+      {
+        mask  [jbox]        = true;
+        jboxes[jboxCount++] = jbox;
+      }
+    }
+  }
+
+JEM_IVDEP
+
+  for ( j = 0; j < jboxCount; j++ )
+  {
+    mask[jboxes[j]] = false;
+  }
+
+  for ( j = 0; j < jboxCount; j++ )
+  {
+    boxBoxMap.pruneList ( jboxes[j], mask.addr() );
+  }
+
+  for ( i = 0; i < iboxCount; i++ )
+  {
+    ibox       = iboxes[i];
+    mask[ibox] = false;
+
+    boxBoxMap.clearList ( ibox );
+  }
+
+  // Find the new neighbors of the modified boxes.
+
+  findBoxes ( lists, iboxes );
+
+  for ( i = k = 0; i < lists.size(); i++ )
+  {
+    ilist = lists[i].addr ();
+
+    for ( j = 0; j < lists[i].size(); j += n + 1, k++ )
+    {
+      ibox       = iboxes[k];
+      mask[ibox] = true;
+      n          = ilist[j];
+
+      for ( idx_t m = 1; m <= n; m++ )
+      {
+        jbox = ilist[j + m];
+
+        if ( ! mask[jbox] )
+        {
+          boxBoxMap.addToList ( ibox, jbox );
+          boxBoxMap.addToList ( jbox, ibox );
+        }
+      }
+    }
+  }
+}
+
+
+//=======================================================================
+//   class TreeBoxManager
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructors & destructor
+//-----------------------------------------------------------------------
+
+
+TreeBoxManager::TreeBoxManager ()
+{}
+
+
+TreeBoxManager::TreeBoxManager
+
+  ( idx_t  rank,
+    idx_t  boxesPerLeaf )
+
+{
+  JEM_PRECHECK2 ( rank > 0, "invalid rank" );
+  JEM_PRECHECK2 ( boxesPerLeaf > 0,
+                  "invalid number of boxes per leaf" );
+
+  data_ = newInstance<Data_> ( rank, boxesPerLeaf );
+}
+
+
+TreeBoxManager::~TreeBoxManager ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   readFrom
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::readFrom ( ObjectInput& in )
+{
+  idx_t  r, n;
+
+  decode ( in, r, n );
+
+  if ( r <= 0 || n <= 0 )
+  {
+    jem::io::decodeError ( JEM_FUNC );
+  }
+
+  data_ = newInstance<Data_> ( r, n );
+
+  decode ( in, data_->boxes, data_->maskMatrix );
+}
+
+
+//-----------------------------------------------------------------------
+//   writeTo
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::writeTo ( ObjectOutput& out ) const
+{
+  const Data_& d = * data_;
+
+  encode ( out, d.boxes.rank(), d.leafSize, d.boxes, d.maskMatrix );
+}
+
+
+//-----------------------------------------------------------------------
+//   size
+//-----------------------------------------------------------------------
+
+
+idx_t TreeBoxManager::size () const
+{
+  return data_->boxes.size ();
+}
+
+
+//-----------------------------------------------------------------------
+//   rank
+//-----------------------------------------------------------------------
+
+
+idx_t TreeBoxManager::rank () const
+{
+  return data_->boxes.rank ();
+}
+
+
+//-----------------------------------------------------------------------
+//   clear
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::clear ()
+{
+  Data_&  d = * data_;
+
+  d.boxes.clear ();
+  d.invalidate  ();
+  d.clearTree   ();
+}
+
+
+//-----------------------------------------------------------------------
+//   reserve
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::reserve ( idx_t n )
+{
+  data_->boxes.reserve ( n );
+}
+
+
+//-----------------------------------------------------------------------
+//   trimToSize
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::trimToSize ()
+{
+  Data_& d = * data_;
+
+  d.update ();
+
+  d.boxes    .trimToSize ();
+  d.boxBoxMap.compress   ();
+}
+
+
+//-----------------------------------------------------------------------
+//   flushChanges
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::flushChanges ()
+{
+  if ( ! data_->isUpToDate() )
+  {
+    data_->update ();
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   setMaskMatrix
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::setMaskMatrix ( Ref<MaskMatrix> mask )
+{
+  JEM_PRECHECK2 ( mask, "NULL MaskMatrix" );
+
+  data_->maskMatrix = mask;
+
+  data_->invalidate ();
+}
+
+
+//-----------------------------------------------------------------------
+//   getEnclosingBox
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::getEnclosingBox ( const Vector& box ) const
+{
+  data_->boxes.getEnclosingBox ( box );
+}
+
+
+//-----------------------------------------------------------------------
+//   addBox
+//-----------------------------------------------------------------------
+
+
+idx_t TreeBoxManager::addBox
+
+  ( const Vector&  box,
+    idx_t          color )
+
+{
+  return data_->boxes.addBox ( box, color );
+}
+
+
+//-----------------------------------------------------------------------
+//   addBoxes
+//-----------------------------------------------------------------------
+
+
+idx_t TreeBoxManager::addBoxes
+
+  ( const Matrix&  boxes,
+    idx_t          color )
+
+{
+  return data_->boxes.addBoxes ( boxes, color );
+}
+
+
+//-----------------------------------------------------------------------
+//   reorderBoxes
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::reorderBoxes ( const Reordering& reord )
+{
+  data_->invalidate         ();
+  data_->clearTree          ();
+  data_->boxes.reorderBoxes ( reord );
+}
+
+
+//-----------------------------------------------------------------------
+//   getBox
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::getBox
+
+  ( const Vector&  box,
+    idx_t          ibox ) const
+
+{
+  data_->boxes.getBox ( box, ibox );
+}
+
+
+//-----------------------------------------------------------------------
+//   getBoxes
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::getBoxes
+
+  ( const Matrix&  boxes ) const
+
+{
+  data_->boxes.getBoxes ( boxes );
+}
+
+
+//-----------------------------------------------------------------------
+//   getSomeBoxes
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::getSomeBoxes
+
+  ( const Matrix&     boxes,
+    const IdxVector&  iboxes ) const
+
+{
+  data_->boxes.getSomeBoxes ( boxes, iboxes );
+}
+
+
+//-----------------------------------------------------------------------
+//   setColors
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::setColors ( const IdxVector& colors )
+{
+  data_->invalidate      ();
+  data_->boxes.setColors ( colors );
+}
+
+
+//-----------------------------------------------------------------------
+//   setSomeColors
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::setSomeColors
+
+  ( const IdxVector&  iboxes,
+    const IdxVector&  colors )
+
+{
+  Data_&  d = * data_;
+
+  d.boxes.setSomeColors ( iboxes, colors );
+  d.updateSome          ( iboxes );
+}
+
+
+//-----------------------------------------------------------------------
+//   updateBoxes
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::updateBoxes ( const Matrix& boxes )
+{
+  data_->invalidate        ();
+  data_->moveBoxes         ();
+  data_->boxes.updateBoxes ( boxes );
+}
+
+
+//-----------------------------------------------------------------------
+//   updateSomeBoxes
+//-----------------------------------------------------------------------
+
+
+void TreeBoxManager::updateSomeBoxes
+
+  ( const IdxVector&  iboxes,
+    const Matrix&     boxes )
+
+{
+  Data_&  d = * data_;
+
+  d.boxes.updateSomeBoxes ( iboxes, boxes );
+  d.moveBoxes             ();
+  d.updateSome            ( iboxes );
+}
+
+
+//-----------------------------------------------------------------------
+//   findChangedBoxes
+//-----------------------------------------------------------------------
+
+
+idx_t TreeBoxManager::findChangedBoxes
+
+  ( const IdxVector&  iboxes,
+    const Matrix&     boxes ) const
+
+{
+  return data_->boxes.findChangedBoxes ( iboxes, boxes );
+}
+
+
+//-----------------------------------------------------------------------
+//   findBoxNeighbors (given a box index)
+//-----------------------------------------------------------------------
+
+
+idx_t TreeBoxManager::findBoxNeighbors
+
+  ( const IdxVector&  iboxes,
+    idx_t             jbox ) const
+
+{
+  JEM_PRECHECK2 ( iboxes.size() >= size(),
+                  "output array is too small" );
+
+  Data_&        d = * data_;
+
+  const idx_t*  ilist;
+
+  idx_t         i, n;
+
+
+  d.boxes.checkIndex ( jbox );
+
+  if ( ! d.isUpToDate() )
+  {
+    d.update ();
+  }
+
+  ilist = d.boxBoxMap.getList ( n, jbox );
+
+  if ( iboxes.size() < n )
+  {
+    n = iboxes.size ();
+  }
+
+  if ( iboxes.isContiguous() )
+  {
+    std::memcpy ( iboxes.addr(), ilist, (size_t) n * sizeof(idx_t) );
+  }
+  else
+  {
+    for ( i = 0; i < n; i++ )
+    {
+      iboxes[i] = ilist[i];
+    }
+  }
+
+  return n;
+}
+
+
+//-----------------------------------------------------------------------
+//   findBoxNeighbors (given a box)
+//-----------------------------------------------------------------------
+
+
+idx_t TreeBoxManager::findBoxNeighbors
+
+  ( const IdxVector&  iboxes,
+    const Vector&     box,
+    idx_t             color ) const
+
+{
+  JEM_PRECHECK2 ( iboxes.size() >= size(),
+                  "output array is too small" );
+  JEM_PRECHECK2 ( box.size() == rank() * 2,
+                  "bounding box array has wrong size" );
+
+  Data_&       d  = * data_;
+  const idx_t  r2 = box.size ();
+
+  Vector       ybox  ( r2 );
+  Flex<idx_t>  list;
+
+  idx_t        i, n;
+
+
+  d.syncTree ();
+
+  IdxVector    stack ( d.tree.stackSize() );
+
+  for ( i = 0; i < r2; i++ )
+  {
+    ybox[i] = box[i];
+  }
+
+  d.findBoxes ( list, ybox.addr(), color, stack.addr() );
+
+  n = jem::min ( list.size(), iboxes.size() );
+
+  for ( i = 0; i < n; i++ )
+  {
+    iboxes[i] = list[i];
+  }
+
+  return n;
+}
+
+
+JIVE_END_PACKAGE( geom )
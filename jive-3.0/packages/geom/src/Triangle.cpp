@@ -51,6 +51,7 @@
 #include <jive/geom/BoundaryLine.h>
 #include <jive/geom/IShapeFactory.h>
 #include <jive/geom/StdShapeFactory.h>
+#include <jive/geom/FixedParametricShape.h>
 #include <jive/geom/Triangle.h>
 
 
@@ -910,19 +911,35 @@ Ref<IShape> Triangle3::getShape
   Ref<SShape>  xshape = newInstance<StdTriangle3> ();
   Ref<SShape>  sshape = sfuncs ? sfuncs : xshape;
 
-  return newInstance<Triangle3Shape> (
+  ShapeBoundary  bnd = Utils_::getBoundary (
     name,
-    ischeme[0],
-    Utils_::getBoundary (
-      name,
-      & BoundaryLine2::getShape,
-      ischeme[slice(1,END)],
-      getBoundaryTopology (),
-      sshape
-    ),
-    xshape,
+    & BoundaryLine2::getShape,
+    ischeme[slice(1,END)],
+    getBoundaryTopology (),
     sshape
   );
+
+  // Use the fixed-size kernels for the common integration
+  // schemes.
+
+  if ( ! sfuncs )
+  {
+    if ( ischeme[0].size(1) == 1 )
+    {
+      return newInstance< FixedParametricShape<Triangle3Shape,3,1> > (
+        name, ischeme[0], bnd, xshape, sshape
+      );
+    }
+    else if ( ischeme[0].size(1) == 3 )
+    {
+      return newInstance< FixedParametricShape<Triangle3Shape,3,3> > (
+        name, ischeme[0], bnd, xshape, sshape
+      );
+    }
+  }
+
+  return newInstance<Triangle3Shape> ( name, ischeme[0], bnd,
+                                       xshape, sshape );
 }
 
 
@@ -0,0 +1,1600 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+
+#include <jem/base/System.h>
+#include <jem/base/ClassTemplate.h>
+#include <jem/base/array/utilities.h>
+#include <jem/mp/Buffer.h>
+#include <jem/mp/Context.h>
+#include <jem/mp/UniContext.h>
+#include <jem/mp/utilities.h>
+#include <jem/util/ObjFlex.h>
+#include <jem/util/Properties.h>
+#include <jem/util/ArrayBuffer.h>
+#include <jive/util/utilities.h>
+#include <jive/util/Random.h>
+#include <jive/graph/utilities.h>
+#include <jive/graph/Names.h>
+#include <jive/graph/Partition.h>
+#include <jive/graph/PartitionControl.h>
+#include <jive/graph/PartitionerFactory.h>
+#include <jive/graph/MLPartitioner.h>
+#include <jive/graph/MPPartitioner.h>
+
+
+JEM_DEFINE_CLASS( jive::graph::MPPartitioner );
+
+
+JIVE_BEGIN_PACKAGE( graph )
+
+
+using jem::newInstance;
+using jem::mp::RecvBuffer;
+using jem::mp::SendBuffer;
+using jive::util::joinNames;
+
+
+//-----------------------------------------------------------------------
+//   typedefs
+//-----------------------------------------------------------------------
+
+
+typedef jem::util::ArrayBuffer<idx_t>  IdxBuffer;
+
+
+//=======================================================================
+//   class MPPartitioner::Halo_
+//=======================================================================
+
+// Describes the remote neighbors (ghost nodes) of the local nodes
+// and how their values are exchanged. Local nodes are numbered
+// from zero to nodeCount; the ghost nodes follow the local nodes.
+
+
+class MPPartitioner::Halo_
+{
+ public:
+
+  void                      init
+
+    ( MPContext&              mpx,
+      const WGraph&           graph,
+      const IdxVector&        nodeDist );
+
+  void                      update
+
+    ( MPContext&              mpx,
+      const IdxVector&        values )       const;
+
+  inline idx_t              ghostIndex
+
+    ( idx_t                   gid )          const;
+
+
+ public:
+
+  idx_t                     nodeCount;
+
+  IdxVector                 ghostIDs;
+  IdxVector                 recvCounts;
+  IdxVector                 sendCounts;
+  IdxVector                 sendNodes;
+
+  // The adjacency array in the local/ghost numbering.
+
+  IdxVector                 localAdj;
+
+};
+
+
+//=======================================================================
+//   class MPPartitioner::Level_
+//=======================================================================
+
+
+class MPPartitioner::Level_ : public Object
+{
+ public:
+
+  inline                    Level_
+
+    ( MPContext&              mpx,
+      const WGraph&           graph,
+      const IdxVector&        nodeDist );
+
+  inline idx_t              firstNode   () const;
+
+
+ public:
+
+  WGraph                    graph;
+  IdxVector                 nodeDist;
+  Halo_                     halo;
+  int                       myRank;
+
+  // Maps the local nodes to the global nodes in the next (coarser)
+  // level.
+
+  IdxVector                 coarseMap;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline MPPartitioner::Level_::Level_
+
+  ( MPContext&        mpx,
+    const WGraph&     gr,
+    const IdxVector&  dist ) :
+
+    graph    ( gr   ),
+    nodeDist ( dist ),
+    myRank   ( mpx.myRank() )
+
+{
+  halo.init ( mpx, graph, nodeDist );
+}
+
+
+//-----------------------------------------------------------------------
+//   firstNode
+//-----------------------------------------------------------------------
+
+
+inline idx_t MPPartitioner::Level_::firstNode () const
+{
+  return nodeDist[myRank];
+}
+
+
+//=======================================================================
+//   class MPPartitioner::Utils_
+//=======================================================================
+
+
+class MPPartitioner::Utils_
+{
+ public:
+
+  static const int          MATCH_PASSES = 4;
+  static const int          MAX_LEVELS   = 32;
+
+
+  static inline int         ownerOf
+
+    ( const IdxVector&        nodeDist,
+      idx_t                   gid );
+
+  static void               exchange
+
+    ( MPContext&              mpx,
+      IdxVector&              rbuf,
+      IdxVector&              rcounts,
+      const IdxVector&        sbuf,
+      const IdxVector&        scounts );
+
+  static void               sortByRank
+
+    ( IdxVector&              sbuf,
+      IdxVector&              scounts,
+      const IdxBuffer&        data,
+      const IdxBuffer&        ranks,
+      idx_t                   recSize,
+      int                     procCount );
+
+  static void               fetch
+
+    ( MPContext&              mpx,
+      const IdxVector&        values,
+      const IdxVector&        gids,
+      const IdxVector&        nodeDist,
+      const IdxVector&        localValues );
+
+  static void               matchNodes
+
+    ( MPContext&              mpx,
+      const IdxVector&        match,
+      const Level_&           level,
+      Random&                 rand,
+      idx_t                   ilevel );
+
+};
+
+
+//-----------------------------------------------------------------------
+//   ownerOf
+//-----------------------------------------------------------------------
+
+
+inline int MPPartitioner::Utils_::ownerOf
+
+  ( const IdxVector&  nodeDist,
+    idx_t             gid )
+
+{
+  return (int) (jem::upperBound( gid, nodeDist ) - 1);
+}
+
+
+//-----------------------------------------------------------------------
+//   exchange
+//-----------------------------------------------------------------------
+
+// Sends scounts[p] items from sbuf to process p. On return, rbuf
+// contains the items received from all processes, and rcounts[p]
+// the number of items received from process p.
+
+
+void MPPartitioner::Utils_::exchange
+
+  ( MPContext&        mpx,
+    IdxVector&        rbuf,
+    IdxVector&        rcounts,
+    const IdxVector&  sbuf,
+    const IdxVector&  scounts )
+
+{
+  const int  procCount = mpx.size ();
+
+  IdxVector  ones ( procCount );
+
+
+  ones = 1_idx;
+
+  rcounts.resize ( procCount );
+
+  mpx.alltoallv ( RecvBuffer ( rcounts.addr(), procCount ),
+                  ones.addr  (),
+                  SendBuffer ( scounts.addr(), procCount ),
+                  ones.addr  () );
+
+  rbuf.resize ( sum( rcounts ) );
+
+  mpx.alltoallv ( RecvBuffer ( rbuf.addr(), rbuf.size() ),
+                  rcounts.addr (),
+                  SendBuffer ( sbuf.addr(), sbuf.size() ),
+                  scounts.addr () );
+}
+
+
+//-----------------------------------------------------------------------
+//   sortByRank
+//-----------------------------------------------------------------------
+
+// Sorts records of recSize items by their destination process.
+
+
+void MPPartitioner::Utils_::sortByRank
+
+  ( IdxVector&        sbuf,
+    IdxVector&        scounts,
+    const IdxBuffer&  data,
+    const IdxBuffer&  ranks,
+    idx_t             recSize,
+    int               procCount )
+
+{
+  const idx_t  recCount = ranks.size ();
+
+  IdxVector    offsets  ( procCount );
+
+  idx_t        i, j, k;
+
+
+  scounts.resize ( procCount );
+  sbuf   .resize ( data.size() );
+
+  scounts = 0_idx;
+
+  for ( i = 0; i < recCount; i++ )
+  {
+    scounts[ranks[i]] += recSize;
+  }
+
+  for ( j = i = 0; i < procCount; i++ )
+  {
+    offsets[i] = j;
+    j         += scounts[i];
+  }
+
+  for ( i = 0; i < recCount; i++ )
+  {
+    j = offsets[ranks[i]];
+
+    for ( k = 0; k < recSize; k++ )
+    {
+      sbuf[j + k] = data[i * recSize + k];
+    }
+
+    offsets[ranks[i]] = j + recSize;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   fetch
+//-----------------------------------------------------------------------
+
+// Gets the values associated with the global nodes gids; the
+// distribution of these values is given by nodeDist.
+
+
+void MPPartitioner::Utils_::fetch
+
+  ( MPContext&        mpx,
+    const IdxVector&  values,
+    const IdxVector&  gids,
+    const IdxVector&  nodeDist,
+    const IdxVector&  localValues )
+
+{
+  const int    procCount = mpx.size   ();
+  const idx_t  first     = nodeDist[mpx.myRank()];
+  const idx_t  n         = gids.size ();
+
+  IdxVector    scounts   ( procCount );
+  IdxVector    offsets   ( procCount );
+  IdxVector    sbuf      ( n );
+  IdxVector    iperm     ( n );
+  IdxVector    rbuf;
+  IdxVector    rcounts;
+  IdxVector    replies;
+
+  idx_t        i, j;
+  int          p;
+
+
+  scounts = 0_idx;
+
+  for ( i = 0; i < n; i++ )
+  {
+    scounts[ownerOf( nodeDist, gids[i] )]++;
+  }
+
+  for ( j = p = 0; p < procCount; p++ )
+  {
+    offsets[p] = j;
+    j         += scounts[p];
+  }
+
+  for ( i = 0; i < n; i++ )
+  {
+    p          = ownerOf ( nodeDist, gids[i] );
+    j          = offsets[p]++;
+    sbuf [j]   = gids[i];
+    iperm[j]   = i;
+  }
+
+  exchange ( mpx, rbuf, rcounts, sbuf, scounts );
+
+  replies.resize ( rbuf.size() );
+
+  for ( i = 0; i < rbuf.size(); i++ )
+  {
+    replies[i] = localValues[rbuf[i] - first];
+  }
+
+  mpx.alltoallv ( RecvBuffer ( sbuf.addr(), n ),
+                  scounts.addr (),
+                  SendBuffer ( replies.addr(), replies.size() ),
+                  rcounts.addr () );
+
+  for ( i = 0; i < n; i++ )
+  {
+    values[iperm[i]] = sbuf[i];
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   matchNodes
+//-----------------------------------------------------------------------
+
+// Computes a heavy-edge matching of the local nodes. On return,
+// match[i] contains the global index of the node that has been
+// matched with the local node i, or the global index of node i if
+// it has not been matched. Nodes on different processes are
+// matched through a request/reply protocol. In each pass, requests
+// are only sent to nodes with a higher (even passes) or lower (odd
+// passes) global index so that two nodes can not wait for each
+// other.
+
+
+void MPPartitioner::Utils_::matchNodes
+
+  ( MPContext&        mpx,
+    const IdxVector&  match,
+    const Level_&     level,
+    Random&           rand,
+    idx_t             ilevel )
+
+{
+  const int      UNMATCHED = -1;
+  const int      PENDING   = -2;
+
+  const WGraph&  gr        = level.graph;
+  const Halo_&   halo      = level.halo;
+  const int      procCount = mpx.size     ();
+  const idx_t    first     = level.firstNode ();
+  const idx_t    n         = gr.nodeCount ();
+  const idx_t    m         = n + halo.ghostIDs.size ();
+
+  IdxVector      iperm     ( n );
+  IdxVector      weights   ( m );
+  IdxVector      matched   ( m );
+  IdxVector      sbuf;
+  IdxVector      scounts;
+  IdxVector      rbuf;
+  IdxVector      rcounts;
+  IdxVector      replies;
+
+  IdxBuffer      requests;
+  IdxBuffer      ranks;
+
+  double         gain, maxGain;
+
+  idx_t          inode;
+  idx_t          jnode;
+  idx_t          gid;
+  idx_t          i, j, k;
+
+
+  iperm = jem::iarray ( n );
+
+  weights[slice(BEGIN,n)] = gr.nodeWeights;
+
+  halo.update ( mpx, weights );
+
+  if ( ilevel > 2 )
+  {
+    jem::sort ( iperm, gr.nodeWeights );
+  }
+  else
+  {
+    randomize ( iperm, rand );
+  }
+
+  match = (idx_t) UNMATCHED;
+
+  for ( int ipass = 0; ipass < MATCH_PASSES; ipass++ )
+  {
+    for ( i = 0; i < n; i++ )
+    {
+      matched[i] = (match[i] == UNMATCHED) ? 0 : 1;
+    }
+
+    halo.update ( mpx, matched );
+
+    requests.clear ();
+    ranks   .clear ();
+
+    for ( i = 0; i < n; i++ )
+    {
+      inode = iperm[i];
+
+      if ( match[inode] != UNMATCHED )
+      {
+        continue;
+      }
+
+      jnode   = -1;
+      maxGain = -1.0;
+
+      for ( j = gr.xadj[inode]; j < gr.xadj[inode + 1]; j++ )
+      {
+        k = halo.localAdj[j];
+
+        if ( k == inode || matched[k] )
+        {
+          continue;
+        }
+
+        if ( k < n )
+        {
+          if ( match[k] != UNMATCHED )
+          {
+            continue;
+          }
+        }
+        else
+        {
+          gid = halo.ghostIDs[k - n];
+
+          if ( (ipass % 2 == 0 && gid < first + inode) ||
+               (ipass % 2 == 1 && gid > first + inode) )
+          {
+            continue;
+          }
+        }
+
+        gain = (double) gr.edgeWeights[j] /
+               ((double) weights[k] + 1.0);
+
+        if ( gain > maxGain )
+        {
+          jnode   = k;
+          maxGain = gain;
+        }
+      }
+
+      if      ( jnode < 0 )
+      {
+        continue;
+      }
+      else if ( jnode < n )
+      {
+        match[inode] = first + jnode;
+        match[jnode] = first + inode;
+      }
+      else
+      {
+        gid          = halo.ghostIDs[jnode - n];
+        match[inode] = PENDING;
+
+        requests.pushBack ( first + inode );
+        requests.pushBack ( gid );
+        ranks   .pushBack ( ownerOf( level.nodeDist, gid ) );
+      }
+    }
+
+    sortByRank ( sbuf, scounts, requests, ranks, 2, procCount );
+    exchange   ( mpx, rbuf, rcounts, sbuf, scounts );
+
+    // The first request for an unmatched node is granted.
+
+    replies.resize ( rbuf.size() / 2 );
+
+    for ( i = 0; i < replies.size(); i++ )
+    {
+      inode = rbuf[2 * i + 1] - first;
+
+      if ( match[inode] == UNMATCHED )
+      {
+        match[inode] = rbuf[2 * i];
+        replies[i]   = 1;
+      }
+      else
+      {
+        replies[i]   = 0;
+      }
+    }
+
+    for ( int p = 0; p < procCount; p++ )
+    {
+      scounts[p] /= 2;
+      rcounts[p] /= 2;
+    }
+
+    rbuf.resize ( sbuf.size() / 2 );
+
+    mpx.alltoallv ( RecvBuffer ( rbuf.addr(), rbuf.size() ),
+                    scounts.addr (),
+                    SendBuffer ( replies.addr(), replies.size() ),
+                    rcounts.addr () );
+
+    for ( i = 0; i < rbuf.size(); i++ )
+    {
+      inode = sbuf[2 * i] - first;
+
+      if ( rbuf[i] )
+      {
+        match[inode] = sbuf[2 * i + 1];
+      }
+      else
+      {
+        match[inode] = UNMATCHED;
+      }
+    }
+  }
+
+  for ( i = 0; i < n; i++ )
+  {
+    if ( match[i] < 0 )
+    {
+      match[i] = first + i;
+    }
+  }
+}
+
+
+//=======================================================================
+//   class MPPartitioner::Halo_ (implementation)
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   init
+//-----------------------------------------------------------------------
+
+
+void MPPartitioner::Halo_::init
+
+  ( MPContext&        mpx,
+    const WGraph&     gr,
+    const IdxVector&  nodeDist )
+
+{
+  const int    procCount = mpx.size   ();
+  const idx_t  first     = nodeDist[mpx.myRank()];
+  const idx_t  edgeCount = gr.adjncy.size ();
+
+  IdxBuffer    gids;
+
+  idx_t        gid;
+  idx_t        i, j;
+
+
+  nodeCount = gr.nodeCount ();
+
+  for ( i = 0; i < edgeCount; i++ )
+  {
+    gid = gr.adjncy[i];
+
+    if ( gid < first || gid >= first + nodeCount )
+    {
+      gids.pushBack ( gid );
+    }
+  }
+
+  ghostIDs.ref ( gids.toArray() );
+
+  jem::sort ( ghostIDs );
+
+  for ( i = j = 0; i < ghostIDs.size(); i++ )
+  {
+    if ( j == 0 || ghostIDs[j - 1] != ghostIDs[i] )
+    {
+      ghostIDs[j++] = ghostIDs[i];
+    }
+  }
+
+  ghostIDs.reshape ( j );
+  recvCounts.resize ( procCount );
+
+  recvCounts = 0_idx;
+
+  for ( i = 0; i < j; i++ )
+  {
+    recvCounts[Utils_::ownerOf( nodeDist, ghostIDs[i] )]++;
+  }
+
+  Utils_::exchange ( mpx, sendNodes, sendCounts,
+                     ghostIDs, recvCounts );
+
+  for ( i = 0; i < sendNodes.size(); i++ )
+  {
+    sendNodes[i] -= first;
+  }
+
+  localAdj.resize ( edgeCount );
+
+  for ( i = 0; i < edgeCount; i++ )
+  {
+    gid = gr.adjncy[i];
+
+    if ( gid < first || gid >= first + nodeCount )
+    {
+      localAdj[i] = ghostIndex ( gid );
+    }
+    else
+    {
+      localAdj[i] = gid - first;
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   update
+//-----------------------------------------------------------------------
+
+// Copies the values of the local nodes to the ghost nodes on the
+// other processes.
+
+
+void MPPartitioner::Halo_::update
+
+  ( MPContext&        mpx,
+    const IdxVector&  values ) const
+
+{
+  const idx_t  n = sendNodes.size ();
+
+  IdxVector    sbuf ( n );
+
+
+  for ( idx_t i = 0; i < n; i++ )
+  {
+    sbuf[i] = values[sendNodes[i]];
+  }
+
+  mpx.alltoallv ( RecvBuffer ( values.addr() + nodeCount,
+                               ghostIDs.size() ),
+                  recvCounts.addr (),
+                  SendBuffer ( sbuf.addr(), n ),
+                  sendCounts.addr () );
+}
+
+
+//-----------------------------------------------------------------------
+//   ghostIndex
+//-----------------------------------------------------------------------
+
+
+inline idx_t MPPartitioner::Halo_::ghostIndex ( idx_t gid ) const
+{
+  return nodeCount + jem::binarySearch ( gid, ghostIDs );
+}
+
+
+//=======================================================================
+//   class MPPartitioner
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+const char*  MPPartitioner::TYPE_NAME  = "MP";
+const int    MPPartitioner::MAX_PASSES = 8;
+
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+MPPartitioner::MPPartitioner
+
+  ( const String&            name,
+    const Ref<Random>&       rand,
+    const Ref<Partitioner>&  parter ) :
+
+    Super      ( name   ),
+    rand_      ( rand   ),
+    parter_    ( parter )
+
+{
+  if ( ! rand_ )
+  {
+    rand_ = newInstance<Random> ();
+  }
+
+  if ( ! parter_ )
+  {
+    parter_ = newInstance<MLPartitioner> (
+      joinNames ( myName_, PropNames::PARTITIONER ),
+      rand_
+    );
+  }
+
+  maxPasses_ = MAX_PASSES;
+}
+
+
+MPPartitioner::~MPPartitioner ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   configure & getConfig
+//-----------------------------------------------------------------------
+
+
+void MPPartitioner::configure ( const Properties& props )
+{
+  using jem::maxOf;
+
+  if ( props.contains( myName_ ) )
+  {
+    Properties  myProps = props.findProps ( myName_ );
+
+    myProps.find ( maxPasses_,
+                   PropNames::MAX_PASSES,
+                   0, maxOf( maxPasses_ ) );
+  }
+
+  parter_->configure ( props );
+}
+
+
+void MPPartitioner::getConfig ( const Properties& props ) const
+{
+  Properties  myProps = props.makeProps ( myName_ );
+
+  myProps.set ( PropNames::MAX_PASSES, maxPasses_ );
+
+  parter_->getConfig ( props );
+}
+
+
+//-----------------------------------------------------------------------
+//   partition
+//-----------------------------------------------------------------------
+
+
+void MPPartitioner::partition
+
+  ( MPContext&        mpx,
+    const IdxVector&  nodeMap,
+    const WGraph&     graph,
+    const IdxVector&  nodeDist,
+    const Control&    ctrl )
+
+{
+  JEM_PRECHECK2 ( nodeDist.size() == mpx.size() + 1,
+                  "invalid node distribution array" );
+  JEM_PRECHECK2 ( nodeMap.size() == graph.nodeCount(),
+                  "node map size mismatch" );
+
+  using jem::io::endl;
+  using jem::System;
+  using jem::util::ObjFlex;
+
+  const int      myRank    = mpx.myRank  ();
+  const idx_t    partCount = ctrl.partCount ();
+  const idx_t    first     = nodeDist[myRank];
+  const idx_t    nodeCount = graph.nodeCount ();
+
+  Ref<Level_>    fine;
+  Ref<Level_>    coarse;
+  IdxVector      labels;
+  IdxVector      coarseLabels;
+
+  ObjFlex        levels;
+
+  idx_t          fineCount;
+  idx_t          coarseCount;
+
+
+  JEM_PRECHECK2 ( nodeDist[myRank + 1] - first == nodeCount,
+                  "node distribution does not match the graph" );
+
+  fineCount = nodeDist[mpx.size()];
+
+  // Handle the trivial cases:
+
+  if ( fineCount == 0 || partCount == 0 )
+  {
+    return;
+  }
+
+  if ( partCount == 1 )
+  {
+    nodeMap = 0_idx;
+
+    return;
+  }
+
+  if ( partCount >= fineCount )
+  {
+    for ( idx_t inode = 0; inode < nodeCount; inode++ )
+    {
+      nodeMap[inode] = first + inode;
+    }
+
+    return;
+  }
+
+  coarse = newInstance<Level_> ( mpx, graph, nodeDist );
+
+  levels.reserve  ( 16 );
+  levels.pushBack ( coarse );
+
+  while ( fineCount > 16 * partCount &&
+          levels.size() < Utils_::MAX_LEVELS )
+  {
+    fine.swap ( coarse );
+
+    coarse      = coarsen_ ( mpx, *fine, levels.size() );
+    coarseCount = coarse->nodeDist[mpx.size()];
+
+    if ( coarseCount == fineCount )
+    {
+      coarse = fine;
+      break;
+    }
+
+    levels.pushBack ( coarse );
+
+    if ( fineCount < (idx_t) (1.5 * (double) coarseCount) )
+    {
+      break;
+    }
+
+    fineCount = coarseCount;
+  }
+
+  if ( myRank == 0 )
+  {
+    print ( System::info( myName_ ), myName_,
+            " : level count = ",        levels.size(),
+            ", coarsest graph size = ", coarse->nodeDist[mpx.size()],
+            endl );
+  }
+
+  coarseLabels.resize ( coarse->graph.nodeCount() );
+
+  partitionCoarsest_ ( mpx, coarseLabels, *coarse, ctrl );
+
+  // Uncoarsen the graph
+
+  while ( levels.size() > 1 )
+  {
+    levels.popBack ();
+
+    fine = static_cast<Level_*> ( levels.back() );
+
+    labels.resize ( fine->graph.nodeCount() );
+
+    Utils_::fetch ( mpx, labels, fine->coarseMap,
+                    coarse->nodeDist, coarseLabels );
+
+    refine_ ( mpx, labels, *fine, ctrl );
+
+    coarse = fine;
+
+    coarseLabels.swap ( labels );
+  }
+
+  nodeMap = coarseLabels;
+}
+
+
+//-----------------------------------------------------------------------
+//   makeNew
+//-----------------------------------------------------------------------
+
+
+Ref<Partitioner> MPPartitioner::makeNew
+
+  ( const String&      myName,
+    const Properties&  conf,
+    const Properties&  props,
+    const Properties&  globdat )
+
+{
+  Ref<Random>       rand = Random::get ( globdat );
+
+  Ref<Partitioner>  parter;
+
+  String            name = joinNames ( myName,
+                                       PropNames::PARTITIONER );
+
+
+  if ( props.contains( name ) )
+  {
+    parter = PartitionerFactory::newInstance ( name,  conf,
+                                               props, globdat );
+  }
+  else
+  {
+    conf.makeProps(name).set ( PropNames::TYPE,
+                               MLPartitioner::TYPE_NAME );
+
+    parter = MLPartitioner::makeNew ( name, conf, props, globdat );
+  }
+
+  return newInstance<Self> ( myName, rand, parter );
+}
+
+
+//-----------------------------------------------------------------------
+//   declare
+//-----------------------------------------------------------------------
+
+
+void MPPartitioner::declare ()
+{
+  PartitionerFactory::declare ( TYPE_NAME,  & makeNew );
+  PartitionerFactory::declare ( CLASS_NAME, & makeNew );
+}
+
+
+//-----------------------------------------------------------------------
+//   partition_
+//-----------------------------------------------------------------------
+
+
+void MPPartitioner::partition_
+
+  ( Partition&      part,
+    const Control&  ctrl )
+
+{
+  const idx_t       nodeCount = part.nodeCount ();
+
+  Ref<MPContext>    mpx       = newInstance<jem::mp::UniContext> ();
+
+  IdxVector         nodeMap   ( nodeCount );
+  IdxVector         nodeDist  ( 2 );
+
+
+  nodeDist[0] = 0;
+  nodeDist[1] = nodeCount;
+
+  partition ( *mpx, nodeMap, part.getGraph(), nodeDist, ctrl );
+
+  part.mapNodes ( nodeMap );
+}
+
+
+//-----------------------------------------------------------------------
+//   coarsen_
+//-----------------------------------------------------------------------
+
+
+Ref<MPPartitioner::Level_> MPPartitioner::coarsen_
+
+  ( MPContext&  mpx,
+    Level_&     fine,
+    idx_t       ilevel )
+
+{
+  const WGraph&  gr        = fine.graph;
+  const Halo_&   halo      = fine.halo;
+  const int      procCount = mpx.size     ();
+  const int      myRank    = mpx.myRank   ();
+  const idx_t    first     = fine.firstNode ();
+  const idx_t    n         = gr.nodeCount ();
+  const idx_t    m         = n + halo.ghostIDs.size ();
+
+  IdxVector      match     ( n );
+  IdxVector      cmap      ( m );
+  IdxVector      counts    ( procCount );
+  IdxVector      cdist     ( procCount + 1 );
+  IdxVector      sbuf;
+  IdxVector      scounts;
+  IdxVector      rbuf;
+  IdxVector      rcounts;
+
+  IdxBuffer      records;
+  IdxBuffer      ranks;
+
+  idx_t          cfirst;
+  idx_t          cn;
+  idx_t          c, d;
+  idx_t          i, j, k;
+
+
+  Utils_::matchNodes ( mpx, match, fine, *rand_, ilevel );
+
+  // The node with the lowest global index owns the coarse node.
+
+  cn = 0;
+
+  for ( i = 0; i < n; i++ )
+  {
+    if ( match[i] >= first + i )
+    {
+      cn++;
+    }
+  }
+
+  counts         = 0_idx;
+  counts[myRank] = cn;
+
+  mpx.allreduce ( RecvBuffer ( cdist.addr(), procCount ),
+                  SendBuffer ( counts.addr(), procCount ),
+                  jem::mp::SUM );
+
+  for ( j = 0, i = 0; i < procCount; i++ )
+  {
+    k        = cdist[i];
+    cdist[i] = j;
+    j       += k;
+  }
+
+  cdist[procCount] = j;
+  cfirst           = cdist[myRank];
+
+  cmap = -1_idx;
+  k    =  0;
+
+  for ( i = 0; i < n; i++ )
+  {
+    if ( match[i] >= first + i )
+    {
+      cmap[i] = cfirst + k++;
+    }
+  }
+
+  for ( i = 0; i < n; i++ )
+  {
+    j = match[i] - first;
+
+    if ( j >= 0 && j < n && j < i )
+    {
+      cmap[i] = cmap[j];
+    }
+  }
+
+  halo.update ( mpx, cmap );
+
+  for ( i = 0; i < n; i++ )
+  {
+    if ( cmap[i] < 0 )
+    {
+      cmap[i] = cmap[halo.ghostIndex( match[i] )];
+    }
+  }
+
+  halo.update ( mpx, cmap );
+
+  fine.coarseMap.ref ( cmap[slice(BEGIN,n)] );
+
+  // Send the node weights and edges to the owners of the coarse
+  // nodes. Each record contains a coarse node, a coarse neighbor
+  // (or -1 for the node weight) and a weight.
+
+  for ( i = 0; i < n; i++ )
+  {
+    c = cmap[i];
+    k = Utils_::ownerOf ( cdist, c );
+
+    records.pushBack ( c  );
+    records.pushBack ( -1 );
+    records.pushBack ( gr.nodeWeights[i] );
+    ranks  .pushBack ( k  );
+
+    for ( j = gr.xadj[i]; j < gr.xadj[i + 1]; j++ )
+    {
+      d = cmap[halo.localAdj[j]];
+
+      if ( d != c )
+      {
+        records.pushBack ( c );
+        records.pushBack ( d );
+        records.pushBack ( gr.edgeWeights[j] );
+        ranks  .pushBack ( k );
+      }
+    }
+  }
+
+  Utils_::sortByRank ( sbuf, scounts, records, ranks, 3, procCount );
+  Utils_::exchange   ( mpx, rbuf, rcounts, sbuf, scounts );
+
+  records.clear ();
+  ranks  .clear ();
+
+  // Assemble the local part of the coarse graph.
+
+  const idx_t  recCount = rbuf.size () / 3;
+
+  IdxVector    xadj     ( cn + 1 );
+  IdxVector    nweights ( cn );
+  IdxVector    adjncy;
+  IdxVector    eweights;
+  IdxVector    iperm;
+  IdxVector    tmp;
+
+  xadj     = 0_idx;
+  nweights = 0_idx;
+
+  for ( i = 0; i < recCount; i++ )
+  {
+    c = rbuf[3 * i] - cfirst;
+
+    if ( rbuf[3 * i + 1] < 0 )
+    {
+      nweights[c] += rbuf[3 * i + 2];
+    }
+    else
+    {
+      xadj[c + 1]++;
+    }
+  }
+
+  for ( i = 0; i < cn; i++ )
+  {
+    xadj[i + 1] += xadj[i];
+  }
+
+  adjncy  .resize ( xadj[cn] );
+  eweights.resize ( xadj[cn] );
+
+  for ( i = 0; i < recCount; i++ )
+  {
+    if ( rbuf[3 * i + 1] >= 0 )
+    {
+      c           = rbuf[3 * i] - cfirst;
+      j           = xadj[c]++;
+      adjncy  [j] = rbuf[3 * i + 1];
+      eweights[j] = rbuf[3 * i + 2];
+    }
+  }
+
+  for ( i = cn; i > 0; i-- )
+  {
+    xadj[i] = xadj[i - 1];
+  }
+
+  xadj[0] = 0;
+
+  // Merge duplicate edges.
+
+  iperm.resize ( adjncy.size() );
+  tmp  .resize ( 2 * adjncy.size() );
+
+  for ( i = k = 0; i < cn; i++ )
+  {
+    const idx_t  jfirst = xadj[i];
+    const idx_t  jlast  = xadj[i + 1];
+
+    IdxVector    ip     ( iperm[slice(jfirst,jlast)] );
+
+    for ( j = jfirst; j < jlast; j++ )
+    {
+      ip[j - jfirst] = j;
+    }
+
+    jem::sort ( ip, adjncy );
+
+    for ( j = jfirst; j < jlast; j++ )
+    {
+      tmp[2 * j]     = adjncy  [ip[j - jfirst]];
+      tmp[2 * j + 1] = eweights[ip[j - jfirst]];
+    }
+
+    xadj[i] = k;
+
+    for ( j = jfirst; j < jlast; j++ )
+    {
+      d = tmp[2 * j];
+
+      if ( k > xadj[i] && adjncy[k - 1] == d )
+      {
+        eweights[k - 1] += tmp[2 * j + 1];
+      }
+      else
+      {
+        adjncy  [k] = d;
+        eweights[k] = tmp[2 * j + 1];
+        k++;
+      }
+    }
+  }
+
+  xadj[cn] = k;
+
+  WGraph  cgraph ( xadj,
+                   adjncy  [slice(BEGIN,k)].clone (),
+                   nweights,
+                   eweights[slice(BEGIN,k)].clone () );
+
+  return newInstance<Level_> ( mpx, cgraph, cdist );
+}
+
+
+//-----------------------------------------------------------------------
+//   partitionCoarsest_
+//-----------------------------------------------------------------------
+
+
+void MPPartitioner::partitionCoarsest_
+
+  ( MPContext&        mpx,
+    const IdxVector&  nodeMap,
+    const Level_&     coarse,
+    const Control&    ctrl )
+
+{
+  const WGraph&  gr        = coarse.graph;
+  const int      procCount = mpx.size   ();
+  const int      myRank    = mpx.myRank ();
+  const idx_t    n         = gr.nodeCount ();
+  const idx_t    nnz       = gr.adjncy.size ();
+
+  IdxVector      sbuf      ( 2 * (n + nnz) );
+  IdxVector      scounts   ( procCount );
+  IdxVector      rbuf;
+  IdxVector      rcounts;
+
+  idx_t          i;
+
+
+  // Gather the graph on the first process. Each process sends its
+  // node weights, row sizes, adjacency array and edge weights.
+
+  sbuf[slice(0,n)] = gr.nodeWeights;
+
+  for ( i = 0; i < n; i++ )
+  {
+    sbuf[n + i] = gr.xadj[i + 1] - gr.xadj[i];
+  }
+
+  sbuf[slice(2 * n,2 * n + nnz)]           = gr.adjncy[slice(gr.xadj[0],
+                                                             gr.xadj[n])];
+  sbuf[slice(2 * n + nnz,2 * (n + nnz))]   =
+    gr.edgeWeights[slice(gr.xadj[0],gr.xadj[n])];
+
+  scounts    = 0_idx;
+  scounts[0] = sbuf.size ();
+
+  Utils_::exchange ( mpx, rbuf, rcounts, sbuf, scounts );
+
+  IdxVector  gmap;
+
+  scounts = 0_idx;
+
+  if ( myRank == 0 )
+  {
+    const idx_t  gn = coarse.nodeDist[procCount];
+
+    IdxVector    xadj     ( gn + 1 );
+    IdxVector    nweights ( gn );
+    IdxVector    adjncy   ( rbuf.size() / 2 - gn );
+    IdxVector    eweights ( adjncy.size() );
+
+    idx_t        j, k, p, pn, pnnz, ioff;
+
+    gmap.resize ( gn );
+
+    xadj[0] = 0;
+    ioff    = 0;
+    k       = 0;
+
+    for ( p = 0; p < procCount; p++ )
+    {
+      const idx_t  first = coarse.nodeDist[p];
+
+      pn          = coarse.nodeDist[p + 1] - first;
+      pnnz        = rcounts[p] / 2 - pn;
+      scounts[p]  = pn;
+
+      for ( i = 0; i < pn; i++ )
+      {
+        nweights[first + i]   = rbuf[ioff + i];
+        xadj[first + i + 1]   = xadj[first + i] + rbuf[ioff + pn + i];
+      }
+
+      for ( j = 0; j < pnnz; j++, k++ )
+      {
+        adjncy  [k] = rbuf[ioff + 2 * pn + j];
+        eweights[k] = rbuf[ioff + 2 * pn + pnnz + j];
+      }
+
+      ioff += rcounts[p];
+    }
+
+    WGraph  graph ( xadj, adjncy, nweights, eweights );
+
+    parter_->partition ( gmap, graph, ctrl );
+  }
+
+  rcounts    = 0_idx;
+  rcounts[0] = n;
+
+  mpx.alltoallv ( RecvBuffer ( nodeMap.addr(), n ),
+                  rcounts.addr (),
+                  SendBuffer ( gmap.addr(), gmap.size() ),
+                  scounts.addr () );
+}
+
+
+//-----------------------------------------------------------------------
+//   refine_
+//-----------------------------------------------------------------------
+
+// Improves the partition by moving nodes to the neighboring part to
+// which they are connected most strongly. Each process may only use
+// a fraction of the weight that a part can still receive, so that
+// the global balance constraints are met after each sweep. The
+// moves are restricted to higher (even sweeps) or lower (odd
+// sweeps) part indices to avoid that neighboring nodes on different
+// processes are swapped back and forth.
+
+
+void MPPartitioner::refine_
+
+  ( MPContext&        mpx,
+    const IdxVector&  nodeMap,
+    Level_&           level,
+    const Control&    ctrl )
+
+{
+  const WGraph&  gr        = level.graph;
+  const Halo_&   halo      = level.halo;
+  const idx_t    procCount = mpx.size     ();
+  const idx_t    partCount = ctrl.partCount ();
+  const idx_t    n         = gr.nodeCount ();
+  const idx_t    m         = n + halo.ghostIDs.size ();
+
+  IdxVector      labels    ( m );
+  IdxVector      iperm     ( n );
+  IdxVector      pw        ( partCount );
+  IdxVector      delta     ( partCount );
+  IdxVector      dsum      ( partCount );
+  IdxVector      conn      ( partCount );
+  IdxVector      maxDelta  ( partCount );
+  IdxVector      tgtDelta  ( partCount );
+  IdxVector      touched   ( partCount );
+
+  idx_t          ipart, jpart, kpart;
+  idx_t          moved, lastMoved;
+  idx_t          nt, w, w2;
+  idx_t          gain, maxConn;
+  idx_t          i, j, k;
+  bool           accept;
+
+
+  labels[slice(BEGIN,n)] = nodeMap;
+
+  delta = 0_idx;
+  conn  = 0_idx;
+
+  for ( i = 0; i < n; i++ )
+  {
+    delta[nodeMap[i]] += gr.nodeWeights[i];
+  }
+
+  mpx.allreduce ( RecvBuffer ( pw.addr(),    partCount ),
+                  SendBuffer ( delta.addr(), partCount ),
+                  jem::mp::SUM );
+
+  iperm     = jem::iarray ( n );
+  lastMoved = -1;
+
+  for ( int isweep = 0; isweep < maxPasses_; isweep++ )
+  {
+    halo.update ( mpx, labels );
+    randomize   ( iperm, *rand_ );
+
+    for ( ipart = 0; ipart < partCount; ipart++ )
+    {
+      maxDelta[ipart] =
+
+        jem::max ( 0_idx, ctrl.maxWeight( ipart ) - pw[ipart] ) /
+        procCount;
+
+      tgtDelta[ipart] =
+
+        jem::max ( 0_idx, ctrl.targetWeight( ipart ) - pw[ipart] ) /
+        procCount;
+    }
+
+    delta = 0_idx;
+    moved = 0;
+
+    for ( i = 0; i < n; i++ )
+    {
+      k     = iperm[i];
+      ipart = labels[k];
+      w     = gr.nodeWeights[k];
+      nt    = 0;
+
+      for ( j = gr.xadj[k]; j < gr.xadj[k + 1]; j++ )
+      {
+        kpart = labels[halo.localAdj[j]];
+
+        if ( conn[kpart] == 0 )
+        {
+          touched[nt++] = kpart;
+        }
+
+        conn[kpart] += gr.edgeWeights[j];
+      }
+
+      jpart   = -1;
+      maxConn = -1;
+
+      for ( j = 0; j < nt; j++ )
+      {
+        kpart = touched[j];
+
+        if ( kpart == ipart                       ||
+             (isweep % 2 == 0 && kpart < ipart)   ||
+             (isweep % 2 == 1 && kpart > ipart) )
+        {
+          continue;
+        }
+
+        if ( conn[kpart] > maxConn )
+        {
+          jpart   = kpart;
+          maxConn = conn[kpart];
+        }
+      }
+
+      if ( jpart >= 0 )
+      {
+        gain = maxConn - conn[ipart];
+        w2   = pw[ipart] + delta[ipart];
+
+        // Move the node if that reduces the edge cut, or if that
+        // improves the balance without increasing the edge cut
+        // too much.
+
+        if ( gain > 0 )
+        {
+          accept = (delta[jpart] + w <= maxDelta[jpart]);
+        }
+        else if ( w2 > ctrl.targetWeight( ipart ) )
+        {
+          accept = ((gain == 0 || w2 > ctrl.maxWeight( ipart )) &&
+                    delta[jpart] + w <= tgtDelta[jpart]);
+        }
+        else
+        {
+          accept = false;
+        }
+
+        if ( ! accept )
+        {
+          jpart = -1;
+        }
+      }
+
+      if ( jpart >= 0 )
+      {
+        labels[k]     = jpart;
+        delta[ipart] -= w;
+        delta[jpart] += w;
+        moved++;
+      }
+
+      for ( j = 0; j < nt; j++ )
+      {
+        conn[touched[j]] = 0;
+      }
+    }
+
+    mpx.allreduce ( RecvBuffer ( dsum.addr(),  partCount ),
+                    SendBuffer ( delta.addr(), partCount ),
+                    jem::mp::SUM );
+
+    for ( ipart = 0; ipart < partCount; ipart++ )
+    {
+      pw[ipart] += dsum[ipart];
+    }
+
+    moved = jem::mp::allsum ( mpx, moved );
+
+    // Stop if no nodes have been moved in both directions.
+
+    if ( moved == 0 && lastMoved == 0 )
+    {
+      break;
+    }
+
+    lastMoved = moved;
+  }
+
+  nodeMap = labels[slice(BEGIN,n)];
+}
+
+
+JIVE_END_PACKAGE( graph )
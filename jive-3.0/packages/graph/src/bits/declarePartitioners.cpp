@@ -38,6 +38,7 @@
 #include <jive/graph/GreedyPartitioner.h>
 #include <jive/graph/GrowBisectioner.h>
 #include <jive/graph/MLPartitioner.h>
+#include <jive/graph/MPPartitioner.h>
 #include <jive/graph/RBPartitioner.h>
 #include <jive/graph/declare.h>
 
@@ -60,6 +61,7 @@ static void declarePartitioners_ ()
   GreedyPartitioner :: declare ();
   GrowBisectioner   :: declare ();
   MLPartitioner     :: declare ();
+  MPPartitioner     :: declare ();
   RBPartitioner     :: declare ();
 }
 
@@ -83,7 +83,10 @@ const char*  MPModel::TYPE_NAME = "MP";
 //-----------------------------------------------------------------------
 
 
-MPModel::MPModel ()
+MPModel::MPModel () :
+
+  splitMatmul_ ( false )
+
 {}
 
 
@@ -94,10 +97,11 @@ MPModel::MPModel
     Ref<TableExchanger>    tex,
     Ref<VectorExchanger>   vex ) :
 
-    Super  ( name  ),
-    child_ ( child ),
-    tex_   ( tex   ),
-    vex_   ( vex   )
+    Super        ( name  ),
+    child_       ( child ),
+    tex_         ( tex   ),
+    vex_         ( vex   ),
+    splitMatmul_ ( false )
 
 {
   JEM_PRECHECK ( child );
@@ -134,7 +138,8 @@ MPModel::MPModel
     const Properties&  props,
     const Properties&  globdat ) :
 
-    Super ( name )
+    Super        ( name  ),
+    splitMatmul_ ( false )
 
 {
   using jive::util::joinNames;
@@ -198,7 +203,8 @@ void MPModel::readFrom ( ObjectInput& in )
   decode ( in,
            tabNames_,
            vecActions_,
-           vecNames_ );
+           vecNames_,
+           splitMatmul_ );
 }
 
 
@@ -218,7 +224,8 @@ void MPModel::writeTo ( ObjectOutput& out ) const
   encode ( out,
            tabNames_,
            vecActions_,
-           vecNames_ );
+           vecNames_,
+           splitMatmul_ );
 }
 
 
@@ -311,6 +318,8 @@ void MPModel::configure
         throw;
       }
     }
+
+    myProps.find ( splitMatmul_, PropNames::SPLIT_MATMUL );
   }
 
   child_->configure ( props, globdat );
@@ -345,8 +354,9 @@ void MPModel::getConfig
     vectors[2 * i + 1] = vecNames_  [i];
   }
 
-  myProps.set ( PropNames::TABLES,  tables  );
-  myProps.set ( PropNames::VECTORS, vectors );
+  myProps.set ( PropNames::TABLES,       tables       );
+  myProps.set ( PropNames::VECTORS,      vectors      );
+  myProps.set ( PropNames::SPLIT_MATMUL, splitMatmul_ );
 
   child_->getConfig ( props, globdat );
 }
@@ -473,9 +483,13 @@ bool MPModel::takeAction
       {
         if ( ! mat->isDistributed() )
         {
-          mat = newInstance<MPMatrixObj> ( mat, vex_ );
+          Ref<MPMatrixObj>  mpMat =
+
+            newInstance<MPMatrixObj> ( mat, vex_ );
+
+          mpMat->setSplitMatmul ( splitMatmul_ );
 
-          params.set ( ActionParams::MATRIX[i], mat );
+          params.set ( ActionParams::MATRIX[i], mpMat );
         }
       }
 
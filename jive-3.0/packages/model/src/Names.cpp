@@ -50,27 +50,28 @@ const char*  RunvarNames::LOAD_SCALE    = "loadScale";
 //=======================================================================
 
 
-const char*  PropertyNames::CONSTANT    = "constant";
-const char*  PropertyNames::CON_TABLE   = "conTable";
-const char*  PropertyNames::DEBUG       = "debug";
-const char*  PropertyNames::EPSILON     = "epsilon";
-const char*  PropertyNames::FILTERS     = "actionFilters";
-const char*  PropertyNames::ITEMS       = "items";
-const char*  PropertyNames::LINEAR      = "linear";
-const char*  PropertyNames::LOAD_CASE   = "loadCase";
-const char*  PropertyNames::LOAD_SCALE  = "loadScale";
-const char*  PropertyNames::LOAD_TABLE  = "loadTable";
-const char*  PropertyNames::MATRIX      = "matrix";
-const char*  PropertyNames::MATRIX0     = "matrix0";
-const char*  PropertyNames::MATRIX1     = "matrix1";
-const char*  PropertyNames::MATRIX2     = "matrix2";
-const char*  PropertyNames::MODEL       = "model";
-const char*  PropertyNames::MODELS      = "models";
-const char*  PropertyNames::NOISE_LEVEL = "noiseLevel";
-const char*  PropertyNames::SCALE_FUNC  = "scaleFunc";
-const char*  PropertyNames::SYMMETRIC   = "symmetric";
-const char*  PropertyNames::TABLES      = "tables";
-const char*  PropertyNames::VECTORS     = "vectors";
+const char*  PropertyNames::CONSTANT     = "constant";
+const char*  PropertyNames::CON_TABLE    = "conTable";
+const char*  PropertyNames::DEBUG        = "debug";
+const char*  PropertyNames::EPSILON      = "epsilon";
+const char*  PropertyNames::FILTERS      = "actionFilters";
+const char*  PropertyNames::ITEMS        = "items";
+const char*  PropertyNames::LINEAR       = "linear";
+const char*  PropertyNames::LOAD_CASE    = "loadCase";
+const char*  PropertyNames::LOAD_SCALE   = "loadScale";
+const char*  PropertyNames::LOAD_TABLE   = "loadTable";
+const char*  PropertyNames::MATRIX       = "matrix";
+const char*  PropertyNames::MATRIX0      = "matrix0";
+const char*  PropertyNames::MATRIX1      = "matrix1";
+const char*  PropertyNames::MATRIX2      = "matrix2";
+const char*  PropertyNames::MODEL        = "model";
+const char*  PropertyNames::MODELS       = "models";
+const char*  PropertyNames::NOISE_LEVEL  = "noiseLevel";
+const char*  PropertyNames::SCALE_FUNC   = "scaleFunc";
+const char*  PropertyNames::SPLIT_MATMUL = "splitMatmul";
+const char*  PropertyNames::SYMMETRIC    = "symmetric";
+const char*  PropertyNames::TABLES       = "tables";
+const char*  PropertyNames::VECTORS      = "vectors";
 
 
 JIVE_END_PACKAGE( model )
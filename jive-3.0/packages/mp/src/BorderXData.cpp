@@ -61,11 +61,13 @@ void BorderXData::init ()
 
   borderCount = topo.size (0);
 
-  borderIDs.resize ( borderCount );
+  borderIDs  .resize ( borderCount );
+  borderRanks.resize ( borderCount );
 
   for ( idx_t ib = 0; ib < borderCount; ib++ )
   {
-    borderIDs[ib] = borders.getBorderID ( ib );
+    borderIDs[ib]   = borders.getBorderID ( ib );
+    borderRanks[ib] = (int) borderIDs[ib];
   }
 
   borderOffsets.ref ( topo.getRowOffsets()    );
@@ -95,6 +97,7 @@ void BorderXData::init2
     sd.borderCount = rd.borderCount;
 
     sd.borderIDs    .ref ( rd.borderIDs     );
+    sd.borderRanks  .ref ( rd.borderRanks   );
     sd.borderOffsets.ref ( rd.borderOffsets );
     sd.borderItems  .ref ( rd.borderItems   );
   }
@@ -30,6 +30,7 @@
  */
 
 
+#include <cstring>
 #include <jem/base/assert.h>
 #include <jem/base/ClassTemplate.h>
 #include <jem/base/IllegalArgumentException.h>
@@ -37,7 +38,6 @@
 #include <jem/base/array/intrinsics.h>
 #include <jem/mp/Buffer.h>
 #include <jem/mp/Context.h>
-#include <jem/mp/RequestList.h>
 #include <jem/util/Event.h>
 #include <jem/util/Properties.h>
 #include <jive/log.h>
@@ -59,7 +59,6 @@ using jem::newInstance;
 using jem::Array;
 using jem::mp::RecvBuffer;
 using jem::mp::SendBuffer;
-using jem::mp::RequestList;
 using jive::util::DBColumn;
 
 
@@ -85,6 +84,8 @@ class DataExchanger::XData_ : public BorderXData
   IdxVector                 rowSizes;
   IdxVector                 intBuffer;
   Vector                    floatBuffer;
+  IdxVector                 msgSizes;
+  Array<jem::byte>          msgBuffer;
 
 };
 
@@ -113,16 +114,9 @@ class DataExchanger::RecvData_ : public XData_
   typedef XData_            Super;
 
 
-  inline                    RecvData_
+  explicit inline           RecvData_
 
-    ( const Ref<Context>&     mpx,
-      const BorderSet&        borders );
-
-
- public:
-
-  Ref<RequestList>          requests;
-  idx_t                     rbufSize;
+    ( const BorderSet&        borders );
 
 };
 
@@ -134,15 +128,11 @@ class DataExchanger::RecvData_ : public XData_
 
 inline DataExchanger::RecvData_::RecvData_
 
-  ( const Ref<Context>&  mpx,
-    const BorderSet&     borders ) :
+  ( const BorderSet&  borders ) :
 
     Super ( borders )
 
-{
-  requests = mpx->newRequestList ();
-  rbufSize = 0;
-}
+{}
 
 
 //=======================================================================
@@ -166,7 +156,6 @@ class DataExchanger::SendData_ : public XData_
  public:
 
   Ref<Context>              mpContext;
-  idx_t                     maxMsgSize;
 
 };
 
@@ -184,15 +173,20 @@ inline DataExchanger::SendData_::SendData_
     Super      ( borders ),
     mpContext  (     mpx )
 
-{
-  maxMsgSize = 0;
-}
+{}
 
 
 //=======================================================================
 //   class DataExchanger::Utils_
 //=======================================================================
 
+// The row sizes of all columns are exchanged first. The data of all
+// integer and floating point columns are then packed into a single
+// message per neighbor. The row sizes of a border are stored column
+// by column, the integer columns first. The exchanged data are stored
+// in the same order, but separately for the integer and floating
+// point columns.
+
 
 class DataExchanger::Utils_
 {
@@ -207,15 +201,33 @@ class DataExchanger::Utils_
       SendData_&              sd,
       const ColumnArray&      cols );
 
-  template <class T, class Column>
-
-    static void             exchangeData
+  static void               exchangeData
 
     ( RecvData_&              rd,
       SendData_&              sd,
-      Array<T>&               rbuf,
-      Array<T>&               sbuf,
-      const Array<Column*>&   cols );
+      const IntColArray&      icols,
+      const FloatColArray&    fcols );
+
+  static void               getDataSizes
+
+    ( idx_t&                  isize,
+      idx_t&                  fsize,
+      const XData_&           xdata,
+      idx_t                   ib,
+      idx_t                   icolCount,
+      idx_t                   colCount );
+
+  template <class T, class Column>
+
+    static idx_t            packData
+
+    ( jem::byte*              buf,
+      Array<T>&               tbuf,
+      const XData_&           xdata,
+      idx_t                   ib,
+      const Array<Column*>&   cols,
+      idx_t                   jcol0,
+      idx_t                   colCount );
 
   template <class T, class Column>
 
@@ -223,7 +235,9 @@ class DataExchanger::Utils_
 
     ( const RecvData_&        rd,
       const Array<T>&         rbuf,
-      const Array<Column*>&   cols );
+      const Array<Column*>&   cols,
+      idx_t                   jcol0,
+      idx_t                   colCount );
 
   template <class T, class Column>
 
@@ -231,7 +245,9 @@ class DataExchanger::Utils_
 
     ( const RecvData_&        rd,
       const Array<T>&         rbuf,
-      const Array<Column*>&   cols );
+      const Array<Column*>&   cols,
+      idx_t                   jcol0,
+      idx_t                   colCount );
 
 };
 
@@ -253,44 +269,33 @@ void DataExchanger::Utils_::exchangeRowSizes
   DBColumn*    col;
   idx_t*       ptr;
 
-  int          rank;
-  idx_t        msgSize;
   idx_t        ifirst;
   idx_t        ilast;
   idx_t        irow;
   idx_t        jcol;
   idx_t        ib;
 
-  idx_t        i, j, n;
+  idx_t        i, j;
 
 
   rd.rowSizes.resize ( colCount * rd.borderItems.size() );
   sd.rowSizes.resize ( colCount * sd.borderItems.size() );
-
-  rd.requests->clear ();
+  rd.msgSizes.resize ( rd.borderCount );
+  sd.msgSizes.resize ( sd.borderCount );
 
   for ( ib = 0; ib < rd.borderCount; ib++ )
   {
-    rank   = (int) rd.borderIDs[ib];
     ifirst = rd.borderOffsets[ib];
     ilast  = rd.borderOffsets[ib + 1];
-    n      = colCount * (ilast - ifirst);
-    ptr    = rd.rowSizes.addr ( ifirst * colCount );
 
-    rd.requests->addRequest ( RecvBuffer( ptr, n ), rank, XTAG_ );
+    rd.msgSizes[ib] = colCount * (ilast - ifirst);
   }
 
-  rd.requests->startAll ();
-
-  sd.maxMsgSize = 0;
-
   for ( ib = 0; ib < sd.borderCount; ib++ )
   {
-    rank    = (int) sd.borderIDs[ib];
-    ifirst  = sd.borderOffsets[ib];
-    ilast   = sd.borderOffsets[ib + 1];
-    ptr     = sd.rowSizes.addr ( ifirst * colCount );
-    msgSize = 0;
+    ifirst = sd.borderOffsets[ib];
+    ilast  = sd.borderOffsets[ib + 1];
+    ptr    = sd.rowSizes.addr ( ifirst * colCount );
 
     for ( jcol = j = 0; jcol < colCount; jcol++ )
     {
@@ -298,121 +303,239 @@ void DataExchanger::Utils_::exchangeRowSizes
 
       for ( i = ifirst; i < ilast; i++, j++ )
       {
-        irow     = sd.borderItems[i];
-        ptr[j]   = col->rowSize ( irow );
-        msgSize += ptr[j];
+        irow   = sd.borderItems[i];
+        ptr[j] = col->rowSize ( irow );
       }
     }
 
-    n = colCount * (ilast - ifirst);
+    sd.msgSizes[ib] = colCount * (ilast - ifirst);
+  }
+
+  sd.mpContext->neighborExchange (
+    RecvBuffer ( rd.rowSizes.addr(), rd.rowSizes.size() ),
+    rd.borderRanks.addr (),
+    rd.msgSizes   .addr (),
+    (int) rd.borderCount,
+    SendBuffer ( sd.rowSizes.addr(), sd.rowSizes.size() ),
+    sd.borderRanks.addr (),
+    sd.msgSizes   .addr (),
+    (int) sd.borderCount,
+    XTAG_
+  );
+}
+
+
+//-----------------------------------------------------------------------
+//   exchangeData
+//-----------------------------------------------------------------------
+
+
+void DataExchanger::Utils_::exchangeData
 
-    sd.mpContext->send ( SendBuffer( ptr, n ), rank, XTAG_ );
+  ( RecvData_&            rd,
+    SendData_&            sd,
+    const IntColArray&    icols,
+    const FloatColArray&  fcols )
+
+{
+  const idx_t    ISIZE     = (idx_t) sizeof(idx_t);
+  const idx_t    FSIZE     = (idx_t) sizeof(double);
+
+  const idx_t    icolCount = icols.size ();
+  const idx_t    colCount  = icolCount + fcols.size ();
+
+  jem::byte*     ptr;
+
+  idx_t          isize;
+  idx_t          fsize;
+  idx_t          maxIsize;
+  idx_t          maxFsize;
+  idx_t          ib;
+
+  idx_t          i, j, n;
+
+
+  // Pack the data to be sent to each neighbor.
+
+  maxIsize = maxFsize = n = 0;
+
+  for ( ib = 0; ib < sd.borderCount; ib++ )
+  {
+    getDataSizes ( isize, fsize, sd, ib, icolCount, colCount );
 
-    if ( msgSize > sd.maxMsgSize )
+    maxIsize        = jem::max ( maxIsize, isize );
+    maxFsize        = jem::max ( maxFsize, fsize );
+    sd.msgSizes[ib] = isize * ISIZE + fsize * FSIZE;
+    n              += sd.msgSizes[ib];
+  }
+
+  sd.intBuffer  .resize ( maxIsize );
+  sd.floatBuffer.resize ( maxFsize );
+  sd.msgBuffer  .resize ( n );
+
+  ptr = sd.msgBuffer.addr ();
+
+  for ( ib = 0; ib < sd.borderCount; ib++ )
+  {
+    ptr += packData ( ptr, sd.intBuffer,   sd, ib,
+                      icols, 0,         colCount );
+    ptr += packData ( ptr, sd.floatBuffer, sd, ib,
+                      fcols, icolCount, colCount );
+  }
+
+  // Exchange the messages and unpack the received data.
+
+  isize = fsize = n = 0;
+
+  for ( ib = 0; ib < rd.borderCount; ib++ )
+  {
+    getDataSizes ( i, j, rd, ib, icolCount, colCount );
+
+    rd.msgSizes[ib] = i * ISIZE + j * FSIZE;
+    isize          += i;
+    fsize          += j;
+    n              += rd.msgSizes[ib];
+  }
+
+  rd.intBuffer  .resize ( isize );
+  rd.floatBuffer.resize ( fsize );
+  rd.msgBuffer  .resize ( n );
+
+  sd.mpContext->neighborExchange (
+    RecvBuffer ( rd.msgBuffer.addr(), rd.msgBuffer.size() ),
+    rd.borderRanks.addr (),
+    rd.msgSizes   .addr (),
+    (int) rd.borderCount,
+    SendBuffer ( sd.msgBuffer.addr(), sd.msgBuffer.size() ),
+    sd.borderRanks.addr (),
+    sd.msgSizes   .addr (),
+    (int) sd.borderCount,
+    XTAG_
+  );
+
+  ptr   = rd.msgBuffer.addr ();
+  isize = fsize = 0;
+
+  for ( ib = 0; ib < rd.borderCount; ib++ )
+  {
+    getDataSizes ( i, j, rd, ib, icolCount, colCount );
+
+    if ( i > 0 )
     {
-      sd.maxMsgSize = msgSize;
+      std::memcpy ( rd.intBuffer.addr(isize), ptr,
+                    (size_t) (i * ISIZE) );
     }
+
+    ptr   += i * ISIZE;
+    isize += i;
+
+    if ( j > 0 )
+    {
+      std::memcpy ( rd.floatBuffer.addr(fsize), ptr,
+                    (size_t) (j * FSIZE) );
+    }
+
+    ptr   += j * FSIZE;
+    fsize += j;
   }
+}
 
-  rd.requests->waitAll ();
 
-  if ( rd.rowSizes.size() > 0 )
+//-----------------------------------------------------------------------
+//   getDataSizes
+//-----------------------------------------------------------------------
+
+
+void DataExchanger::Utils_::getDataSizes
+
+  ( idx_t&         isize,
+    idx_t&         fsize,
+    const XData_&  xd,
+    idx_t          ib,
+    idx_t          icolCount,
+    idx_t          colCount )
+
+{
+  const idx_t  ifirst = xd.borderOffsets[ib];
+  const idx_t  ilast  = xd.borderOffsets[ib + 1];
+  const idx_t  first  = colCount  * ifirst;
+  const idx_t  mid    = first + icolCount * (ilast - ifirst);
+  const idx_t  last   = colCount  * ilast;
+
+  idx_t        i;
+
+
+  isize = fsize = 0;
+
+  for ( i = first; i < mid; i++ )
   {
-    rd.rbufSize = jem::sum ( rd.rowSizes );
+    isize += xd.rowSizes[i];
   }
-  else
+
+  for ( i = mid; i < last; i++ )
   {
-    rd.rbufSize = 0;
+    fsize += xd.rowSizes[i];
   }
 }
 
 
 //-----------------------------------------------------------------------
-//   exchangeData
+//   packData
 //-----------------------------------------------------------------------
 
+// Copies the data of the given columns in border ib to a message
+// buffer and returns the number of bytes written. The array tbuf must
+// be large enough to hold the data of all columns in the border.
+
 
 template <class T, class Column>
 
-  void DataExchanger::Utils_::exchangeData
+  idx_t DataExchanger::Utils_::packData
 
-  ( RecvData_&             rd,
-    SendData_&             sd,
-    Array<T>&              rbuf,
-    Array<T>&              sbuf,
-    const Array<Column*>&  cols )
+  ( jem::byte*             buf,
+    Array<T>&              tbuf,
+    const XData_&          xd,
+    idx_t                  ib,
+    const Array<Column*>&  cols,
+    idx_t                  jcol0,
+    idx_t                  colCount )
 
 {
-  const idx_t  colCount = cols.size ();
+  const idx_t  ifirst = xd.borderOffsets[ib];
+  const idx_t  ilast  = xd.borderOffsets[ib + 1];
 
   Column*      col;
-  T*           ptr;
 
-  int          rank;
-  idx_t        ifirst;
-  idx_t        ilast;
   idx_t        irow;
   idx_t        jcol;
-  idx_t        ib;
 
   idx_t        i, j, k, n;
 
 
-  rd.requests->clear ();
-  rbuf.resize ( rd.rbufSize );
-
   j = 0;
 
-  for ( ib = 0; ib < rd.borderCount; ib++ )
+  for ( jcol = 0; jcol < cols.size(); jcol++ )
   {
-    rank   = (int) rd.borderIDs[ib];
-    ifirst = colCount * rd.borderOffsets[ib];
-    ilast  = colCount * rd.borderOffsets[ib + 1];
-    ptr    = rbuf.addr ( j );
-    n      = 0;
+    col = cols[jcol];
+    k   = colCount * ifirst + (jcol0 + jcol) * (ilast - ifirst);
 
     for ( i = ifirst; i < ilast; i++ )
     {
-      n += rd.rowSizes[i];
-    }
+      irow = xd.borderItems[i];
+      n    = xd.rowSizes[k++];
 
-    rd.requests->addRequest ( RecvBuffer( ptr, n ), rank, XTAG_ );
+      col->getData ( tbuf.addr(j), n, irow );
 
-    j += n;
+      j   += n;
+    }
   }
 
-  rd.requests->startAll ();
-
-  sbuf.resize ( sd.maxMsgSize );
-
-  k = 0;
-
-  for ( ib = 0; ib < sd.borderCount; ib++ )
+  if ( j > 0 )
   {
-    rank   = (int) sd.borderIDs[ib];
-    ifirst = sd.borderOffsets[ib];
-    ilast  = sd.borderOffsets[ib + 1];
-    j      = 0;
-
-    for ( jcol = 0; jcol < colCount; jcol++ )
-    {
-      col = cols[jcol];
-
-      for ( i = ifirst; i < ilast; i++ )
-      {
-        irow = sd.borderItems[i];
-        n    = sd.rowSizes[k++];
-
-        col->getData ( sbuf.addr(j), n, irow );
-
-        j   += n;
-      }
-    }
-
-    sd.mpContext->send ( SendBuffer( sbuf.addr(), j ), rank, XTAG_ );
+    std::memcpy ( buf, tbuf.addr(), (size_t) j * sizeof(T) );
   }
 
-  rd.requests->waitAll ();
+  return j * (idx_t) sizeof(T);
 }
 
 
@@ -427,11 +550,11 @@ template <class T, class Column>
 
   ( const RecvData_&       rd,
     const Array<T>&        rbuf,
-    const Array<Column*>&  cols )
+    const Array<Column*>&  cols,
+    idx_t                  jcol0,
+    idx_t                  colCount )
 
 {
-  const idx_t  colCount = cols.size ();
-
   Column*      col;
 
   Array<T>     tbuf;
@@ -447,23 +570,24 @@ template <class T, class Column>
 
   n = 0;
 
-  for ( jcol = 0; jcol < colCount; jcol++ )
+  for ( jcol = 0; jcol < cols.size(); jcol++ )
   {
     n = jem::max ( n, cols[jcol]->maxRowSize() );
   }
 
   tbuf.resize ( n );
 
-  j = k = 0;
+  j = 0;
 
   for ( ib = 0; ib < rd.borderCount; ib++ )
   {
     ifirst = rd.borderOffsets[ib];
     ilast  = rd.borderOffsets[ib + 1];
 
-    for ( jcol = 0; jcol < colCount; jcol++ )
+    for ( jcol = 0; jcol < cols.size(); jcol++ )
     {
       col = cols[jcol];
+      k   = colCount * ifirst + (jcol0 + jcol) * (ilast - ifirst);
 
       for ( i = ifirst; i < ilast; i++ )
       {
@@ -496,11 +620,11 @@ template <class T, class Column>
 
   ( const RecvData_&       rd,
     const Array<T>&        rbuf,
-    const Array<Column*>&  cols )
+    const Array<Column*>&  cols,
+    idx_t                  jcol0,
+    idx_t                  colCount )
 
 {
-  const idx_t  colCount = cols.size ();
-
   Column*      col;
 
   idx_t        ifirst;
@@ -512,16 +636,17 @@ template <class T, class Column>
   idx_t        i, j, k, n;
 
 
-  j = k = 0;
+  j = 0;
 
   for ( ib = 0; ib < rd.borderCount; ib++ )
   {
     ifirst = rd.borderOffsets[ib];
     ilast  = rd.borderOffsets[ib + 1];
 
-    for ( jcol = 0; jcol < colCount; jcol++ )
+    for ( jcol = 0; jcol < cols.size(); jcol++ )
     {
       col = cols[jcol];
+      k   = colCount * ifirst + (jcol0 + jcol) * (ilast - ifirst);
 
       for ( i = ifirst; i < ilast; i++ )
       {
@@ -638,8 +763,7 @@ void DataExchanger::exchange ( Database& dbase )
     );
   }
 
-  exchange ( dbase.getIntColumns()   );
-  exchange ( dbase.getFloatColumns() );
+  exchange_ ( dbase.getIntColumns(), dbase.getFloatColumns() );
 }
 
 
@@ -650,37 +774,7 @@ void DataExchanger::exchange ( Database& dbase )
 
 void DataExchanger::exchange ( const IntColArray& cols )
 {
-  if ( cols.size() > 0 )
-  {
-    Array<DBColumn*>  dbCols ( castTo<DBColumn*>( cols ) );
-
-    RecvData_&        rd = *recvData_;
-    SendData_&        sd = *sendData_;
-
-    if ( ! updated_ )
-    {
-      update_ ();
-    }
-
-    if ( rd.borderCount + sd.borderCount > 0 )
-    {
-      Utils_::exchangeRowSizes ( rd, sd, dbCols );
-
-      Utils_::exchangeData     ( rd, sd,
-                                 rd.intBuffer,
-                                 sd.intBuffer,
-                                 cols );
-
-      if ( rd.borders == sd.borders )
-      {
-        Utils_::addToColumns   ( rd, rd.intBuffer, cols );
-      }
-      else
-      {
-        Utils_::updateColumns  ( rd, rd.intBuffer, cols );
-      }
-    }
-  }
+  exchange_ ( cols, FloatColArray() );
 }
 
 
@@ -691,37 +785,7 @@ void DataExchanger::exchange ( const IntColArray& cols )
 
 void DataExchanger::exchange ( const FloatColArray& cols )
 {
-  if ( cols.size() > 0 )
-  {
-    Array<DBColumn*>  dbCols ( castTo<DBColumn*>( cols ) );
-
-    RecvData_&        rd = *recvData_;
-    SendData_&        sd = *sendData_;
-
-    if ( ! updated_ )
-    {
-      update_ ();
-    }
-
-    if ( rd.borderCount + sd.borderCount > 0 )
-    {
-      Utils_::exchangeRowSizes ( rd, sd, dbCols );
-
-      Utils_::exchangeData     ( rd, sd,
-                                 rd.floatBuffer,
-                                 sd.floatBuffer,
-                                 cols );
-
-      if ( rd.borders == sd.borders )
-      {
-        Utils_::addToColumns   ( rd, rd.floatBuffer, cols );
-      }
-      else
-      {
-        Utils_::updateColumns  ( rd, rd.floatBuffer, cols );
-      }
-    }
-  }
+  exchange_ ( IntColArray(), cols );
 }
 
 
@@ -804,7 +868,7 @@ void DataExchanger::init_
   ItemSet*  items = rb.getItems ();
 
 
-  recvData_ = newInstance<RecvData_> ( mpx, rb );
+  recvData_ = newInstance<RecvData_> ( rb );
   sendData_ = newInstance<SendData_> ( mpx, sb );
 
   connect ( items->newSizeEvent,  this, & Self::invalidate_ );
@@ -824,6 +888,59 @@ void DataExchanger::init_
 }
 
 
+//-----------------------------------------------------------------------
+//   exchange_
+//-----------------------------------------------------------------------
+
+
+void DataExchanger::exchange_
+
+  ( const IntColArray&    icols,
+    const FloatColArray&  fcols )
+
+{
+  const idx_t  icolCount = icols.size ();
+  const idx_t  colCount  = icolCount + fcols.size ();
+
+  if ( colCount > 0 )
+  {
+    Array<DBColumn*>  dbCols ( colCount );
+
+    RecvData_&        rd = *recvData_;
+    SendData_&        sd = *sendData_;
+
+    if ( ! updated_ )
+    {
+      update_ ();
+    }
+
+    if ( rd.borderCount + sd.borderCount > 0 )
+    {
+      dbCols[slice(BEGIN,icolCount)] = castTo<DBColumn*> ( icols );
+      dbCols[slice(icolCount,END)]   = castTo<DBColumn*> ( fcols );
+
+      Utils_::exchangeRowSizes ( rd, sd, dbCols );
+      Utils_::exchangeData     ( rd, sd, icols, fcols );
+
+      if ( rd.borders == sd.borders )
+      {
+        Utils_::addToColumns   ( rd, rd.intBuffer,   icols,
+                                 0,         colCount );
+        Utils_::addToColumns   ( rd, rd.floatBuffer, fcols,
+                                 icolCount, colCount );
+      }
+      else
+      {
+        Utils_::updateColumns  ( rd, rd.intBuffer,   icols,
+                                 0,         colCount );
+        Utils_::updateColumns  ( rd, rd.floatBuffer, fcols,
+                                 icolCount, colCount );
+      }
+    }
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   update_
 //-----------------------------------------------------------------------
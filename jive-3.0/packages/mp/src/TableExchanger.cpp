@@ -30,13 +30,13 @@
  */
 
 
+#include <cstring>
 #include <jem/base/assert.h>
 #include <jem/base/ClassTemplate.h>
 #include <jem/base/IllegalArgumentException.h>
 #include <jem/base/array/utilities.h>
 #include <jem/mp/Buffer.h>
 #include <jem/mp/Context.h>
-#include <jem/mp/RequestList.h>
 #include <jem/util/Event.h>
 #include <jem/util/Properties.h>
 #include <jive/log.h>
@@ -55,9 +55,9 @@ JIVE_BEGIN_PACKAGE( mp )
 
 
 using jem::newInstance;
+using jem::Array;
 using jem::mp::RecvBuffer;
 using jem::mp::SendBuffer;
-using jem::mp::RequestList;
 
 
 //=======================================================================
@@ -82,6 +82,8 @@ class TableExchanger::XData_ : public BorderXData
   IdxVector               rowSizes;
   IdxVector               colIndices;
   Vector                  rowValues;
+  IdxVector               msgSizes;
+  Array<jem::byte>        msgBuffer;
 
 };
 
@@ -110,15 +112,9 @@ class TableExchanger::RecvData_ : public XData_
   typedef XData_          Super;
 
 
-  inline                  RecvData_
+  explicit inline         RecvData_
 
-    ( const Ref<Context>&   mpx,
-      const BorderSet&      borders );
-
-
- public:
-
-  Ref<RequestList>        requests;
+    ( const BorderSet&      borders );
 
 };
 
@@ -130,14 +126,11 @@ class TableExchanger::RecvData_ : public XData_
 
 inline TableExchanger::RecvData_::RecvData_
 
-  ( const Ref<Context>&  mpx,
-    const BorderSet&     borders ) :
+  ( const BorderSet&  borders ) :
 
     Super ( borders )
 
-{
-  requests = mpx->newRequestList ();
-}
+{}
 
 
 //=======================================================================
@@ -185,18 +178,24 @@ inline TableExchanger::SendData_::SendData_
 //   class TableExchanger::Utils_
 //=======================================================================
 
+// The row sizes are exchanged first. The column indices and values
+// are then packed into a single message per neighbor, so that each
+// table exchange costs two messages per neighbor, independent of the
+// number of rows in a border.
+
 
 class TableExchanger::Utils_
 {
  public:
 
-  static void             exchangeRowSizes
+  static const idx_t      ENTRY_SIZE;
 
-    ( RecvData_&            rdata,
-      SendData_&            sdata,
-      const SparseMatrix&   matrix );
 
-  static void             exchangeColIndices
+  static void             setBorderSizes
+
+    ( XData_&               xdata );
+
+  static void             exchangeRowSizes
 
     ( RecvData_&            rdata,
       SendData_&            sdata,
@@ -227,6 +226,34 @@ class TableExchanger::Utils_
 };
 
 
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+const idx_t  TableExchanger::Utils_::ENTRY_SIZE =
+
+  (idx_t) (sizeof(idx_t) + sizeof(double));
+
+
+//-----------------------------------------------------------------------
+//   setBorderSizes
+//-----------------------------------------------------------------------
+
+
+void TableExchanger::Utils_::setBorderSizes ( XData_& xd )
+{
+  xd.msgSizes.resize ( xd.borderCount );
+
+  for ( idx_t ib = 0; ib < xd.borderCount; ib++ )
+  {
+    xd.msgSizes[ib] =
+
+      xd.borderOffsets[ib + 1] - xd.borderOffsets[ib];
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   exchangeRowSizes
 //-----------------------------------------------------------------------
@@ -243,63 +270,33 @@ void TableExchanger::Utils_::exchangeRowSizes
 
   const idx_t*  rowOffsets = mtx.getOffsetPtr ();
 
-  idx_t*        ptr;
-
-  int           rank;
-  idx_t         msgSize;
-  idx_t         maxMsgSize;
-  idx_t         ifirst;
-  idx_t         ilast;
   idx_t         irow;
+  idx_t         i, n;
 
-  idx_t         i, j, n;
 
-
-  rd.requests->clear ();
   rd.rowSizes.resize ( rd.borderItems.size() );
   sd.rowSizes.resize ( sd.borderItems.size() );
 
-  for ( idx_t ib = 0; ib < rd.borderCount; ib++ )
-  {
-    rank   = (int) rd.borderIDs[ib];
-    ifirst = rd.borderOffsets[ib];
-    ilast  = rd.borderOffsets[ib + 1];
-    ptr    = rd.rowSizes.addr ( ifirst );
-    n      = ilast - ifirst;
-
-    rd.requests->addRequest ( RecvBuffer( ptr, n ), rank, XTAG_ );
-  }
-
-  rd.requests->startAll ();
-
-  maxMsgSize = 0;
-
-  for ( idx_t ib = 0; ib < sd.borderCount; ib++ )
+  for ( i = 0, n = sd.borderItems.size(); i < n; i++ )
   {
-    rank    = (int) sd.borderIDs[ib];
-    ifirst  = sd.borderOffsets[ib];
-    ilast   = sd.borderOffsets[ib + 1];
-    ptr     = sd.rowSizes.addr ( ifirst );
-    msgSize = 0;
-
-    for ( i = ifirst, j = 0; i < ilast; i++, j++ )
-    {
-      irow     = sd.borderItems[i];
-      ptr[j]   = rowOffsets[irow + 1] - rowOffsets[irow];
-      msgSize += ptr[j];
-    }
-
-    n = ilast - ifirst;
-
-    sd.mpContext->send ( SendBuffer( ptr, n ), rank, XTAG_ );
-
-    if ( msgSize > maxMsgSize )
-    {
-      maxMsgSize = msgSize;
-    }
+    irow           = sd.borderItems[i];
+    sd.rowSizes[i] = rowOffsets[irow + 1] - rowOffsets[irow];
   }
 
-  rd.requests->waitAll ();
+  setBorderSizes ( rd );
+  setBorderSizes ( sd );
+
+  sd.mpContext->neighborExchange (
+    RecvBuffer ( rd.rowSizes.addr(), rd.rowSizes.size() ),
+    rd.borderRanks.addr (),
+    rd.msgSizes   .addr (),
+    (int) rd.borderCount,
+    SendBuffer ( sd.rowSizes.addr(), sd.rowSizes.size() ),
+    sd.borderRanks.addr (),
+    sd.msgSizes   .addr (),
+    (int) sd.borderCount,
+    XTAG_
+  );
 
   if ( rd.rowSizes.size() > 0 )
   {
@@ -312,17 +309,18 @@ void TableExchanger::Utils_::exchangeRowSizes
 
   rd.colIndices.resize ( n );
   rd.rowValues .resize ( n );
-  sd.colIndices.resize ( maxMsgSize );
-  sd.rowValues .resize ( maxMsgSize );
 }
 
 
 //-----------------------------------------------------------------------
-//   exchangeColIndices
+//   exchangeData
 //-----------------------------------------------------------------------
 
+// Each message contains the column indices of all rows in a border,
+// followed by the values of those rows.
+
 
-void TableExchanger::Utils_::exchangeColIndices
+void TableExchanger::Utils_::exchangeData
 
   ( RecvData_&           rd,
     SendData_&           sd,
@@ -331,107 +329,81 @@ void TableExchanger::Utils_::exchangeColIndices
 {
   JEM_ASSERT ( mtx.isContiguous() );
 
-  const idx_t*  rowOffsets = mtx.getOffsetPtr ();
-  const idx_t*  colIndices = mtx.getIndexPtr  ();
+  const idx_t*   rowOffsets = mtx.getOffsetPtr ();
+  const idx_t*   colIndices = mtx.getIndexPtr  ();
+  const double*  tabValues  = mtx.getValuePtr  ();
 
-  idx_t*        ptr;
+  jem::byte*     ptr;
 
-  int           rank;
-  idx_t         ifirst;
-  idx_t         ilast;
-  idx_t         irow;
+  idx_t          ifirst;
+  idx_t          ilast;
+  idx_t          irow;
+  idx_t          ib;
+
+  idx_t          i, j, k, n;
 
-  idx_t         i, j, k, n;
 
+  // Pack the column indices and values for each neighbor.
 
-  rd.requests->clear ();
+  sd.msgSizes.resize ( sd.borderCount );
 
-  j = 0;
+  k = 0;
 
-  for ( idx_t ib = 0; ib < rd.borderCount; ib++ )
+  for ( ib = 0; ib < sd.borderCount; ib++ )
   {
-    rank   = (int) rd.borderIDs[ib];
-    ifirst = rd.borderOffsets[ib];
-    ilast  = rd.borderOffsets[ib + 1];
-    ptr    = rd.colIndices.addr ( j );
+    ifirst = sd.borderOffsets[ib];
+    ilast  = sd.borderOffsets[ib + 1];
     n      = 0;
 
     for ( i = ifirst; i < ilast; i++ )
     {
-      n += rd.rowSizes[i];
+      n += sd.rowSizes[i];
     }
 
-    rd.requests->addRequest ( RecvBuffer( ptr, n ), rank, XTAG_ );
-
-    j += n;
+    sd.msgSizes[ib] = n * ENTRY_SIZE;
+    k              += n;
   }
 
-  rd.requests->startAll ();
+  sd.msgBuffer.resize ( k * ENTRY_SIZE );
 
-  ptr = sd.colIndices.addr ();
+  ptr = sd.msgBuffer.addr ();
 
-  for ( idx_t ib = 0; ib < sd.borderCount; ib++ )
+  for ( ib = 0; ib < sd.borderCount; ib++ )
   {
-    rank   = (int) sd.borderIDs[ib];
     ifirst = sd.borderOffsets[ib];
     ilast  = sd.borderOffsets[ib + 1];
-    k      = 0;
 
     for ( i = ifirst; i < ilast; i++ )
     {
       irow = sd.borderItems[i];
-      n    = rowOffsets[irow + 1];
-
-      for ( j = rowOffsets[irow]; j < n; j++, k++ )
-      {
-        ptr[k] = colIndices[j];
-      }
-    }
-
-    sd.mpContext->send ( SendBuffer( ptr, k ), rank, XTAG_ );
-  }
-
-  rd.requests->waitAll ();
-}
-
-
-//-----------------------------------------------------------------------
-//   exchangeData
-//-----------------------------------------------------------------------
+      j    = rowOffsets[irow];
+      n    = rowOffsets[irow + 1] - j;
 
+      std::memcpy ( ptr, colIndices + j, (size_t) n * sizeof(idx_t) );
 
-void TableExchanger::Utils_::exchangeData
-
-  ( RecvData_&           rd,
-    SendData_&           sd,
-    const SparseMatrix&  mtx )
-
-{
-  JEM_ASSERT ( mtx.isContiguous() );
-
-  const idx_t*   rowOffsets = mtx.getOffsetPtr ();
-  const double*  tabValues  = mtx.getValuePtr  ();
-
-  double*        ptr;
+      ptr += n * (idx_t) sizeof(idx_t);
+    }
 
-  int            rank;
-  idx_t          ifirst;
-  idx_t          ilast;
-  idx_t          irow;
+    for ( i = ifirst; i < ilast; i++ )
+    {
+      irow = sd.borderItems[i];
+      j    = rowOffsets[irow];
+      n    = rowOffsets[irow + 1] - j;
 
-  idx_t          i, j, k, n;
+      std::memcpy ( ptr, tabValues + j, (size_t) n * sizeof(double) );
 
+      ptr += n * (idx_t) sizeof(double);
+    }
+  }
 
-  rd.requests->clear ();
+  // Exchange the messages and unpack the received data.
 
-  j = 0;
+  rd.msgSizes.resize ( rd.borderCount );
 
-  for ( idx_t ib = 0; ib < rd.borderCount; ib++ )
+  for ( ib = 0; ib < rd.borderCount; ib++ )
   {
-    rank   = (int) rd.borderIDs[ib];
     ifirst = rd.borderOffsets[ib];
     ilast  = rd.borderOffsets[ib + 1];
-    ptr    = rd.rowValues.addr ( j );
     n      = 0;
 
     for ( i = ifirst; i < ilast; i++ )
@@ -439,37 +411,45 @@ void TableExchanger::Utils_::exchangeData
       n += rd.rowSizes[i];
     }
 
-    rd.requests->addRequest ( RecvBuffer( ptr, n ), rank, XTAG_ );
-
-    j += n;
+    rd.msgSizes[ib] = n * ENTRY_SIZE;
   }
 
-  rd.requests->startAll ();
+  rd.msgBuffer.resize ( rd.colIndices.size() * ENTRY_SIZE );
 
-  ptr = sd.rowValues.addr ();
+  sd.mpContext->neighborExchange (
+    RecvBuffer ( rd.msgBuffer.addr(), rd.msgBuffer.size() ),
+    rd.borderRanks.addr (),
+    rd.msgSizes   .addr (),
+    (int) rd.borderCount,
+    SendBuffer ( sd.msgBuffer.addr(), sd.msgBuffer.size() ),
+    sd.borderRanks.addr (),
+    sd.msgSizes   .addr (),
+    (int) sd.borderCount,
+    XTAG_
+  );
 
-  for ( idx_t ib = 0; ib < sd.borderCount; ib++ )
+  ptr = rd.msgBuffer.addr ();
+  j   = 0;
+
+  for ( ib = 0; ib < rd.borderCount; ib++ )
   {
-    rank   = (int) sd.borderIDs[ib];
-    ifirst = sd.borderOffsets[ib];
-    ilast  = sd.borderOffsets[ib + 1];
-    k      = 0;
+    n = rd.msgSizes[ib] / ENTRY_SIZE;
 
-    for ( i = ifirst; i < ilast; i++ )
+    if ( n > 0 )
     {
-      irow = sd.borderItems[i];
-      n    = rowOffsets[irow + 1];
+      std::memcpy ( rd.colIndices.addr(j), ptr,
+                    (size_t) n * sizeof(idx_t) );
+
+      ptr += n * (idx_t) sizeof(idx_t);
+
+      std::memcpy ( rd.rowValues.addr(j), ptr,
+                    (size_t) n * sizeof(double) );
 
-      for ( j = rowOffsets[irow]; j < n; j++, k++ )
-      {
-        ptr[k] = tabValues[j];
-      }
+      ptr += n * (idx_t) sizeof(double);
     }
 
-    sd.mpContext->send ( SendBuffer( ptr, k ), rank, XTAG_ );
+    j += n;
   }
-
-  rd.requests->waitAll ();
 }
 
 
@@ -565,77 +545,46 @@ void TableExchanger::Utils_::exchangeWeights
     const Vector&  w )
 
 {
-  double*  ptr;
-
-  int      rank;
-  idx_t    ifirst;
-  idx_t    ilast;
-
-  idx_t    i, j, n;
+  idx_t  i, n;
 
 
-  rd.requests->clear ();
+  rd.rowValues.resize ( rd.borderItems.size() );
+  sd.rowValues.resize ( sd.borderItems.size() );
 
-  rd.rowValues.resize ( rd.borderItems.size()      );
-  sd.rowValues.resize ( sd.borders.maxBorderSize() );
-
-  for ( idx_t ib = 0; ib < rd.borderCount; ib++ )
+  for ( i = 0, n = sd.borderItems.size(); i < n; i++ )
   {
-    rank   = (int) rd.borderIDs[ib];
-    ifirst = rd.borderOffsets[ib];
-    ilast  = rd.borderOffsets[ib + 1];
-    ptr    = rd.rowValues.addr ( ifirst );
-    n      = ilast - ifirst;
-
-    rd.requests->addRequest ( RecvBuffer( ptr, n ), rank, XTAG_ );
+    sd.rowValues[i] = w[sd.borderItems[i]];
   }
 
-  rd.requests->startAll ();
+  setBorderSizes ( rd );
+  setBorderSizes ( sd );
 
-  ptr = sd.rowValues.addr ();
+  sd.mpContext->neighborExchange (
+    RecvBuffer ( rd.rowValues.addr(), rd.rowValues.size() ),
+    rd.borderRanks.addr (),
+    rd.msgSizes   .addr (),
+    (int) rd.borderCount,
+    SendBuffer ( sd.rowValues.addr(), sd.rowValues.size() ),
+    sd.borderRanks.addr (),
+    sd.msgSizes   .addr (),
+    (int) sd.borderCount,
+    XTAG_
+  );
 
-  for ( idx_t ib = 0; ib < sd.borderCount; ib++ )
-  {
-    rank   = (int) sd.borderIDs[ib];
-    ifirst = sd.borderOffsets[ib];
-    ilast  = sd.borderOffsets[ib + 1];
-
-    for ( i = ifirst, j = 0; i < ilast; i++, j++ )
-    {
-      ptr[j] = w[sd.borderItems[i]];
-    }
-
-    n = ilast - ifirst;
-
-    sd.mpContext->send ( SendBuffer( ptr, n ), rank, XTAG_ );
-  }
-
-  rd.requests->waitAll ();
+  n = rd.borderItems.size ();
 
   if ( rd.borders == sd.borders )
   {
-    for ( idx_t ib = 0; ib < rd.borderCount; ib++ )
+    for ( i = 0; i < n; i++ )
     {
-      ifirst = rd.borderOffsets[ib];
-      ilast  = rd.borderOffsets[ib + 1];
-
-      for ( i = ifirst; i < ilast; i++ )
-      {
-        w[rd.borderItems[i]] += rd.rowValues[i];
-      }
+      w[rd.borderItems[i]] += rd.rowValues[i];
     }
   }
   else
   {
-    for ( idx_t ib = 0; ib < rd.borderCount; ib++ )
+    for ( i = 0; i < n; i++ )
     {
-      ifirst = rd.borderOffsets[ib];
-      ilast  = rd.borderOffsets[ib + 1];
-
-      for ( i = ifirst; i < ilast; i++ )
-      {
-        w[rd.borderItems[i]] = rd.rowValues[i];
-      }
+      w[rd.borderItems[i]]  = rd.rowValues[i];
     }
   }
 }
@@ -749,17 +698,16 @@ void TableExchanger::exchange ( XTable& table )
       mtx = mtx.clone ();
     }
 
-    Utils_::exchangeRowSizes   ( rd, sd, mtx );
-    Utils_::exchangeColIndices ( rd, sd, mtx );
-    Utils_::exchangeData       ( rd, sd, mtx );
+    Utils_::exchangeRowSizes ( rd, sd, mtx );
+    Utils_::exchangeData     ( rd, sd, mtx );
 
     if ( rd.borders == sd.borders )
     {
-      Utils_::addToTable       ( table, rd );
+      Utils_::addToTable     ( table, rd );
     }
     else
     {
-      Utils_::updateTable      ( table, rd );
+      Utils_::updateTable    ( table, rd );
     }
   }
 }
@@ -877,7 +825,7 @@ void TableExchanger::init_
 
   ItemSet*  items = rb.getItems ();
 
-  recvData_ = newInstance<RecvData_> ( mpx, rb );
+  recvData_ = newInstance<RecvData_> ( rb );
   sendData_ = newInstance<SendData_> ( mpx, sb );
 
   connect ( items->newSizeEvent,  this, & Self::invalidate_ );
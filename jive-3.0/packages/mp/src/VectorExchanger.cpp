@@ -101,6 +101,15 @@ class VectorExchanger::XData_ : public Collectable
       const BorderSet&        recvBorders,
       const BorderSet&        sendBorders );
 
+  void                      gather
+
+    ( const Vector&           vec );
+
+  void                      scatter
+
+    ( const Vector&           vec,
+      bool                    add )            const;
+
 
  public:
 
@@ -113,6 +122,8 @@ class VectorExchanger::XData_ : public Collectable
   IntVector                 recvProcs;
   IdxVector                 sendOffsets;
   IdxVector                 recvOffsets;
+  IdxVector                 sendRuns;
+  IdxVector                 recvRuns;
   Vector                    sendVector;
   Vector                    recvVector;
   Vector                    sendBuffer;
@@ -126,6 +137,14 @@ class VectorExchanger::XData_ : public Collectable
 
   Idx2Map                   tagMap;
 
+
+ private:
+
+  static void               makeRuns_
+
+    ( IdxVector&              runs,
+      const IdxVector&        dofs );
+
 };
 
 
@@ -207,6 +226,10 @@ void VectorExchanger::XData_::update
       ( RecvBuffer( recvVector.addr(i), n ), rank, DATA_TAG );
   }
 
+  makeRuns_ ( recvRuns, recvDofs );
+
+  sendRuns.ref ( recvRuns );
+
   sendInfo = 0;
   recvInfo = 0;
 
@@ -259,6 +282,8 @@ void VectorExchanger::XData_::update
       ( SendBuffer( sendVector.addr(i), n ), rank, DATA_TAG );
   }
 
+  makeRuns_ ( sendRuns, sendDofs );
+
   // Setup the recv data structures.
 
   recvReqs    ->clear ();
@@ -291,6 +316,8 @@ void VectorExchanger::XData_::update
       ( RecvBuffer( recvVector.addr(i), n ), rank, DATA_TAG );
   }
 
+  makeRuns_ ( recvRuns, recvDofs );
+
   sendInfo = 0;
   recvInfo = 0;
 
@@ -299,6 +326,193 @@ void VectorExchanger::XData_::update
 }
 
 
+//-----------------------------------------------------------------------
+//   gather
+//-----------------------------------------------------------------------
+
+
+void VectorExchanger::XData_::gather ( const Vector& vec )
+{
+  if ( ! vec.isContiguous() )
+  {
+    sendVector = vec[sendDofs];
+    return;
+  }
+
+  const double*  src  = vec       .addr ();
+  double*        dest = sendVector.addr ();
+  const idx_t    n    = sendDofs  .size ();
+
+  if ( sendRuns.size() > 0 )
+  {
+    const idx_t*  runs = sendRuns.addr ();
+    const idx_t   m    = sendRuns.size ();
+
+    for ( idx_t i = 0; i < m; i += 2 )
+    {
+      const double*  s   = src + runs[i];
+      const idx_t    len = runs[i + 1];
+
+      for ( idx_t j = 0; j < len; j++ )
+      {
+        dest[j] = s[j];
+      }
+
+      dest += len;
+    }
+  }
+  else
+  {
+    const idx_t*  dofs = sendDofs.addr ();
+
+    for ( idx_t i = 0; i < n; i++ )
+    {
+      dest[i] = src[dofs[i]];
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   scatter
+//-----------------------------------------------------------------------
+
+
+void VectorExchanger::XData_::scatter
+
+  ( const Vector&  vec,
+    bool           add ) const
+
+{
+  if ( ! vec.isContiguous() )
+  {
+    if ( add )
+    {
+      vec[recvDofs] += recvVector;
+    }
+    else
+    {
+      vec[recvDofs]  = recvVector;
+    }
+
+    return;
+  }
+
+  const double*  src  = recvVector.addr ();
+  double*        dest = vec       .addr ();
+  const idx_t    n    = recvDofs  .size ();
+
+  if ( recvRuns.size() > 0 )
+  {
+    const idx_t*  runs = recvRuns.addr ();
+    const idx_t   m    = recvRuns.size ();
+
+    for ( idx_t i = 0; i < m; i += 2 )
+    {
+      double*      d   = dest + runs[i];
+      const idx_t  len = runs[i + 1];
+
+      if ( add )
+      {
+        for ( idx_t j = 0; j < len; j++ )
+        {
+          d[j] += src[j];
+        }
+      }
+      else
+      {
+        for ( idx_t j = 0; j < len; j++ )
+        {
+          d[j]  = src[j];
+        }
+      }
+
+      src += len;
+    }
+  }
+  else
+  {
+    const idx_t*  dofs = recvDofs.addr ();
+
+    if ( add )
+    {
+      for ( idx_t i = 0; i < n; i++ )
+      {
+        dest[dofs[i]] += src[i];
+      }
+    }
+    else
+    {
+      for ( idx_t i = 0; i < n; i++ )
+      {
+        dest[dofs[i]]  = src[i];
+      }
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   makeRuns_
+//-----------------------------------------------------------------------
+
+// Compresses a DOF index array into (first DOF, length) pairs
+// covering consecutive DOFs. The pairs are only stored when the
+// average run length is at least two; otherwise the runs array is
+// left empty and the plain index array is used instead.
+
+void VectorExchanger::XData_::makeRuns_
+
+  ( IdxVector&        runs,
+    const IdxVector&  dofs )
+
+{
+  const idx_t  n = dofs.size ();
+
+  idx_t        runCount;
+  idx_t        i, j;
+
+
+  runs.resize ( 0 );
+
+  runCount = 0;
+
+  for ( i = 0; i < n; i = j )
+  {
+    j = i + 1;
+
+    while ( j < n && dofs[j] == dofs[j - 1] + 1 )
+    {
+      j++;
+    }
+
+    runCount++;
+  }
+
+  if ( 2 * runCount > n )
+  {
+    return;
+  }
+
+  runs.resize ( 2 * runCount );
+
+  runCount = 0;
+
+  for ( i = 0; i < n; i = j )
+  {
+    j = i + 1;
+
+    while ( j < n && dofs[j] == dofs[j - 1] + 1 )
+    {
+      j++;
+    }
+
+    runs[runCount++] = dofs[i];
+    runs[runCount++] = j - i;
+  }
+}
+
+
 //=======================================================================
 //   class VectorExchanger
 //=======================================================================
@@ -433,7 +647,40 @@ void VectorExchanger::startOne ( int mode )
 
   xdata_[mode]->recvVecReqs->startAll ();
 
-  xmode_ = mode;
+  xmode_   = mode;
+  sending_ = false;
+}
+
+
+//-----------------------------------------------------------------------
+//   sendOne
+//-----------------------------------------------------------------------
+
+
+void VectorExchanger::sendOne ( const Vector& sendVec )
+{
+  if ( ! updated_ )
+  {
+    invalidError_ ( JEM_FUNC );
+  }
+
+  if ( xmode_ == INACTIVE_ || sending_ )
+  {
+    xmodeError_   ( JEM_FUNC );
+  }
+
+  if ( sendVec.size() != dofCount_ )
+  {
+    sizeError ( JEM_FUNC, "send vector", sendVec.size(), dofCount_ );
+  }
+
+  XData_&  xd = *(xdata_[xmode_]);
+
+  xd.gather ( sendVec );
+
+  xd.sendVecReqs->startAll ();
+
+  sending_ = true;
 }
 
 
@@ -467,23 +714,21 @@ void VectorExchanger::endOne
 
   XData_&  xd = *(xdata_[xmode_]);
 
-  xd.sendVector = sendVec[xd.sendDofs];
+  if ( ! sending_ )
+  {
+    xd.gather ( sendVec );
+
+    xd.sendVecReqs->startAll ();
+  }
 
-  xd.sendVecReqs->startAll ();
   xd.recvVecReqs->waitAll  ();
 
-  if ( overlap_ && xmode_ == EXCHANGE )
-  {
-    recvVec[xd.recvDofs]  = xd.recvVector;
-  }
-  else
-  {
-    recvVec[xd.recvDofs] += xd.recvVector;
-  }
+  xd.scatter ( recvVec, ! (overlap_ && xmode_ == EXCHANGE) );
 
   xd.sendVecReqs->waitAll ();
 
-  xmode_ = INACTIVE_;
+  xmode_   = INACTIVE_;
+  sending_ = false;
 }
 
 
@@ -930,6 +1175,7 @@ void VectorExchanger::init_ ()
   overlap_  = (recvBorders_ != sendBorders_);
   xmode_    = INACTIVE_;
   updated_  = false;
+  sending_  = false;
 
   xdata_[EXCHANGE] = newInstance<XData_> ( mpx_ );
 
@@ -30,13 +30,20 @@
  */
 
 
-#include <jem/io/DataInputStream.h>
-#include <jem/io/DataOutputStream.h>
+#include <jem/base/Thread.h>
+#include <jem/base/Throwable.h>
+#include <jem/io/Pipe.h>
+#include <jem/io/PipedInputStream.h>
+#include <jem/io/PipedOutputStream.h>
 #include <jem/io/ArrayInputStream.h>
 #include <jem/io/ArrayOutputStream.h>
+#include <jem/io/BufferedOutputStream.h>
+#include <jem/io/DataInputStream.h>
+#include <jem/io/DataOutputStream.h>
 #include <jem/io/SerializationException.h>
 #include <jem/mp/Context.h>
 #include <jem/mp/BcastStream.h>
+#include <jem/mp/ChannelConstants.h>
 #include <jem/util/Dictionary.h>
 #include <jem/util/DictionaryEnumerator.h>
 #include <jive/util/ItemSet.h>
@@ -47,13 +54,18 @@ JIVE_BEGIN_PACKAGE( mp )
 
 
 using jem::newInstance;
-using jem::io::DataInputStream;
-using jem::io::DataOutputStream;
+using jem::Thread;
+using jem::Throwable;
+using jem::io::Pipe;
+using jem::io::PipedInputStream;
+using jem::io::PipedOutputStream;
 using jem::io::ArrayInputStream;
 using jem::io::ArrayOutputStream;
+using jem::io::BufferedOutputStream;
+using jem::io::DataInputStream;
+using jem::io::DataOutputStream;
 using jem::io::SerializationException;
 using jem::mp::BcastStream;
-using jem::util::ArrayBuffer;
 using jem::util::DictEnum;
 
 
@@ -66,6 +78,24 @@ ScatterCodec::~ScatterCodec ()
 {}
 
 
+//-----------------------------------------------------------------------
+//   class ScatterWriter
+//-----------------------------------------------------------------------
+
+
+ScatterWriter::~ScatterWriter ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   class ScatterReader
+//-----------------------------------------------------------------------
+
+
+ScatterReader::~ScatterReader ()
+{}
+
+
 //-----------------------------------------------------------------------
 //   constants
 //-----------------------------------------------------------------------
@@ -74,18 +104,251 @@ ScatterCodec::~ScatterCodec ()
 static const int  SCATTER_MAGIC = 1234;
 
 
+#ifdef JEM_USE_THREADS
+
+//=======================================================================
+//   class WriterThread
+//=======================================================================
+
+// Runs a ScatterWriter and sends its output into a pipe. This allows
+// the root process to broadcast the data while it is being written,
+// so that it never needs to hold all data in memory.
+
+
+class WriterThread : public Thread
+{
+ public:
+
+  explicit inline           WriterThread
+
+    ( ScatterWriter&          writer,
+      const Ref<Pipe>&        pipe );
+
+  virtual void              run           () override;
+  void                      checkError    () const;
+
+
+ private:
+
+  ScatterWriter&            writer_;
+  Ref<PipedOutputStream>    output_;
+
+  bool                      failed_;
+  String                    errWhere_;
+  String                    errWhat_;
+
+};
+
+
 //-----------------------------------------------------------------------
-//   readObjects
+//   constructor
 //-----------------------------------------------------------------------
 
 
-static void             readObjects
+inline WriterThread::WriterThread
 
-  ( DataInput&            in,
-    ScatterCodec&         codec,
-    Dictionary&           dict,
-    const Ref<ItemSet>&   items )
+  ( ScatterWriter&     writer,
+    const Ref<Pipe>&   pipe ) :
+
+    writer_ ( writer ),
+    failed_ ( false )
+
+{
+  output_ = newInstance<PipedOutputStream> ( pipe );
+}
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+void WriterThread::run ()
+{
+  try
+  {
+    Ref<DataOutputStream>  output =
+
+      newInstance<DataOutputStream> (
+        newInstance<BufferedOutputStream> ( output_ )
+      );
+
+    writer_.writeData ( *output );
+    output->close     ();
+  }
+  catch ( const Throwable& ex )
+  {
+    failed_   = true;
+    errWhere_ = ex.where ();
+    errWhat_  = ex.what  ();
+  }
+  catch ( ... )
+  {
+    failed_   = true;
+    errWhere_ = JEM_FUNC;
+    errWhat_  = "unknown exception";
+  }
+
+  // Make sure that the reader does not wait forever.
+
+  output_->close ();
+}
+
+
+//-----------------------------------------------------------------------
+//   checkError
+//-----------------------------------------------------------------------
+
+
+void WriterThread::checkError () const
+{
+  if ( failed_ )
+  {
+    throw SerializationException (
+      errWhere_,
+      "error writing scatter data: " + errWhat_
+    );
+  }
+}
+
+#endif
+
+
+//=======================================================================
+//   class ObjectWriter
+//=======================================================================
+
+
+class ObjectWriter : public ScatterWriter
+{
+ public:
+
+  inline                    ObjectWriter
+
+    ( ScatterCodec&           codec,
+      Dictionary&             dict );
+
+  virtual void              writeData
 
+    ( DataOutput&             out )          override;
+
+
+ private:
+
+  ScatterCodec&             codec_;
+  Dictionary&               dict_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline ObjectWriter::ObjectWriter
+
+  ( ScatterCodec&  codec,
+    Dictionary&    dict ) :
+
+    codec_ ( codec ),
+    dict_  ( dict  )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   writeData
+//-----------------------------------------------------------------------
+
+
+void ObjectWriter::writeData ( DataOutput& out )
+{
+  Ref<Object>    obj;
+  Ref<DictEnum>  e;
+
+  StringVector   names ( dict_.size() );
+
+
+  idx_t  i = 0;
+
+  for ( e = dict_.enumerate(); ! e->atEnd(); e->toNext() )
+  {
+    names[i++] = e->getKey ();
+  }
+
+  e = nullptr;
+
+  idx_t  n = names.size ();
+
+  encode ( out, n );
+
+  for ( i = 0; i < n; i++ )
+  {
+    obj = dict_.get ( names[i] );
+
+    dict_.erase ( names[i] );
+
+    encode ( out, names[i], SCATTER_MAGIC );
+
+    codec_.writeObject ( out, obj );
+  }
+}
+
+
+//=======================================================================
+//   class ObjectReader
+//=======================================================================
+
+
+class ObjectReader : public ScatterReader
+{
+ public:
+
+  inline                    ObjectReader
+
+    ( ScatterCodec&           codec,
+      Dictionary&             dict,
+      const Ref<ItemSet>&     items );
+
+  virtual void              readData
+
+    ( DataInput&              in )           override;
+
+
+ private:
+
+  ScatterCodec&             codec_;
+  Dictionary&               dict_;
+  Ref<ItemSet>              items_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline ObjectReader::ObjectReader
+
+  ( ScatterCodec&        codec,
+    Dictionary&          dict,
+    const Ref<ItemSet>&  items ) :
+
+    codec_ ( codec ),
+    dict_  ( dict  ),
+    items_ ( items )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   readData
+//-----------------------------------------------------------------------
+
+
+void ObjectReader::readData ( DataInput& in )
 {
   Ref<Object>  obj;
   String       name;
@@ -110,27 +373,29 @@ static void             readObjects
       );
     }
 
-    obj = codec.readObject ( in, items );
+    obj = codec_.readObject ( in, items_ );
 
     if ( obj )
     {
-      dict.insert ( name, obj );
+      dict_.insert ( name, obj );
     }
   }
 }
 
 
+//=======================================================================
+//   public functions
+//=======================================================================
+
 //-----------------------------------------------------------------------
-//   recvObjects
+//   recvStream
 //-----------------------------------------------------------------------
 
 
-void                    recvObjects
+void                    recvStream
 
   ( Context&              mpx,
-    ScatterCodec&         codec,
-    Dictionary&           recvDict,
-    const Ref<ItemSet>&   myItems,
+    ScatterReader&        reader,
     int                   root )
 
 {
@@ -140,68 +405,130 @@ void                    recvObjects
       newInstance<BcastStream> ( root, & mpx, nullptr )
     );
 
-  readObjects ( *input, codec, recvDict, myItems );
+  reader.readData ( *input );
 }
 
 
 //-----------------------------------------------------------------------
-//   scatterObjects
+//   scatterStream
 //-----------------------------------------------------------------------
 
+// The data is written by a separate thread into a pipe with a fixed
+// capacity. The current thread broadcasts the contents of the pipe
+// and also reads the data destined for the root process. Without
+// thread support, all data is first written to a memory buffer.
 
-void                    scatterObjects
+
+void                    scatterStream
 
   ( Context&              mpx,
-    ScatterCodec&         codec,
-    Dictionary&           recvDict,
-    Dictionary&           sendDict,
-    const Ref<ItemSet>&   myItems )
+    ScatterReader&        reader,
+    ScatterWriter&        writer )
 
 {
-  Ref<ArrayInputStream>   inBuf;
-  Ref<ArrayOutputStream>  outBuf;
-  Ref<DataInputStream>    input;
-  Ref<DataOutputStream>   output;
+#ifdef JEM_USE_THREADS
 
-  Ref<Object>             obj;
-  Ref<DictEnum>           e;
+  Ref<Pipe>              pipe   =
 
-  StringVector            names ( sendDict.size() );
+    newInstance<Pipe> ( jem::mp::getStreamBufsize( mpx ) );
 
+  Ref<PipedInputStream>  pipeIn = newInstance<PipedInputStream> ( pipe );
+  Ref<WriterThread>      thread = newInstance<WriterThread>     ( writer,
+                                                                  pipe );
+  Ref<DataInputStream>   input;
 
-  idx_t  i = 0;
 
-  for ( e = sendDict.enumerate(); ! e->atEnd(); e->toNext() )
+  thread->start ();
+
+  try
   {
-    names[i++] = e->getKey ();
+    input = newInstance<DataInputStream> (
+      newInstance<BcastStream> ( mpx.myRank(), & mpx, pipeIn )
+    );
+
+    reader.readData ( *input );
   }
+  catch ( ... )
+  {
+    // Close the pipe to stop the writer and report its error, if
+    // any, as that is most likely the cause of the problem.
 
-  e      = nullptr;
-  outBuf = newInstance<ArrayOutputStream> ();
-  output = newInstance<DataOutputStream>  ( outBuf );
+    pipeIn->close      ();
+    thread->join       ();
+    thread->checkError ();
 
-  idx_t  n = names.size ();
+    throw;
+  }
 
-  encode ( *output, n );
+  pipeIn->close      ();
+  thread->join       ();
+  thread->checkError ();
 
-  for ( i = 0; i < n; i++ )
-  {
-    obj = sendDict.get ( names[i] );
+#else
 
-    sendDict.erase ( names[i] );
+  Ref<ArrayOutputStream>  outBuf = newInstance<ArrayOutputStream> ();
+  Ref<DataOutputStream>   output =
 
-    encode ( *output, names[i], SCATTER_MAGIC );
+    newInstance<DataOutputStream> ( outBuf );
+
+  Ref<DataInputStream>    input;
 
-    codec.writeObject ( *output, obj );
-  }
 
-  inBuf = newInstance<ArrayInputStream> ( outBuf->toArray() );
+  writer.writeData ( *output );
+  output->close    ();
 
   input = newInstance<DataInputStream> (
-    newInstance<BcastStream> ( mpx.myRank(), & mpx, inBuf )
+    newInstance<BcastStream> (
+      mpx.myRank (),
+      & mpx,
+      newInstance<ArrayInputStream> ( outBuf->toArray() )
+    )
   );
 
-  readObjects ( *input, codec, recvDict, myItems );
+  reader.readData ( *input );
+
+#endif
+}
+
+
+//-----------------------------------------------------------------------
+//   recvObjects
+//-----------------------------------------------------------------------
+
+
+void                    recvObjects
+
+  ( Context&              mpx,
+    ScatterCodec&         codec,
+    Dictionary&           recvDict,
+    const Ref<ItemSet>&   myItems,
+    int                   root )
+
+{
+  ObjectReader  reader ( codec, recvDict, myItems );
+
+  recvStream ( mpx, reader, root );
+}
+
+
+//-----------------------------------------------------------------------
+//   scatterObjects
+//-----------------------------------------------------------------------
+
+
+void                    scatterObjects
+
+  ( Context&              mpx,
+    ScatterCodec&         codec,
+    Dictionary&           recvDict,
+    Dictionary&           sendDict,
+    const Ref<ItemSet>&   myItems )
+
+{
+  ObjectReader  reader ( codec, recvDict, myItems );
+  ObjectWriter  writer ( codec, sendDict );
+
+  scatterStream ( mpx, reader, writer );
 }
 
 
@@ -30,13 +30,9 @@
  */
 
 
-#include <jem/io/DataInputStream.h>
-#include <jem/io/DataOutputStream.h>
-#include <jem/io/ArrayInputStream.h>
-#include <jem/io/ArrayOutputStream.h>
+#include <jem/io/DataInput.h>
+#include <jem/io/DataOutput.h>
 #include <jem/io/SerializationException.h>
-#include <jem/mp/Context.h>
-#include <jem/mp/BcastStream.h>
 #include <jive/util/ItemMap.h>
 #include <jive/util/XMemberSet.h>
 #include <jive/mp/scatter.h>
@@ -45,15 +41,7 @@
 JIVE_BEGIN_PACKAGE( mp )
 
 
-using jem::dynamicCast;
-using jem::newInstance;
-using jem::io::DataInputStream;
-using jem::io::DataOutputStream;
-using jem::io::ArrayInputStream;
-using jem::io::ArrayOutputStream;
 using jem::io::SerializationException;
-using jem::mp::BcastStream;
-using jem::util::ArrayBuffer;
 using jive::util::ItemMap;
 
 
@@ -140,6 +128,106 @@ static void         writeMembers
 }
 
 
+//=======================================================================
+//   class MemberReader
+//=======================================================================
+
+
+class MemberReader : public ScatterReader
+{
+ public:
+
+  explicit inline           MemberReader
+
+    ( XMemberSet&             mbrs );
+
+  virtual void              readData
+
+    ( DataInput&              in )           override;
+
+
+ private:
+
+  XMemberSet&               mbrs_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline MemberReader::MemberReader ( XMemberSet& mbrs ) :
+
+  mbrs_ ( mbrs )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   readData
+//-----------------------------------------------------------------------
+
+
+void MemberReader::readData ( DataInput& in )
+{
+  readMembers ( in, mbrs_ );
+}
+
+
+//=======================================================================
+//   class MemberWriter
+//=======================================================================
+
+
+class MemberWriter : public ScatterWriter
+{
+ public:
+
+  explicit inline           MemberWriter
+
+    ( const MemberSet&        mbrs );
+
+  virtual void              writeData
+
+    ( DataOutput&             out )          override;
+
+
+ private:
+
+  const MemberSet&          mbrs_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline MemberWriter::MemberWriter ( const MemberSet& mbrs ) :
+
+  mbrs_ ( mbrs )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   writeData
+//-----------------------------------------------------------------------
+
+
+void MemberWriter::writeData ( DataOutput& out )
+{
+  writeMembers ( out, mbrs_ );
+}
+
+
+//=======================================================================
+//   public functions
+//=======================================================================
+
 //-----------------------------------------------------------------------
 //   recvMembers
 //-----------------------------------------------------------------------
@@ -152,13 +240,9 @@ void                recvMembers
     int               root )
 
 {
-  Ref<DataInputStream>  input  =
-
-    newInstance<DataInputStream> (
-      newInstance<BcastStream> ( root, & mpx, nullptr )
-    );
+  MemberReader  reader ( mbrs );
 
-  readMembers ( *input, mbrs );
+  recvStream ( mpx, reader, root );
 }
 
 
@@ -174,24 +258,10 @@ void                scatterMembers
     const MemberSet&  sendMbrs )
 
 {
-  Ref<ArrayInputStream>   inBuf;
-  Ref<ArrayOutputStream>  outBuf;
-  Ref<DataInputStream>    input;
-  Ref<DataOutputStream>   output;
-
-
-  outBuf = newInstance<ArrayOutputStream> ();
-  output = newInstance<DataOutputStream>  ( outBuf );
-
-  writeMembers ( *output, sendMbrs );
-
-  inBuf  = newInstance<ArrayInputStream> ( outBuf->toArray() );
-
-  input  = newInstance<DataInputStream> (
-    newInstance<BcastStream> ( mpx.myRank(), & mpx, inBuf )
-  );
+  MemberReader  reader ( recvMbrs );
+  MemberWriter  writer ( sendMbrs );
 
-  readMembers ( *input, recvMbrs );
+  scatterStream ( mpx, reader, writer );
 }
 
 
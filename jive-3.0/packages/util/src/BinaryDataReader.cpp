@@ -0,0 +1,1265 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+
+#include <jem/base/ClassTemplate.h>
+#include <jem/base/IllegalInputException.h>
+#include <jem/base/IllegalArgumentException.h>
+#include <jem/base/array/operators.h>
+#include <jem/base/array/utilities.h>
+#include <jem/io/Writer.h>
+#include <jem/io/MappedInputStream.h>
+#include <jem/util/Pattern.h>
+#include <jem/util/Properties.h>
+#include <jem/util/HashDictionary.h>
+#include <jem/util/DictionaryEnumerator.h>
+#include <jive/util/utilities.h>
+#include <jive/util/ItemMap.h>
+#include <jive/util/ItemGroup.h>
+#include <jive/util/ArrayItemGroup.h>
+#include <jive/util/XPointSet.h>
+#include <jive/util/XGroupSet.h>
+#include <jive/util/XMemberSet.h>
+#include <jive/util/DenseTable.h>
+#include <jive/util/SparseTable.h>
+#include <jive/util/ConstraintsParser.h>
+#include <jive/util/private/BinaryDataFormat.h>
+#include <jive/util/BinaryDataReader.h>
+
+
+JEM_DEFINE_CLASS( jive::util::BinaryDataReader );
+
+
+JIVE_BEGIN_PACKAGE( util )
+
+
+using jem::dynamicCast;
+using jem::staticCast;
+using jem::newInstance;
+using jem::IllegalInputException;
+using jem::IllegalArgumentException;
+using jem::io::MappedInputStream;
+using jem::util::Pattern;
+using jem::util::HashDictionary;
+
+
+//=======================================================================
+//   class BinaryDataReader::Target_
+//=======================================================================
+
+// Collects the objects that are to be filled with the data sections
+// associated with one item type.
+
+
+class BinaryDataReader::Target_ : public Object
+{
+ public:
+
+  Ref<XPointSet>          points;
+  Ref<XGroupSet>          groups;
+  Ref<XMemberSet>         members;
+  Ref<ItemSet>            groupItems;
+  Ref<Dictionary>         itemGroups;
+  String                  groupFilter;
+  Ref<ItemSet>            tableItems;
+  Ref<Dictionary>         tables;
+  String                  tableFilter;
+  Ref<ConParser>          conParser;
+
+};
+
+
+//=======================================================================
+//   class BinaryDataReader::Input_
+//=======================================================================
+
+
+class BinaryDataReader::Input_
+{
+ public:
+
+  explicit inline         Input_
+
+    ( const String&         fname );
+
+  inline lint             readLint    ();
+  String                  readString  ();
+
+  const lint*             readLints
+
+    ( lint                  n );
+
+  const double*           readDoubles
+
+    ( lint                  n );
+
+  idx_t                   readIndices
+
+    ( const IdxVector&      iitems,
+      const ItemSet&        items,
+      lint                  n );
+
+  void                    formatError
+
+    ( const String&         what )         const;
+
+
+ public:
+
+  const String            fname;
+  Ref<MappedInputStream>  input;
+
+
+ private:
+
+  const byte*             readSpan_
+
+    ( lint                  n );
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline BinaryDataReader::Input_::Input_ ( const String& name ) :
+
+  fname ( name )
+
+{
+  input = newInstance<MappedInputStream> ( fname );
+}
+
+
+//-----------------------------------------------------------------------
+//   readLint
+//-----------------------------------------------------------------------
+
+
+inline lint BinaryDataReader::Input_::readLint ()
+{
+  return * readLints ( 1 );
+}
+
+
+//-----------------------------------------------------------------------
+//   readString
+//-----------------------------------------------------------------------
+
+
+String BinaryDataReader::Input_::readString ()
+{
+  const lint   n = readLint ();
+
+  const char*  s = (const char*)
+
+    readSpan_ ( BinaryDataFormat::padSize( n ) );
+
+  return String ( s, s + n );
+}
+
+
+//-----------------------------------------------------------------------
+//   readLints
+//-----------------------------------------------------------------------
+
+
+const lint* BinaryDataReader::Input_::readLints ( lint n )
+{
+  if ( n < 0 || n > input->available() / 8 )
+  {
+    formatError ( "invalid array size" );
+  }
+
+  return (const lint*) readSpan_ ( 8 * n );
+}
+
+
+//-----------------------------------------------------------------------
+//   readDoubles
+//-----------------------------------------------------------------------
+
+
+const double* BinaryDataReader::Input_::readDoubles ( lint n )
+{
+  if ( n < 0 || n > input->available() / 8 )
+  {
+    formatError ( "invalid array size" );
+  }
+
+  return (const double*) readSpan_ ( 8 * n );
+}
+
+
+//-----------------------------------------------------------------------
+//   readIndices
+//-----------------------------------------------------------------------
+
+// Reads an array of item IDs and converts them to item indices. Returns
+// the number of IDs that could be found.
+
+
+idx_t BinaryDataReader::Input_::readIndices
+
+  ( const IdxVector&  iitems,
+    const ItemSet&    items,
+    lint              n )
+
+{
+  JEM_ASSERT ( iitems.size() == n );
+
+  const lint*  ids = readLints ( n );
+
+  IdxVector    itemIDs ( iitems.size() );
+
+
+  for ( idx_t i = 0; i < iitems.size(); i++ )
+  {
+    itemIDs[i] = (idx_t) ids[i];
+  }
+
+  return items.getItemMap()->findItems ( iitems, itemIDs );
+}
+
+
+//-----------------------------------------------------------------------
+//   formatError
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::Input_::formatError
+
+  ( const String&  what ) const
+
+{
+  throw IllegalInputException (
+    fname,
+    String::format ( "invalid binary data file: %s", what )
+  );
+}
+
+
+//-----------------------------------------------------------------------
+//   readSpan_
+//-----------------------------------------------------------------------
+
+
+const byte* BinaryDataReader::Input_::readSpan_ ( lint n )
+{
+  if ( n < 0 || n > input->available() ||
+       n > (lint) jem::maxOf<idx_t>() )
+  {
+    formatError ( "unexpected end of file" );
+  }
+
+  return input->readSpan ( (idx_t) n );
+}
+
+
+//=======================================================================
+//   class BinaryDataReader::Utils_
+//=======================================================================
+
+
+class BinaryDataReader::Utils_
+{
+ public:
+
+  typedef BinaryDataReader  Reader;
+
+
+  static void               readPointSet
+
+    ( Input_&                 in,
+      XPointSet&              points,
+      Writer*                 logger );
+
+  static void               readGroupSet
+
+    ( Input_&                 in,
+      XGroupSet&              groups,
+      bool                    skipUnknown,
+      Writer*                 logger );
+
+  static void               readMemberSet
+
+    ( Input_&                 in,
+      XMemberSet&             members,
+      bool                    skipUnknown,
+      Writer*                 logger );
+
+  static void               readItemGroup
+
+    ( Input_&                 in,
+      const Target_&          target,
+      bool                    skipUnknown,
+      Writer*                 logger );
+
+  static void               readTable
+
+    ( Input_&                 in,
+      const Target_&          target,
+      bool                    skipUnknown,
+      Writer*                 logger );
+
+  static void               readConstraints
+
+    ( Input_&                 in,
+      ConParser&              conParser,
+      bool                    skipUnknown,
+      Writer*                 logger );
+
+  static void               noSuchItem
+
+    ( const Input_&           in,
+      const ItemSet&          items );
+
+};
+
+
+//-----------------------------------------------------------------------
+//   readPointSet
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::Utils_::readPointSet
+
+  ( Input_&     in,
+    XPointSet&  points,
+    Writer*     logger )
+
+{
+  const idx_t    rank   = (idx_t) in.readLint  ();
+  const idx_t    count  = (idx_t) in.readLint  ();
+
+  const lint*    ids    = in.readLints   ( count );
+  const double*  coords = in.readDoubles ( (lint) count * rank );
+
+  Vector         x      ( rank );
+
+
+  if ( points.size() > 0 && rank != points.rank() )
+  {
+    in.formatError (
+      String::format ( "%s set has rank %d; should be %d",
+                       points.getItemName (),
+                       rank,
+                       points.rank        () )
+    );
+  }
+
+  points.reserve ( points.size() + count );
+
+  for ( idx_t ip = 0; ip < count; ip++ )
+  {
+    const double*  xp = coords + ip * rank;
+
+    for ( idx_t i = 0; i < rank; i++ )
+    {
+      x[i] = xp[i];
+    }
+
+    points.addPoint ( (idx_t) ids[ip], x );
+  }
+
+  if ( logger )
+  {
+    print ( *logger, "  ", in.fname, " : read ",
+            points.getItemName(), " set (", count, " items)\n" );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   readGroupSet
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::Utils_::readGroupSet
+
+  ( Input_&     in,
+    XGroupSet&  groups,
+    bool        skipUnknown,
+    Writer*     logger )
+
+{
+  using jem::slice;
+
+  const ItemSet&  items   = * groups.getGroupedItems ();
+
+  const idx_t     count   = (idx_t) in.readLint ();
+
+  const lint*     ids     = in.readLints ( count );
+  const lint*     offsets = in.readLints ( (lint) count + 1 );
+
+  const idx_t     nnz     = (idx_t) offsets[count];
+
+  IdxVector       iitems  ( nnz );
+
+  idx_t           added   = 0;
+
+
+  if ( in.readIndices( iitems, items, nnz ) < nnz && ! skipUnknown )
+  {
+    noSuchItem ( in, items );
+  }
+
+  groups.reserve ( groups.size() + count );
+
+  for ( idx_t ig = 0; ig < count; ig++ )
+  {
+    const idx_t  i = (idx_t) offsets[ig];
+    const idx_t  j = (idx_t) offsets[ig + 1];
+
+    if ( i < 0 || i > j || j > nnz )
+    {
+      in.formatError ( "invalid group offset array" );
+    }
+
+    if ( skipUnknown && j > i && jem::min( iitems[slice(i,j)] ) < 0 )
+    {
+      continue;
+    }
+
+    groups.addGroup ( (idx_t) ids[ig], iitems[slice(i,j)] );
+
+    added++;
+  }
+
+  if ( logger )
+  {
+    print ( *logger, "  ", in.fname, " : read ",
+            groups.getItemName(), " set (", added, " items)\n" );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   readMemberSet
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::Utils_::readMemberSet
+
+  ( Input_&      in,
+    XMemberSet&  members,
+    bool         skipUnknown,
+    Writer*      logger )
+
+{
+  const ItemSet&  items   = * members.getCompoundItems ();
+
+  const idx_t     count   = (idx_t) in.readLint ();
+
+  const lint*     ids     = in.readLints ( count );
+
+  IdxVector       iitems  ( count );
+
+  idx_t           added   = 0;
+
+
+  if ( in.readIndices( iitems, items, count ) < count &&
+       ! skipUnknown )
+  {
+    noSuchItem ( in, items );
+  }
+
+  const lint*     ilocals = in.readLints ( count );
+
+  members.reserve ( members.size() + count );
+
+  for ( idx_t im = 0; im < count; im++ )
+  {
+    if ( iitems[im] >= 0 )
+    {
+      members.addMember ( (idx_t) ids[im], iitems[im],
+                          (idx_t) ilocals[im] );
+      added++;
+    }
+  }
+
+  if ( logger )
+  {
+    print ( *logger, "  ", in.fname, " : read ",
+            members.getItemName(), " set (", added, " items)\n" );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   readItemGroup
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::Utils_::readItemGroup
+
+  ( Input_&         in,
+    const Target_&  target,
+    bool            skipUnknown,
+    Writer*         logger )
+
+{
+  using jem::count;
+
+  const ItemSet&  items  = * target.groupItems;
+
+  const String    name   = in.readString ();
+  const idx_t     size   = (idx_t) in.readLint ();
+
+  IdxVector       iitems ( size );
+
+  Ref<ItemGroup>  group;
+  Ref<XItemGroup> xgroup;
+
+
+  if ( ! Pattern::matches( target.groupFilter, name ) )
+  {
+    return;
+  }
+
+  if ( in.readIndices( iitems, items, size ) < size )
+  {
+    if ( ! skipUnknown )
+    {
+      noSuchItem ( in, items );
+    }
+
+    IdxVector  jitems ( count( iitems >= 0 ) );
+    idx_t      j = 0;
+
+    for ( idx_t i = 0; i < size; i++ )
+    {
+      if ( iitems[i] >= 0 )
+      {
+        jitems[j++] = iitems[i];
+      }
+    }
+
+    iitems.ref ( jitems );
+  }
+
+  group = dynamicCast<ItemGroup> ( target.itemGroups->get( name ) );
+
+  if ( group )
+  {
+    xgroup = dynamicCast<XItemGroup> ( group );
+
+    if ( ! xgroup )
+    {
+      throw IllegalInputException (
+        in.fname,
+        String::format ( "%s group `%s\' can not be modified",
+                         items.getItemName (),
+                         name )
+      );
+    }
+
+    xgroup->append ( iitems );
+  }
+  else
+  {
+    group = newInstance<ArrayItemGroup> ( iitems, target.groupItems );
+
+    target.itemGroups->insert ( name, group );
+  }
+
+  if ( logger )
+  {
+    print ( *logger, "  ", in.fname, " : read ",
+            items.getItemName(), " group `", name,
+            "\' (", iitems.size(), " items)\n" );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   readTable
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::Utils_::readTable
+
+  ( Input_&         in,
+    const Target_&  target,
+    bool            skipUnknown,
+    Writer*         logger )
+
+{
+  const ItemSet&  items    = * target.tableItems;
+
+  const String    name     = in.readString ();
+  const bool      dense    = (in.readLint() != 0);
+  const idx_t     colCount = (idx_t) in.readLint ();
+
+  StringVector    colNames ( colCount );
+
+  Ref<Table>      table;
+  Ref<XTable>     xtable;
+
+
+  if ( ! Pattern::matches( target.tableFilter, name ) )
+  {
+    return;
+  }
+
+  for ( idx_t j = 0; j < colCount; j++ )
+  {
+    colNames[j] = in.readString ();
+  }
+
+  const idx_t     rowCount = (idx_t) in.readLint ();
+
+  IdxVector       irows    ( rowCount );
+
+
+  if ( in.readIndices( irows, items, rowCount ) < rowCount &&
+       ! skipUnknown )
+  {
+    noSuchItem ( in, items );
+  }
+
+  const lint*     offsets  = in.readLints   ( (lint) rowCount + 1 );
+  const idx_t     nnz      = (idx_t) offsets[rowCount];
+  const lint*     jcols    = in.readLints   ( nnz );
+  const double*   values   = in.readDoubles ( nnz );
+
+  IdxVector       jmap;
+  IdxVector       jtable   ( nnz );
+
+
+  table = dynamicCast<Table> ( target.tables->get( name ) );
+
+  if ( table )
+  {
+    xtable = dynamicCast<XTable> ( table );
+
+    if ( ! xtable )
+    {
+      throw IllegalInputException (
+        in.fname,
+        String::format ( "%s table `%s\' can not be modified",
+                         items.getItemName (),
+                         name )
+      );
+    }
+  }
+  else
+  {
+    String  tname = joinNames ( target.tableItems->getName(), name );
+
+    if ( dense )
+    {
+      xtable = newInstance<DenseTable>  ( tname, target.tableItems );
+    }
+    else
+    {
+      xtable = newInstance<SparseTable> ( tname, target.tableItems );
+    }
+  }
+
+  jmap.ref ( xtable->addColumns( colNames ) );
+
+  for ( idx_t i = 0; i < nnz; i++ )
+  {
+    if ( jcols[i] < 0 || jcols[i] >= colCount )
+    {
+      in.formatError ( "invalid table column index" );
+    }
+
+    jtable[i] = jmap[(idx_t) jcols[i]];
+  }
+
+  xtable->reserve ( xtable->size() + nnz );
+
+  for ( idx_t i = 0; i < rowCount; i++ )
+  {
+    const idx_t  k = (idx_t) offsets[i];
+    const idx_t  n = (idx_t) offsets[i + 1] - k;
+
+    if ( k < 0 || n < 0 || k + n > nnz )
+    {
+      in.formatError ( "invalid table offset array" );
+    }
+
+    if ( irows[i] >= 0 )
+    {
+      xtable->setData ( irows.addr( i ), 1,
+                        jtable.addr( k ), n, values + k );
+    }
+  }
+
+  if ( ! table )
+  {
+    target.tables->insert ( name, xtable );
+  }
+
+  if ( logger )
+  {
+    print ( *logger, "  ", in.fname, " : read ",
+            items.getItemName(), " table `", name,
+            "\' (", colCount, " columns)\n" );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   readConstraints
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::Utils_::readConstraints
+
+  ( Input_&     in,
+    ConParser&  conParser,
+    bool        skipUnknown,
+    Writer*     logger )
+
+{
+  const ItemSet&  items     = * conParser.getItems ();
+
+  const idx_t     typeCount = (idx_t) in.readLint ();
+
+  StringVector    typeNames ( typeCount );
+
+
+  for ( idx_t i = 0; i < typeCount; i++ )
+  {
+    typeNames[i] = in.readString ();
+  }
+
+  const idx_t     conCount  = (idx_t) in.readLint ();
+  const lint*     ioffsets  = in.readLints ( (lint) conCount + 1 );
+  const idx_t     n         = (idx_t) ioffsets[conCount];
+
+  IdxVector       offsets   ( conCount + 1 );
+  IdxVector       iitems    ( n );
+  IdxVector       itypes    ( n );
+  Vector          values    ( n );
+  BoolVector      rmask     ( conCount );
+
+  const lint*     ip;
+  const double*   xp;
+  idx_t           i, j, k;
+
+
+  if ( in.readIndices( iitems, items, n ) < n && ! skipUnknown )
+  {
+    noSuchItem ( in, items );
+  }
+
+  ip = in.readLints   ( n );
+
+  for ( i = 0; i < n; i++ )
+  {
+    itypes[i] = (idx_t) ip[i];
+  }
+
+  xp = in.readDoubles ( n );
+
+  for ( i = 0; i < n; i++ )
+  {
+    values[i] = xp[i];
+  }
+
+  ip = in.readLints   ( conCount );
+
+  for ( i = 0; i < conCount; i++ )
+  {
+    rmask[i] = (ip[i] != 0);
+  }
+
+  // Remove the constraints that refer to unknown items. The arrays
+  // are compressed in place.
+
+  offsets[0] = k = j = 0;
+
+  for ( idx_t icon = 0; icon < conCount; icon++ )
+  {
+    const idx_t  first = (idx_t) ioffsets[icon];
+    const idx_t  last  = (idx_t) ioffsets[icon + 1];
+
+    bool         valid = true;
+
+    if ( first < 0 || first >= last || last > n )
+    {
+      in.formatError ( "invalid constraint offset array" );
+    }
+
+    for ( i = first; i < last; i++ )
+    {
+      valid = valid && (iitems[i] >= 0);
+    }
+
+    if ( ! valid )
+    {
+      continue;
+    }
+
+    for ( i = first; i < last; i++, k++ )
+    {
+      iitems[k] = iitems[i];
+      itypes[k] = itypes[i];
+      values[k] = values[i];
+    }
+
+    rmask[j++]  = rmask[icon];
+    offsets[j]  = k;
+  }
+
+  if ( j < conCount )
+  {
+    using jem::slice;
+    using jem::BEGIN;
+
+    offsets.ref ( offsets[slice(BEGIN,j + 1)] );
+    iitems .ref ( iitems [slice(BEGIN,k)] );
+    itypes .ref ( itypes [slice(BEGIN,k)] );
+    values .ref ( values [slice(BEGIN,k)] );
+    rmask  .ref ( rmask  [slice(BEGIN,j)] );
+  }
+
+  try
+  {
+    conParser.addData ( typeNames, offsets,
+                        iitems, itypes, values, rmask );
+  }
+  catch ( const IllegalArgumentException& )
+  {
+    in.formatError ( "invalid constraint data" );
+  }
+
+  if ( logger )
+  {
+    print ( *logger, "  ", in.fname, " : read ",
+            items.getItemName(), " constraints (",
+            j, " slave dofs)\n" );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   noSuchItem
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::Utils_::noSuchItem
+
+  ( const Input_&   in,
+    const ItemSet&  items )
+
+{
+  throw IllegalInputException (
+    in.fname,
+    String::format ( "reference to an undefined %s",
+                     items.getItemName() )
+  );
+}
+
+
+//=======================================================================
+//   class BinaryDataReader
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+const char*  BinaryDataReader::FILE_EXTENSION = ".bdata";
+
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+BinaryDataReader::BinaryDataReader ()
+{
+  targets_     = newInstance<HashDictionary> ();
+  skipUnknown_ = false;
+}
+
+
+BinaryDataReader::~BinaryDataReader ()
+{}
+
+
+//-----------------------------------------------------------------------
+//   readFile
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::readFile
+
+  ( const String&       fname,
+    const Ref<Writer>&  logger )
+
+{
+  typedef BinaryDataFormat  Format;
+
+  Input_    in ( fname );
+
+  Target_*  target;
+  String    itemName;
+  lint      kind;
+  lint      size;
+  lint      start;
+
+
+  if ( in.input->available() < 24 )
+  {
+    in.formatError ( "missing file header" );
+  }
+
+  if ( in.readLint() != Format::MAGIC )
+  {
+    in.formatError ( "invalid magic number" );
+  }
+
+  if ( in.readLint() != Format::ORDER_MARK )
+  {
+    in.formatError ( "file has been written on a machine with "
+                     "a different byte order" );
+  }
+
+  if ( in.readLint() != Format::VERSION )
+  {
+    in.formatError ( "unsupported format version" );
+  }
+
+  while ( in.input->available() > 0 )
+  {
+    kind = in.readLint ();
+
+    if ( kind == Format::END )
+    {
+      break;
+    }
+
+    size  = in.readLint ();
+    start = in.input->getPosition ();
+
+    if ( size < 0 || size > in.input->available() )
+    {
+      in.formatError ( "invalid section size" );
+    }
+
+    itemName = in.readString ();
+    target   = getTarget_  ( itemName );
+
+    if ( target )
+    {
+      switch ( kind )
+      {
+      case Format::POINT_SET:
+
+        if ( target->points )
+        {
+          Utils_::readPointSet    ( in, *target->points,
+                                    logger.get() );
+        }
+
+        break;
+
+      case Format::GROUP_SET:
+
+        if ( target->groups )
+        {
+          Utils_::readGroupSet    ( in, *target->groups,
+                                    skipUnknown_, logger.get() );
+        }
+
+        break;
+
+      case Format::MEMBER_SET:
+
+        if ( target->members )
+        {
+          Utils_::readMemberSet   ( in, *target->members,
+                                    skipUnknown_, logger.get() );
+        }
+
+        break;
+
+      case Format::ITEM_GROUP:
+
+        if ( target->itemGroups )
+        {
+          Utils_::readItemGroup   ( in, *target,
+                                    skipUnknown_, logger.get() );
+        }
+
+        break;
+
+      case Format::TABLE:
+
+        if ( target->tables )
+        {
+          Utils_::readTable       ( in, *target,
+                                    skipUnknown_, logger.get() );
+        }
+
+        break;
+
+      case Format::CONSTRAINTS:
+
+        if ( target->conParser )
+        {
+          Utils_::readConstraints ( in, *target->conParser,
+                                    skipUnknown_, logger.get() );
+        }
+
+        break;
+      }
+    }
+
+    in.input->setPosition ( start + size );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   skipUnknownItems
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::skipUnknownItems ( bool choice )
+{
+  skipUnknown_ = choice;
+}
+
+
+//-----------------------------------------------------------------------
+//   addPointSet
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::addPointSet ( const Ref<XPointSet>& points )
+{
+  JEM_PRECHECK2 ( points, "NULL PointSet" );
+
+  getTarget_( points->getItemName() )->points = points;
+}
+
+
+//-----------------------------------------------------------------------
+//   addGroupSet
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::addGroupSet ( const Ref<XGroupSet>& groups )
+{
+  JEM_PRECHECK2 ( groups, "NULL GroupSet" );
+
+  getTarget_( groups->getItemName() )->groups = groups;
+}
+
+
+//-----------------------------------------------------------------------
+//   addMemberSet
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::addMemberSet ( const Ref<XMemberSet>& members )
+{
+  JEM_PRECHECK2 ( members, "NULL MemberSet" );
+
+  getTarget_( members->getItemName() )->members = members;
+}
+
+
+//-----------------------------------------------------------------------
+//   addItemGroups
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::addItemGroups
+
+  ( const Ref<ItemSet>&     items,
+    const Ref<Dictionary>&  groups,
+    const String&           filter )
+
+{
+  JEM_PRECHECK2 ( items && groups, "NULL ItemSet or Dictionary" );
+
+  Target_*  target = getTarget_ ( items->getItemName() );
+
+  target->groupItems  = items;
+  target->itemGroups  = groups;
+  target->groupFilter = filter;
+}
+
+
+void BinaryDataReader::addItemGroups
+
+  ( const Properties&  globdat,
+    const String&      filter )
+
+{
+  Ref<Dict>      list = ItemSet::getAll ( globdat );
+  Ref<ItemSet>   items;
+  Ref<DictEnum>  e;
+
+  for ( e = list->enumerate(); ! e->atEnd(); e->toNext() )
+  {
+    items = staticCast<ItemSet> ( e->getValue() );
+
+    addItemGroups ( items,
+                    ItemGroup::getFor ( items, globdat ),
+                    filter );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   addTables
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::addTables
+
+  ( const Ref<ItemSet>&     items,
+    const Ref<Dictionary>&  tables,
+    const String&           filter )
+
+{
+  JEM_PRECHECK2 ( items && tables, "NULL ItemSet or Dictionary" );
+
+  Target_*  target = getTarget_ ( items->getItemName() );
+
+  target->tableItems  = items;
+  target->tables      = tables;
+  target->tableFilter = filter;
+}
+
+
+void BinaryDataReader::addTables
+
+  ( const Properties&  globdat,
+    const String&      filter )
+
+{
+  Ref<Dict>      list = ItemSet::getAll ( globdat );
+  Ref<ItemSet>   items;
+  Ref<DictEnum>  e;
+
+  for ( e = list->enumerate(); ! e->atEnd(); e->toNext() )
+  {
+    items = staticCast<ItemSet> ( e->getValue() );
+
+    addTables ( items, Table::getFor( items, globdat ), filter );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   addConstraints
+//-----------------------------------------------------------------------
+
+
+void BinaryDataReader::addConstraints
+
+  ( const Ref<ConParser>&  conParser )
+
+{
+  JEM_PRECHECK2 ( conParser, "NULL ConstraintsParser" );
+
+  getTarget_( conParser->getItems()->getItemName() )->conParser =
+
+    conParser;
+}
+
+
+void BinaryDataReader::addConstraints ( const Properties& globdat )
+{
+  Ref<Dict>      list = ItemSet::getAll ( globdat );
+  Ref<ItemSet>   items;
+  Ref<DictEnum>  e;
+
+  for ( e = list->enumerate(); ! e->atEnd(); e->toNext() )
+  {
+    items = staticCast<ItemSet> ( e->getValue() );
+
+    addConstraints ( ConParser::get( items, globdat ) );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   isBinaryFile
+//-----------------------------------------------------------------------
+
+
+bool BinaryDataReader::isBinaryFile ( const String& fname )
+{
+  using jem::slice;
+  using jem::END;
+
+  const String  ext = FILE_EXTENSION;
+  const idx_t   n   = fname.size ();
+
+  if ( n > ext.size() )
+  {
+    return ext.equalsIgnoreCase ( fname[slice(n - ext.size(),END)] );
+  }
+
+  return false;
+}
+
+
+//-----------------------------------------------------------------------
+//   getTarget_
+//-----------------------------------------------------------------------
+
+
+BinaryDataReader::Target_* BinaryDataReader::getTarget_
+
+  ( const String&  itemName )
+
+{
+  Ref<Target_>  target =
+
+    staticCast<Target_> ( targets_->get( itemName ) );
+
+  if ( ! target )
+  {
+    target = newInstance<Target_> ();
+
+    targets_->insert ( itemName, target );
+  }
+
+  return target.get ();
+}
+
+
+JIVE_END_PACKAGE( util )
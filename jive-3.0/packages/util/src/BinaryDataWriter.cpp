@@ -0,0 +1,732 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+
+#include <jem/base/assert.h>
+#include <jem/base/ClassTemplate.h>
+#include <jem/base/array/utilities.h>
+#include <jem/io/FileOutputStream.h>
+#include <jem/io/BufferedOutputStream.h>
+#include <jem/numeric/sparse/SparseMatrix.h>
+#include <jem/util/Flex.h>
+#include <jem/util/Properties.h>
+#include <jem/util/Dictionary.h>
+#include <jem/util/DictionaryEnumerator.h>
+#include <jive/util/ItemMap.h>
+#include <jive/util/PointSet.h>
+#include <jive/util/GroupSet.h>
+#include <jive/util/MemberSet.h>
+#include <jive/util/ItemGroup.h>
+#include <jive/util/AllItemGroup.h>
+#include <jive/util/EmptyItemGroup.h>
+#include <jive/util/Table.h>
+#include <jive/util/ConstraintsParser.h>
+#include <jive/util/private/BinaryDataFormat.h>
+#include <jive/util/BinaryDataWriter.h>
+
+
+JEM_DEFINE_CLASS( jive::util::BinaryDataWriter );
+
+
+JIVE_BEGIN_PACKAGE( util )
+
+
+using jem::dynamicCast;
+using jem::newInstance;
+using jem::io::FileOutputStream;
+using jem::io::BufferedOutputStream;
+using jem::util::Flex;
+
+
+//=======================================================================
+//   class BinaryDataWriter::Utils_
+//=======================================================================
+
+
+class BinaryDataWriter::Utils_
+{
+ public:
+
+  static ItemSet*           getParentItems
+
+    ( const ItemSet&          items );
+
+  static idx_t              findItems
+
+    ( const Flex<ItemSet*>&   isets,
+      const ItemSet*          items );
+
+};
+
+
+//-----------------------------------------------------------------------
+//   getParentItems
+//-----------------------------------------------------------------------
+
+// Returns the item set that the items in the given set refer to, or
+// NULL if they do not refer to another item set.
+
+
+ItemSet* BinaryDataWriter::Utils_::getParentItems
+
+  ( const ItemSet&  items )
+
+{
+  const GroupSet*   groups  = dynamic_cast<const GroupSet*>  ( &items );
+  const MemberSet*  members = dynamic_cast<const MemberSet*> ( &items );
+
+  if      ( groups )
+  {
+    return groups->getGroupedItems ();
+  }
+  else if ( members )
+  {
+    return members->getCompoundItems ();
+  }
+  else
+  {
+    return nullptr;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   findItems
+//-----------------------------------------------------------------------
+
+
+idx_t BinaryDataWriter::Utils_::findItems
+
+  ( const Flex<ItemSet*>&  isets,
+    const ItemSet*         items )
+
+{
+  for ( idx_t i = 0; i < isets.size(); i++ )
+  {
+    if ( isets[i] == items )
+    {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+
+//=======================================================================
+//   class BinaryDataWriter
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+BinaryDataWriter::BinaryDataWriter ( const String& fname )
+{
+  typedef BinaryDataFormat  Format;
+
+  output_ = newInstance<BufferedOutputStream> (
+    newInstance<FileOutputStream> ( fname )
+  );
+
+  position_   = 0;
+  sectionEnd_ = 0;
+
+  writeLint_ ( Format::MAGIC      );
+  writeLint_ ( Format::ORDER_MARK );
+  writeLint_ ( Format::VERSION    );
+}
+
+
+BinaryDataWriter::~BinaryDataWriter ()
+{
+  if ( output_ )
+  {
+    output_->close ();
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   close
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::close ()
+{
+  if ( output_ )
+  {
+    writeLint_ ( BinaryDataFormat::END );
+
+    output_->close ();
+    output_ = nullptr;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   writePointSet
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writePointSet ( const PointSet& points )
+{
+  const idx_t  rank   = points.rank ();
+  const idx_t  count  = points.size ();
+
+  Matrix       coords ( rank, count );
+
+
+  points.getCoords ( coords );
+
+  beginSection_ ( BinaryDataFormat::POINT_SET,
+                  16 + 8 * (lint) count * (1 + rank), points );
+
+  writeLint_    ( rank  );
+  writeLint_    ( count );
+  writeIDs_     ( IdxVector( jem::iarray( count ) ), points );
+  writeDoubles_ ( coords.addr(), coords.itemCount() );
+  endSection_   ();
+}
+
+
+//-----------------------------------------------------------------------
+//   writeGroupSet
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writeGroupSet ( const GroupSet& groups )
+{
+  const ItemSet&  items   = * groups.getGroupedItems ();
+
+  const idx_t     count   = groups.size ();
+
+  Topology        topo    = groups.toMatrix ();
+
+  IdxVector       offsets = topo.getRowOffsets    ();
+  IdxVector       iitems  = topo.getColumnIndices ();
+
+
+  beginSection_ ( BinaryDataFormat::GROUP_SET,
+                  16 + 8 * ((lint) 2 * count + iitems.size()),
+                  groups );
+
+  writeLint_    ( count );
+  writeIDs_     ( IdxVector( jem::iarray( count ) ), groups );
+  writeIndices_ ( offsets );
+  writeIDs_     ( iitems, items );
+  endSection_   ();
+}
+
+
+//-----------------------------------------------------------------------
+//   writeMemberSet
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writeMemberSet ( const MemberSet& members )
+{
+  const ItemSet&  items   = * members.getCompoundItems ();
+
+  const idx_t     count   = members.size ();
+
+  IdxVector       iitems  ( count );
+  IdxVector       ilocals ( count );
+
+
+  for ( idx_t im = 0; im < count; im++ )
+  {
+    members.getMember ( iitems[im], ilocals[im], im );
+  }
+
+  beginSection_ ( BinaryDataFormat::MEMBER_SET,
+                  8 + 24 * (lint) count, members );
+
+  writeLint_    ( count );
+  writeIDs_     ( IdxVector( jem::iarray( count ) ), members );
+  writeIDs_     ( iitems, items );
+  writeIndices_ ( ilocals );
+  endSection_   ();
+}
+
+
+//-----------------------------------------------------------------------
+//   writeItemGroup
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writeItemGroup
+
+  ( const String&     name,
+    const ItemGroup&  group )
+
+{
+  const ItemSet&  items  = * group.getItems ();
+
+  IdxVector       iitems = group.getIndices ();
+
+
+  beginSection_ ( BinaryDataFormat::ITEM_GROUP,
+                  BinaryDataFormat::stringSize( name.size() ) +
+                  8 + 8 * (lint) iitems.size(),
+                  items );
+
+  writeString_  ( name );
+  writeLint_    ( iitems.size() );
+  writeIDs_     ( iitems, items );
+  endSection_   ();
+}
+
+
+//-----------------------------------------------------------------------
+//   writeTable
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writeTable
+
+  ( const String&  name,
+    const Table&   table )
+
+{
+  typedef BinaryDataFormat  Format;
+
+  const ItemSet&  items    = * table.getRowItems ();
+
+  SparseMatrix    mat      = table.toMatrix       ();
+  StringVector    colNames = table.getColumnNames ();
+
+  IdxVector       offsets  = mat.getRowOffsets    ();
+  IdxVector       jcols    = mat.getColumnIndices ();
+  Vector          values   = mat.getValues        ();
+
+  const idx_t     nnz      = jcols.size ();
+
+  Flex<idx_t>     irows;
+  Flex<idx_t>     roffsets;
+
+  lint            size;
+
+
+  // Skip the empty rows.
+
+  roffsets.pushBack ( 0 );
+
+  for ( idx_t irow = 0; irow < offsets.size() - 1; irow++ )
+  {
+    if ( offsets[irow + 1] > offsets[irow] )
+    {
+      irows   .pushBack ( irow );
+      roffsets.pushBack ( offsets[irow + 1] );
+    }
+  }
+
+  size = Format::stringSize ( name.size() ) + 24 +
+         8 * ((lint) 2 * irows.size() + 1 + 2 * nnz);
+
+  for ( idx_t j = 0; j < colNames.size(); j++ )
+  {
+    size += Format::stringSize ( colNames[j].size() );
+  }
+
+  beginSection_ ( Format::TABLE, size, items );
+
+  writeString_  ( name );
+  writeLint_    ( table.isDense() ? 1 : 0 );
+  writeLint_    ( colNames.size() );
+
+  for ( idx_t j = 0; j < colNames.size(); j++ )
+  {
+    writeString_ ( colNames[j] );
+  }
+
+  writeLint_    ( irows.size() );
+  writeIDs_     ( IdxVector( irows.begin(), irows.end() ), items );
+  writeIndices_ ( IdxVector( roffsets.begin(), roffsets.end() ) );
+  writeIndices_ ( jcols );
+  writeDoubles_ ( jem::makeContiguous( values ).addr(), nnz );
+  endSection_   ();
+}
+
+
+//-----------------------------------------------------------------------
+//   writeConstraints
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writeConstraints ( const ConParser& conParser )
+{
+  typedef BinaryDataFormat  Format;
+
+  const ItemSet&  items = * conParser.getItems ();
+
+  StringVector    typeNames;
+  IdxVector       offsets;
+  IdxVector       iitems;
+  IdxVector       itypes;
+  Vector          values;
+  BoolVector      rmask;
+
+  lint            size;
+
+
+  conParser.getData ( typeNames, offsets,
+                      iitems, itypes, values, rmask );
+
+  const idx_t     conCount = rmask .size ();
+  const idx_t     n        = iitems.size ();
+
+  IdxVector       imask    ( conCount );
+
+
+  size = 16 + 8 * ((lint) 2 * conCount + 1 + 3 * n);
+
+  for ( idx_t i = 0; i < typeNames.size(); i++ )
+  {
+    size += Format::stringSize ( typeNames[i].size() );
+  }
+
+  for ( idx_t i = 0; i < conCount; i++ )
+  {
+    imask[i] = rmask[i] ? 1 : 0;
+  }
+
+  beginSection_ ( Format::CONSTRAINTS, size, items );
+
+  writeLint_    ( typeNames.size() );
+
+  for ( idx_t i = 0; i < typeNames.size(); i++ )
+  {
+    writeString_ ( typeNames[i] );
+  }
+
+  writeLint_    ( conCount );
+  writeIndices_ ( offsets );
+  writeIDs_     ( iitems, items );
+  writeIndices_ ( itypes );
+  writeDoubles_ ( values.addr(), n );
+  writeIndices_ ( imask );
+  endSection_   ();
+}
+
+
+//-----------------------------------------------------------------------
+//   writeAll
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writeAll ( const Properties& globdat )
+{
+  Ref<Dict>       list = ItemSet::getAll ( globdat );
+
+  Flex<ItemSet*>  isets;
+
+  Ref<DictEnum>   e;
+  Ref<Dict>       dict;
+  Ref<ConParser>  conParser;
+
+  ItemSet*        items;
+  idx_t           i, n;
+
+
+  for ( e = list->enumerate(); ! e->atEnd(); e->toNext() )
+  {
+    isets.pushBack ( jem::staticCast<ItemSet*>( e->getValue() ) );
+  }
+
+  n = isets.size ();
+
+  // Determine the depth of each item set in the tree formed by the
+  // sets that refer to other sets. Writing the sets in order of
+  // increasing depth ensures that each set is written after the set
+  // that it refers to.
+
+  IdxVector  depth ( n );
+
+  for ( i = 0; i < n; i++ )
+  {
+    items = isets[i];
+
+    for ( depth[i] = 0; depth[i] < n; depth[i]++ )
+    {
+      items = Utils_::getParentItems ( *items );
+
+      if ( ! items || Utils_::findItems( isets, items ) < 0 )
+      {
+        break;
+      }
+    }
+  }
+
+  for ( idx_t d = 0; d <= n; d++ )
+  {
+    for ( i = 0; i < n; i++ )
+    {
+      if ( depth[i] != d )
+      {
+        continue;
+      }
+
+      items = isets[i];
+
+      if      ( dynamic_cast<PointSet*>( items ) )
+      {
+        writePointSet  ( * static_cast<PointSet*>( items ) );
+      }
+      else if ( dynamic_cast<GroupSet*>( items ) )
+      {
+        writeGroupSet  ( * static_cast<GroupSet*>( items ) );
+      }
+      else if ( dynamic_cast<MemberSet*>( items ) )
+      {
+        writeMemberSet ( * static_cast<MemberSet*>( items ) );
+      }
+    }
+  }
+
+  // Write the data associated with the item sets.
+
+  for ( i = 0; i < n; i++ )
+  {
+    Ref<ItemSet>  iset = isets[i];
+
+    dict = ItemGroup::findFor ( iset, globdat );
+
+    if ( dict )
+    {
+      for ( e = dict->enumerate(); ! e->atEnd(); e->toNext() )
+      {
+        Ref<Object>     obj   = e->getValue ();
+        Ref<ItemGroup>  group = dynamicCast<ItemGroup> ( obj );
+
+        // The predefined groups are created along with the group
+        // dictionary and need not be stored.
+
+        if ( dynamicCast<AllItemGroup*>  ( obj ) ||
+             dynamicCast<EmptyItemGroup*>( obj ) )
+        {
+          continue;
+        }
+
+        if ( group && group->getItems() == iset.get() )
+        {
+          writeItemGroup ( e->getKey(), *group );
+        }
+      }
+    }
+
+    dict = Table::findFor ( iset, globdat );
+
+    if ( dict )
+    {
+      for ( e = dict->enumerate(); ! e->atEnd(); e->toNext() )
+      {
+        Ref<Table>  table = dynamicCast<Table> ( e->getValue() );
+
+        if ( table && table->getRowItems() == iset.get() )
+        {
+          writeTable ( e->getKey(), *table );
+        }
+      }
+    }
+
+    conParser = ConParser::find ( iset, globdat );
+
+    if ( conParser && conParser->slaveDofCount() > 0 )
+    {
+      writeConstraints ( *conParser );
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   beginSection_
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::beginSection_
+
+  ( int             kind,
+    lint            size,
+    const ItemSet&  items )
+
+{
+  JEM_PRECHECK2 ( output_, "binary data file has been closed" );
+
+  const String  itemName = items.getItemName ();
+
+  size += BinaryDataFormat::stringSize ( itemName.size() );
+
+  writeLint_   ( kind );
+  writeLint_   ( size );
+
+  sectionEnd_ = position_ + size;
+
+  writeString_ ( itemName );
+}
+
+
+//-----------------------------------------------------------------------
+//   endSection_
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::endSection_ ()
+{
+  JEM_ASSERT2 ( position_ == sectionEnd_,
+                "invalid binary data section size" );
+}
+
+
+//-----------------------------------------------------------------------
+//   writeLint_
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writeLint_ ( lint value )
+{
+  write_ ( &value, 8 );
+}
+
+
+//-----------------------------------------------------------------------
+//   writeString_
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writeString_ ( const String& str )
+{
+  const lint  n = str.size ();
+  const lint  p = BinaryDataFormat::padSize ( n ) - n;
+
+  const char  zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+
+  writeLint_ ( n );
+  write_     ( str.addr(), n );
+  write_     ( zeros,      p );
+}
+
+
+//-----------------------------------------------------------------------
+//   writeIndices_
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writeIndices_ ( const IdxVector& idx )
+{
+  const idx_t  n = idx.size ();
+
+  lint         buf[512];
+  idx_t        i, j;
+
+
+  for ( i = 0; i < n; i += j )
+  {
+    for ( j = 0; j < 512 && i + j < n; j++ )
+    {
+      buf[j] = (lint) idx[i + j];
+    }
+
+    write_ ( buf, 8 * j );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   writeIDs_
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writeIDs_
+
+  ( const IdxVector&  iitems,
+    const ItemSet&    items )
+
+{
+  IdxVector  itemIDs ( iitems.size() );
+
+  items.getItemMap()->getItemIDs ( itemIDs, iitems );
+
+  writeIndices_ ( itemIDs );
+}
+
+
+//-----------------------------------------------------------------------
+//   writeDoubles_
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::writeDoubles_
+
+  ( const double*  buf,
+    idx_t          count )
+
+{
+  write_ ( buf, 8 * (lint) count );
+}
+
+
+//-----------------------------------------------------------------------
+//   write_
+//-----------------------------------------------------------------------
+
+
+void BinaryDataWriter::write_
+
+  ( const void*  buf,
+    lint         size )
+
+{
+  const lint   maxChunk = 1 << 24;
+
+  const byte*  src      = (const byte*) buf;
+
+
+  JEM_PRECHECK2 ( output_, "binary data file has been closed" );
+
+  position_ += size;
+
+  while ( size > 0 )
+  {
+    lint  n = jem::min ( size, maxChunk );
+
+    output_->write ( src, (idx_t) n );
+
+    src  += n;
+    size -= n;
+  }
+}
+
+
+JIVE_END_PACKAGE( util )
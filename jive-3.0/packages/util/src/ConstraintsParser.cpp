@@ -1473,6 +1473,149 @@ void ConstraintsParser::getConstraints
 }
 
 
+//-----------------------------------------------------------------------
+//   getData
+//-----------------------------------------------------------------------
+
+// Flattens the constraints into a set of arrays. The nodes of
+// constraint i are stored at positions offsets[i] to offsets[i + 1];
+// the first node is the slave dof and the others are the master dofs.
+
+
+void ConstraintsParser::getData
+
+  ( StringVector&  typeNames,
+    IdxVector&     offsets,
+    IdxVector&     iitems,
+    IdxVector&     itypes,
+    Vector&        values,
+    BoolVector&    rmask ) const
+
+{
+  const Data_&  d        = * data_;
+
+  const idx_t   conCount = d.constraints.size ();
+
+  Node_*        node;
+  idx_t         i, n;
+
+
+  typeNames.ref    ( d.typeNames.toArray() );
+  offsets  .resize ( conCount + 1 );
+  rmask    .resize ( conCount );
+
+  n = 0;
+
+  for ( idx_t icon = 0; icon < conCount; icon++ )
+  {
+    offsets[icon] = n;
+    rmask  [icon] = d.rvalueMask[icon];
+
+    for ( node = d.constraints[icon]; node; node = node->next )
+    {
+      n++;
+    }
+  }
+
+  offsets[conCount] = n;
+
+  iitems.resize ( n );
+  itypes.resize ( n );
+  values.resize ( n );
+
+  for ( idx_t icon = i = 0; icon < conCount; icon++ )
+  {
+    for ( node = d.constraints[icon]; node; node = node->next, i++ )
+    {
+      iitems[i] = node->iitem;
+      itypes[i] = node->itype;
+      values[i] = node->value;
+    }
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   addData
+//-----------------------------------------------------------------------
+
+
+void ConstraintsParser::addData
+
+  ( const StringVector&  typeNames,
+    const IdxVector&     offsets,
+    const IdxVector&     iitems,
+    const IdxVector&     itypes,
+    const Vector&        values,
+    const BoolVector&    rmask )
+
+{
+  JEM_PRECHECK2 ( offsets.size() == rmask.size() + 1,
+                  "offset array has wrong size" );
+  JEM_PRECHECK2 ( iitems.size() == itypes.size() &&
+                  iitems.size() == values.size(),
+                  "Array size mismatch" );
+
+  Data_&        d         = * data_;
+
+  const idx_t   conCount  = rmask    .size ();
+  const idx_t   typeCount = typeNames.size ();
+  const idx_t   itemCount = d.items->size  ();
+
+  IdxVector     typeMap   ( typeCount );
+
+  Node_*        node;
+  idx_t         i, n;
+
+
+  for ( i = 0; i < typeCount; i++ )
+  {
+    typeMap[i] = d.typeNames.addName ( typeNames[i] );
+  }
+
+  d.constraints.reserve ( d.constraints.size() + conCount );
+  d.rvalueMask .reserve ( d.rvalueMask .size() + conCount );
+
+  for ( idx_t icon = 0; icon < conCount; icon++ )
+  {
+    i = offsets[icon];
+    n = offsets[icon + 1];
+
+    if ( i >= n || n > iitems.size() )
+    {
+      throw jem::IllegalArgumentException (
+        JEM_FUNC,
+        "invalid constraint offset array"
+      );
+    }
+
+    for ( idx_t j = i; j < n; j++ )
+    {
+      if ( iitems[j] < 0 || iitems[j] >= itemCount ||
+           itypes[j] < 0 || itypes[j] >= typeCount )
+      {
+        throw jem::IllegalArgumentException (
+          JEM_FUNC,
+          "invalid item or dof type index"
+        );
+      }
+    }
+
+    node = d.newNode ( iitems[i], typeMap[itypes[i]], values[i] );
+
+    d.constraints.pushBack ( node );
+    d.rvalueMask .pushBack ( rmask[icon] );
+
+    for ( i++; i < n; i++ )
+    {
+      node->next = d.newNode ( iitems[i],
+                               typeMap[itypes[i]], values[i] );
+      node       = node->next;
+    }
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   store
 //-----------------------------------------------------------------------
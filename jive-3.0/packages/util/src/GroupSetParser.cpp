@@ -33,6 +33,7 @@
 #include <jem/base/ClassTemplate.h>
 #include <jem/util/Properties.h>
 #include <jem/util/ArrayBuffer.h>
+#include <jem/util/Flex.h>
 #include <jem/xml/ParseLog.h>
 #include <jem/xml/ParserState.h>
 #include <jive/util/ItemMap.h>
@@ -41,6 +42,7 @@
 #include <jive/util/ParseUtils.h>
 #include <jive/util/ParserActions.h>
 #include <jive/util/GroupSetParser.h>
+#include "private/TextBlock.h"
 
 
 JEM_DEFINE_CLASS( jive::util::GroupSetParser );
@@ -49,7 +51,9 @@ JEM_DEFINE_CLASS( jive::util::GroupSetParser );
 JIVE_BEGIN_PACKAGE( util )
 
 
+using jem::ThreadTeam;
 using jem::util::ArrayBuffer;
+using jem::util::Flex;
 using jem::xml::ParseLog;
 
 
@@ -65,6 +69,36 @@ class GroupSetParser::Utils_ : public ParseUtils
   typedef
     ArrayBuffer<idx_t>      IdxBuffer;
 
+  class                     Chunk;
+  class                     Work;
+
+  typedef jem::Array
+    < Chunk >               Chunks;
+
+
+  static void               parseTokens
+
+    ( State&                  state,
+      XGroupSet&              groups,
+      const Scope*            scope,
+      idx_t                   groupSize,
+      bool                    skipUnknown );
+
+  static bool               parseBlock
+
+    ( State&                  state,
+      XGroupSet&              groups,
+      idx_t                   groupSize,
+      bool                    skipUnknown,
+      const TextBlock&        block );
+
+  static bool               parseChunk
+
+    ( Chunk&                  chunk,
+      TextBlock::Cursor&      cursor,
+      const ItemMap&          imap,
+      idx_t                   groupSize,
+      bool                    skipUnknown );
 
   static void               parse
 
@@ -123,6 +157,314 @@ class GroupSetParser::Utils_ : public ParseUtils
 };
 
 
+//-----------------------------------------------------------------------
+//   class GroupSetParser::Utils_::Chunk
+//-----------------------------------------------------------------------
+
+// The groups read from one chunk of a text block. The members of a
+// group are stored as item indices. The line numbers are relative to
+// the start of the chunk.
+
+
+class GroupSetParser::Utils_::Chunk
+{
+ public:
+
+  Flex<idx_t>               groupIDs;
+  Flex<idx_t>               offsets;
+  Flex<idx_t>               iitems;
+  Flex<idx_t>               lines;
+  lint                      lineCount;
+  bool                      failed;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   class GroupSetParser::Utils_::Work
+//-----------------------------------------------------------------------
+
+
+class GroupSetParser::Utils_::Work : public ThreadTeam::Work
+{
+ public:
+
+  inline                    Work
+
+    ( const TextBlock&        block,
+      Chunks&                 chunks,
+      const ItemMap&          imap,
+      idx_t                   groupSize,
+      bool                    skipUnknown );
+
+  virtual void              run
+
+    ( idx_t                   first,
+      idx_t                   last )           override;
+
+
+ private:
+
+  const TextBlock&          block_;
+  Chunks&                   chunks_;
+  const ItemMap&            imap_;
+  const idx_t               groupSize_;
+  const bool                skipUnknown_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline GroupSetParser::Utils_::Work::Work
+
+  ( const TextBlock&  block,
+    Chunks&           chunks,
+    const ItemMap&    imap,
+    idx_t             groupSize,
+    bool              skipUnknown ) :
+
+    block_       ( block       ),
+    chunks_      ( chunks      ),
+    imap_        ( imap        ),
+    groupSize_   ( groupSize   ),
+    skipUnknown_ ( skipUnknown )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+void GroupSetParser::Utils_::Work::run
+
+  ( idx_t  first,
+    idx_t  last )
+
+{
+  for ( idx_t ichunk = first; ichunk < last; ichunk++ )
+  {
+    Chunk&             chunk  = chunks_[ichunk];
+    TextBlock::Cursor  cursor = block_.getChunk ( ichunk );
+
+    chunk.failed    = ! parseChunk ( chunk,      cursor, imap_,
+                                     groupSize_, skipUnknown_ );
+    chunk.lineCount = cursor.lineCount;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   parseTokens
+//-----------------------------------------------------------------------
+
+
+void GroupSetParser::Utils_::parseTokens
+
+  ( State&        state,
+    XGroupSet&    groups,
+    const Scope*  scope,
+    idx_t         groupSize,
+    bool          skipUnknown )
+
+{
+  if ( groupSize >= 0 )
+  {
+    parseFixed ( state, groups, scope, groupSize );
+  }
+  else
+  {
+    parse      ( state, groups, scope, skipUnknown );
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   parseBlock
+//-----------------------------------------------------------------------
+
+// Parses the chunks of a text block in parallel and then adds the
+// groups in their original order. Returns false, without modifying
+// the group set, if the block must be parsed by the tokenizer.
+
+
+bool GroupSetParser::Utils_::parseBlock
+
+  ( State&            state,
+    XGroupSet&        groups,
+    idx_t             groupSize,
+    bool              skipUnknown,
+    const TextBlock&  block )
+
+{
+  const String    groupName  =   groups.getItemName     ();
+  const ItemSet&  items      = * groups.getGroupedItems ();
+  const ItemMap&  itemMap    = * items.getItemMap       ();
+  const idx_t     chunkCount =   block.chunkCount       ();
+
+  Chunks          chunks     ( chunkCount );
+  IdxVector       iitems;
+  lint            line;
+  idx_t           groupCount;
+  idx_t           maxSize;
+  idx_t           i, j, n;
+
+
+  // Some item maps update their internal state on the first look-up;
+  // make sure that this does not happen in parallel.
+
+  itemMap.findItem ( 0 );
+
+  Work  work ( block, chunks, itemMap, groupSize, skipUnknown );
+
+  block.execute ( work );
+
+  groupCount = 0;
+  maxSize    = 0;
+
+  for ( idx_t ichunk = 0; ichunk < chunkCount; ichunk++ )
+  {
+    const Chunk&  chunk = chunks[ichunk];
+
+    if ( chunk.failed )
+    {
+      return false;
+    }
+
+    n = chunk.groupIDs.size ();
+
+    for ( i = 0; i < n; i++ )
+    {
+      maxSize = jem::max ( maxSize, chunk.offsets[i + 1] -
+                                    chunk.offsets[i] );
+    }
+
+    groupCount += n;
+  }
+
+  if ( groupCount == 0 )
+  {
+    return true;
+  }
+
+  groups.reserve ( groups.size() + groupCount );
+  iitems.resize  ( maxSize );
+
+  line = block.getFirstLine ();
+
+  for ( idx_t ichunk = 0; ichunk < chunkCount; ichunk++ )
+  {
+    const Chunk&  chunk = chunks[ichunk];
+
+    n = chunk.groupIDs.size ();
+
+    try
+    {
+      for ( i = 0; i < n; i++ )
+      {
+        idx_t  k = chunk.offsets[i];
+        idx_t  m = chunk.offsets[i + 1] - k;
+
+        for ( j = 0; j < m; j++ )
+        {
+          iitems[j] = chunk.iitems[k + j];
+        }
+
+        groups.addGroup ( chunk.groupIDs[i],
+                          iitems[slice(BEGIN,m)] );
+      }
+    }
+    catch ( const ItemIDException& )
+    {
+      state.input->setLineNumber ( line + chunk.lines[i] );
+      throw;
+    }
+
+    line += chunk.lineCount;
+
+    if ( n > 0 )
+    {
+      state.log->logEvent (
+        state,
+        ParseLog::PROGRESS,
+        String::format ( "at %s %d", groupName,
+                         chunk.groupIDs.back() )
+      );
+    }
+  }
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------
+//   parseChunk
+//-----------------------------------------------------------------------
+
+
+bool GroupSetParser::Utils_::parseChunk
+
+  ( Chunk&              chunk,
+    TextBlock::Cursor&  cursor,
+    const ItemMap&      imap,
+    idx_t               groupSize,
+    bool                skipUnknown )
+
+{
+  idx_t  groupID;
+  idx_t  itemID;
+  idx_t  iitem;
+
+
+  chunk.offsets.pushBack ( 0 );
+
+  while ( ! cursor.atEnd() )
+  {
+    chunk.lines.pushBack ( (idx_t) cursor.lineCount );
+
+    if ( ! cursor.readInteger( groupID ) )
+    {
+      return false;
+    }
+
+    while ( ! cursor.readChar( ';' ) )
+    {
+      if ( ! cursor.readInteger( itemID ) )
+      {
+        return false;
+      }
+
+      iitem = imap.findItem ( itemID );
+
+      if ( iitem >= 0 )
+      {
+        chunk.iitems.pushBack ( iitem );
+      }
+      else if ( groupSize >= 0 || ! skipUnknown )
+      {
+        return false;
+      }
+    }
+
+    if ( groupSize >= 0 &&
+         groupSize != chunk.iitems.size() - chunk.offsets.back() )
+    {
+      return false;
+    }
+
+    chunk.groupIDs.pushBack ( groupID );
+    chunk.offsets .pushBack ( chunk.iitems.size() );
+  }
+
+  return true;
+}
+
+
 //-----------------------------------------------------------------------
 //   parse
 //-----------------------------------------------------------------------
@@ -545,15 +887,14 @@ void GroupSetParser::parse ( State& state )
   {
     try
     {
-      if ( groupSize_ >= 0 )
+      if ( scope )
       {
-        Utils_::parseFixed ( state, * groups_,
-                             scope,   groupSize_ );
+        Utils_::parseTokens ( state,      * groups_, scope,
+                              groupSize_, skipUnknown_ );
       }
       else
       {
-        Utils_::parse      ( state, * groups_,
-                             scope,   skipUnknown_ );
+        parseBlock_ ( state );
       }
     }
     catch ( const ItemIDException& ex )
@@ -564,6 +905,30 @@ void GroupSetParser::parse ( State& state )
 }
 
 
+//-----------------------------------------------------------------------
+//   parseBlock_
+//-----------------------------------------------------------------------
+
+// Reads the whole data block and parses it in parallel. Anything
+// other than plain group definitions is handled by the tokenizer.
+
+
+void GroupSetParser::parseBlock_ ( State& state )
+{
+  TextBlock  block ( state );
+
+  if ( ! Utils_::parseBlock( state,      * groups_,
+                             groupSize_, skipUnknown_, block ) )
+  {
+    TextBlock::Input  input ( state, block );
+
+    Utils_::parseTokens ( state,      * groups_, nullptr,
+                          groupSize_, skipUnknown_ );
+    input.finish        ();
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   takeAction
 //-----------------------------------------------------------------------
@@ -36,8 +36,7 @@
 #include <jem/base/ClassTemplate.h>
 #include <jem/io/ObjectInput.h>
 #include <jem/io/ObjectOutput.h>
-#include <jem/util/HashMap.h>
-#include <jem/util/FastAllocator.h>
+#include <jem/util/FlatHashMap.h>
 #include <jive/util/error.h>
 #include <jive/util/Reordering.h>
 #include <jive/util/ItemIDException.h>
@@ -49,8 +48,7 @@ JEM_DEFINE_SERIABLE_CLASS( jive::util::HashItemMap );
 
 using jem::newInstance;
 using jem::util::Flex;
-using jem::util::HashMap;
-using jem::util::FastAllocator;
+using jem::util::FlatHashMap;
 
 
 JIVE_BEGIN_PACKAGE( util )
@@ -63,7 +61,7 @@ JIVE_BEGIN_PACKAGE( util )
 
 class HashItemMap::IndexMap_ :
 
-  public HashMap < idx_t, idx_t, FastAllocator > {};
+  public FlatHashMap < idx_t, idx_t > {};
 
 
 //=======================================================================
@@ -355,15 +353,15 @@ void HashItemMap::reorderItems ( const Reordering& reord )
 
 idx_t HashItemMap::findItem ( idx_t itemID ) const
 {
-  IndexMap_::Iterator itr = indexMap_->find ( itemID );
+  const idx_t*  iitem = indexMap_->find ( itemID );
 
-  if ( itr == indexMap_->end() )
+  if ( ! iitem )
   {
     return -1_idx;
   }
   else
   {
-    return itr->second;
+    return *iitem;
   }
 }
 
@@ -382,25 +380,39 @@ idx_t HashItemMap::findItems
   JEM_PRECHECK2 ( iitems.size() >= itemIDs.size(),
                   "Array size mismatch" );
 
-  const idx_t  n = itemIDs.size ();
+  // The IDs are looked up in small batches. The slots of all IDs in
+  // a batch are prefetched first so that the cache misses overlap.
 
-  IndexMap_::Iterator  last = indexMap_->end ();
-  IndexMap_::Iterator  itr;
+  const idx_t       BATCH_SIZE = 16;
 
-  idx_t  k = 0;
+  const IndexMap_&  indexMap   = * indexMap_;
+  const idx_t       n          = itemIDs.size ();
 
-  for ( idx_t i = 0; i < n; i++ )
+  idx_t             k          = 0;
+
+
+  for ( idx_t i = 0; i < n; i += BATCH_SIZE )
   {
-    itr = indexMap_->find ( itemIDs[i] );
+    const idx_t  j = jem::min ( n, i + BATCH_SIZE );
 
-    if ( itr == last )
+    for ( idx_t ii = i; ii < j; ii++ )
     {
-      iitems[i] = -1_idx;
+      indexMap.prefetch ( itemIDs[ii] );
     }
-    else
+
+    for ( idx_t ii = i; ii < j; ii++ )
     {
-      iitems[i] = itr->second;
-      k++;
+      const idx_t*  iitem = indexMap.find ( itemIDs[ii] );
+
+      if ( ! iitem )
+      {
+        iitems[ii] = -1_idx;
+      }
+      else
+      {
+        iitems[ii] = *iitem;
+        k++;
+      }
     }
   }
 
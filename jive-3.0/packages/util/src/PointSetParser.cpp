@@ -33,6 +33,7 @@
 #include <jem/base/ClassTemplate.h>
 #include <jem/util/Properties.h>
 #include <jem/util/ArrayBuffer.h>
+#include <jem/util/Flex.h>
 #include <jem/xml/ParseLog.h>
 #include <jem/xml/ParserState.h>
 #include <jive/util/ItemIDException.h>
@@ -40,12 +41,15 @@
 #include <jive/util/ParseUtils.h>
 #include <jive/util/ParserActions.h>
 #include <jive/util/PointSetParser.h>
+#include "private/TextBlock.h"
 
 
 JEM_DEFINE_CLASS( jive::util::PointSetParser );
 
 
+using jem::ThreadTeam;
 using jem::util::ArrayBuffer;
+using jem::util::Flex;
 using jem::xml::ParseLog;
 using jem::xml::Tokenizer;
 
@@ -62,6 +66,26 @@ class PointSetParser::Utils_
 {
  public:
 
+  class                 Chunk;
+  class                 Work;
+
+  typedef jem::Array
+    < Chunk >           Chunks;
+
+
+  static bool           parseBlock
+
+    ( State&              state,
+      XPointSet&          points,
+      idx_t               rank,
+      const TextBlock&    block );
+
+  static bool           parseChunk
+
+    ( Chunk&              chunk,
+      TextBlock::Cursor&  cursor,
+      idx_t               rank );
+
   static Vector         parseCoords
 
     ( State&              state );
@@ -81,6 +105,272 @@ class PointSetParser::Utils_
 };
 
 
+//-----------------------------------------------------------------------
+//   class PointSetParser::Utils_::Chunk
+//-----------------------------------------------------------------------
+
+// The points read from one chunk of a text block. The line numbers
+// are relative to the start of the chunk.
+
+
+class PointSetParser::Utils_::Chunk
+{
+ public:
+
+  Flex<idx_t>           pointIDs;
+  Flex<double>          coords;
+  Flex<idx_t>           lines;
+  lint                  lineCount;
+  bool                  failed;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   class PointSetParser::Utils_::Work
+//-----------------------------------------------------------------------
+
+
+class PointSetParser::Utils_::Work : public ThreadTeam::Work
+{
+ public:
+
+  inline                Work
+
+    ( const TextBlock&    block,
+      Chunks&             chunks,
+      idx_t               rank );
+
+  virtual void          run
+
+    ( idx_t               first,
+      idx_t               last )       override;
+
+
+ private:
+
+  const TextBlock&      block_;
+  Chunks&               chunks_;
+  const idx_t           rank_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline PointSetParser::Utils_::Work::Work
+
+  ( const TextBlock&  block,
+    Chunks&           chunks,
+    idx_t             rank ) :
+
+    block_  ( block  ),
+    chunks_ ( chunks ),
+    rank_   ( rank   )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+void PointSetParser::Utils_::Work::run
+
+  ( idx_t  first,
+    idx_t  last )
+
+{
+  for ( idx_t ichunk = first; ichunk < last; ichunk++ )
+  {
+    Chunk&             chunk  = chunks_[ichunk];
+    TextBlock::Cursor  cursor = block_.getChunk ( ichunk );
+
+    chunk.failed    = ! parseChunk ( chunk, cursor, rank_ );
+    chunk.lineCount = cursor.lineCount;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   parseBlock
+//-----------------------------------------------------------------------
+
+// Parses the chunks of a text block in parallel and then adds the
+// points in their original order. Returns false, without modifying
+// the point set, if the block must be parsed by the tokenizer.
+
+
+bool PointSetParser::Utils_::parseBlock
+
+  ( State&            state,
+    XPointSet&        points,
+    idx_t             rank,
+    const TextBlock&  block )
+
+{
+  const String  pointName  = points.getItemName ();
+  const idx_t   chunkCount = block.chunkCount   ();
+
+  Chunks        chunks     ( chunkCount );
+  Vector        coords;
+  lint          line;
+  idx_t         pointCount;
+  idx_t         i, n;
+
+
+  if ( points.size() > 0 )
+  {
+    rank = points.rank ();
+  }
+  else if ( rank < 0 )
+  {
+    // Determine the rank from the first point.
+
+    TextBlock::Cursor  cursor = block.getChunk ( 0 );
+
+    double             x;
+
+    rank = 0;
+
+    if ( ! cursor.atEnd() )
+    {
+      if ( ! cursor.readInteger( i ) )
+      {
+        return false;
+      }
+
+      while ( ! cursor.readChar( ';' ) )
+      {
+        if ( ! cursor.readFloat( x ) )
+        {
+          return false;
+        }
+
+        rank++;
+      }
+    }
+  }
+
+  Work  work ( block, chunks, rank );
+
+  block.execute ( work );
+
+  pointCount = 0;
+
+  for ( idx_t ichunk = 0; ichunk < chunkCount; ichunk++ )
+  {
+    if ( chunks[ichunk].failed )
+    {
+      return false;
+    }
+
+    pointCount += chunks[ichunk].pointIDs.size ();
+  }
+
+  if ( pointCount == 0 )
+  {
+    return true;
+  }
+
+  points.reserve ( points.size() + pointCount );
+  coords.resize  ( rank );
+
+  line = block.getFirstLine ();
+
+  for ( idx_t ichunk = 0; ichunk < chunkCount; ichunk++ )
+  {
+    const Chunk&   chunk = chunks[ichunk];
+    const double*  x     = chunk.coords.addr ();
+
+    n = chunk.pointIDs.size ();
+
+    try
+    {
+      for ( i = 0; i < n; i++, x += rank )
+      {
+        for ( idx_t j = 0; j < rank; j++ )
+        {
+          coords[j] = x[j];
+        }
+
+        points.addPoint ( chunk.pointIDs[i], coords );
+      }
+    }
+    catch ( const ItemIDException& )
+    {
+      state.input->setLineNumber ( line + chunk.lines[i] );
+      throw;
+    }
+
+    line += chunk.lineCount;
+
+    if ( n > 0 )
+    {
+      state.log->logEvent (
+        state,
+        ParseLog::PROGRESS,
+        String::format ( "at %s %d", pointName,
+                         chunk.pointIDs.back() )
+      );
+    }
+  }
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------
+//   parseChunk
+//-----------------------------------------------------------------------
+
+
+bool PointSetParser::Utils_::parseChunk
+
+  ( Chunk&              chunk,
+    TextBlock::Cursor&  cursor,
+    idx_t               rank )
+
+{
+  idx_t   pointID;
+  double  x;
+
+
+  while ( ! cursor.atEnd() )
+  {
+    chunk.lines.pushBack ( (idx_t) cursor.lineCount );
+
+    if ( ! cursor.readInteger( pointID ) )
+    {
+      return false;
+    }
+
+    chunk.pointIDs.pushBack ( pointID );
+
+    for ( idx_t j = 0; j < rank; j++ )
+    {
+      if ( ! cursor.readFloat( x ) )
+      {
+        return false;
+      }
+
+      chunk.coords.pushBack ( x );
+    }
+
+    if ( ! cursor.readChar( ';' ) )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
 //-----------------------------------------------------------------------
 //   parseCoords (rank unknown)
 //-----------------------------------------------------------------------
@@ -238,7 +528,14 @@ void PointSetParser::parse ( State& state )
   {
     try
     {
-      parse_ ( state );
+      if ( scope_ )
+      {
+        parse_      ( state );
+      }
+      else
+      {
+        parseBlock_ ( state );
+      }
     }
     catch ( const ItemIDException& ex )
     {
@@ -356,6 +653,28 @@ void PointSetParser::parse_ ( State& state )
 }
 
 
+//-----------------------------------------------------------------------
+//   parseBlock_
+//-----------------------------------------------------------------------
+
+// Reads the whole data block and parses it in parallel. Anything
+// other than plain point definitions is handled by parse_().
+
+
+void PointSetParser::parseBlock_ ( State& state )
+{
+  TextBlock  block ( state );
+
+  if ( ! Utils_::parseBlock( state, *points_, rank_, block ) )
+  {
+    TextBlock::Input  input ( state, block );
+
+    parse_       ( state );
+    input.finish ();
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   scan_
 //-----------------------------------------------------------------------
@@ -33,6 +33,7 @@
 #include <jem/base/ClassTemplate.h>
 #include <jem/util/Properties.h>
 #include <jem/util/Dictionary.h>
+#include <jem/util/Flex.h>
 #include <jem/util/StringUtils.h>
 #include <jem/xml/ParseLog.h>
 #include <jem/xml/ParserState.h>
@@ -46,6 +47,7 @@
 #include <jive/util/XTable.h>
 #include <jive/util/IncludeParser.h>
 #include <jive/util/TableParser.h>
+#include "private/TextBlock.h"
 
 
 JEM_DEFINE_CLASS( jive::util::TableParser );
@@ -56,6 +58,8 @@ JIVE_BEGIN_PACKAGE( util )
 
 using jem::dynamicCast;
 using jem::newInstance;
+using jem::ThreadTeam;
+using jem::util::Flex;
 using jem::util::StringUtils;
 using jem::xml::ParseLog;
 using jem::xml::Tokenizer;
@@ -113,10 +117,31 @@ class TBSectionParser : public TagParser
 
  private:
 
+  class                     Chunk_;
+  class                     Work_;
+
+  typedef jem::Array
+    < Chunk_ >              Chunks_;
+
+
   void                      parseSection_
 
     ( State&                  state  );
 
+  void                      parseRows_
+
+    ( State&                  state  );
+
+  bool                      parseBlock_
+
+    ( State&                  state,
+      const TextBlock&        block  );
+
+  bool                      parseChunk_
+
+    ( Chunk_&                 chunk,
+      TextBlock::Cursor&      cursor )           const;
+
   void                      scanSection_
 
     ( State&                  state  );
@@ -183,6 +208,95 @@ class TBSectionParser : public TagParser
 };
 
 
+//-----------------------------------------------------------------------
+//   class TBSectionParser::Chunk_
+//-----------------------------------------------------------------------
+
+// The rows read from one chunk of a text block. Rows that do not
+// exist, and that are to be skipped, are only counted.
+
+
+class TBSectionParser::Chunk_
+{
+ public:
+
+  Flex<idx_t>               irows;
+  Flex<double>              values;
+  idx_t                     rowCount;
+  bool                      failed;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   class TBSectionParser::Work_
+//-----------------------------------------------------------------------
+
+
+class TBSectionParser::Work_ : public ThreadTeam::Work
+{
+ public:
+
+  inline                    Work_
+
+    ( const TBSectionParser&  parser,
+      const TextBlock&        block,
+      Chunks_&                chunks );
+
+  virtual void              run
+
+    ( idx_t                   first,
+      idx_t                   last )             override;
+
+
+ private:
+
+  const TBSectionParser&    parser_;
+  const TextBlock&          block_;
+  Chunks_&                  chunks_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline TBSectionParser::Work_::Work_
+
+  ( const TBSectionParser&  parser,
+    const TextBlock&        block,
+    Chunks_&                chunks ) :
+
+    parser_ ( parser ),
+    block_  ( block  ),
+    chunks_ ( chunks )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   run
+//-----------------------------------------------------------------------
+
+
+void TBSectionParser::Work_::run
+
+  ( idx_t  first,
+    idx_t  last )
+
+{
+  for ( idx_t ichunk = first; ichunk < last; ichunk++ )
+  {
+    Chunk_&            chunk  = chunks_[ichunk];
+    TextBlock::Cursor  cursor = block_.getChunk ( ichunk );
+
+    chunk.failed = ! parser_.parseChunk_ ( chunk, cursor );
+  }
+}
+
+
 //-----------------------------------------------------------------------
 //   constructor & destructor
 //-----------------------------------------------------------------------
@@ -386,6 +500,33 @@ void TBSectionParser::handleAttribute
 
 
 void TBSectionParser::parseSection_ ( State& state )
+{
+  table_->reserve ( rowItems_->size() / 4 + 32 );
+
+  if ( scope_ )
+  {
+    parseRows_ ( state );
+    return;
+  }
+
+  TextBlock  block ( state );
+
+  if ( ! parseBlock_( state, block ) )
+  {
+    TextBlock::Input  input ( state, block );
+
+    parseRows_   ( state );
+    input.finish ();
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   parseRows_
+//-----------------------------------------------------------------------
+
+
+void TBSectionParser::parseRows_ ( State& state )
 {
   const Scope*  scope =   scope_.get ();
   Tokenizer&    input = * state.input;
@@ -395,8 +536,6 @@ void TBSectionParser::parseSection_ ( State& state )
   int           token;
 
 
-  table_->reserve ( rowItems_->size() / 4 + 32 );
-
   rowCount = 0;
   token    = input.nextToken ();
 
@@ -442,6 +581,142 @@ void TBSectionParser::parseSection_ ( State& state )
 }
 
 
+//-----------------------------------------------------------------------
+//   parseBlock_
+//-----------------------------------------------------------------------
+
+// Parses the chunks of a text block in parallel and then stores the
+// rows in their original order. Returns false, without modifying the
+// table, if the block contains rows that must be parsed by
+// parseRows_(); rows that are specified by a range or a group name,
+// for instance.
+
+
+bool TBSectionParser::parseBlock_
+
+  ( State&            state,
+    const TextBlock&  block )
+
+{
+  const idx_t  chunkCount = block.chunkCount ();
+  const idx_t  colCount   = jcols_.size      ();
+
+  Chunks_      chunks     ( chunkCount );
+  idx_t        rowCount;
+  idx_t        i, n;
+
+
+  // Some item maps update their internal state on the first look-up;
+  // make sure that this does not happen in parallel.
+
+  rowMap_->findItem ( 0 );
+
+  Work_  work ( *this, block, chunks );
+
+  block.execute ( work );
+
+  for ( idx_t ichunk = 0; ichunk < chunkCount; ichunk++ )
+  {
+    if ( chunks[ichunk].failed )
+    {
+      return false;
+    }
+  }
+
+  rowCount = 0;
+
+  for ( idx_t ichunk = 0; ichunk < chunkCount; ichunk++ )
+  {
+    const Chunk_&  chunk = chunks[ichunk];
+    const double*  vals  = chunk.values.addr ();
+
+    n = chunk.irows.size ();
+
+    for ( i = 0; i < n; i++, vals += colCount )
+    {
+      table_->setData ( chunk.irows.addr( i ), 1,
+                        jcols_.addr(),         colCount, vals );
+    }
+
+    rowCount += chunk.rowCount;
+
+    if ( chunk.rowCount > 0 )
+    {
+      state.log->logEvent (
+        state,
+        ParseLog::PROGRESS,
+        String::format ( "number of rows read : %d", rowCount )
+      );
+    }
+  }
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------
+//   parseChunk_
+//-----------------------------------------------------------------------
+
+
+bool TBSectionParser::parseChunk_
+
+  ( Chunk_&             chunk,
+    TextBlock::Cursor&  cursor ) const
+
+{
+  const idx_t  colCount = jcols_.size ();
+
+  double       value;
+  idx_t        rowID;
+  idx_t        irow;
+
+
+  chunk.rowCount = 0;
+
+  while ( ! cursor.atEnd() )
+  {
+    if ( ! cursor.readInteger( rowID ) )
+    {
+      return false;
+    }
+
+    irow = rowMap_->findItem ( rowID );
+
+    if ( irow < 0 && ! skipUnknown_ )
+    {
+      return false;
+    }
+
+    for ( idx_t j = 0; j < colCount; j++ )
+    {
+      if ( ! cursor.readFloat( value ) )
+      {
+        return false;
+      }
+
+      if ( irow >= 0 )
+      {
+        chunk.values.pushBack ( value );
+      }
+    }
+
+    if ( irow >= 0 )
+    {
+      chunk.irows.pushBack ( irow );
+    }
+
+    chunk.rowCount++;
+
+    // A line-terminating ';' is optional
+
+    cursor.readChar ( ';' );
+  }
+
+  return true;
+}
+
+
 //-----------------------------------------------------------------------
 //   scanSection_
 //-----------------------------------------------------------------------
@@ -0,0 +1,395 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+
+
+#include <cstring>
+#include <jem/base/ThreadTeam.h>
+#include <jem/io/FloatConv.h>
+#include <jem/util/ArrayBuffer.h>
+#include <jem/xml/Parser.h>
+#include <jem/xml/ParserState.h>
+#include <jem/xml/Tokenizer.h>
+#include "TextBlock.h"
+
+
+JIVE_BEGIN_PACKAGE( util )
+
+
+using jem::newInstance;
+using jem::ThreadTeam;
+using jem::io::FloatConv;
+using jem::util::ArrayBuffer;
+using jem::xml::Parser;
+using jem::xml::Tokenizer;
+
+
+//=======================================================================
+//   class TextBlock
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   static data
+//-----------------------------------------------------------------------
+
+
+const idx_t  TextBlock::CHUNK_SIZE = 128 * 1024;
+
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+TextBlock::TextBlock ( State& state )
+{
+  Tokenizer&          input = * state.input;
+
+  ArrayBuffer<idx_t>  offsets;
+  const char*         text;
+  const char*         eol;
+  idx_t               size;
+  idx_t               i;
+
+
+  firstLine_ = input.getLineNumber ();
+
+  input.readRawText ( text_ );
+
+  text = text_.addr ();
+  size = text_.size ();
+
+  offsets.reserve  ( size / CHUNK_SIZE + 2 );
+  offsets.pushBack ( 0 );
+
+  // Split the text after the first new-line character that follows
+  // the nominal end of each chunk.
+
+  i = CHUNK_SIZE;
+
+  while ( i < size )
+  {
+    eol = (const char*)
+
+      std::memchr ( text + i, '\n', (size_t) (size - i) );
+
+    if ( ! eol )
+    {
+      break;
+    }
+
+    i = (idx_t) (eol - text) + 1;
+
+    if ( i >= size )
+    {
+      break;
+    }
+
+    offsets.pushBack ( i );
+
+    i += CHUNK_SIZE;
+  }
+
+  offsets.pushBack ( size );
+
+  offsets_.ref ( offsets.toArray() );
+}
+
+
+//-----------------------------------------------------------------------
+//   getChunk
+//-----------------------------------------------------------------------
+
+
+TextBlock::Cursor TextBlock::getChunk ( idx_t ichunk ) const
+{
+  JEM_ASSERT ( ichunk >= 0 && ichunk < chunkCount() );
+
+  const char*  text = text_.addr ();
+
+  return Cursor ( text + offsets_[ichunk],
+                  text + offsets_[ichunk + 1] );
+}
+
+
+//-----------------------------------------------------------------------
+//   execute
+//-----------------------------------------------------------------------
+
+
+void TextBlock::execute ( Work& work ) const
+{
+  Ref<ThreadTeam>  team  = ThreadTeam::getCurrent ();
+  const idx_t      count = chunkCount ();
+
+  if ( team && team->size() > 1 && count > 1 )
+  {
+    team->execute ( work, count );
+  }
+  else
+  {
+    work.run ( 0, count );
+  }
+}
+
+
+//=======================================================================
+//   class TextBlock::Cursor
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   readInteger
+//-----------------------------------------------------------------------
+
+
+bool TextBlock::Cursor::readInteger ( idx_t& value )
+{
+  lint  ivalue;
+
+  if ( ! readInteger_( ivalue ) )
+  {
+    return false;
+  }
+
+  value = (idx_t) ivalue;
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------
+//   readFloat
+//-----------------------------------------------------------------------
+
+
+bool TextBlock::Cursor::readFloat ( double& value )
+{
+  const char*  p;
+  const char*  q;
+  idx_t        digitCount;
+  bool         isInteger;
+
+
+  skipWhite_ ();
+
+  p         = pos_;
+  isInteger = true;
+
+  if ( p < end_ && (*p == '-' || *p == '+') )
+  {
+    p++;
+  }
+
+  q = p;
+
+  while ( p < end_ && *p >= '0' && *p <= '9' )
+  {
+    p++;
+  }
+
+  digitCount = (idx_t) (p - q);
+
+  if ( p < end_ && *p == '.' )
+  {
+    isInteger = false;
+    q         = ++p;
+
+    while ( p < end_ && *p >= '0' && *p <= '9' )
+    {
+      p++;
+    }
+
+    digitCount += (idx_t) (p - q);
+  }
+
+  if ( digitCount == 0 )
+  {
+    return false;
+  }
+
+  if ( p < end_ && (*p == 'e' || *p == 'E') )
+  {
+    isInteger = false;
+
+    p++;
+
+    if ( p < end_ && (*p == '-' || *p == '+') )
+    {
+      p++;
+    }
+
+    q = p;
+
+    while ( p < end_ && *p >= '0' && *p <= '9' )
+    {
+      p++;
+    }
+
+    if ( p == q )
+    {
+      return false;
+    }
+  }
+
+  if ( ! isDelim_( p ) )
+  {
+    return false;
+  }
+
+  // Integers are converted in the same way as by the tokenizer.
+
+  if ( isInteger )
+  {
+    lint  ivalue;
+
+    if ( ! readInteger_( ivalue ) )
+    {
+      return false;
+    }
+
+    value = (double) ivalue;
+
+    return true;
+  }
+
+  if ( ! FloatConv::parse( value, pos_, (idx_t) (p - pos_) ) )
+  {
+    return false;
+  }
+
+  pos_ = p;
+
+  return true;
+}
+
+
+//-----------------------------------------------------------------------
+//   readInteger_
+//-----------------------------------------------------------------------
+
+
+bool TextBlock::Cursor::readInteger_ ( lint& value )
+{
+  // Longer numbers are left to the tokenizer, which checks for
+  // overflow.
+
+  const idx_t  MAX_DIGITS = 18;
+
+  const char*  p;
+  const char*  q;
+  lint         ivalue;
+  bool         negative;
+
+
+  skipWhite_ ();
+
+  p        = pos_;
+  ivalue   = 0;
+  negative = false;
+
+  if ( p < end_ && (*p == '-' || *p == '+') )
+  {
+    negative = (*p == '-');
+    p++;
+  }
+
+  q = p;
+
+  while ( p < end_ && *p >= '0' && *p <= '9' )
+  {
+    ivalue = 10 * ivalue + (lint) (*p - '0');
+    p++;
+  }
+
+  if ( p == q || (p - q) > MAX_DIGITS || ! isDelim_( p ) )
+  {
+    return false;
+  }
+
+  pos_  = p;
+  value = negative ? -ivalue : ivalue;
+
+  return true;
+}
+
+
+//=======================================================================
+//   class TextBlock::Input
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor & destructor
+//-----------------------------------------------------------------------
+
+
+TextBlock::Input::Input
+
+  ( State&            state,
+    const TextBlock&  block ) :
+
+    state_ ( state )
+
+{
+  Ref<Tokenizer>  input = newInstance<Tokenizer> (
+    String ( block.text_.addr(), block.text_.size() )
+  );
+
+  input->setOptions    ( state.input->getOptions() );
+  input->setLineNumber ( block.firstLine_ );
+
+  input_      = state.input;
+  state.input = input;
+}
+
+
+TextBlock::Input::~Input ()
+{
+  input_->setLineNumber ( state_.input->getLineNumber() );
+
+  state_.input = input_;
+}
+
+
+//-----------------------------------------------------------------------
+//   finish
+//-----------------------------------------------------------------------
+
+
+void TextBlock::Input::finish ()
+{
+  if ( state_.input->nextToken() != Tokenizer::EOF_TOKEN )
+  {
+    Parser::parseError ( state_ );
+  }
+}
+
+
+JIVE_END_PACKAGE( util )
@@ -0,0 +1,337 @@
+
+/*
+ *  Copyright (C) 2019 DRG. All rights reserved.
+ *
+ *  This file is part of Jive, an object oriented toolkit for solving
+ *  partial differential equations.
+ *
+ *  Commercial License Usage
+ *
+ *  This file may be used under the terms of a commercial license
+ *  provided with the software, or under the terms contained in a written
+ *  agreement between you and DRG. For more information contact DRG at
+ *  http://www.dynaflow.com.
+ *
+ *  GNU Lesser General Public License Usage
+ *
+ *  Alternatively, this file may be used under the terms of the GNU
+ *  Lesser General Public License version 2.1 or version 3 as published
+ *  by the Free Software Foundation and appearing in the file
+ *  LICENSE.LGPLv21 and LICENSE.LGPLv3 included in the packaging of this
+ *  file. Please review the following information to ensure the GNU
+ *  Lesser General Public License requirements will be met:
+ *  https://www.gnu.org/licenses/lgpl.html and
+ *  http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+ *  This file is part of Jive, an object oriented toolkit for
+ *  solving partial differential equations.
+ *
+ *  Jive version: 3.0
+ *  Date:         Fri 20 Dec 14:30:12 CET 2019
+ */
+
+#ifndef JIVE_UTIL_PRIVATE_TEXTBLOCK_H
+#define JIVE_UTIL_PRIVATE_TEXTBLOCK_H
+
+#include <jem/base/StringBuffer.h>
+#include <jem/base/ThreadTeam.h>
+#include <jive/Array.h>
+#include <jive/util/import.h>
+
+
+namespace jem
+{
+  namespace xml
+  {
+    class Tokenizer;
+    class ParserState;
+  }
+}
+
+
+JIVE_BEGIN_PACKAGE( util )
+
+
+//-----------------------------------------------------------------------
+//   class TextBlock
+//-----------------------------------------------------------------------
+
+// Holds the raw text of a data block (the contents of a Nodes or
+// Elements tag, for instance) so that it can be parsed in parallel.
+// The text is split into chunks at line boundaries; each chunk can be
+// scanned independently by a Cursor. If a chunk contains something
+// that the Cursor does not understand, the Input class can be used to
+// parse the complete block with the standard tokenizer instead.
+
+
+class TextBlock
+{
+ public:
+
+  typedef jem::
+    xml::ParserState        State;
+  typedef jem::
+    ThreadTeam::Work        Work;
+
+  class                     Cursor;
+  class                     Input;
+
+  static const idx_t        CHUNK_SIZE;
+
+
+  explicit                  TextBlock
+
+    ( State&                  state );
+
+  inline idx_t              chunkCount    () const noexcept;
+  inline lint               getFirstLine  () const noexcept;
+
+  Cursor                    getChunk
+
+    ( idx_t                   ichunk )       const;
+
+  void                      execute
+
+    ( Work&                   work )         const;
+
+
+ private:
+
+  jem::StringBuffer         text_;
+  IdxVector                 offsets_;
+  lint                      firstLine_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   class TextBlock::Cursor
+//-----------------------------------------------------------------------
+
+// Scans the numbers in a chunk without allocating memory. The read
+// functions return false if the next token is not a plain decimal
+// number; the caller should then fall back to the standard tokenizer.
+
+
+class TextBlock::Cursor
+{
+ public:
+
+  inline                    Cursor
+
+    ( const char*             first,
+      const char*             last );
+
+  inline bool               atEnd         ();
+
+  inline bool               readChar
+
+    ( char                    c );
+
+  bool                      readInteger
+
+    ( idx_t&                  value );
+
+  bool                      readFloat
+
+    ( double&                 value );
+
+
+ public:
+
+  lint                      lineCount;
+
+
+ private:
+
+  bool                      readInteger_
+
+    ( lint&                   value );
+
+  inline void               skipWhite_    ();
+  inline bool               isDelim_
+
+    ( const char*             p )            const;
+
+
+ private:
+
+  const char*               pos_;
+  const char*               end_;
+
+};
+
+
+//-----------------------------------------------------------------------
+//   class TextBlock::Input
+//-----------------------------------------------------------------------
+
+// Temporarily replaces the input tokenizer of a parser state by one
+// that reads the text of a block. The original tokenizer is restored,
+// with an updated line number, when the Input object is destroyed.
+
+
+class TextBlock::Input
+{
+ public:
+
+                            Input
+
+    ( State&                  state,
+      const TextBlock&        block );
+
+                           ~Input         ();
+
+  void                      finish        ();
+
+
+ private:
+
+                            Input
+
+    ( const Input&            rhs );
+
+  Input&                    operator =
+
+    ( const Input&            rhs );
+
+
+ private:
+
+  State&                    state_;
+  Ref<jem::xml::Tokenizer>  input_;
+
+};
+
+
+
+
+
+//#######################################################################
+//   Implementation
+//#######################################################################
+
+//=======================================================================
+//   class TextBlock
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   chunkCount
+//-----------------------------------------------------------------------
+
+
+inline idx_t TextBlock::chunkCount () const noexcept
+{
+  return (offsets_.size() - 1);
+}
+
+
+//-----------------------------------------------------------------------
+//   getFirstLine
+//-----------------------------------------------------------------------
+
+
+inline lint TextBlock::getFirstLine () const noexcept
+{
+  return firstLine_;
+}
+
+
+//=======================================================================
+//   class TextBlock::Cursor
+//=======================================================================
+
+//-----------------------------------------------------------------------
+//   constructor
+//-----------------------------------------------------------------------
+
+
+inline TextBlock::Cursor::Cursor
+
+  ( const char*  first,
+    const char*  last ) :
+
+    lineCount ( 0 ),
+    pos_      ( first ),
+    end_      ( last )
+
+{}
+
+
+//-----------------------------------------------------------------------
+//   atEnd
+//-----------------------------------------------------------------------
+
+
+inline bool TextBlock::Cursor::atEnd ()
+{
+  skipWhite_ ();
+
+  return (pos_ == end_);
+}
+
+
+//-----------------------------------------------------------------------
+//   readChar
+//-----------------------------------------------------------------------
+
+
+inline bool TextBlock::Cursor::readChar ( char c )
+{
+  skipWhite_ ();
+
+  if ( pos_ < end_ && *pos_ == c )
+  {
+    pos_++;
+    return true;
+  }
+
+  return false;
+}
+
+
+//-----------------------------------------------------------------------
+//   skipWhite_
+//-----------------------------------------------------------------------
+
+
+inline void TextBlock::Cursor::skipWhite_ ()
+{
+  while ( pos_ < end_ )
+  {
+    char  c = *pos_;
+
+    if ( c == '\n' )
+    {
+      lineCount++;
+    }
+    else if ( c != ' ' && (c < '\t' || c > '\r') )
+    {
+      break;
+    }
+
+    pos_++;
+  }
+}
+
+
+//-----------------------------------------------------------------------
+//   isDelim_
+//-----------------------------------------------------------------------
+
+
+inline bool TextBlock::Cursor::isDelim_ ( const char* p ) const
+{
+  if ( p == end_ )
+  {
+    return true;
+  }
+
+  char  c = *p;
+
+  return (c == ';' || c == ' ' || (c >= '\t' && c <= '\r'));
+}
+
+
+JIVE_END_PACKAGE( util )
+
+#endif